@@ -65,6 +65,7 @@
 #include "filesystem/PluginDirectory.h"
 #include "utils/SystemInfo.h"
 #include "utils/TimeUtils.h"
+#include "utils/TraceRecorder.h"
 #include "GUILargeTextureManager.h"
 #include "TextureCache.h"
 #include "playlists/SmartPlayList.h"
@@ -2331,6 +2332,8 @@ void CApplication::UnlockFrameMoveGuard()
 
 void CApplication::FrameMove(bool processEvents, bool processGUI)
 {
+  CTraceScope trace("CApplication::FrameMove");
+
   if (processEvents)
   {
     // currently we calculate the repeat time (ie time from last similar keypress) just global as fps
@@ -3926,6 +3929,23 @@ bool CApplication::OnMessage(CGUIMessage& message)
 
   case GUI_MSG_PLAYBACK_AVSTARTED:
     m_playerEvent.Set();
+    if (m_appPlayer.IsPlayingAudio() &&
+        CServiceBroker::GetPlaylistPlayer().GetCurrentPlaylist() == PLAYLIST_MUSIC)
+    {
+      // hand copies of the upcoming items to the player, which may open them ahead of time
+      const CPlayListPlayer &playlistPlayer = CServiceBroker::GetPlaylistPlayer();
+      const CPlayList &playlist = playlistPlayer.GetPlaylist(PLAYLIST_MUSIC);
+      std::vector<CFileItem> upcoming;
+      for (int offset = 1; offset <= 3; offset++)
+      {
+        int song = playlistPlayer.GetNextSong(offset);
+        if (song < 0 || song >= playlist.size())
+          break;
+        if (!URIUtils::IsPlugin(playlist[song]->GetDynPath()))
+          upcoming.push_back(*playlist[song]);
+      }
+      m_appPlayer.PreloadUpcomingFiles(upcoming);
+    }
 #ifdef HAS_PYTHON
     // informs python script currently running playback has started
     // (does nothing if python is not loaded)
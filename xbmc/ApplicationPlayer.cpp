@@ -574,6 +574,13 @@ void CApplicationPlayer::OnNothingToQueueNotify()
     player->OnNothingToQueueNotify();
 }
 
+void CApplicationPlayer::PreloadUpcomingFiles(const std::vector<CFileItem> &files)
+{
+  std::shared_ptr<IPlayer> player = GetInternal();
+  if (player)
+    player->PreloadUpcomingFiles(files);
+}
+
 void CApplicationPlayer::GetVideoStreamInfo(int streamId, VideoStreamInfo &info)
 {
   std::shared_ptr<IPlayer> player = GetInternal();
@@ -122,6 +122,7 @@ public:
   void LoadPage(int p, int sp, unsigned char* buffer);
   bool OnAction(const CAction &action);
   void OnNothingToQueueNotify();
+  void PreloadUpcomingFiles(const std::vector<CFileItem> &files);
   void Pause();
   bool QueueNextFile(const CFileItem &file);
   void Seek(bool bPlus = true, bool bLargeStep = false, bool bChapterOverride = false);
@@ -28,9 +28,13 @@
 #include "interfaces/AnnouncementManager.h"
 #include "interfaces/info/InfoExpression.h"
 #include "messaging/ApplicationMessenger.h"
+#include "settings/Settings.h"
+#include "settings/SettingsComponent.h"
 #include "settings/SkinSettings.h"
+#include "settings/lib/Setting.h"
 #include "utils/CharsetConverter.h"
 #include "utils/StringUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
@@ -51,12 +55,30 @@ CGUIInfoManager::CGUIInfoManager(void)
 
 CGUIInfoManager::~CGUIInfoManager(void)
 {
+  CSettingsComponent *settingsComponent = CServiceBroker::GetSettingsComponent();
+  if (settingsComponent && settingsComponent->GetSettings())
+    settingsComponent->GetSettings()->UnregisterCallback(this);
+
   delete m_currentFile;
 }
 
 void CGUIInfoManager::Initialize()
 {
   KODI::MESSAGING::CApplicationMessenger::GetInstance().RegisterReceiver(this);
+
+  RegisterSettingCondition(CSettings::SETTING_POWERMANAGEMENT_SHUTDOWNTIME);
+}
+
+void CGUIInfoManager::RegisterSettingCondition(const std::string &settingId)
+{
+  CSettingsComponent *settingsComponent = CServiceBroker::GetSettingsComponent();
+  if (settingsComponent && settingsComponent->GetSettings())
+    settingsComponent->GetSettings()->RegisterCallback(this, { settingId });
+}
+
+void CGUIInfoManager::OnSettingChanged(std::shared_ptr<const CSetting> setting)
+{
+  InfoSourceChanged(INFO::INFO_SOURCE_SETTINGS);
 }
 
 /// \brief Translates a string as given by the skin into an int that we use for more
@@ -8653,6 +8675,7 @@ int CGUIInfoManager::TranslateSingleString(const std::string &strCondition, bool
         {
           std::string paramCopy = param;
           StringUtils::ToLower(paramCopy);
+          RegisterSettingCondition(paramCopy);
           return AddMultiInfo(CGUIInfo(SYSTEM_GET_BOOL, paramCopy));
         }
         for (const infomap& i : system_param)
@@ -9233,9 +9256,9 @@ INFO::InfoPtr CGUIInfoManager::Register(const std::string &expression, int conte
   std::pair<INFOBOOLTYPE::iterator, bool> res;
 
   if (condition.find_first_of("|+[]!") != condition.npos)
-    res = m_bools.insert(std::make_shared<InfoExpression>(condition, context, m_refreshCounter));
+    res = m_bools.insert(std::make_shared<InfoExpression>(condition, context, m_sourceCounters));
   else
-    res = m_bools.insert(std::make_shared<InfoSingle>(condition, context, m_refreshCounter));
+    res = m_bools.insert(std::make_shared<InfoSingle>(condition, context, m_sourceCounters));
 
   if (res.second)
     res.first->get()->Initialize();
@@ -9549,6 +9572,10 @@ void CGUIInfoManager::Clear()
   CSingleLock lock(m_critInfo);
   m_skinVariableStrings.clear();
 
+  // the bools that are kept may refer to the settings of another skin or profile
+  m_sourceCounters.Changed(INFO::INFO_SOURCE_SKIN);
+  m_sourceCounters.Changed(INFO::INFO_SOURCE_SETTINGS);
+
   /*
     Erase any info bools that are unused. We do this repeatedly as each run
     will remove those bools that are no longer dependencies of other bools
@@ -9804,9 +9831,108 @@ bool CGUIInfoManager::GetItemBool(const CGUIListItem *item, int contextWindow, i
 
 void CGUIInfoManager::ResetCache()
 {
+  CTraceScope trace("CGUIInfoManager::ResetCache");
+
   // mark our infobools as dirty
   CSingleLock lock(m_critInfo);
-  ++m_refreshCounter;
+  m_sourceCounters.Changed(INFO::INFO_SOURCE_FRAME);
+
+  const time_t minute = time(nullptr) / 60;
+  if (minute != m_lastMinute)
+  {
+    m_lastMinute = minute;
+    m_sourceCounters.Changed(INFO::INFO_SOURCE_TIME);
+  }
+
+  // the player changes its state on its own threads, in an order that doesn't match the callbacks
+  // to the application. comparing the few values the player conditions are made of is cheaper
+  // than evaluating those conditions every frame.
+  CApplicationPlayer& player = g_application.GetAppPlayer();
+  const int playerState = (player.IsPlaying() ? 1 : 0) |
+                          (player.IsPlayingAudio() ? 2 : 0) |
+                          (player.IsPlayingVideo() ? 4 : 0) |
+                          (player.IsPlayingGame() ? 8 : 0);
+  const float playerSpeed = player.GetPlaySpeed();
+  if (playerState != m_playerState || playerSpeed != m_playerSpeed)
+  {
+    m_playerState = playerState;
+    m_playerSpeed = playerSpeed;
+    m_sourceCounters.Changed(INFO::INFO_SOURCE_PLAYER);
+  }
+}
+
+void CGUIInfoManager::InfoSourceChanged(INFO::InfoSource source)
+{
+  CSingleLock lock(m_critInfo);
+  m_sourceCounters.Changed(source);
+}
+
+unsigned int CGUIInfoManager::GetConditionSources(int condition) const
+{
+  condition = std::abs(condition);
+  if (condition >= MULTI_INFO_START && condition <= MULTI_INFO_END &&
+      static_cast<size_t>(condition - MULTI_INFO_START) < m_multiInfo.size())
+    condition = std::abs(m_multiInfo[condition - MULTI_INFO_START].m_info);
+
+  // only sources whose changes are tracked are listed, everything else is evaluated every frame
+  switch (condition)
+  {
+    case SYSTEM_ALWAYS_TRUE:
+    case SYSTEM_ALWAYS_FALSE:
+      return 0;
+    case SKIN_BOOL:
+    case SKIN_STRING:
+    case SKIN_STRING_IS_EQUAL:
+    case SKIN_HAS_THEME:
+      return 1 << INFO::INFO_SOURCE_SKIN;
+    case SYSTEM_TIME:
+    case SYSTEM_DATE:
+      return 1 << INFO::INFO_SOURCE_TIME;
+    case PLAYER_HAS_MEDIA:
+    case PLAYER_HAS_AUDIO:
+    case PLAYER_HAS_VIDEO:
+    case PLAYER_HAS_GAME:
+    case PLAYER_PLAYING:
+    case PLAYER_PAUSED:
+    case PLAYER_REWINDING:
+    case PLAYER_FORWARDING:
+    case PLAYER_REWINDING_2x:
+    case PLAYER_REWINDING_4x:
+    case PLAYER_REWINDING_8x:
+    case PLAYER_REWINDING_16x:
+    case PLAYER_REWINDING_32x:
+    case PLAYER_FORWARDING_2x:
+    case PLAYER_FORWARDING_4x:
+    case PLAYER_FORWARDING_8x:
+    case PLAYER_FORWARDING_16x:
+    case PLAYER_FORWARDING_32x:
+      return 1 << INFO::INFO_SOURCE_PLAYER;
+    case SYSTEM_GET_BOOL:
+    case SYSTEM_HAS_SHUTDOWN:
+      return 1 << INFO::INFO_SOURCE_SETTINGS;
+    case PVR_IS_RECORDING:
+    case PVR_IS_RECORDING_TV:
+    case PVR_IS_RECORDING_RADIO:
+    case PVR_HAS_TIMER:
+    case PVR_HAS_TV_TIMER:
+    case PVR_HAS_RADIO_TIMER:
+    case PVR_HAS_TV_CHANNELS:
+    case PVR_HAS_RADIO_CHANNELS:
+    case PVR_HAS_NONRECORDING_TIMER:
+    case PVR_HAS_NONRECORDING_TV_TIMER:
+    case PVR_HAS_NONRECORDING_RADIO_TIMER:
+    case PVR_IS_PLAYING_TV:
+    case PVR_IS_PLAYING_RADIO:
+    case PVR_IS_PLAYING_RECORDING:
+    case PVR_IS_PLAYING_EPGTAG:
+    case PVR_ACTUAL_STREAM_ENCRYPTED:
+    case PVR_IS_TIMESHIFTING:
+    case PVR_CAN_RECORD_PLAYING_CHANNEL:
+    case PVR_IS_RECORDING_PLAYING_CHANNEL:
+      return 1 << INFO::INFO_SOURCE_PVR;
+    default:
+      return 1 << INFO::INFO_SOURCE_FRAME;
+  }
 }
 
 void CGUIInfoManager::SetCurrentVideoTag(const CVideoInfoTag &tag)
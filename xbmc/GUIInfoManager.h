@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <ctime>
 #include <map>
 #include <memory>
 #include <set>
@@ -18,6 +19,7 @@
 #include "interfaces/info/InfoBool.h"
 #include "interfaces/info/SkinVariable.h"
 #include "messaging/IMessageTarget.h"
+#include "settings/lib/ISettingCallback.h"
 #include "threads/CriticalSection.h"
 #include "utils/Observer.h"
 
@@ -51,7 +53,7 @@ namespace MUSIC_INFO
  \ingroup strings
  \brief
  */
-class CGUIInfoManager : public Observable, public KODI::MESSAGING::IMessageTarget
+class CGUIInfoManager : public Observable, public KODI::MESSAGING::IMessageTarget, public ISettingCallback
 {
 public:
   CGUIInfoManager(void);
@@ -62,6 +64,14 @@ public:
   void Clear();
   void ResetCache();
 
+  /*! \brief Mark the info bools depending on a source for evaluation
+   \param source the source that changed
+   */
+  void InfoSourceChanged(INFO::InfoSource source);
+
+  // ISettingCallback implementation
+  void OnSettingChanged(std::shared_ptr<const CSetting> setting) override;
+
   // KODI::MESSAGING::IMessageTarget implementation
   int GetMessageMask() override;
   void OnApplicationMessage(KODI::MESSAGING::ThreadMessage* pMsg) override;
@@ -92,6 +102,12 @@ public:
   int TranslateString(const std::string &strCondition);
   int TranslateSingleString(const std::string &strCondition, bool &listItemDependent);
 
+  /*! \brief Get the sources a condition depends on
+   \param condition the condition as returned by TranslateSingleString()
+   \return bit mask of the sources, (1 << source) for each source
+   */
+  unsigned int GetConditionSources(int condition) const;
+
   std::string GetLabel(int info, int contextWindow = 0, std::string *fallback = nullptr) const;
   std::string GetImage(int info, int contextWindow, std::string *fallback = nullptr);
   bool GetInt(int &value, int info, int contextWindow = 0, const CGUIListItem *item = nullptr) const;
@@ -176,6 +192,11 @@ private:
   int TranslateMusicPlayerString(const std::string &info) const;
   static TIME_FORMAT TranslateTimeFormat(const std::string &format);
 
+  /*! \brief Get notified about changes of a setting a condition reads
+   \param settingId the id of the setting
+   */
+  void RegisterSettingCondition(const std::string &settingId);
+
   std::string GetMultiInfoLabel(const KODI::GUILIB::GUIINFO::CGUIInfo &info, int contextWindow, std::string *fallback = nullptr) const;
   bool GetMultiInfoInt(int &value, const KODI::GUILIB::GUIINFO::CGUIInfo &info, int contextWindow, const CGUIListItem *item) const;
   bool GetMultiInfoBool(const KODI::GUILIB::GUIINFO::CGUIInfo &info, int contextWindow, const CGUIListItem *item);
@@ -201,7 +222,10 @@ private:
 
   typedef std::set<INFO::InfoPtr, bool(*)(const INFO::InfoPtr&, const INFO::InfoPtr&)> INFOBOOLTYPE;
   INFOBOOLTYPE m_bools;
-  unsigned int m_refreshCounter = 0;
+  INFO::InfoSourceCounters m_sourceCounters;
+  time_t m_lastMinute = 0;
+  int m_playerState = -1;     ///< playing, audio, video and game flags of the player at the last frame
+  float m_playerSpeed = 0.0f; ///< speed of the player at the last frame
   std::vector<INFO::CSkinVariableString> m_skinVariableStrings;
 
   CCriticalSection m_critInfo;
@@ -11,18 +11,28 @@
 #include "guilib/Texture.h"
 #include "threads/SingleLock.h"
 #include "utils/TimeUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/JobManager.h"
 #include "windowing/GraphicContext.h"
 #include "utils/log.h"
 #include "TextureCache.h"
 
+#include <algorithm>
 #include <cassert>
 
-CImageLoader::CImageLoader(const std::string &path, const bool useCache):
-  m_path(path)
+namespace
+{
+  // leaves a worker of the normal priority for other jobs
+  const unsigned int MAX_LOADING_IMAGES = 3;
+}
+
+CImageLoader::CImageLoader(const std::string &path, const bool useCache, unsigned int size):
+  m_path(path),
+  m_size(size)
 {
   m_texture = NULL;
   m_use_cache = useCache;
+  m_loadTime = 0;
 }
 
 CImageLoader::~CImageLoader()
@@ -32,6 +42,7 @@ CImageLoader::~CImageLoader()
 
 bool CImageLoader::DoWork()
 {
+  CTraceScope trace("CImageLoader::DoWork");
   bool needsChecking = false;
   std::string loadPath;
 
@@ -46,12 +57,21 @@ bool CImageLoader::DoWork()
 
   if (!loadPath.empty())
   {
-    // direct route - load the image
+    // direct route - load the image, the decoders scale it down while decoding
+    unsigned int width = CServiceBroker::GetWinSystem()->GetGfxContext().GetWidth();
+    unsigned int height = CServiceBroker::GetWinSystem()->GetGfxContext().GetHeight();
+    if (m_size)
+    {
+      width = std::min(width, m_size);
+      height = std::min(height, m_size);
+    }
+
     unsigned int start = XbmcThreads::SystemClockMillis();
-    m_texture = CBaseTexture::LoadFromFile(loadPath, CServiceBroker::GetWinSystem()->GetGfxContext().GetWidth(), CServiceBroker::GetWinSystem()->GetGfxContext().GetHeight());
+    m_texture = CBaseTexture::LoadFromFile(loadPath, width, height);
+    m_loadTime = XbmcThreads::SystemClockMillis() - start;
 
-    if (XbmcThreads::SystemClockMillis() - start > 100)
-      CLog::Log(LOGDEBUG, "%s - took %u ms to load %s", __FUNCTION__, XbmcThreads::SystemClockMillis() - start, loadPath.c_str());
+    if (m_loadTime > 100)
+      CLog::Log(LOGDEBUG, "%s - took %u ms to load %s", __FUNCTION__, m_loadTime, loadPath.c_str());
 
     if (m_texture)
     {
@@ -73,8 +93,9 @@ bool CImageLoader::DoWork()
   return (m_texture != NULL);
 }
 
-CGUILargeTextureManager::CLargeTexture::CLargeTexture(const std::string &path):
-  m_path(path)
+CGUILargeTextureManager::CLargeTexture::CLargeTexture(const std::string &path, unsigned int size):
+  m_path(path),
+  m_size(size)
 {
   m_refCount = 1;
   m_timeToDelete = 0;
@@ -144,13 +165,15 @@ void CGUILargeTextureManager::CleanupUnusedImages(bool immediately)
 
 // if available, increment reference count, and return the image.
 // else, add to the queue list if appropriate.
-bool CGUILargeTextureManager::GetImage(const std::string &path, CTextureArray &texture, bool firstRequest, const bool useCache)
+bool CGUILargeTextureManager::GetImage(const std::string &path, CTextureArray &texture, bool firstRequest, const bool useCache, unsigned int size)
 {
+  size = GetDecodeSize(size);
+
   CSingleLock lock(m_listSection);
   for (listIterator it = m_allocated.begin(); it != m_allocated.end(); ++it)
   {
     CLargeTexture *image = *it;
-    if (image->GetPath() == path)
+    if (image->Matches(path, size))
     {
       if (firstRequest)
         image->AddRef();
@@ -160,18 +183,31 @@ bool CGUILargeTextureManager::GetImage(const std::string &path, CTextureArray &t
   }
 
   if (firstRequest)
-    QueueImage(path, useCache);
+    QueueImage(path, useCache, size);
+  else
+  { // still waiting, so it is still wanted
+    for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
+    {
+      if (it->image->Matches(path, size))
+      {
+        it->lastRequest = CTimeUtils::GetFrameTime();
+        break;
+      }
+    }
+  }
 
   return true;
 }
 
-void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immediately)
+void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immediately, unsigned int size)
 {
+  size = GetDecodeSize(size);
+
   CSingleLock lock(m_listSection);
   for (listIterator it = m_allocated.begin(); it != m_allocated.end(); ++it)
   {
     CLargeTexture *image = *it;
-    if (image->GetPath() == path)
+    if (image->Matches(path, size))
     {
       if (image->DecrRef(immediately) && immediately)
         m_allocated.erase(it);
@@ -180,20 +216,22 @@ void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immedia
   }
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
-    unsigned int id = it->first;
-    CLargeTexture *image = it->second;
-    if (image->GetPath() == path && image->DecrRef(true))
+    unsigned int id = it->jobID;
+    CLargeTexture *image = it->image;
+    if (image->Matches(path, size) && image->DecrRef(true))
     {
       // cancel this job
-      CJobManager::GetInstance().CancelJob(id);
+      if (id)
+        CJobManager::GetInstance().CancelJob(id);
       m_queued.erase(it);
+      StartLoaders();
       return;
     }
   }
 }
 
 // queue the image, and start the background loader if necessary
-void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache)
+void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache, unsigned int size)
 {
   if (path.empty())
     return;
@@ -201,18 +239,59 @@ void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache)
   CSingleLock lock(m_listSection);
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
-    CLargeTexture *image = it->second;
-    if (image->GetPath() == path)
+    CLargeTexture *image = it->image;
+    if (image->Matches(path, size))
     {
       image->AddRef();
+      it->lastRequest = CTimeUtils::GetFrameTime();
       return; // already queued
     }
   }
 
   // queue the item
-  CLargeTexture *image = new CLargeTexture(path);
-  unsigned int jobID = CJobManager::GetInstance().AddJob(new CImageLoader(path, useCache), this, CJob::PRIORITY_NORMAL);
-  m_queued.push_back(std::make_pair(jobID, image));
+  CQueuedImage queued;
+  queued.image = new CLargeTexture(path, size);
+  queued.jobID = 0;
+  queued.useCache = useCache;
+  queued.lastRequest = CTimeUtils::GetFrameTime();
+  queued.sequence = m_sequence++;
+  m_queued.push_back(queued);
+  StartLoaders();
+}
+
+void CGUILargeTextureManager::StartLoaders()
+{
+  unsigned int loading = std::count_if(m_queued.begin(), m_queued.end(),
+                                       [](const CQueuedImage &queued) { return queued.jobID != 0; });
+  while (loading < MAX_LOADING_IMAGES)
+  {
+    // images asked for in this frame are visible, of those the newest requests are where the view moves to
+    queueIterator next = m_queued.end();
+    for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
+    {
+      if (!it->jobID && (next == m_queued.end() || it->lastRequest > next->lastRequest ||
+                         (it->lastRequest == next->lastRequest && it->sequence > next->sequence)))
+        next = it;
+    }
+    if (next == m_queued.end())
+      break;
+
+    next->jobID = CJobManager::GetInstance().AddJob(new CImageLoader(next->image->GetPath(), next->useCache, next->image->GetSize()), this, CJob::PRIORITY_NORMAL);
+    if (!next->jobID)
+      break;
+    loading++;
+  }
+}
+
+unsigned int CGUILargeTextureManager::GetDecodeSize(unsigned int size)
+{
+  if (!size)
+    return 0;
+
+  unsigned int decodeSize = 1;
+  while (decodeSize < size && decodeSize < 0x80000000)
+    decodeSize <<= 1;
+  return decodeSize;
 }
 
 void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJob *job)
@@ -221,14 +300,19 @@ void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJ
   CSingleLock lock(m_listSection);
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
-    if (it->first == jobID)
+    if (it->jobID == jobID)
     { // found our job
       CImageLoader *loader = static_cast<CImageLoader*>(job);
-      CLargeTexture *image = it->second;
+      CLargeTexture *image = it->image;
+      if (loader->m_texture)
+        CLog::Log(LOGDEBUG, "%s - loaded %s at %ux%u in %u ms, %u images waiting", __FUNCTION__,
+                  image->GetPath().c_str(), loader->m_texture->GetWidth(), loader->m_texture->GetHeight(),
+                  loader->m_loadTime, static_cast<unsigned int>(m_queued.size() - 1));
       image->SetTexture(loader->m_texture);
       loader->m_texture = NULL; // we want to keep the texture, and jobs are auto-deleted.
       m_queued.erase(it);
       m_allocated.push_back(image);
+      StartLoaders();
       return;
     }
   }
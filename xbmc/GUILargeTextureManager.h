@@ -26,7 +26,7 @@
 class CImageLoader : public CJob
 {
 public:
-  CImageLoader(const std::string &path, const bool useCache);
+  CImageLoader(const std::string &path, const bool useCache, unsigned int size = 0);
   ~CImageLoader() override;
 
   /*!
@@ -36,6 +36,8 @@ public:
 
   bool          m_use_cache; ///< Whether or not to use any caching with this image
   std::string    m_path; ///< path of image to load
+  unsigned int  m_size; ///< largest width and height to decode the image at, 0 for the screen size
+  unsigned int  m_loadTime; ///< milliseconds taken to load the image
   CBaseTexture *m_texture; ///< Texture object to load the image into \sa CBaseTexture.
 };
 
@@ -46,6 +48,11 @@ public:
  Used to load textures for the user interface asynchronously, allowing fluid framerates
  while background loading textures.
 
+ Only a few images are loaded at once. The others wait in a queue, and the image asked for
+ most recently is loaded next. Waiting images are asked for again on every frame they are
+ visible. Images that scrolled out of view therefore wait behind the visible ones. Of the
+ visible ones, the newest requests come first, which follows the scroll direction.
+
  \sa IJobCallback, CGUITexture
  */
 class CGUILargeTextureManager : public IJobCallback
@@ -74,10 +81,13 @@ public:
    \param texture texture object to hold the resulting texture
    \param orientation orientation of resulting texture
    \param firstRequest true if this is the first time we are requesting this texture
+   \param size the largest width and height the image is shown at in pixels, 0 if unknown. The image
+                is decoded at that size (rounded up) instead of the screen size. Requests for larger
+                sizes load the image again.
    \return true if the image exists, else false.
    \sa CGUITextureArray and CGUITexture
    */
-  bool GetImage(const std::string &path, CTextureArray &texture, bool firstRequest, bool useCache = true);
+  bool GetImage(const std::string &path, CTextureArray &texture, bool firstRequest, bool useCache = true, unsigned int size = 0);
 
   /*!
    \brief Request a texture to be unloaded.
@@ -89,8 +99,9 @@ public:
    \param path path of the image to release.
    \param immediately if set true the image is immediately unloaded once its reference count reaches zero
                       rather than being unloaded after a delay.
+   \param size the size the image was requested with.
    */
-  void ReleaseImage(const std::string &path, bool immediately = false);
+  void ReleaseImage(const std::string &path, bool immediately = false, unsigned int size = 0);
 
   /*!
    \brief Cleanup images that are no longer in use.
@@ -107,7 +118,7 @@ private:
   class CLargeTexture
   {
   public:
-    explicit CLargeTexture(const std::string &path);
+    CLargeTexture(const std::string &path, unsigned int size);
     virtual ~CLargeTexture();
 
     void AddRef();
@@ -116,6 +127,8 @@ private:
     void SetTexture(CBaseTexture* texture);
 
     const std::string &GetPath() const { return m_path; };
+    unsigned int GetSize() const { return m_size; };
+    bool Matches(const std::string &path, unsigned int size) const { return m_size == size && m_path == path; };
     const CTextureArray &GetTexture() const { return m_texture; };
 
   private:
@@ -123,17 +136,39 @@ private:
 
     unsigned int m_refCount;
     std::string m_path;
+    unsigned int m_size;
     CTextureArray m_texture;
     unsigned int m_timeToDelete;
   };
 
-  void QueueImage(const std::string &path, bool useCache = true);
+  struct CQueuedImage
+  {
+    CLargeTexture *image;
+    unsigned int jobID;       ///< 0 while waiting for a free loader
+    bool useCache;
+    unsigned int lastRequest; ///< frame time the image was last asked for
+    unsigned int sequence;    ///< order of the first request
+  };
+
+  void QueueImage(const std::string &path, bool useCache, unsigned int size);
+
+  /*!
+   \brief Start loading the most wanted of the waiting images while there are free loaders.
+   */
+  void StartLoaders();
+
+  /*!
+   \brief The size to decode an image at, requests are rounded up to a power of two so that
+   controls of similar sizes share the image.
+   */
+  static unsigned int GetDecodeSize(unsigned int size);
 
-  std::vector< std::pair<unsigned int, CLargeTexture *> > m_queued;
+  std::vector<CQueuedImage> m_queued;
   std::vector<CLargeTexture *> m_allocated;
   typedef std::vector<CLargeTexture *>::iterator listIterator;
-  typedef std::vector< std::pair<unsigned int, CLargeTexture *> >::iterator queueIterator;
+  typedef std::vector<CQueuedImage>::iterator queueIterator;
 
+  unsigned int m_sequence = 0;
   CCriticalSection m_listSection;
 };
 
@@ -123,6 +123,7 @@ void CPVRClient::ResetProperties(int iClientId /* = PVR_INVALID_CLIENT_ID */)
 
   m_struct.toKodi.kodiInstance = this;
   m_struct.toKodi.TransferEpgEntry = cb_transfer_epg_entry;
+  m_struct.toKodi.TransferEpgEntries = cb_transfer_epg_entries;
   m_struct.toKodi.TransferChannelEntry = cb_transfer_channel_entry;
   m_struct.toKodi.TransferTimerEntry = cb_transfer_timer_entry;
   m_struct.toKodi.TransferRecordingEntry = cb_transfer_recording_entry;
@@ -863,6 +864,24 @@ PVR_ERROR CPVRClient::GetRecordings(CPVRRecordings *results, bool deleted) {
   }, m_clientCapabilities.SupportsRecordings() && (!deleted || m_clientCapabilities.SupportsRecordingsUndelete()));
 }
 
+PVR_ERROR CPVRClient::GetRecordingsChangeToken(std::string &strToken)
+{
+  return DoAddonCall(__FUNCTION__, [&strToken](const AddonInstance* addon) {
+    // add-ons built against an older API do not provide the function
+    if (!addon->GetRecordingsChangeToken)
+      return PVR_ERROR_NOT_IMPLEMENTED;
+
+    char token[PVR_ADDON_CHANGE_TOKEN_LENGTH] = {0};
+    const PVR_ERROR error = addon->GetRecordingsChangeToken(token, sizeof(token));
+    if (error == PVR_ERROR_NO_ERROR)
+    {
+      token[sizeof(token) - 1] = '\0';
+      strToken = token;
+    }
+    return error;
+  }, m_clientCapabilities.SupportsRecordings());
+}
+
 PVR_ERROR CPVRClient::DeleteRecording(const CPVRRecording &recording)
 {
   return DoAddonCall(__FUNCTION__, [&recording](const AddonInstance* addon) {
@@ -974,6 +993,24 @@ PVR_ERROR CPVRClient::GetTimers(CPVRTimersContainer *results)
   }, m_clientCapabilities.SupportsTimers());
 }
 
+PVR_ERROR CPVRClient::GetTimersChangeToken(std::string &strToken)
+{
+  return DoAddonCall(__FUNCTION__, [&strToken](const AddonInstance* addon) {
+    // add-ons built against an older API do not provide the function
+    if (!addon->GetTimersChangeToken)
+      return PVR_ERROR_NOT_IMPLEMENTED;
+
+    char token[PVR_ADDON_CHANGE_TOKEN_LENGTH] = {0};
+    const PVR_ERROR error = addon->GetTimersChangeToken(token, sizeof(token));
+    if (error == PVR_ERROR_NO_ERROR)
+    {
+      token[sizeof(token) - 1] = '\0';
+      strToken = token;
+    }
+    return error;
+  }, m_clientCapabilities.SupportsTimers());
+}
+
 PVR_ERROR CPVRClient::AddTimer(const CPVRTimerInfoTag &timer)
 {
   return DoAddonCall(__FUNCTION__, [&timer](const AddonInstance* addon) {
@@ -1549,6 +1586,26 @@ void CPVRClient::cb_transfer_epg_entry(void *kodiInstance, const ADDON_HANDLE ha
   kodiEpg->UpdateEntry(epgentry, client->GetID());
 }
 
+void CPVRClient::cb_transfer_epg_entries(void *kodiInstance, const ADDON_HANDLE handle, const EPG_TAG *epgentries, unsigned int iCount)
+{
+  if (!handle)
+  {
+    CLog::LogF(LOGERROR, "Invalid handler data");
+    return;
+  }
+
+  CPVRClient *client = static_cast<CPVRClient*>(kodiInstance);
+  CPVREpg *kodiEpg = static_cast<CPVREpg *>(handle->dataAddress);
+  if ((!epgentries && iCount > 0) || !client || !kodiEpg)
+  {
+    CLog::LogF(LOGERROR, "Invalid handler data");
+    return;
+  }
+
+  /* transfer these entries to the epg */
+  kodiEpg->UpdateEntries(epgentries, iCount, client->GetID());
+}
+
 void CPVRClient::cb_transfer_channel_entry(void *kodiInstance, const ADDON_HANDLE handle, const PVR_CHANNEL *channel)
 {
   if (!handle)
@@ -482,6 +482,13 @@ namespace PVR
      */
     PVR_ERROR GetRecordings(CPVRRecordings *results, bool deleted);
 
+    /*!
+     * @brief Get a token that changes whenever the recordings on the backend change.
+     * @param strToken The token.
+     * @return PVR_ERROR_NO_ERROR if the token has been fetched successfully, PVR_ERROR_NOT_IMPLEMENTED if the backend provides no token.
+     */
+    PVR_ERROR GetRecordingsChangeToken(std::string &strToken);
+
     /*!
      * @brief Delete a recording on the backend.
      * @param recording The recording to delete.
@@ -574,6 +581,13 @@ namespace PVR
      */
     PVR_ERROR GetTimers(CPVRTimersContainer *results);
 
+    /*!
+     * @brief Get a token that changes whenever the timers on the backend change.
+     * @param strToken The token.
+     * @return PVR_ERROR_NO_ERROR if the token has been fetched successfully, PVR_ERROR_NOT_IMPLEMENTED if the backend provides no token.
+     */
+    PVR_ERROR GetTimersChangeToken(std::string &strToken);
+
     /*!
      * @brief Add a timer on the backend.
      * @param timer The timer to add.
@@ -950,6 +964,15 @@ namespace PVR
      */
     static void cb_transfer_epg_entry(void* kodiInstance, const ADDON_HANDLE handle, const EPG_TAG* entry);
 
+    /*!
+     * @brief Transfer several EPG tags from the add-on to Kodi
+     * @param kodiInstance Pointer to Kodi's CPVRClient class
+     * @param handle The handle parameter that Kodi used when requesting the EPG data
+     * @param entries The entries to transfer to Kodi
+     * @param iCount The number of entries
+     */
+    static void cb_transfer_epg_entries(void* kodiInstance, const ADDON_HANDLE handle, const EPG_TAG* entries, unsigned int iCount);
+
     /*!
      * @brief Transfer a channel entry from the add-on to Kodi
      * @param kodiInstance Pointer to Kodi's CPVRClient class
@@ -7,7 +7,11 @@
  */
 
 #include "Skin.h"
+
+#include <cinttypes>
+
 #include "AddonManager.h"
+#include "GUIInfoManager.h"
 #include "ServiceBroker.h"
 #include "Util.h"
 #include "dialogs/GUIDialogKaiToast.h"
@@ -300,6 +304,16 @@ void CSkinInfo::LoadIncludes()
   CLog::Log(LOGINFO, "Loading skin includes from %s", includesPath.c_str());
   m_includes.Clear();
   m_includes.Load(includesPath);
+
+  // resolved windows are only valid for this version of the skin and its include files
+  std::string fingerprint = ID() + ":" + Version().asString();
+  for (const auto& file : m_includes.GetFiles())
+  {
+    struct __stat64 stat;
+    if (CFile::Stat(file, &stat) == 0)
+      fingerprint += StringUtils::Format("|%s:%" PRId64 ":%" PRId64, file.c_str(), static_cast<int64_t>(stat.st_mtime), static_cast<int64_t>(stat.st_size));
+  }
+  m_includesCache.Open("special://temp/skincache/", fingerprint);
 }
 
 void CSkinInfo::ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions /* = NULL */)
@@ -310,6 +324,37 @@ void CSkinInfo::ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool
   m_includes.Resolve(node, xmlIncludeConditions);
 }
 
+std::unique_ptr<TiXmlElement> CSkinInfo::GetResolvedWindow(const std::string &file, std::map<INFO::InfoPtr, bool> &xmlIncludeConditions) const
+{
+  std::unique_ptr<TiXmlElement> root;
+  CGUIIncludesCache::Conditions conditions;
+  if (!m_includesCache.Get(file, root, conditions))
+    return nullptr;
+
+  // the includes are resolved differently if a condition changed since
+  CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+  std::map<INFO::InfoPtr, bool> registered;
+  for (const auto& condition : conditions)
+  {
+    INFO::InfoPtr info = infoMgr.Register(condition.first);
+    if (!info || info->Get() != condition.second)
+      return nullptr;
+    registered.insert(std::make_pair(info, condition.second));
+  }
+
+  xmlIncludeConditions.swap(registered);
+  return root;
+}
+
+void CSkinInfo::SetResolvedWindow(const std::string &file, const TiXmlElement &root, const std::map<INFO::InfoPtr, bool> &xmlIncludeConditions)
+{
+  CGUIIncludesCache::Conditions conditions;
+  for (const auto& condition : xmlIncludeConditions)
+    conditions.emplace_back(condition.first->GetExpression(), condition.second);
+
+  m_includesCache.Set(file, root, conditions);
+}
+
 int CSkinInfo::GetStartWindow() const
 {
   int windowID = CServiceBroker::GetSettingsComponent()->GetSettings()->GetInt(CSettings::SETTING_LOOKANDFEEL_STARTUPWINDOW);
@@ -775,6 +820,9 @@ bool CSkinInfo::SettingsFromXML(const CXBMCTinyXML &doc, bool loadDefaults /* =
       CLog::Log(LOGWARNING, "CSkinInfo: ignoring setting of unknown type \"%s\"", setting->GetType().c_str());
   }
 
+  if (CServiceBroker::GetGUI())
+    CServiceBroker::GetGUI()->GetInfoManager().InfoSourceChanged(INFO::INFO_SOURCE_SKIN);
+
   return true;
 }
 
@@ -812,6 +860,10 @@ void CSkinSettingUpdateHandler::OnTimeout()
 
 void CSkinSettingUpdateHandler::TriggerSave()
 {
+  // every change of a skin setting passes here
+  if (CServiceBroker::GetGUI())
+    CServiceBroker::GetGUI()->GetInfoManager().InfoSourceChanged(INFO::INFO_SOURCE_SKIN);
+
   if (m_timer.IsRunning())
     m_timer.Restart();
   else
@@ -16,6 +16,7 @@
 #include "addons/Addon.h"
 #include "windowing/GraphicContext.h" // needed for the RESOLUTION members
 #include "guilib/GUIIncludes.h"    // needed for the GUIInclude member
+#include "guilib/GUIIncludesCache.h"
 
 #define CREDIT_LINE_LENGTH 50
 
@@ -151,6 +152,20 @@ public:
 
   void ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = NULL);
 
+  /*! \brief Get a window with its includes resolved from the skin cache
+   \param file the path of the window XML
+   \param xmlIncludeConditions [out] the conditions of the resolved includes
+   \return the resolved window or nullptr if it isn't cached for the current values of the conditions
+   */
+  std::unique_ptr<TiXmlElement> GetResolvedWindow(const std::string &file, std::map<INFO::InfoPtr, bool> &xmlIncludeConditions) const;
+
+  /*! \brief Store a window with its includes resolved in the skin cache
+   \param file the path of the window XML
+   \param root the resolved window
+   \param xmlIncludeConditions the conditions of the resolved includes
+   */
+  void SetResolvedWindow(const std::string &file, const TiXmlElement &root, const std::map<INFO::InfoPtr, bool> &xmlIncludeConditions);
+
   float GetEffectsSlowdown() const { return m_effectsSlowDown; };
 
   const std::vector<CStartupWindow> &GetStartupWindows() const { return m_startupWindows; };
@@ -222,6 +237,7 @@ protected:
 
   float m_effectsSlowDown;
   CGUIIncludes m_includes;
+  CGUIIncludesCache m_includesCache;
   std::string m_currentAspect;
 
   std::vector<CStartupWindow> m_startupWindows;
@@ -64,6 +64,17 @@ public:
     return m_Callbacks->toKodi.TransferEpgEntry(m_Callbacks->toKodi.kodiInstance, handle, entry);
   }
 
+  /*!
+   * @brief Transfer several EPG tags from the add-on to Kodi in one call
+   * @param handle The handle parameter that Kodi used when requesting the EPG data
+   * @param entries The entries to transfer to Kodi. Entries may share string pointers.
+   * @param count The number of entries
+   */
+  void TransferEpgEntries(const ADDON_HANDLE handle, const EPG_TAG* entries, unsigned int count)
+  {
+    return m_Callbacks->toKodi.TransferEpgEntries(m_Callbacks->toKodi.kodiInstance, handle, entries, count);
+  }
+
   /*!
    * @brief Transfer a channel entry from the add-on to XBMC
    * @param handle The handle parameter that XBMC used when requesting the channel list
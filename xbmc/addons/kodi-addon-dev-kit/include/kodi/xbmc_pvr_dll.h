@@ -261,6 +261,17 @@ extern "C"
    */
   PVR_ERROR GetRecordings(ADDON_HANDLE handle, bool deleted);
 
+  /*!
+   * Get a token that changes whenever the recordings or deleted recordings on the backend change.
+   * @param token must be filled with a null terminated token, at most size bytes long including the terminator.
+   * @param size The size of the token buffer.
+   * @return PVR_ERROR_NO_ERROR if the token has been fetched successfully.
+   * @remarks Optional, and only used if bSupportsRecordings is set to true. Kodi does not fetch the
+   *          recordings again as long as the token does not change.
+   *          Return PVR_ERROR_NOT_IMPLEMENTED if this add-on won't provide this function. In this case Kodi always fetches the recordings.
+   */
+  PVR_ERROR GetRecordingsChangeToken(char* token, unsigned int size);
+
   /*!
    * Delete a recording on the backend.
    * @param recording The recording to delete.
@@ -376,6 +387,17 @@ extern "C"
    */
   PVR_ERROR GetTimers(ADDON_HANDLE handle);
 
+  /*!
+   * Get a token that changes whenever the timers on the backend change.
+   * @param token must be filled with a null terminated token, at most size bytes long including the terminator.
+   * @param size The size of the token buffer.
+   * @return PVR_ERROR_NO_ERROR if the token has been fetched successfully.
+   * @remarks Optional, and only used if bSupportsTimers is set to true. Kodi does not fetch the
+   *          timers again as long as the token does not change.
+   *          Return PVR_ERROR_NOT_IMPLEMENTED if this add-on won't provide this function. In this case Kodi always fetches the timers.
+   */
+  PVR_ERROR GetTimersChangeToken(char* token, unsigned int size);
+
   /*!
    * Add a timer on the backend.
    * @param timer The timer to add.
@@ -779,5 +801,8 @@ extern "C"
     pClient->toAddon.GetStreamTimes                 = GetStreamTimes;
 
     pClient->toAddon.GetStreamReadChunkSize         = GetStreamReadChunkSize;
+
+    pClient->toAddon.GetRecordingsChangeToken       = GetRecordingsChangeToken;
+    pClient->toAddon.GetTimersChangeToken           = GetTimersChangeToken;
   };
 };
@@ -59,6 +59,7 @@ struct DemuxPacket;
 #define PVR_ADDON_ATTRIBUTE_DESC_LENGTH 64
 #define PVR_ADDON_ATTRIBUTE_VALUES_ARRAY_SIZE 512
 #define PVR_ADDON_DESCRAMBLE_INFO_STRING_LENGTH 64
+#define PVR_ADDON_CHANGE_TOKEN_LENGTH         256
 
 #define XBMC_INVALID_CODEC_ID   0
 #define XBMC_INVALID_CODEC      { XBMC_CODEC_TYPE_UNKNOWN, XBMC_INVALID_CODEC_ID }
@@ -618,6 +619,8 @@ extern "C" {
     void (*EpgEventStateChange)(void* kodiInstance, EPG_TAG* tag, EPG_EVENT_STATE newState);
 
     xbmc_codec_t (*GetCodecByName)(const void* kodiInstance, const char* strCodecName);
+
+    void (*TransferEpgEntries)(void* kodiInstance, const ADDON_HANDLE handle, const EPG_TAG *epgentries, unsigned int iCount);
   } AddonToKodiFuncTable_PVR;
 
   /*!
@@ -700,6 +703,8 @@ extern "C" {
     void (__cdecl* OnPowerSavingDeactivated)(void);
     PVR_ERROR (__cdecl* GetStreamTimes)(PVR_STREAM_TIMES*);
     PVR_ERROR (__cdecl* GetStreamReadChunkSize)(int*);
+    PVR_ERROR (__cdecl* GetRecordingsChangeToken)(char*, unsigned int);
+    PVR_ERROR (__cdecl* GetTimersChangeToken)(char*, unsigned int);
   } KodiToAddonFuncTable_PVR;
 
   typedef struct AddonInstance_PVR
@@ -12,6 +12,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <string.h>
+#include "utils/EndianSwap.h"
 #include "utils/log.h"
 
 #define BURST_HEADER_SIZE       8
@@ -21,7 +22,6 @@
 #define EAC3_MAX_BURST_PAYLOAD_SIZE (24576 - BURST_HEADER_SIZE)
 
 CAEBitstreamPacker::CAEBitstreamPacker() :
-  m_trueHD   (NULL),
   m_dtsHD    (NULL),
   m_eac3     (NULL)
 {
@@ -30,7 +30,6 @@ CAEBitstreamPacker::CAEBitstreamPacker() :
 
 CAEBitstreamPacker::~CAEBitstreamPacker()
 {
-  delete[] m_trueHD;
   delete[] m_dtsHD;
   delete[] m_eac3;
 }
@@ -126,32 +125,51 @@ void CAEBitstreamPacker::Reset()
 {
   m_dataSize = 0;
   m_trueHDPos = 0;
+  m_trueHDEnd = 0;
   m_pauseDuration = 0;
   m_packedBuffer[0] = 0;
 }
 
-/* we need to pack 24 TrueHD audio units into the unknown MAT format before packing into IEC61937 */
+/* copies a block into the MAT frame in IEC byte order, odd sizes are zero padded */
+static unsigned int CopyIEC(uint8_t* dest, const uint8_t* src, unsigned int size)
+{
+#ifdef __BIG_ENDIAN__
+  memcpy(dest, src, size);
+  if (size & 0x1)
+    dest[size++] = 0;
+#else
+  Endian_Swap16_buf((uint16_t*)dest, (uint16_t*)src, size >> 1);
+  if (size & 0x1)
+  {
+    dest[size - 1] = 0;
+    dest[size] = src[size - 1];
+    size++;
+  }
+#endif
+  return size;
+}
+
+/* we need to pack 24 TrueHD audio units into the unknown MAT format before packing into IEC61937.
+ * the units are byte swapped straight into the output burst as they arrive, only the gaps between
+ * them are cleared, so every byte of the 61k MAT frame is written exactly once */
 void CAEBitstreamPacker::PackTrueHD(CAEStreamInfo &info, uint8_t* data, int size)
 {
   /* magic MAT format values, meaning is unknown at this point */
   static const uint8_t mat_start_code [20] = { 0x07, 0x9E, 0x00, 0x03, 0x84, 0x01, 0x01, 0x01, 0x80, 0x00, 0x56, 0xA5, 0x3B, 0xF4, 0x81, 0x83, 0x49, 0x80, 0x77, 0xE0 };
   static const uint8_t mat_middle_code[12] = { 0xC3, 0xC1, 0x42, 0x49, 0x3B, 0xFA, 0x82, 0x83, 0x49, 0x80, 0x77, 0xE0 };
   static const uint8_t mat_end_code   [16] = { 0xC3, 0xC2, 0xC0, 0xC4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x97, 0x11 };
+  static const unsigned int mat_middle_pos = (12 * TRUEHD_FRAME_OFFSET) - BURST_HEADER_SIZE + MAT_MIDDLE_CODE_OFFSET;
+  static const unsigned int mat_end_pos    = MAT_FRAME_SIZE - sizeof(mat_end_code);
 
-  /* create the buffer if it doesnt already exist */
-  if (!m_trueHD)
-  {
-    m_trueHD    = new uint8_t[MAT_FRAME_SIZE];
-    m_trueHDPos = 0;
-  }
+  uint8_t *mat = m_packedBuffer + IEC61937_DATA_OFFSET;
 
   /* setup the frame for the data */
   if (m_trueHDPos == 0)
+    m_trueHDEnd = CopyIEC(mat, mat_start_code, sizeof(mat_start_code));
+  else if (m_trueHDPos == 12)
   {
-    memset(m_trueHD, 0, MAT_FRAME_SIZE);
-    memcpy(m_trueHD, mat_start_code, sizeof(mat_start_code));
-    memcpy(m_trueHD + (12 * TRUEHD_FRAME_OFFSET) - BURST_HEADER_SIZE + MAT_MIDDLE_CODE_OFFSET, mat_middle_code, sizeof(mat_middle_code));
-    memcpy(m_trueHD + MAT_FRAME_SIZE - sizeof(mat_end_code), mat_end_code, sizeof(mat_end_code));
+    memset(mat + m_trueHDEnd, 0, mat_middle_pos - m_trueHDEnd);
+    m_trueHDEnd = mat_middle_pos + CopyIEC(mat + mat_middle_pos, mat_middle_code, sizeof(mat_middle_code));
   }
 
   size_t offset;
@@ -179,13 +197,19 @@ void CAEBitstreamPacker::PackTrueHD(CAEStreamInfo &info, uint8_t* data, int size
     size = maxSize;
   }
 
-  memcpy(m_trueHD + offset, data, size);
+  /* all max sizes are even, so padding an odd unit never runs into the next one */
+  memset(mat + m_trueHDEnd, 0, offset - m_trueHDEnd);
+  m_trueHDEnd = offset + CopyIEC(mat + offset, data, size);
 
   /* if we have a full frame */
   if (++m_trueHDPos == 24)
   {
+    memset(mat + m_trueHDEnd, 0, mat_end_pos - m_trueHDEnd);
+    CopyIEC(mat + mat_end_pos, mat_end_code, sizeof(mat_end_code));
+
     m_trueHDPos = 0;
-    m_dataSize  = CAEPackIEC61937::PackTrueHD(m_trueHD, MAT_FRAME_SIZE, m_packedBuffer);
+    m_trueHDEnd = 0;
+    m_dataSize  = CAEPackIEC61937::PackTrueHDHeader(MAT_FRAME_SIZE, m_packedBuffer);
   }
 }
 
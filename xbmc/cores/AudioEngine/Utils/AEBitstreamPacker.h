@@ -34,9 +34,10 @@ private:
   void PackDTSHD(CAEStreamInfo &info, uint8_t* data, int size);
   void PackEAC3(CAEStreamInfo &info, uint8_t* data, int size);
 
-  /* we keep the trueHD and dtsHD buffers separate so that we can handle a fast stream switch */
-  uint8_t      *m_trueHD;
+  /* trueHD MAT frames are assembled in place in m_packedBuffer, the caller always feeds
+   * all 24 units of a frame between two Reset() calls */
   unsigned int  m_trueHDPos = 0;
+  unsigned int  m_trueHDEnd = 0;
 
   uint8_t      *m_dtsHD;
   unsigned int  m_dtsHDSize = 0;
@@ -8,16 +8,17 @@
 
 #include <cassert>
 #include "AEPackIEC61937.h"
+#include "utils/EndianSwap.h"
 
 #include <string.h>
 
 #define IEC61937_PREAMBLE1  0xF872
 #define IEC61937_PREAMBLE2  0x4E1F
 
+/* payload swaps run at TrueHD/DTS-HD MA rates, use the vectorised helper */
 inline void SwapEndian(uint16_t *dst, uint16_t *src, unsigned int size)
 {
-  for (unsigned int i = 0; i < size; ++i, ++dst, ++src)
-    *dst = ((*src & 0xFF00) >> 8) | ((*src & 0x00FF) << 8);
+  Endian_Swap16_buf(dst, src, static_cast<int>(size));
 }
 
 int CAEPackIEC61937::PackAC3(uint8_t *data, unsigned int size, uint8_t *dest)
@@ -112,6 +113,20 @@ int CAEPackIEC61937::PackTrueHD(uint8_t *data, unsigned int size, uint8_t *dest)
   return OUT_FRAMESTOBYTES(TRUEHD_FRAME_SIZE);
 }
 
+int CAEPackIEC61937::PackTrueHDHeader(unsigned int size, uint8_t *dest)
+{
+  assert(size <= OUT_FRAMESTOBYTES(TRUEHD_FRAME_SIZE) - IEC61937_DATA_OFFSET);
+  struct IEC61937Packet *packet = (struct IEC61937Packet*)dest;
+  packet->m_preamble1 = IEC61937_PREAMBLE1;
+  packet->m_preamble2 = IEC61937_PREAMBLE2;
+  packet->m_type      = IEC61937_TYPE_TRUEHD;
+  packet->m_length    = size;
+
+  size += size & 0x1;
+  memset(packet->m_data + size, 0, OUT_FRAMESTOBYTES(TRUEHD_FRAME_SIZE) - IEC61937_DATA_OFFSET - size);
+  return OUT_FRAMESTOBYTES(TRUEHD_FRAME_SIZE);
+}
+
 int CAEPackIEC61937::PackDTSHD(uint8_t *data, unsigned int size, uint8_t *dest, unsigned int period)
 {
   unsigned int subtype;
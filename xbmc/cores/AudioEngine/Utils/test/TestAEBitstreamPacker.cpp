@@ -0,0 +1,147 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Utils/AEBitstreamPacker.h"
+#include "cores/AudioEngine/Utils/AEPackIEC61937.h"
+#include "cores/AudioEngine/Utils/AEStreamInfo.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+
+#include <functional>
+#include <string.h>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+const unsigned int MAT_FRAME_SIZE = 61424;
+const unsigned int TRUEHD_UNIT_STRIDE = 2560;
+
+std::vector<uint8_t> MakePayload(size_t size)
+{
+  std::vector<uint8_t> data(size);
+  uint32_t seed = 0x12345678;
+  for (auto& b : data)
+  {
+    seed = seed * 1103515245 + 12345;
+    b = static_cast<uint8_t>(seed >> 16);
+  }
+  return data;
+}
+
+/* straight port of the previous two pass implementation, used as reference */
+std::vector<uint8_t> ReferenceMAT(const uint8_t* data, const int* sizes)
+{
+  static const uint8_t start[20] = { 0x07, 0x9E, 0x00, 0x03, 0x84, 0x01, 0x01, 0x01, 0x80, 0x00, 0x56, 0xA5, 0x3B, 0xF4, 0x81, 0x83, 0x49, 0x80, 0x77, 0xE0 };
+  static const uint8_t middle[12] = { 0xC3, 0xC1, 0x42, 0x49, 0x3B, 0xFA, 0x82, 0x83, 0x49, 0x80, 0x77, 0xE0 };
+  static const uint8_t end[16] = { 0xC3, 0xC2, 0xC0, 0xC4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x97, 0x11 };
+
+  std::vector<uint8_t> mat(MAT_FRAME_SIZE + 2, 0);
+  memcpy(mat.data(), start, sizeof(start));
+  memcpy(mat.data() + 12 * 2560 - 8 - 4, middle, sizeof(middle));
+  memcpy(mat.data() + MAT_FRAME_SIZE - sizeof(end), end, sizeof(end));
+
+  for (int i = 0; i < 24; i++)
+  {
+    size_t offset;
+    if (i == 0)
+      offset = sizeof(start);
+    else if (i == 12)
+      offset = i * 2560 + sizeof(middle) - 8 - 4;
+    else
+      offset = i * 2560 - 8;
+    memcpy(mat.data() + offset, data + i * TRUEHD_UNIT_STRIDE, sizes[i]);
+  }
+
+  std::vector<uint8_t> out(OUT_FRAMESTOBYTES(TRUEHD_FRAME_SIZE));
+  CAEPackIEC61937::PackTrueHD(mat.data(), MAT_FRAME_SIZE, out.data());
+  return out;
+}
+
+double Throughput(const std::function<int()>& pack, unsigned int payloadBytes)
+{
+  const unsigned int iterations = 2000;
+  int64_t start = CurrentHostCounter();
+  for (unsigned int i = 0; i < iterations; i++)
+    pack();
+  double seconds = static_cast<double>(CurrentHostCounter() - start) / CurrentHostFrequency();
+  return seconds > 0 ? (static_cast<double>(payloadBytes) * iterations) / seconds / 1000000.0 : 0;
+}
+
+void Report(const char* format, double mbps)
+{
+  ::testing::Test::RecordProperty(format, StringUtils::Format("%.1f MB/s", mbps));
+  EXPECT_GT(mbps, 0.0);
+}
+
+} // namespace
+
+TEST(TestAEBitstreamPacker, TrueHDMatchesReference)
+{
+  std::vector<uint8_t> data = MakePayload(24 * TRUEHD_UNIT_STRIDE);
+
+  /* mix of odd sizes and units filling their whole slot */
+  int sizes[24];
+  for (int i = 0; i < 24; i++)
+    sizes[i] = 1500 + i * 37;
+  sizes[0] = 2532;
+  sizes[11] = 2555;
+  sizes[12] = 2551;
+  sizes[23] = 2528;
+
+  CAEStreamInfo info;
+  info.m_type = CAEStreamInfo::STREAM_TYPE_TRUEHD;
+  CAEBitstreamPacker packer;
+
+  /* twice, so leftovers of the first frame in the burst buffer would show up */
+  for (int pass = 0; pass < 2; pass++)
+  {
+    packer.Reset();
+    for (int i = 0; i < 24; i++)
+      packer.Pack(info, data.data() + i * TRUEHD_UNIT_STRIDE, sizes[i] - pass * 701);
+
+    int refSizes[24];
+    for (int i = 0; i < 24; i++)
+      refSizes[i] = sizes[i] - pass * 701;
+    std::vector<uint8_t> ref = ReferenceMAT(data.data(), refSizes);
+
+    ASSERT_EQ(ref.size(), packer.GetSize());
+    EXPECT_EQ(0, memcmp(ref.data(), packer.GetBuffer(), ref.size()));
+  }
+}
+
+TEST(TestAEBitstreamPacker, Throughput)
+{
+  std::vector<uint8_t> data = MakePayload(MAX_IEC61937_PACKET);
+  std::vector<uint8_t> out(MAX_IEC61937_PACKET);
+
+  Report("AC3", Throughput([&]() {
+    return CAEPackIEC61937::PackAC3(data.data(), 1536, out.data());
+  }, 1536));
+  Report("EAC3", Throughput([&]() {
+    return CAEPackIEC61937::PackEAC3(data.data(), 6 * 1024, out.data());
+  }, 6 * 1024));
+  Report("DTS", Throughput([&]() {
+    return CAEPackIEC61937::PackDTS_512(data.data(), 2012, out.data(), false);
+  }, 2012));
+  Report("DTSHD", Throughput([&]() {
+    return CAEPackIEC61937::PackDTSHD(data.data(), 30000, out.data(), 8192);
+  }, 30000));
+
+  CAEStreamInfo info;
+  info.m_type = CAEStreamInfo::STREAM_TYPE_TRUEHD;
+  CAEBitstreamPacker packer;
+  Report("TrueHD", Throughput([&]() {
+    packer.Reset();
+    for (int i = 0; i < 24; i++)
+      packer.Pack(info, data.data() + i * TRUEHD_UNIT_STRIDE, 2400);
+    return packer.GetSize();
+  }, 24 * 2400));
+}
@@ -92,6 +92,8 @@ public:
   virtual bool OpenFile(const CFileItem& file, const CPlayerOptions& options){ return false;}
   virtual bool QueueNextFile(const CFileItem &file) { return false; }
   virtual void OnNothingToQueueNotify() {}
+  /*! \brief Upcoming playlist items the player may open ahead of time, called on the application thread */
+  virtual void PreloadUpcomingFiles(const std::vector<CFileItem> &files) {}
   virtual bool CloseFile(bool reopen = false) = 0;
   virtual bool IsPlaying() const { return false;}
   virtual bool CanPause() { return true; };
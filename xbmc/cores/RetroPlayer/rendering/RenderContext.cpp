@@ -99,6 +99,15 @@ void CRenderContext::EnableGUIShader(GL_SHADER_METHOD method)
 #endif
 }
 
+void CRenderContext::FlushGUIBatch()
+{
+#if HAS_GLES >= 2
+  CRenderSystemGLES *renderingGLES = dynamic_cast<CRenderSystemGLES*>(m_rendering);
+  if (renderingGLES != nullptr)
+    renderingGLES->FlushBatch();
+#endif
+}
+
 void CRenderContext::DisableGUIShader()
 {
 #if defined(HAS_GL)
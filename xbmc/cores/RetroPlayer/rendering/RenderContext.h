@@ -57,6 +57,8 @@ namespace RETRO
     // OpenGL(ES) rendering functions
     void EnableGUIShader(GL_SHADER_METHOD method);
     void DisableGUIShader();
+    void FlushGUIBatch(); //! Draw the queued GUI quads, call before changing GL state
+
     int GUIShaderGetPos();
     int GUIShaderGetCoord0();
     int GUIShaderGetUniCol();
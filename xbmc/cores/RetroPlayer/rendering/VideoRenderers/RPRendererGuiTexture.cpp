@@ -224,6 +224,9 @@ void CRPRendererGuiTexture::RenderInternal(bool clear, uint8_t alpha)
 
 #elif defined(HAS_GLES)
 
+  // draw the queued GUI quads before changing texture and blend state
+  m_context.FlushGUIBatch();
+
   renderBuffer->BindToUnit(0);
 
   glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
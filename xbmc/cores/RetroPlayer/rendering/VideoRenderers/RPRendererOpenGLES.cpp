@@ -58,6 +58,9 @@ CRPRendererOpenGLES::~CRPRendererOpenGLES()
 
 void CRPRendererOpenGLES::RenderInternal(bool clear, uint8_t alpha)
 {
+  // draw the queued GUI quads before changing blend state and textures
+  m_context.FlushGUIBatch();
+
   if (clear)
   {
     if (alpha == 255)
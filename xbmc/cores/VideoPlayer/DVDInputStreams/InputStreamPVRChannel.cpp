@@ -8,9 +8,22 @@
 
 #include "InputStreamPVRChannel.h"
 
+#include "PVRTimeshiftBuffer.h"
+
+#include <atomic>
+
+#include "ServiceBroker.h"
 #include "addons/PVRClient.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
 
+namespace
+{
+  std::atomic<unsigned int> timeshiftBufferCount(0);
+}
+
 CInputStreamPVRChannel::CInputStreamPVRChannel(IVideoPlayer* pPlayer, const CFileItem& fileitem)
   : CInputStreamPVRBase(pPlayer, fileitem),
     m_bDemuxActive(false)
@@ -30,19 +43,116 @@ CDVDInputStream::IDemux* CInputStreamPVRChannel::GetIDemux()
   return CInputStreamPVRBase::GetIDemux();
 }
 
+void CInputStreamPVRChannel::Abort()
+{
+  if (m_timeshift)
+    m_timeshift->Abort();
+}
+
+bool CInputStreamPVRChannel::IsRealtime()
+{
+  // only realtime while playing at the live position
+  if (m_timeshift)
+    return m_timeshift->IsLive(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRTimeshiftThreshold * 1000);
+
+  return CInputStreamPVRBase::IsRealtime();
+}
+
+void CInputStreamPVRChannel::Pause(bool bPaused)
+{
+  // the backend keeps streaming into the local buffer
+  if (!m_timeshift)
+    CInputStreamPVRBase::Pause(bPaused);
+}
+
+CDVDInputStream::ITimes* CInputStreamPVRChannel::GetITimes()
+{
+  if (m_timeshift)
+    return nullptr;
+
+  return CInputStreamPVRBase::GetITimes();
+}
+
+CDVDInputStream::IDisplayTime* CInputStreamPVRChannel::GetIDisplayTime()
+{
+  if (m_timeshift)
+    return this;
+
+  return nullptr;
+}
+
+int CInputStreamPVRChannel::GetTotalTime()
+{
+  return m_timeshift ? m_timeshift->GetEndTime() : 0;
+}
+
+int CInputStreamPVRChannel::GetTime()
+{
+  return m_timeshift ? m_timeshift->GetTime() : 0;
+}
+
+CDVDInputStream::IPosTime* CInputStreamPVRChannel::GetIPosTime()
+{
+  if (m_timeshift)
+    return this;
+
+  return nullptr;
+}
+
+bool CInputStreamPVRChannel::PosTime(int ms)
+{
+  if (!m_timeshift || !m_timeshift->SeekTime(ms))
+    return false;
+
+  m_eof = false;
+  return true;
+}
+
 bool CInputStreamPVRChannel::OpenPVRStream()
 {
   if (m_client && (m_client->OpenLiveStream(m_item) == PVR_ERROR_NO_ERROR))
   {
     m_bDemuxActive = m_client->GetClientCapabilities().HandlesDemuxing();
     CLog::Log(LOGDEBUG, "CInputStreamPVRChannel - %s - opened channel stream %s", __FUNCTION__, m_item.GetPath().c_str());
+    OpenTimeshiftBuffer();
     return true;
   }
   return false;
 }
 
+void CInputStreamPVRChannel::OpenTimeshiftBuffer()
+{
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  if (m_bDemuxActive || advancedSettings->m_iPVRLocalTimeshiftSize <= 0)
+    return;
+
+  // the backend handles timeshift itself
+  bool bCanPause = false;
+  m_client->CanPauseStream(bCanPause);
+  if (bCanPause)
+    return;
+
+  const std::string strPath = StringUtils::Format("special://temp/pvrtimeshift-%u.ts", timeshiftBufferCount++);
+  m_timeshift.reset(new CPVRTimeshiftBuffer(strPath,
+                                            static_cast<int64_t>(advancedSettings->m_iPVRLocalTimeshiftSize) * 1024 * 1024,
+                                            advancedSettings->m_iPVRLocalTimeshiftDuration * 60));
+
+  const std::shared_ptr<PVR::CPVRClient> client = m_client;
+  const bool bOpened = m_timeshift->Open([client](uint8_t* buf, int buf_size)
+                                         {
+                                           int ret = -1;
+                                           client->ReadLiveStream(buf, buf_size, ret);
+                                           return ret < -1 ? -1 : ret;
+                                         });
+  if (!bOpened)
+    m_timeshift.reset();
+}
+
 void CInputStreamPVRChannel::ClosePVRStream()
 {
+  // the add-on must not be read and closed at the same time, the buffer waits for its recording thread
+  m_timeshift.reset();
+
   if (m_client && (m_client->CloseLiveStream() == PVR_ERROR_NO_ERROR))
   {
     m_bDemuxActive = false;
@@ -54,7 +164,9 @@ int CInputStreamPVRChannel::ReadPVRStream(uint8_t* buf, int buf_size)
 {
   int ret = -1;
 
-  if (m_client)
+  if (m_timeshift)
+    ret = m_timeshift->Read(buf, buf_size);
+  else if (m_client)
     m_client->ReadLiveStream(buf, buf_size, ret);
 
   return ret;
@@ -64,7 +176,9 @@ int64_t CInputStreamPVRChannel::SeekPVRStream(int64_t offset, int whence)
 {
   int64_t ret = -1;
 
-  if (m_client)
+  if (m_timeshift)
+    ret = m_timeshift->Seek(offset, whence);
+  else if (m_client)
     m_client->SeekLiveStream(offset, whence, ret);
 
   return ret;
@@ -74,6 +188,10 @@ int64_t CInputStreamPVRChannel::GetPVRStreamLength()
 {
   int64_t ret = -1;
 
+  // the recorded window moves, there is no fixed length
+  if (m_timeshift)
+    return ret;
+
   if (m_client)
     m_client->GetLiveStreamLength(ret);
 
@@ -92,7 +210,9 @@ bool CInputStreamPVRChannel::CanPausePVRStream()
 {
   bool ret = false;
 
-  if (m_client)
+  if (m_timeshift)
+    ret = true;
+  else if (m_client)
     m_client->CanPauseStream(ret);
 
   return ret;
@@ -102,7 +222,9 @@ bool CInputStreamPVRChannel::CanSeekPVRStream()
 {
   bool ret = false;
 
-  if (m_client)
+  if (m_timeshift)
+    ret = true;
+  else if (m_client)
     m_client->CanSeekStream(ret);
 
   return ret;
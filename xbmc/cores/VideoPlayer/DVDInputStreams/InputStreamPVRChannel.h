@@ -10,7 +10,14 @@
 
 #include "InputStreamPVRBase.h"
 
-class CInputStreamPVRChannel : public CInputStreamPVRBase
+#include <memory>
+
+class CPVRTimeshiftBuffer;
+
+class CInputStreamPVRChannel
+  : public CInputStreamPVRBase
+  , public CDVDInputStream::IDisplayTime
+  , public CDVDInputStream::IPosTime
 {
 public:
   CInputStreamPVRChannel(IVideoPlayer* pPlayer, const CFileItem& fileitem);
@@ -18,6 +25,18 @@ public:
 
   CDVDInputStream::IDemux* GetIDemux() override;
 
+  void Abort() override;
+  bool IsRealtime() override;
+  void Pause(bool bPaused) override;
+
+  // the local timeshift buffer reports its window through IDisplayTime and seeks with IPosTime
+  CDVDInputStream::ITimes* GetITimes() override;
+  CDVDInputStream::IDisplayTime* GetIDisplayTime() override;
+  int GetTotalTime() override;
+  int GetTime() override;
+  CDVDInputStream::IPosTime* GetIPosTime() override;
+  bool PosTime(int ms) override;
+
 protected:
   bool OpenPVRStream() override;
   void ClosePVRStream() override;
@@ -29,5 +48,8 @@ protected:
   bool CanSeekPVRStream() override;
 
 private:
+  void OpenTimeshiftBuffer();
+
   bool m_bDemuxActive;
+  std::unique_ptr<CPVRTimeshiftBuffer> m_timeshift; /*!< local timeshift, if the backend has none */
 };
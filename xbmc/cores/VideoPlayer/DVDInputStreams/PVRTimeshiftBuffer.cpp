@@ -0,0 +1,359 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRTimeshiftBuffer.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <vector>
+
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+
+using namespace XFILE;
+
+namespace
+{
+  const int INDEX_INTERVAL = 250;  // ms between index entries
+  const int READ_CHUNK_SIZE = 64 * 1024;
+  const int READ_TIMEOUT = 10000;  // ms to wait for live data
+  const int CLOSE_WARN_TIME = 5000; // ms a pending live read may take before it is logged
+}
+
+CPVRTimeshiftBuffer::CPVRTimeshiftBuffer(const std::string& strPath, int64_t iMaxSize, int iMaxDuration)
+  : CThread("PVRTimeshiftBuffer"),
+    m_strPath(strPath),
+    m_iMaxSize(iMaxSize),
+    m_iMaxDuration(iMaxDuration),
+    m_bAbort(false)
+{
+}
+
+CPVRTimeshiftBuffer::~CPVRTimeshiftBuffer()
+{
+  Close();
+}
+
+bool CPVRTimeshiftBuffer::Open(const Source& source)
+{
+  Close();
+
+  if (!m_writeFile.OpenForWrite(m_strPath, true))
+  {
+    CLog::LogF(LOGERROR, "Could not create timeshift buffer '%s'", m_strPath.c_str());
+    return false;
+  }
+
+  if (!m_readFile.Open(m_strPath, READ_NO_CACHE))
+  {
+    CLog::LogF(LOGERROR, "Could not open timeshift buffer '%s'", m_strPath.c_str());
+    m_writeFile.Close();
+    CFile::Delete(m_strPath);
+    return false;
+  }
+
+  {
+    CSingleLock lock(m_critSection);
+    m_index.clear();
+    m_iStart = m_iEnd = m_iPosition = 0;
+    m_bSourceEnded = m_bSourceFailed = false;
+  }
+
+  m_bOpen = true;
+  m_source = source;
+  m_iOpenTime = XbmcThreads::SystemClockMillis();
+  m_bAbort = false;
+  m_dataAvailable.Reset();
+  Create();
+
+  CLog::Log(LOGDEBUG, "CPVRTimeshiftBuffer - %s - recording into '%s' (%lld MB, %d s)", __FUNCTION__,
+            m_strPath.c_str(), static_cast<long long>(m_iMaxSize / (1024 * 1024)), m_iMaxDuration);
+  return true;
+}
+
+void CPVRTimeshiftBuffer::Close()
+{
+  m_bAbort = true;
+  m_dataAvailable.Set();
+
+  // the live stream must not be closed while the recording thread reads from it, wait for the
+  // pending read. Sources return without data after their own timeout.
+  StopThread(false);
+  if (IsRunning() && !WaitForThreadExit(CLOSE_WARN_TIME))
+    CLog::LogF(LOGWARNING, "Live stream read did not return within %d ms, still waiting", CLOSE_WARN_TIME);
+  StopThread(true);
+
+  if (m_bOpen)
+  {
+    m_readFile.Close();
+    m_writeFile.Close();
+    CFile::Delete(m_strPath);
+    m_bOpen = false;
+  }
+
+  m_source = nullptr;
+}
+
+void CPVRTimeshiftBuffer::Abort()
+{
+  m_bAbort = true;
+  m_dataAvailable.Set();
+}
+
+int CPVRTimeshiftBuffer::Now() const
+{
+  return static_cast<int>(XbmcThreads::SystemClockMillis() - m_iOpenTime);
+}
+
+void CPVRTimeshiftBuffer::Process()
+{
+  std::vector<uint8_t> buffer(READ_CHUNK_SIZE);
+
+  while (!m_bStop)
+  {
+    const int iRead = m_source(buffer.data(), READ_CHUNK_SIZE);
+    if (iRead <= 0)
+    {
+      CSingleLock lock(m_critSection);
+      m_bSourceEnded = true;
+      m_bSourceFailed = iRead < 0;
+      break;
+    }
+
+    int64_t iOffset;
+    {
+      CSingleLock lock(m_critSection);
+      iOffset = m_iEnd;
+      // make room before overwriting the oldest data
+      if (iOffset + iRead - m_iStart > m_iMaxSize)
+        m_iStart = iOffset + iRead - m_iMaxSize;
+    }
+
+    if (!WriteRing(buffer.data(), iRead, iOffset))
+    {
+      CSingleLock lock(m_critSection);
+      m_bSourceEnded = m_bSourceFailed = true;
+      break;
+    }
+
+    {
+      CSingleLock lock(m_critSection);
+      const int iNow = Now();
+      AppendIndex(iNow, iOffset);
+      m_iEnd = iOffset + iRead;
+      TrimLocked(iNow);
+    }
+    m_dataAvailable.Set();
+  }
+
+  m_dataAvailable.Set();
+}
+
+bool CPVRTimeshiftBuffer::WriteRing(const uint8_t* buf, int size, int64_t offset)
+{
+  while (size > 0)
+  {
+    const int64_t iPos = offset % m_iMaxSize;
+    const int iChunk = static_cast<int>(std::min<int64_t>(size, m_iMaxSize - iPos));
+    if (m_writeFile.Seek(iPos, SEEK_SET) != iPos || m_writeFile.Write(buf, iChunk) != iChunk)
+    {
+      CLog::LogF(LOGERROR, "Could not write to timeshift buffer '%s'", m_strPath.c_str());
+      return false;
+    }
+    buf += iChunk;
+    offset += iChunk;
+    size -= iChunk;
+  }
+  return true;
+}
+
+int CPVRTimeshiftBuffer::ReadRing(uint8_t* buf, int size, int64_t offset)
+{
+  int iTotal = 0;
+  while (iTotal < size)
+  {
+    const int64_t iPos = (offset + iTotal) % m_iMaxSize;
+    const int iChunk = static_cast<int>(std::min<int64_t>(size - iTotal, m_iMaxSize - iPos));
+    if (m_readFile.Seek(iPos, SEEK_SET) != iPos)
+      return -1;
+
+    const ssize_t iRead = m_readFile.Read(buf + iTotal, iChunk);
+    if (iRead <= 0)
+      return -1;
+    iTotal += static_cast<int>(iRead);
+  }
+  return iTotal;
+}
+
+void CPVRTimeshiftBuffer::AppendIndex(int iTime, int64_t iOffset)
+{
+  if (m_index.empty() || iTime - m_index.back().iTime >= INDEX_INTERVAL)
+    m_index.push_back({iTime, iOffset});
+}
+
+void CPVRTimeshiftBuffer::TrimLocked(int iNow)
+{
+  // drop data older than the maximum duration
+  if (m_iMaxDuration > 0)
+  {
+    const int iOldest = iNow - m_iMaxDuration * 1000;
+    while (m_index.size() > 1 && m_index[1].iTime <= iOldest)
+    {
+      m_index.pop_front();
+      m_iStart = std::max(m_iStart, m_index.front().iOffset);
+    }
+  }
+
+  // keep the entry covering the oldest recorded byte
+  while (m_index.size() > 1 && m_index[1].iOffset <= m_iStart)
+    m_index.pop_front();
+}
+
+int CPVRTimeshiftBuffer::GetTimeLocked(int64_t offset) const
+{
+  if (m_index.empty())
+    return 0;
+
+  // the last entry at or before the offset
+  auto it = std::upper_bound(m_index.begin(), m_index.end(), offset,
+                             [](int64_t iOffset, const IndexEntry& entry) { return iOffset < entry.iOffset; });
+  if (it != m_index.begin())
+    --it;
+  return it->iTime;
+}
+
+int CPVRTimeshiftBuffer::Read(uint8_t* buf, int buf_size)
+{
+  XbmcThreads::EndTime timeout(READ_TIMEOUT);
+
+  while (!m_bAbort)
+  {
+    int64_t iPosition;
+    int iAvailable;
+    {
+      CSingleLock lock(m_critSection);
+      // the data at the read position was overwritten while paused
+      if (m_iPosition < m_iStart)
+        m_iPosition = m_iStart;
+
+      iPosition = m_iPosition;
+      iAvailable = static_cast<int>(std::min<int64_t>(buf_size, m_iEnd - m_iPosition));
+      if (iAvailable <= 0 && m_bSourceEnded)
+        return m_bSourceFailed ? -1 : 0;
+    }
+
+    if (iAvailable > 0)
+    {
+      const int iRead = ReadRing(buf, iAvailable, iPosition);
+      if (iRead < 0)
+        return -1;
+
+      CSingleLock lock(m_critSection);
+      // the writer overtook us during the read, the data is invalid
+      if (iPosition < m_iStart)
+        continue;
+      if (m_iPosition == iPosition)
+        m_iPosition += iRead;
+      return iRead;
+    }
+
+    if (timeout.IsTimePast())
+      return 0;
+
+    m_dataAvailable.WaitMSec(100);
+  }
+
+  return -1;
+}
+
+int64_t CPVRTimeshiftBuffer::Seek(int64_t offset, int whence)
+{
+  CSingleLock lock(m_critSection);
+
+  int64_t iPosition;
+  switch (whence)
+  {
+    case SEEK_SET:
+      iPosition = offset;
+      break;
+    case SEEK_CUR:
+      iPosition = m_iPosition + offset;
+      break;
+    case SEEK_END:
+      iPosition = m_iEnd + offset;
+      break;
+    default:
+      return -1;
+  }
+
+  if (iPosition < m_iStart || iPosition > m_iEnd)
+    return -1;
+
+  m_iPosition = iPosition;
+  return m_iPosition;
+}
+
+bool CPVRTimeshiftBuffer::SeekTime(int iTime)
+{
+  CSingleLock lock(m_critSection);
+  if (m_index.empty())
+    return false;
+
+  // the first entry after the time, the data before it may have arrived at the requested time
+  auto it = std::upper_bound(m_index.begin(), m_index.end(), iTime,
+                             [](int time, const IndexEntry& entry) { return time < entry.iTime; });
+  if (it != m_index.begin())
+    --it;
+
+  m_iPosition = std::max(it->iOffset, m_iStart);
+  CLog::Log(LOGDEBUG, "CPVRTimeshiftBuffer - %s - seek to %d ms, offset %lld", __FUNCTION__, iTime,
+            static_cast<long long>(m_iPosition));
+  return true;
+}
+
+int64_t CPVRTimeshiftBuffer::GetStart() const
+{
+  CSingleLock lock(m_critSection);
+  return m_iStart;
+}
+
+int64_t CPVRTimeshiftBuffer::GetEnd() const
+{
+  CSingleLock lock(m_critSection);
+  return m_iEnd;
+}
+
+int64_t CPVRTimeshiftBuffer::GetPosition() const
+{
+  CSingleLock lock(m_critSection);
+  return m_iPosition;
+}
+
+int CPVRTimeshiftBuffer::GetTime() const
+{
+  CSingleLock lock(m_critSection);
+  return GetTimeLocked(std::max(m_iPosition, m_iStart));
+}
+
+int CPVRTimeshiftBuffer::GetStartTime() const
+{
+  CSingleLock lock(m_critSection);
+  return GetTimeLocked(m_iStart);
+}
+
+int CPVRTimeshiftBuffer::GetEndTime() const
+{
+  CSingleLock lock(m_critSection);
+  return m_bSourceEnded || m_index.empty() ? GetTimeLocked(m_iEnd) : Now();
+}
+
+bool CPVRTimeshiftBuffer::IsLive(int iThreshold) const
+{
+  return GetEndTime() - GetTime() < iThreshold;
+}
@@ -0,0 +1,155 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <stdint.h>
+#include <string>
+
+#include "filesystem/File.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+/*!
+ * @brief Local timeshift buffer for live streams of backends without timeshift support.
+ *
+ * A thread records the live stream into a ring file bounded by size and duration. The player
+ * reads from the file at its own position, so it can pause, rewind and seek within the
+ * recorded window while recording continues. Stream positions are logical byte offsets
+ * that keep increasing; the recorded window is [GetStart(), GetEnd()). An index maps the
+ * time the data arrived to offsets, times are milliseconds since Open().
+ */
+class CPVRTimeshiftBuffer : private CThread
+{
+public:
+  /*!
+   * @brief Reads from the live stream.
+   * Gets a buffer and its size, returns the number of bytes read, 0 at the end of the stream, -1 on error.
+   * Must return within a bounded time even without data, Close() waits for a pending read.
+   */
+  typedef std::function<int(uint8_t*, int)> Source;
+
+  /*!
+   * @brief Create a buffer.
+   * @param strPath The ring file, it is created on Open() and deleted on Close().
+   * @param iMaxSize The size of the ring file in bytes.
+   * @param iMaxDuration The maximum time kept in the buffer in seconds, 0 for no limit.
+   */
+  CPVRTimeshiftBuffer(const std::string& strPath, int64_t iMaxSize, int iMaxDuration);
+  ~CPVRTimeshiftBuffer() override;
+
+  /*!
+   * @brief Create the ring file and start recording.
+   * @param source The live stream.
+   * @return True on success, false otherwise.
+   */
+  bool Open(const Source& source);
+
+  /*!
+   * @brief Stop recording and delete the ring file.
+   * Returns once the recording thread is done with the live stream, so the caller may close it.
+   */
+  void Close();
+
+  /*!
+   * @brief Unblock a pending Read().
+   */
+  void Abort();
+
+  /*!
+   * @brief Read recorded data at the current position, waits for data at the live position.
+   * @return The number of bytes read, 0 at the end of the stream, -1 on error.
+   */
+  int Read(uint8_t* buf, int buf_size);
+
+  /*!
+   * @brief Move the read position within the recorded window.
+   * @return The new position or -1 if the position is not recorded.
+   */
+  int64_t Seek(int64_t offset, int whence);
+
+  /*!
+   * @brief Move the read position to the data that arrived at the given time.
+   * @param iTime The time in ms, clamped to the recorded window.
+   * @return True on success, false otherwise.
+   */
+  bool SeekTime(int iTime);
+
+  int64_t GetStart() const;
+  int64_t GetEnd() const;
+  int64_t GetPosition() const;
+
+  /*!
+   * @brief Get the time the data at the read position arrived.
+   * @return The time in ms.
+   */
+  int GetTime() const;
+
+  /*!
+   * @brief Get the time the oldest recorded data arrived.
+   * @return The time in ms.
+   */
+  int GetStartTime() const;
+
+  /*!
+   * @brief Get the time the newest recorded data arrived.
+   * @return The time in ms.
+   */
+  int GetEndTime() const;
+
+  /*!
+   * @brief Check whether the read position is near the live position.
+   * @param iThreshold The maximum distance in ms.
+   * @return True if the read position is less than iThreshold behind live.
+   */
+  bool IsLive(int iThreshold) const;
+
+protected:
+  void Process() override;
+
+private:
+  struct IndexEntry
+  {
+    int iTime;       /*!< ms since Open() */
+    int64_t iOffset; /*!< logical offset of the first byte that arrived at this time */
+  };
+
+  CPVRTimeshiftBuffer(const CPVRTimeshiftBuffer&) = delete;
+  CPVRTimeshiftBuffer& operator=(const CPVRTimeshiftBuffer&) = delete;
+
+  bool WriteRing(const uint8_t* buf, int size, int64_t offset);
+  int ReadRing(uint8_t* buf, int size, int64_t offset);
+  void AppendIndex(int iTime, int64_t iOffset);
+  void TrimLocked(int iNow);
+  int GetTimeLocked(int64_t offset) const;
+  int Now() const;
+
+  const std::string m_strPath;
+  const int64_t m_iMaxSize;
+  const int m_iMaxDuration;
+
+  Source m_source;
+  XFILE::CFile m_writeFile;
+  XFILE::CFile m_readFile;
+  unsigned int m_iOpenTime = 0;
+  bool m_bOpen = false;
+
+  mutable CCriticalSection m_critSection;
+  CEvent m_dataAvailable;
+  std::deque<IndexEntry> m_index; /*!< sorted by time and offset */
+  int64_t m_iStart = 0;           /*!< logical offset of the oldest recorded byte */
+  int64_t m_iEnd = 0;             /*!< logical offset after the newest recorded byte */
+  int64_t m_iPosition = 0;        /*!< logical read position */
+  bool m_bSourceEnded = false;    /*!< the live stream ended or failed */
+  bool m_bSourceFailed = false;
+  std::atomic<bool> m_bAbort;
+};
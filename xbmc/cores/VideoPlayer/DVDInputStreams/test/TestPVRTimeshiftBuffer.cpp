@@ -0,0 +1,126 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDInputStreams/PVRTimeshiftBuffer.h"
+#include "threads/Event.h"
+#include "threads/SystemClock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+const char* const BUFFER_PATH = "special://temp/TestPVRTimeshiftBuffer.ts";
+
+/* a live stream of iSize bytes, the byte at offset i is i % 251 */
+CPVRTimeshiftBuffer::Source CreateSource(int64_t iSize, int iChunkSize)
+{
+  std::shared_ptr<int64_t> offset = std::make_shared<int64_t>(0);
+  return [offset, iSize, iChunkSize](uint8_t* buf, int buf_size)
+  {
+    const int iRead = static_cast<int>(std::min<int64_t>(std::min(buf_size, iChunkSize), iSize - *offset));
+    for (int i = 0; i < iRead; ++i)
+      buf[i] = static_cast<uint8_t>((*offset + i) % 251);
+    *offset += iRead;
+    return iRead;
+  };
+}
+
+void WaitForEnd(const CPVRTimeshiftBuffer& buffer, int64_t iEnd)
+{
+  XbmcThreads::EndTime timeout(5000);
+  while (buffer.GetEnd() < iEnd && !timeout.IsTimePast())
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+}
+
+bool CheckData(const uint8_t* buf, int size, int64_t offset)
+{
+  for (int i = 0; i < size; ++i)
+  {
+    if (buf[i] != static_cast<uint8_t>((offset + i) % 251))
+      return false;
+  }
+  return true;
+}
+
+}
+
+TEST(TestPVRTimeshiftBuffer, ReadAll)
+{
+  CPVRTimeshiftBuffer buffer(BUFFER_PATH, 1024 * 1024, 0);
+  ASSERT_TRUE(buffer.Open(CreateSource(100000, 1000)));
+
+  std::vector<uint8_t> data(4096);
+  int64_t iTotal = 0;
+  int iRead;
+  while ((iRead = buffer.Read(data.data(), static_cast<int>(data.size()))) > 0)
+  {
+    EXPECT_TRUE(CheckData(data.data(), iRead, iTotal));
+    iTotal += iRead;
+  }
+  EXPECT_EQ(0, iRead);
+  EXPECT_EQ(100000, iTotal);
+}
+
+TEST(TestPVRTimeshiftBuffer, WrapsAndSeeks)
+{
+  // the stream is three times the size of the ring
+  CPVRTimeshiftBuffer buffer(BUFFER_PATH, 30000, 0);
+  ASSERT_TRUE(buffer.Open(CreateSource(90000, 700)));
+  WaitForEnd(buffer, 90000);
+  ASSERT_EQ(90000, buffer.GetEnd());
+  EXPECT_EQ(60000, buffer.GetStart());
+
+  // the read position was overwritten while "paused", reading continues at the oldest data
+  std::vector<uint8_t> data(5000);
+  ASSERT_EQ(5000, buffer.Read(data.data(), 5000));
+  EXPECT_TRUE(CheckData(data.data(), 5000, 60000));
+
+  EXPECT_EQ(-1, buffer.Seek(1000, SEEK_SET));
+  EXPECT_EQ(-1, buffer.Seek(1, SEEK_END));
+  EXPECT_EQ(80000, buffer.Seek(-10000, SEEK_END));
+  ASSERT_EQ(5000, buffer.Read(data.data(), 5000));
+  EXPECT_TRUE(CheckData(data.data(), 5000, 80000));
+  EXPECT_EQ(85000, buffer.GetPosition());
+
+  // seeking by time ends up at an indexed offset inside the window
+  EXPECT_TRUE(buffer.SeekTime(0));
+  EXPECT_EQ(buffer.GetStart(), buffer.GetPosition());
+  EXPECT_LE(buffer.GetStartTime(), buffer.GetEndTime());
+}
+
+TEST(TestPVRTimeshiftBuffer, CloseWaitsForPendingRead)
+{
+  // the live stream returns without data after a while, like an add-on waiting for its backend
+  std::shared_ptr<std::atomic<bool>> reading = std::make_shared<std::atomic<bool>>(false);
+  std::shared_ptr<CEvent> started = std::make_shared<CEvent>(true);
+  CPVRTimeshiftBuffer buffer(BUFFER_PATH, 1024 * 1024, 0);
+  ASSERT_TRUE(buffer.Open([reading, started](uint8_t* buf, int buf_size)
+                          {
+                            *reading = true;
+                            started->Set();
+                            std::this_thread::sleep_for(std::chrono::milliseconds(300));
+                            *reading = false;
+                            return 0;
+                          }));
+
+  ASSERT_TRUE(started->WaitMSec(5000));
+  XbmcThreads::EndTime timeout(5000);
+  buffer.Close();
+  // the live stream may be closed now, nobody reads from it anymore
+  EXPECT_FALSE(*reading);
+  EXPECT_FALSE(timeout.IsTimePast());
+}
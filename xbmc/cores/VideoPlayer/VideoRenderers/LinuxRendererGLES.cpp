@@ -386,6 +386,9 @@ void CLinuxRendererGLES::RenderUpdate(int index, int index2, bool clear, unsigne
     return;
   }
 
+  // draw the GUI queued below the video
+  m_renderSystem->FlushBatch();
+
   ManageRenderArea();
 
   if (clear)
@@ -367,6 +367,11 @@ void COverlayGlyphGL::Render(SRenderState& state)
   if ((m_texture == 0) || (m_count == 0))
     return;
 
+#if HAS_GLES >= 2
+  // draw the queued GUI quads before changing texture, blend state and matrices
+  dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem())->FlushBatch();
+#endif
+
   glEnable(GL_BLEND);
 
   glBindTexture(GL_TEXTURE_2D, m_texture);
@@ -483,6 +488,11 @@ COverlayTextureGL::~COverlayTextureGL()
 
 void COverlayTextureGL::Render(SRenderState& state)
 {
+#if HAS_GLES >= 2
+  // draw the queued GUI quads before changing texture and blend state
+  dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem())->FlushBatch();
+#endif
+
   glEnable(GL_BLEND);
 
   glBindTexture(GL_TEXTURE_2D, m_texture);
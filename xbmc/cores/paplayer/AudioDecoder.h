@@ -64,6 +64,7 @@ public:
   uint8_t* GetRawData(int &size);
   ICodec *GetCodec() const { return m_codec; }
   float GetReplayGain(float &peakVal);
+  unsigned int GetBufferSize() { return m_pcmBuffer.getSize(); }
 
 private:
   // pcm buffer
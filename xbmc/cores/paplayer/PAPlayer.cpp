@@ -9,6 +9,7 @@
 #include "PAPlayer.h"
 #include "CodecFactory.h"
 #include "ServiceBroker.h"
+#include "URL.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
@@ -28,6 +29,8 @@
 #define TIME_TO_CACHE_NEXT_FILE 5000 /* 5 seconds before end of song, start caching the next song */
 #define FAST_XFADE_TIME           80 /* 80 milliseconds */
 #define MAX_SKIP_XFADE_TIME     2000 /* max 2 seconds crossfade on track skip */
+#define PRELOAD_MAX_STREAMS        2 /* how many upcoming playlist items are opened ahead of time */
+#define PRELOAD_MAX_MEMORY  (8 * 1024 * 1024) /* max bytes of pcm buffers held by preloaded items */
 
 // PAP: Psycho-acoustic Audio Player
 // Supporting all open  audio codec standards.
@@ -46,7 +49,8 @@ PAPlayer::PAPlayer(IPlayerCallback& callback) :
   m_audioCallback(NULL ),
   m_jobCounter(0),
   m_newForcedPlayerTime(-1),
-  m_newForcedTotalTime (-1)
+  m_newForcedTotalTime (-1),
+  m_preload(std::make_shared<PreloadState>())
 {
   memset(&m_playerGUIData, 0, sizeof(m_playerGUIData));
   m_processInfo.reset(CProcessInfo::CreateInstance());
@@ -321,41 +325,57 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
     m_currentStream->m_nextFileItem.reset();
   }
 
-  StreamInfo *si = new StreamInfo();
-  si->m_fileItem = file;
-  if (!si->m_decoder.Create(file, si->m_fileItem.m_lStartOffset))
+  StreamInfo *si = TakePreloaded(file);
+  if (m_currentStream)
   {
-    CLog::Log(LOGWARNING, "PAPlayer::QueueNextFileEx - Failed to create the decoder");
-
-    // advance playlist
-    AdvancePlaylistOnError(si->m_fileItem);
-    m_callback.OnQueueNextItem();
-
-    delete si;
-    return false;
+    if (si)
+      m_preloadHits++;
+    else
+      m_preloadMisses++;
+    CLog::Log(LOGDEBUG, "PAPlayer::QueueNextFileEx - transition %s preload cache (%u of %u served from cache)",
+              si ? "served from" : "missed", m_preloadHits, m_preloadHits + m_preloadMisses);
   }
 
-  /* decode until there is data-available */
-  si->m_decoder.Start();
-  while (si->m_decoder.GetDataSize(true) == 0)
+  if (si)
+    si->m_fileItem = file;
+  else
   {
-    int status = si->m_decoder.GetStatus();
-    if (status == STATUS_ENDED   ||
-        status == STATUS_NO_FILE ||
-        si->m_decoder.ReadSamples(PACKET_SIZE) == RET_ERROR)
+    si = new StreamInfo();
+    si->m_fileItem = file;
+    if (!si->m_decoder.Create(file, si->m_fileItem.m_lStartOffset))
     {
-      CLog::Log(LOGINFO, "PAPlayer::QueueNextFileEx - Error reading samples");
+      CLog::Log(LOGWARNING, "PAPlayer::QueueNextFileEx - Failed to create the decoder");
 
-      si->m_decoder.Destroy();
       // advance playlist
       AdvancePlaylistOnError(si->m_fileItem);
       m_callback.OnQueueNextItem();
+
       delete si;
       return false;
     }
 
-    /* yield our time so that the main PAP thread doesnt stall */
-    CThread::Sleep(1);
+    /* decode until there is data-available */
+    si->m_decoder.Start();
+    while (si->m_decoder.GetDataSize(true) == 0)
+    {
+      int status = si->m_decoder.GetStatus();
+      if (status == STATUS_ENDED   ||
+          status == STATUS_NO_FILE ||
+          si->m_decoder.ReadSamples(PACKET_SIZE) == RET_ERROR)
+      {
+        CLog::Log(LOGINFO, "PAPlayer::QueueNextFileEx - Error reading samples");
+
+        si->m_decoder.Destroy();
+        // advance playlist
+        AdvancePlaylistOnError(si->m_fileItem);
+        m_callback.OnQueueNextItem();
+        delete si;
+        return false;
+      }
+
+      /* yield our time so that the main PAP thread doesnt stall */
+      CThread::Sleep(1);
+    }
   }
 
   // set m_upcomingCrossfadeMS depending on type of file and user settings
@@ -513,6 +533,24 @@ bool PAPlayer::CloseFile(bool reopen)
   if (reopen)
     CServiceBroker::GetActiveAE()->KeepConfiguration(3000);
 
+  /* a preload thread stuck in opening a file is not waited for, it drops the stream itself */
+  std::shared_ptr<PreloadState> preload;
+  {
+    CSingleLock lock(m_streamsLock);
+    preload.swap(m_preload);
+    m_preload = std::make_shared<PreloadState>();
+  }
+  preload->m_abort = true;
+
+  /* logged without debug logging, so the cache can be judged from any log */
+  if (!reopen && m_preloadHits + m_preloadMisses > 0)
+  {
+    CLog::Log(LOGNOTICE, "PAPlayer::CloseFile - %u of %u track transitions were served from the preload cache",
+              m_preloadHits, m_preloadHits + m_preloadMisses);
+    m_preloadHits = 0;
+    m_preloadMisses = 0;
+  }
+
   if (!m_isPaused)
     SoftStop(true, true);
   CloseAllStreams(false);
@@ -531,6 +569,8 @@ bool PAPlayer::CloseFile(bool reopen)
     }
   }
 
+  ClearPreloaded(*preload);
+
   return true;
 }
 
@@ -1153,3 +1193,207 @@ void PAPlayer::AdvancePlaylistOnError(CFileItem &fileItem)
   m_signalStarted = true;
   m_callback.OnAVStarted(fileItem);
 }
+
+static bool IsSameStream(const CFileItem &a, const CFileItem &b)
+{
+  return a.GetDynPath() == b.GetDynPath() &&
+         a.m_lStartOffset == b.m_lStartOffset &&
+         a.m_lEndOffset == b.m_lEndOffset;
+}
+
+/* opening files on network shares can take long, a shared job worker would hold up thumb and
+   texture jobs meanwhile */
+class PAPlayer::CPreloadThread : public CThread
+{
+public:
+  explicit CPreloadThread(const std::shared_ptr<PreloadState> &state)
+    : CThread("PAPlayerPreload"),
+      m_state(state)
+  {
+  }
+
+protected:
+  void Process() override
+  {
+    SetPriority(GetMinPriority());
+    PreloadUpcoming(m_state);
+  }
+
+private:
+  std::shared_ptr<PreloadState> m_state;
+};
+
+void PAPlayer::PreloadUpcomingFiles(const std::vector<CFileItem> &files)
+{
+  std::vector<CFileItem> upcoming;
+  {
+    CSingleLock lock(m_streamsLock);
+    for (const auto& item : files)
+    {
+      // cd drives don't really like it to be prepared, cue sheet tracks share the open stream
+      if (item.IsCDDA() || item.m_lStartOffset || upcoming.size() >= PRELOAD_MAX_STREAMS)
+        continue;
+
+      bool queued = false;
+      for (const auto si : m_streams)
+      {
+        if (IsSameStream(si->m_fileItem, item))
+          queued = true;
+      }
+      if (!queued)
+        upcoming.push_back(item);
+    }
+  }
+
+  std::shared_ptr<PreloadState> state = GetPreloadState();
+  CSingleLock lock(state->m_lock);
+  state->m_upcoming.swap(upcoming);
+  state->m_changed = true;
+  if (state->m_running || state->m_abort)
+    return;
+  state->m_running = true;
+
+  /* CloseFile() does not wait for files being opened, the thread deletes itself when done */
+  CPreloadThread *thread = new CPreloadThread(state);
+  thread->Create(true);
+}
+
+void PAPlayer::PreloadUpcoming(const std::shared_ptr<PreloadState> &state)
+{
+  while (true)
+  {
+    std::vector<CFileItem> upcoming;
+    unsigned int memory = 0;
+    {
+      CSingleLock lock(state->m_lock);
+      if (!state->m_changed || state->m_abort)
+      {
+        state->m_running = false;
+        return;
+      }
+      state->m_changed = false;
+      upcoming = state->m_upcoming;
+
+      /* drop whatever is no longer coming up */
+      for (auto itt = state->m_preloaded.begin(); itt != state->m_preloaded.end();)
+      {
+        StreamInfo* si = *itt;
+        bool wanted = false;
+        for (const auto& item : upcoming)
+        {
+          if (IsSameStream(si->m_fileItem, item))
+            wanted = true;
+        }
+
+        if (!wanted)
+        {
+          itt = state->m_preloaded.erase(itt);
+          si->m_decoder.Destroy();
+          delete si;
+        }
+        else
+        {
+          memory += si->m_decoder.GetBufferSize();
+          ++itt;
+        }
+      }
+    }
+
+    for (const auto& item : upcoming)
+    {
+      if (state->m_abort)
+        break;
+
+      {
+        CSingleLock lock(state->m_lock);
+        bool cached = false;
+        for (const auto si : state->m_preloaded)
+        {
+          if (IsSameStream(si->m_fileItem, item))
+            cached = true;
+        }
+        if (cached)
+          continue;
+      }
+
+      StreamInfo *si = new StreamInfo();
+      si->m_fileItem = item;
+      if (!si->m_decoder.Create(item, item.m_lStartOffset) ||
+          si->m_decoder.GetFormat().m_dataFormat == AE_FMT_RAW)
+      {
+        si->m_decoder.Destroy();
+        delete si;
+        continue;
+      }
+
+      if (memory + si->m_decoder.GetBufferSize() > PRELOAD_MAX_MEMORY)
+      {
+        CLog::Log(LOGDEBUG, "PAPlayer::PreloadUpcoming - memory budget exhausted");
+        si->m_decoder.Destroy();
+        delete si;
+        break;
+      }
+
+      /* decode the first seconds, until the pcm buffer is full */
+      bool failed = false;
+      si->m_decoder.Start();
+      while (!state->m_abort && si->m_decoder.GetStatus() == STATUS_QUEUING)
+      {
+        int ret = si->m_decoder.ReadSamples(PACKET_SIZE);
+        if (ret == RET_ERROR)
+        {
+          failed = true;
+          break;
+        }
+        else if (ret == RET_SLEEP)
+          XbmcThreads::ThreadSleep(1);
+      }
+
+      CSingleLock lock(state->m_lock);
+      if (failed || state->m_abort)
+      {
+        si->m_decoder.Destroy();
+        delete si;
+        continue;
+      }
+
+      CLog::Log(LOGDEBUG, "PAPlayer::PreloadUpcoming - preloaded %s", CURL::GetRedacted(item.GetDynPath()).c_str());
+      memory += si->m_decoder.GetBufferSize();
+      state->m_preloaded.push_back(si);
+    }
+  }
+}
+
+std::shared_ptr<PAPlayer::PreloadState> PAPlayer::GetPreloadState()
+{
+  CSingleLock lock(m_streamsLock);
+  return m_preload;
+}
+
+PAPlayer::StreamInfo* PAPlayer::TakePreloaded(const CFileItem &file)
+{
+  std::shared_ptr<PreloadState> state = GetPreloadState();
+  CSingleLock lock(state->m_lock);
+  for (auto itt = state->m_preloaded.begin(); itt != state->m_preloaded.end(); ++itt)
+  {
+    StreamInfo* si = *itt;
+    if (IsSameStream(si->m_fileItem, file))
+    {
+      state->m_preloaded.erase(itt);
+      return si;
+    }
+  }
+  return nullptr;
+}
+
+void PAPlayer::ClearPreloaded(PreloadState &state)
+{
+  CSingleLock lock(state.m_lock);
+  while (!state.m_preloaded.empty())
+  {
+    StreamInfo* si = state.m_preloaded.front();
+    state.m_preloaded.pop_front();
+    si->m_decoder.Destroy();
+    delete si;
+  }
+}
@@ -10,6 +10,7 @@
 
 #include <atomic>
 #include <list>
+#include <memory>
 #include <vector>
 
 #include "FileItem.h"
@@ -35,6 +36,7 @@ public:
   bool OpenFile(const CFileItem& file, const CPlayerOptions &options) override;
   bool QueueNextFile(const CFileItem &file) override;
   void OnNothingToQueueNotify() override;
+  void PreloadUpcomingFiles(const std::vector<CFileItem> &files) override;
   bool CloseFile(bool reopen = false) override;
   bool IsPlaying() const override;
   void Pause() override;
@@ -132,6 +134,22 @@ private:
   int64_t             m_newForcedTotalTime;
   std::unique_ptr<CProcessInfo> m_processInfo;
 
+  /* upcoming playlist items, opened and pre-decoded by a thread that may outlive the player */
+  struct PreloadState
+  {
+    CCriticalSection       m_lock;
+    StreamList             m_preloaded;          /* opened and pre-decoded streams */
+    std::vector<CFileItem> m_upcoming;           /* the items to preload, handed over by the application */
+    bool                   m_changed = false;    /* m_upcoming changed since the thread read it */
+    bool                   m_running = false;    /* a preload thread is running */
+    std::atomic_bool       m_abort{false};       /* set on close, the thread drops what it still opens */
+  };
+
+  class CPreloadThread;
+  std::shared_ptr<PreloadState> m_preload;
+  unsigned int        m_preloadHits = 0;     /* transitions served from the preload cache */
+  unsigned int        m_preloadMisses = 0;   /* transitions that had to open the file */
+
   bool QueueNextFileEx(const CFileItem &file, bool fadeIn);
   void SoftStart(bool wait = false);
   void SoftStop(bool wait = false, bool close = true);
@@ -149,5 +167,9 @@ private:
   bool SetTotalTimeInternal(int64_t time);
   void CloseFileCB(StreamInfo &si);
   void AdvancePlaylistOnError(CFileItem &fileItem);
+  static void PreloadUpcoming(const std::shared_ptr<PreloadState> &state);
+  static void ClearPreloaded(PreloadState &state);
+  std::shared_ptr<PreloadState> GetPreloadState();
+  StreamInfo* TakePreloaded(const CFileItem &file);
 };
 
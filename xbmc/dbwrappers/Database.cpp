@@ -11,6 +11,7 @@
 #include "filesystem/SpecialProtocol.h"
 #include "profiles/ProfileManager.h"
 #include "settings/SettingsComponent.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 #include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
@@ -221,6 +222,12 @@ CDatabase::CDatabase() :
   m_sqlite = true;
   m_bMultiWrite = false;
   m_multipleExecute = false;
+  m_bulkBatchSize = 0;
+  m_bulkMaxDuration = 0;
+  m_bulkDepth = 0;
+  m_bulkCommits = 0;
+  m_bulkStart = 0;
+  m_bulkEnding = false;
 }
 
 CDatabase::~CDatabase(void)
@@ -593,6 +600,9 @@ void CDatabase::Close()
     return;
   }
 
+  if (m_bulkBatchSize > 0)
+    CommitBulkTransaction();
+
   m_openCount = 0;
   m_multipleExecute = false;
 
@@ -647,6 +657,23 @@ void CDatabase::Interrupt()
 
 void CDatabase::BeginTransaction()
 {
+  // folded into the current batch, a savepoint lets a rollback undo just this write
+  if (m_bulkBatchSize > 0)
+  {
+    if (m_bulkDepth++ == 0)
+    {
+      try
+      {
+        m_pDS->exec("SAVEPOINT bulk_write");
+      }
+      catch (...)
+      {
+        CLog::Log(LOGERROR, "database:begintransaction failed to set a savepoint");
+      }
+    }
+    return;
+  }
+
   try
   {
     if (NULL != m_pDB.get())
@@ -660,10 +687,58 @@ void CDatabase::BeginTransaction()
 
 bool CDatabase::CommitTransaction()
 {
+  if (m_bulkBatchSize > 0)
+  {
+    // only the outermost commit of a write releases its savepoint, a rolled back write has none
+    if (m_bulkDepth == 0 || --m_bulkDepth > 0)
+      return true;
+
+    try
+    {
+      m_pDS->exec("RELEASE SAVEPOINT bulk_write");
+      if (++m_bulkCommits < m_bulkBatchSize &&
+          XbmcThreads::SystemClockMillis() - m_bulkStart < m_bulkMaxDuration)
+        return true;
+
+      // start the next batch
+      const unsigned int commits = m_bulkCommits;
+      m_bulkCommits = 0;
+      m_bulkStart = XbmcThreads::SystemClockMillis();
+      if (NULL != m_pDB.get())
+      {
+        // a batch that can't be committed is rolled back, rather than kept open until the next one
+        if (!m_pDB->try_commit_transaction())
+        {
+          CLog::Log(LOGERROR, "database:committransaction failed, rolled back %u commits of the bulk transaction", commits);
+          m_pDB->rollback_transaction();
+          EmptyCache();
+          m_pDB->start_transaction();
+          return false;
+        }
+        m_pDB->start_transaction();
+      }
+    }
+    catch (...)
+    {
+      CLog::Log(LOGERROR, "database:committransaction failed");
+      return false;
+    }
+    return true;
+  }
+
   try
   {
     if (NULL != m_pDB.get())
-      m_pDB->commit_transaction();
+    {
+      if (!m_bulkEnding)
+        m_pDB->commit_transaction();
+      else if (!m_pDB->try_commit_transaction())
+      {
+        CLog::Log(LOGERROR, "database:committransaction failed, rolled back %u commits of the bulk transaction", m_bulkCommits);
+        m_pDB->rollback_transaction();
+        return false;
+      }
+    }
   }
   catch (...)
   {
@@ -677,7 +752,19 @@ void CDatabase::RollbackTransaction()
 {
   try
   {
-    if (NULL != m_pDB.get())
+    if (NULL != m_pDB.get() && m_bulkBatchSize > 0)
+    {
+      // undo the failed write only, the earlier writes of the batch were reported as committed
+      if (m_bulkDepth > 0)
+      {
+        m_bulkDepth = 0;
+        m_pDS->exec("ROLLBACK TO SAVEPOINT bulk_write");
+        m_pDS->exec("RELEASE SAVEPOINT bulk_write");
+      }
+      // the ids of rolled back rows may be cached
+      EmptyCache();
+    }
+    else if (NULL != m_pDB.get())
       m_pDB->rollback_transaction();
   }
   catch (...)
@@ -688,10 +775,56 @@ void CDatabase::RollbackTransaction()
 
 bool CDatabase::InTransaction()
 {
-  if (NULL != m_pDB.get()) return false;
+  if (NULL == m_pDB.get()) return false;
   return m_pDB->in_transaction();
 }
 
+bool CDatabase::BeginBulkTransaction(unsigned int batchSize, unsigned int maxDuration)
+{
+  if (NULL == m_pDB.get() || m_bulkBatchSize > 0 || batchSize == 0)
+    return false;
+
+  BeginTransaction();
+  m_bulkBatchSize = batchSize;
+  m_bulkMaxDuration = maxDuration;
+  m_bulkDepth = 0;
+  m_bulkCommits = 0;
+  m_bulkStart = XbmcThreads::SystemClockMillis();
+  return true;
+}
+
+bool CDatabase::CommitBulkTransaction()
+{
+  if (m_bulkBatchSize == 0)
+    return false;
+
+  m_bulkBatchSize = 0;
+  m_bulkDepth = 0;
+  EmptyCache();
+
+  // the last batch is committed like the others, through the CommitTransaction() of the derived class
+  m_bulkEnding = true;
+  const bool bCommitted = CommitTransaction();
+  m_bulkEnding = false;
+  return bCommitted;
+}
+
+dbiplus::PreparedStatement* CDatabase::GetPreparedStatement(const std::string &strQuery)
+{
+  if (NULL == m_pDB.get() || m_multipleExecute)
+    return nullptr;
+
+  try
+  {
+    return m_pDB->prepare_statement(strQuery);
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - failed to prepare query %s", __FUNCTION__, strQuery.c_str());
+  }
+  return nullptr;
+}
+
 bool CDatabase::CreateDatabase()
 {
   BeginTransaction();
@@ -11,6 +11,7 @@
 namespace dbiplus {
   class Database;
   class Dataset;
+  class PreparedStatement;
 }
 
 #include <memory>
@@ -105,6 +106,39 @@ public:
   virtual bool CommitTransaction();
   void RollbackTransaction();
   bool InTransaction();
+
+  /*!
+   * @brief Start a bulk transaction for large imports such as library scans.
+   *        Until CommitBulkTransaction() is called, BeginTransaction() and
+   *        CommitTransaction() of the individual writes are folded into one
+   *        transaction that is committed every batchSize commits or after
+   *        maxDuration ms, whichever comes first.
+   *        Each outermost write is wrapped in a savepoint, so RollbackTransaction()
+   *        only undoes the write that failed, not the earlier writes of the batch.
+   * @param batchSize number of folded commits per transaction.
+   * @param maxDuration time in ms a batch may keep the database locked.
+   * @return true if the bulk transaction was started, false otherwise.
+   * @sa CommitBulkTransaction
+   */
+  bool BeginBulkTransaction(unsigned int batchSize, unsigned int maxDuration);
+
+  /*!
+   * @brief Commit the current batch and leave bulk transaction mode.
+   * @return true if the batch was committed successfully, false otherwise.
+   * @sa BeginBulkTransaction
+   */
+  bool CommitBulkTransaction();
+
+  /*!
+   * @brief Whether a bulk transaction is active.
+   */
+  bool InBulkTransaction() const { return m_bulkBatchSize > 0; }
+
+  /*!
+   * @brief Drop in-memory caches of database ids. Called whenever a bulk
+   *        transaction ends, as ids of a rolled back batch are no longer valid.
+   */
+  virtual void EmptyCache() {}
   void CopyDB(const std::string& latestDb);
   void DropAnalytics();
 
@@ -235,6 +269,15 @@ protected:
 
   bool BuildSQL(const std::string &strQuery, const Filter &filter, std::string &strSQL);
 
+  /*!
+   * @brief Get a cached compiled statement for a query using ? placeholders.
+   * @param strQuery The query to compile, parameters are bound by index.
+   * @return the statement, or nullptr if the database backend does not support
+   *         prepared statements or queries are queued by BeginMultipleExecute().
+   *         Callers then fall back to PrepareSQL() and ExecuteQuery().
+   */
+  dbiplus::PreparedStatement* GetPreparedStatement(const std::string &strQuery);
+
   bool m_sqlite; ///< \brief whether we use sqlite (defaults to true)
 
   std::unique_ptr<dbiplus::Database> m_pDB;
@@ -254,4 +297,11 @@ private:
 
   bool m_multipleExecute;
   std::vector<std::string> m_multipleQueries;
+
+  unsigned int m_bulkBatchSize; /*!< folded commits per batch, 0 if no bulk transaction is active */
+  unsigned int m_bulkMaxDuration;
+  unsigned int m_bulkDepth; /*!< nesting of the folded BeginTransaction() calls */
+  unsigned int m_bulkCommits;
+  unsigned int m_bulkStart;
+  bool m_bulkEnding; /*!< the last batch is being committed, a failure rolls it back */
 };
@@ -14,6 +14,7 @@
 
 #include <cstdio>
 #include <list>
+#include <stdint.h>
 #include <map>
 #include <string>
 #include <vector>
@@ -40,6 +41,28 @@ class Dataset;		// forward declaration of class Dataset
 #define DB_UNEXPECTED		7	// This shouldn't ever happen
 #define DB_UNEXPECTED_RESULT   -1       //For integer functions
 
+/*************** Class PreparedStatement definition ****************
+
+   compiled statement with ? placeholders, kept by the database for
+   repeated execution with different parameters
+
+******************************************************************/
+class PreparedStatement  {
+public:
+  virtual ~PreparedStatement() = default;
+
+/* bind a parameter, index starts with 1 */
+  virtual void bind(int index, int value) = 0;
+  virtual void bind(int index, int64_t value) = 0;
+  virtual void bind(int index, double value) = 0;
+  virtual void bind(int index, const std::string &value) = 0;
+  virtual void bind_null(int index) = 0;
+
+/* executes the statement and clears the parameters, throws DbErrors on failure */
+  virtual void exec() = 0;
+};
+
+
 /******************* Class Database definition ********************
 
    represents  connection with database server;
@@ -130,6 +153,10 @@ public:
   virtual void start_transaction() {};
   virtual void commit_transaction() {};
   virtual void rollback_transaction() {};
+  /*! \brief Commit like commit_transaction(), but report a failed commit.
+   \return true if committed, false if the transaction is still open.
+   */
+  virtual bool try_commit_transaction() { commit_transaction(); return true; };
 
 /* virtual methods for formatting */
 
@@ -149,6 +176,16 @@ public:
 
   virtual bool in_transaction() {return false;};
 
+/* prepared statements */
+
+  /*! \brief Get a compiled statement for a query using ? placeholders.
+   The statement is compiled on first use and owned by the database, which
+   keeps it until disconnect.
+   \param sql - the query, also the key of the statement cache.
+   \return the statement, or NULL if the backend does not support them.
+   */
+  virtual PreparedStatement *prepare_statement(const std::string &sql) { return NULL; }
+
 };
 
 
@@ -292,6 +329,10 @@ public:
   virtual const void* getExecRes()=0;
 /* as open, but with our query exec Sql */
   virtual bool query(const std::string &sql) = 0;
+/* forward-only query: rows are fetched one at a time by next(), only the
+   current row is held. num_rows() is 1 until eof() and seek(), prev() and
+   last() are not available. Backends without cursors run query() instead. */
+  virtual bool query_cursor(const std::string &sql) { return query(sql); }
 /* Close SQL Query*/
   virtual void close();
 /* This function looks for field Field_name with value equal Field_value
@@ -522,6 +522,21 @@ void MysqlDatabase::commit_transaction() {
   }
 }
 
+bool MysqlDatabase::try_commit_transaction() {
+  if (active)
+  {
+    if (mysql_commit(conn) != 0)
+    {
+      CLog::Log(LOGERROR,"Mysql commit transaction failed: %s", mysql_error(conn));
+      return false;
+    }
+    mysql_autocommit(conn, true);
+    CLog::Log(LOGDEBUG,"Mysql commit transaction");
+    _in_transaction = false;
+  }
+  return true;
+}
+
 void MysqlDatabase::rollback_transaction() {
   if (active)
   {
@@ -69,6 +69,7 @@ public:
 
   void start_transaction() override;
   void commit_transaction() override;
+  bool try_commit_transaction() override;
   void rollback_transaction() override;
 
 /* virtual methods for formatting */
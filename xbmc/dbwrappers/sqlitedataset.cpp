@@ -352,6 +352,7 @@ bool SqliteDatabase::exists(void)
 
 void SqliteDatabase::disconnect(void) {
   if (active == false) return;
+  statements.clear();
   sqlite3_close(conn);
   active = false;
 }
@@ -499,6 +500,16 @@ void SqliteDatabase::commit_transaction() {
   }
 }
 
+bool SqliteDatabase::try_commit_transaction() {
+  if (active) {
+    // a busy database keeps the transaction open
+    if (setErr(sqlite3_exec(conn,"commit",NULL,NULL,NULL),"commit") != SQLITE_OK)
+      return false;
+    _in_transaction = false;
+  }
+  return true;
+}
+
 void SqliteDatabase::rollback_transaction() {
   if (active) {
     sqlite3_exec(conn,"rollback",NULL,NULL,NULL);
@@ -573,9 +584,95 @@ std::string SqliteDatabase::vprepare(const char *format, va_list args)
 }
 
 
+// prepared statements
+// ---------------------------------------------
+PreparedStatement *SqliteDatabase::prepare_statement(const std::string &sql)
+{
+  if (!active)
+    throw DbErrors("No Database Connection");
+
+  auto it = statements.find(sql);
+  if (it != statements.end())
+    return it->second.get();
+
+  sqlite3_stmt *stmt = NULL;
+  if (setErr(sqlite3_prepare_v2(conn, sql.c_str(), -1, &stmt, NULL), sql.c_str()) != SQLITE_OK)
+  {
+    sqlite3_finalize(stmt);
+    throw DbErrors("%s", getErrorMsg());
+  }
+
+  SqlitePreparedStatement *statement = new SqlitePreparedStatement(this, stmt, sql);
+  statements[sql].reset(statement);
+  return statement;
+}
+
+
+//************* SqlitePreparedStatement implementation ******
+
+SqlitePreparedStatement::SqlitePreparedStatement(SqliteDatabase *db, sqlite3_stmt *stmt, const std::string &sql)
+  : db(db), stmt(stmt), sql(sql)
+{
+}
+
+SqlitePreparedStatement::~SqlitePreparedStatement()
+{
+  sqlite3_finalize(stmt);
+}
+
+void SqlitePreparedStatement::check(int err)
+{
+  if (err != SQLITE_OK)
+  {
+    db->setErr(err, sql.c_str());
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    throw DbErrors("%s", db->getErrorMsg());
+  }
+}
+
+void SqlitePreparedStatement::bind(int index, int value)
+{
+  check(sqlite3_bind_int(stmt, index, value));
+}
+
+void SqlitePreparedStatement::bind(int index, int64_t value)
+{
+  check(sqlite3_bind_int64(stmt, index, value));
+}
+
+void SqlitePreparedStatement::bind(int index, double value)
+{
+  check(sqlite3_bind_double(stmt, index, value));
+}
+
+void SqlitePreparedStatement::bind(int index, const std::string &value)
+{
+  check(sqlite3_bind_text(stmt, index, value.c_str(), value.size(), SQLITE_TRANSIENT));
+}
+
+void SqlitePreparedStatement::bind_null(int index)
+{
+  check(sqlite3_bind_null(stmt, index));
+}
+
+void SqlitePreparedStatement::exec()
+{
+  int err = sqlite3_step(stmt);
+  while (err == SQLITE_ROW)
+    err = sqlite3_step(stmt);
+  if (err != SQLITE_DONE)
+    check(err);
+
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+}
+
+
 //************* SqliteDataset implementation ***************
 
 SqliteDataset::SqliteDataset():Dataset() {
+  cursor = NULL;
   haveError = false;
   db = NULL;
   errmsg = NULL;
@@ -584,6 +681,7 @@ SqliteDataset::SqliteDataset():Dataset() {
 
 
 SqliteDataset::SqliteDataset(SqliteDatabase *newDb):Dataset(newDb) {
+  cursor = NULL;
   haveError = false;
   db = newDb;
   errmsg = NULL;
@@ -591,6 +689,7 @@ SqliteDataset::SqliteDataset(SqliteDatabase *newDb):Dataset(newDb) {
 }
 
  SqliteDataset::~SqliteDataset(){
+   if (cursor) sqlite3_finalize(cursor);
    if (errmsg) sqlite3_free(errmsg);
  }
 
@@ -775,6 +874,36 @@ const void* SqliteDataset::getExecRes() {
 }
 
 
+static void read_row(sqlite3_stmt *stmt, sql_record &row)
+{
+  const unsigned int numColumns = sqlite3_column_count(stmt);
+  row.resize(numColumns);
+  for (unsigned int i = 0; i < numColumns; i++)
+  {
+    field_value &v = row.at(i);
+    switch (sqlite3_column_type(stmt, i))
+    {
+    case SQLITE_INTEGER:
+      v.set_asInt64(sqlite3_column_int64(stmt, i));
+      break;
+    case SQLITE_FLOAT:
+      v.set_asDouble(sqlite3_column_double(stmt, i));
+      break;
+    case SQLITE_TEXT:
+      v.set_asString((const char *)sqlite3_column_text(stmt, i));
+      break;
+    case SQLITE_BLOB:
+      v.set_asString((const char *)sqlite3_column_text(stmt, i));
+      break;
+    case SQLITE_NULL:
+    default:
+      v.set_asString("");
+      v.set_isNull();
+      break;
+    }
+  }
+}
+
 bool SqliteDataset::query(const std::string &query) {
     if(!handle()) throw DbErrors("No Database Connection");
     std::string qry = query;
@@ -799,31 +928,7 @@ bool SqliteDataset::query(const std::string &query) {
   while (sqlite3_step(stmt) == SQLITE_ROW)
   { // have a row of data
     sql_record *res = new sql_record;
-    res->resize(numColumns);
-    for (unsigned int i = 0; i < numColumns; i++)
-    {
-      field_value &v = res->at(i);
-      switch (sqlite3_column_type(stmt, i))
-      {
-      case SQLITE_INTEGER:
-        v.set_asInt64(sqlite3_column_int64(stmt, i));
-        break;
-      case SQLITE_FLOAT:
-        v.set_asDouble(sqlite3_column_double(stmt, i));
-        break;
-      case SQLITE_TEXT:
-        v.set_asString((const char *)sqlite3_column_text(stmt, i));
-        break;
-      case SQLITE_BLOB:
-        v.set_asString((const char *)sqlite3_column_text(stmt, i));
-        break;
-      case SQLITE_NULL:
-      default:
-        v.set_asString("");
-        v.set_isNull();
-        break;
-      }
-    }
+    read_row(stmt, *res);
     result.records.push_back(res);
   }
   if (db->setErr(sqlite3_finalize(stmt),query.c_str()) == SQLITE_OK)
@@ -839,6 +944,69 @@ bool SqliteDataset::query(const std::string &query) {
   }
 }
 
+bool SqliteDataset::query_cursor(const std::string &query) {
+  if(!handle()) throw DbErrors("No Database Connection");
+  if (query.find("select") == std::string::npos && query.find("SELECT") == std::string::npos)
+    throw DbErrors("MUST be select SQL!");
+
+  close();
+
+  if (db->setErr(sqlite3_prepare_v2(handle(),query.c_str(),-1,&cursor, NULL),query.c_str()) != SQLITE_OK)
+  {
+    cursor = NULL;
+    throw DbErrors("%s", db->getErrorMsg());
+  }
+  sql = query;
+
+  // column headers
+  const unsigned int numColumns = sqlite3_column_count(cursor);
+  result.record_header.resize(numColumns);
+  for (unsigned int i = 0; i < numColumns; i++)
+    result.record_header[i].name = sqlite3_column_name(cursor, i);
+
+  // the single record reused for every row
+  result.records.push_back(new sql_record);
+
+  active = true;
+  ds_state = dsSelect;
+  frecno = 0;
+  fbof = false;
+  feof = !fetch_row();
+  if (!feof)
+    fill_fields();
+  return true;
+}
+
+bool SqliteDataset::fetch_row() {
+  if (!cursor)
+    return false;
+
+  int err = sqlite3_step(cursor);
+  if (err == SQLITE_ROW)
+  {
+    read_row(cursor, *result.records[0]);
+    return true;
+  }
+
+  // done or failed, the row is gone either way
+  delete result.records[0];
+  result.records.clear();
+  if (err != SQLITE_DONE)
+    db->setErr(err, sql.c_str());
+  close_cursor();
+  return false;
+}
+
+void SqliteDataset::close_cursor() {
+  if (!cursor)
+    return;
+
+  int err = sqlite3_finalize(cursor);
+  cursor = NULL;
+  if (db->setErr(err, sql.c_str()) != SQLITE_OK)
+    throw DbErrors("%s", db->getErrorMsg());
+}
+
 void SqliteDataset::open(const std::string &sql) {
   set_select_sql(sql);
   open();
@@ -855,6 +1023,11 @@ void SqliteDataset::open() {
 
 
 void SqliteDataset::close() {
+  if (cursor)
+  {
+    sqlite3_finalize(cursor);
+    cursor = NULL;
+  }
   Dataset::close();
   result.clear();
   edit_object->clear();
@@ -905,6 +1078,14 @@ void SqliteDataset::prev(void) {
 }
 
 void SqliteDataset::next(void) {
+  if (cursor)
+  {
+    fbof = false;
+    feof = !fetch_row();
+    if (!feof)
+      fill_fields();
+    return;
+  }
   Dataset::next();
   if (!eof())
       fill_fields();
@@ -924,7 +1105,7 @@ void SqliteDataset::free_row(void)
 }
 
 bool SqliteDataset::seek(int pos) {
-  if (ds_state == dsSelect) {
+  if (ds_state == dsSelect && !cursor) {
     Dataset::seek(pos);
     fill_fields();
     return true;
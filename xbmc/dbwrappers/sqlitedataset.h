@@ -12,11 +12,40 @@
 
 #pragma once
 
+#include <memory>
 #include <stdio.h>
 #include "dataset.h"
 #include <sqlite3.h>
 
 namespace dbiplus {
+class SqliteDatabase;
+
+/*************** Class SqlitePreparedStatement definition ***********
+
+       class 'SqlitePreparedStatement' wraps a sqlite3_stmt
+
+******************************************************************/
+class SqlitePreparedStatement : public PreparedStatement {
+public:
+  SqlitePreparedStatement(SqliteDatabase *db, sqlite3_stmt *stmt, const std::string &sql);
+  ~SqlitePreparedStatement() override;
+
+  void bind(int index, int value) override;
+  void bind(int index, int64_t value) override;
+  void bind(int index, double value) override;
+  void bind(int index, const std::string &value) override;
+  void bind_null(int index) override;
+
+  void exec() override;
+
+private:
+  void check(int err);
+
+  SqliteDatabase *db;
+  sqlite3_stmt *stmt;
+  std::string sql;
+};
+
 /***************** Class SqliteDatabase definition ******************
 
        class 'SqliteDatabase' connects with Sqlite-server
@@ -28,6 +57,8 @@ protected:
   sqlite3 *conn;
   bool _in_transaction;
   int last_err;
+/* compiled statements, finalized on disconnect */
+  std::map<std::string, std::unique_ptr<SqlitePreparedStatement>> statements;
 
 public:
 /* default constructor */
@@ -73,6 +104,7 @@ public:
 
   void start_transaction() override;
   void commit_transaction() override;
+  bool try_commit_transaction() override;
   void rollback_transaction() override;
 
 /* virtual methods for formatting */
@@ -80,6 +112,9 @@ public:
 
   bool in_transaction() override {return _in_transaction;};
 
+/* prepared statements */
+  PreparedStatement *prepare_statement(const std::string &sql) override;
+
 };
 
 
@@ -111,6 +146,13 @@ protected:
 /* Changing field values during dataset navigation */
   virtual void free_row();  // free the memory allocated for the current row
 
+/* statement of a query_cursor() query, NULL once all rows are read */
+  sqlite3_stmt *cursor;
+/* steps the cursor into the current row, false at the end of the rows */
+  bool fetch_row();
+/* finalizes the cursor, throws on errors of the statement */
+  void close_cursor();
+
 public:
 /* constructor */
   SqliteDataset();
@@ -132,6 +174,8 @@ or insert() operations default = false) */
   const void* getExecRes() override;
 /* as open, but with our query exec Sql */
   bool query(const std::string &query) override;
+/* forward-only query reading one row at a time */
+  bool query_cursor(const std::string &query) override;
 /* func. closes a query */
   void close(void) override;
 /* Cancel changes, made in insert or edit states of dataset */
@@ -0,0 +1,393 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "dbwrappers/Database.h"
+#include "dbwrappers/dataset.h"
+#include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
+#include "music/Album.h"
+#include "music/MusicDatabase.h"
+#include "settings/AdvancedSettings.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+
+#include <string>
+
+#if defined(TARGET_POSIX)
+#include <sys/resource.h>
+#endif
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+/* music like schema: songs linked to artists and genres */
+class CTestIngestDatabase : public CDatabase
+{
+public:
+  using CDatabase::GetPreparedStatement;
+
+  dbiplus::Dataset &GetDataset() { return *m_pDS; }
+
+  int GetSchemaVersion() const override { return 1; }
+  const char *GetBaseDBName() const override { return "TestIngest"; }
+
+  void CreateTables() override
+  {
+    m_pDS->exec("CREATE TABLE artist (idArtist INTEGER PRIMARY KEY, strArtist TEXT)");
+    m_pDS->exec("CREATE TABLE genre (idGenre INTEGER PRIMARY KEY, strGenre TEXT)");
+    m_pDS->exec("CREATE TABLE song (idSong INTEGER PRIMARY KEY, strTitle TEXT, strFileName TEXT, "
+                "strMusicBrainzTrackID TEXT, iTrack INTEGER, iDuration INTEGER, rating FLOAT)");
+    m_pDS->exec("CREATE TABLE song_artist (idArtist INTEGER, idSong INTEGER, strArtist TEXT, iOrder INTEGER)");
+    m_pDS->exec("CREATE TABLE song_genre (idGenre INTEGER, idSong INTEGER, iOrder INTEGER)");
+  }
+
+  void CreateAnalytics() override
+  {
+    m_pDS->exec("CREATE INDEX idxArtist ON artist(strArtist)");
+    m_pDS->exec("CREATE INDEX idxGenre ON genre(strGenre)");
+    m_pDS->exec("CREATE UNIQUE INDEX idxSongArtist ON song_artist (idSong, idArtist)");
+    m_pDS->exec("CREATE UNIQUE INDEX idxSongGenre ON song_genre (idSong, idGenre)");
+  }
+
+  int Count(const std::string &table)
+  {
+    return atoi(GetSingleValue(PrepareSQL("SELECT COUNT(*) FROM %s", table.c_str())).c_str());
+  }
+
+  /* per statement SQL text, the way the scanners used to write */
+  int AddToTableText(const std::string &table, const std::string &value)
+  {
+    std::string strSQL = PrepareSQL("SELECT id%s FROM %s WHERE str%s LIKE '%s'", table.c_str(), table.c_str(), table.c_str(), value.c_str());
+    m_pDS->query(strSQL);
+    if (m_pDS->num_rows() > 0)
+    {
+      int id = m_pDS->fv(0).get_asInt();
+      m_pDS->close();
+      return id;
+    }
+    m_pDS->close();
+    m_pDS->exec(PrepareSQL("INSERT INTO %s (id%s, str%s) VALUES (NULL, '%s')", table.c_str(), table.c_str(), table.c_str(), value.c_str()));
+    return static_cast<int>(m_pDS->lastinsertid());
+  }
+
+  void AddSongText(const std::string &title, const std::string &artist, const std::string &genre, int track)
+  {
+    BeginTransaction();
+    int idArtist = AddToTableText("artist", artist);
+    int idGenre = AddToTableText("genre", genre);
+    m_pDS->exec(PrepareSQL("INSERT INTO song (idSong, strTitle, strFileName, strMusicBrainzTrackID, iTrack, iDuration, rating) "
+                           "VALUES (NULL, '%s', '%s', NULL, %i, %i, %.1f)",
+                           title.c_str(), (title + ".flac").c_str(), track, 180 + track, 2.5f));
+    int idSong = static_cast<int>(m_pDS->lastinsertid());
+    ExecuteQuery(PrepareSQL("REPLACE INTO song_artist (idArtist, idSong, strArtist, iOrder) VALUES(%i,%i,'%s',%i)",
+                            idArtist, idSong, artist.c_str(), 0));
+    ExecuteQuery(PrepareSQL("INSERT INTO song_genre (idGenre, idSong, iOrder) VALUES(%i,%i,%i)", idGenre, idSong, 0));
+    CommitTransaction();
+  }
+};
+
+class TestDatabase : public ::testing::Test
+{
+protected:
+  DatabaseSettings settings;
+  CTestIngestDatabase database;
+
+  void SetUp() override
+  {
+    XFILE::CFile::Delete("special://temp/TestIngest.db");
+
+    settings.type = "sqlite3";
+    settings.name = "TestIngest";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    ASSERT_TRUE(database.Connect("TestIngest", settings, true));
+  }
+
+  void TearDown() override
+  {
+    database.Close();
+    XFILE::CFile::Delete("special://temp/TestIngest.db");
+  }
+
+  /* songs of ~1 artist per 4 albums of 10 songs and 30 genres, in one bulk transaction */
+  void Fill(unsigned int songs)
+  {
+    database.BeginBulkTransaction(100, 1000000);
+    for (unsigned int i = 0; i < songs; i++)
+      database.AddSongText(StringUtils::Format("Song %u 'live'", i), StringUtils::Format("Artist %u", i / 40),
+                           StringUtils::Format("Genre %u", i % 30), i % 10 + 1);
+    database.CommitBulkTransaction();
+  }
+
+  /* reads all songs, returns the summed durations so the rows are used */
+  int64_t ReadSongs(bool cursor)
+  {
+    dbiplus::Dataset &ds = database.GetDataset();
+    const std::string sql = "SELECT song.*, song_artist.strArtist FROM song JOIN song_artist ON song_artist.idSong = song.idSong";
+    int64_t sum = 0;
+    if (cursor)
+    {
+      ds.query_cursor(sql);
+      for (; !ds.eof(); ds.next())
+        sum += ds.get_sql_record()->at(5).get_asInt64();
+    }
+    else
+    {
+      ds.query(sql);
+      for (const auto &record : ds.get_result_set().records)
+        sum += record->at(5).get_asInt64();
+    }
+    ds.close();
+    return sum;
+  }
+
+  /* growth of the peak resident set size in kB, 0 where it is not available */
+  static long PeakRSS()
+  {
+#if defined(TARGET_POSIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+      return usage.ru_maxrss;
+#endif
+    return 0;
+  }
+
+  void CompareReads(unsigned int songs)
+  {
+    Fill(songs);
+
+    /* the cursor runs first as the peak only ever grows */
+    long rss = PeakRSS();
+    int64_t start = CurrentHostCounter();
+    int64_t sumCursor = ReadSongs(true);
+    double cursorSeconds = static_cast<double>(CurrentHostCounter() - start) / CurrentHostFrequency();
+    long cursorRSS = PeakRSS() - rss;
+
+    rss = PeakRSS();
+    start = CurrentHostCounter();
+    int64_t sumQuery = ReadSongs(false);
+    double querySeconds = static_cast<double>(CurrentHostCounter() - start) / CurrentHostFrequency();
+    long queryRSS = PeakRSS() - rss;
+
+    EXPECT_EQ(sumQuery, sumCursor);
+    RecordProperty("query_ms", StringUtils::Format("%.1f", querySeconds * 1000));
+    RecordProperty("cursor_ms", StringUtils::Format("%.1f", cursorSeconds * 1000));
+    RecordProperty("query_peak_rss_kb", StringUtils::Format("%ld", queryRSS));
+    RecordProperty("cursor_peak_rss_kb", StringUtils::Format("%ld", cursorRSS));
+  }
+};
+
+} // namespace
+
+TEST_F(TestDatabase, PreparedStatementBindsValues)
+{
+  dbiplus::PreparedStatement *stmt = database.GetPreparedStatement("INSERT INTO song (idSong, strTitle, strFileName, strMusicBrainzTrackID, iTrack, iDuration, rating) "
+                                                                   "VALUES (NULL, ?, ?, ?, ?, ?, ?)");
+  ASSERT_NE(nullptr, stmt);
+  EXPECT_EQ(stmt, database.GetPreparedStatement("INSERT INTO song (idSong, strTitle, strFileName, strMusicBrainzTrackID, iTrack, iDuration, rating) "
+                                                "VALUES (NULL, ?, ?, ?, ?, ?, ?)"));
+
+  stmt->bind(1, std::string("Don't Stop"));
+  stmt->bind(2, std::string("a.mp3"));
+  stmt->bind_null(3);
+  stmt->bind(4, 3);
+  stmt->bind(5, static_cast<int64_t>(1) << 40);
+  stmt->bind(6, 7.5);
+  stmt->exec();
+
+  EXPECT_EQ("Don't Stop", database.GetSingleValue("song", "strTitle", "iTrack = 3"));
+  EXPECT_EQ("1", database.GetSingleValue("SELECT COUNT(*) FROM song WHERE strMusicBrainzTrackID IS NULL"));
+  EXPECT_EQ("1099511627776", database.GetSingleValue("song", "iDuration", "iTrack = 3"));
+  EXPECT_EQ(7.5, atof(database.GetSingleValue("song", "rating", "iTrack = 3").c_str()));
+
+  /* constraint errors throw and leave the statement reusable */
+  stmt = database.GetPreparedStatement("INSERT INTO song (idSong, strTitle) VALUES (?, ?)");
+  stmt->bind(1, 1);
+  stmt->bind(2, std::string("duplicate"));
+  EXPECT_THROW(stmt->exec(), dbiplus::DbErrors);
+  stmt->bind(1, 2);
+  stmt->bind(2, std::string("second"));
+  stmt->exec();
+  EXPECT_EQ(2, database.Count("song"));
+}
+
+TEST_F(TestDatabase, BulkTransactionBatchesCommits)
+{
+  EXPECT_TRUE(database.BeginBulkTransaction(3, 1000000));
+  EXPECT_TRUE(database.InBulkTransaction());
+  EXPECT_FALSE(database.BeginBulkTransaction(3, 1000000));
+
+  for (int i = 0; i < 7; i++)
+    database.AddSongText(StringUtils::Format("Song %i", i), "Artist", "Genre", i);
+
+  /* a failing write only undoes itself, not the earlier writes of the open batch */
+  database.BeginTransaction();
+  database.BeginTransaction();
+  database.ExecuteQuery("INSERT INTO genre (idGenre, strGenre) VALUES (NULL, 'Rolled back')");
+  database.RollbackTransaction();
+  EXPECT_TRUE(database.CommitTransaction());
+  EXPECT_TRUE(database.InBulkTransaction());
+  EXPECT_EQ(7, database.Count("song"));
+  EXPECT_EQ(1, database.Count("genre"));
+
+  database.AddSongText("Song 7", "Artist", "Genre", 7);
+  EXPECT_TRUE(database.CommitBulkTransaction());
+  EXPECT_FALSE(database.InBulkTransaction());
+  EXPECT_EQ(8, database.Count("song"));
+  EXPECT_EQ(1, database.Count("artist"));
+}
+
+TEST_F(TestDatabase, CursorReadsTypedRows)
+{
+  database.AddSongText("First", "Artist", "Genre", 1);
+  database.AddSongText("Second", "Artist", "Genre", 2);
+
+  dbiplus::Dataset &ds = database.GetDataset();
+  ASSERT_TRUE(ds.query_cursor("SELECT idSong, strTitle, strMusicBrainzTrackID, iDuration, rating FROM song ORDER BY idSong"));
+  ASSERT_FALSE(ds.eof());
+  const dbiplus::sql_record *record = ds.get_sql_record();
+  EXPECT_EQ(dbiplus::ft_Int64, record->at(0).get_fType());
+  EXPECT_EQ("First", record->at(1).get_asString());
+  EXPECT_TRUE(record->at(2).get_isNull());
+  EXPECT_EQ(181, ds.fv("iDuration").get_asInt());
+  EXPECT_EQ(2.5, ds.fv("song.rating").get_asDouble());
+
+  ds.next();
+  ASSERT_FALSE(ds.eof());
+  EXPECT_EQ("Second", ds.fv("strTitle").get_asString());
+  ds.next();
+  EXPECT_TRUE(ds.eof());
+  EXPECT_EQ(0, ds.num_rows());
+  ds.close();
+
+  /* no rows and closing part way through */
+  ASSERT_TRUE(ds.query_cursor("SELECT * FROM song WHERE idSong < 0"));
+  EXPECT_TRUE(ds.eof());
+  ds.close();
+  ASSERT_TRUE(ds.query_cursor("SELECT * FROM song"));
+  ds.close();
+  EXPECT_EQ(2, database.Count("song"));
+}
+
+TEST_F(TestDatabase, CursorRead)
+{
+  CompareReads(20000);
+}
+
+/* the 100k song library, run with --gtest_also_run_disabled_tests */
+TEST_F(TestDatabase, DISABLED_CursorRead100k)
+{
+  CompareReads(100000);
+}
+
+namespace
+{
+
+/* the writes of the music scanner: CMusicDatabase::AddAlbum() with and without bulk transaction */
+class TestMusicDatabaseIngest : public ::testing::Test
+{
+protected:
+  DatabaseSettings settings;
+  CMusicDatabase database;
+
+  void SetUp() override
+  {
+    XFILE::CFile::Delete("special://temp/TestMusicIngest.db");
+
+    settings.type = "sqlite3";
+    settings.name = "TestMusicIngest";
+    settings.host = CSpecialProtocol::TranslatePath("special://temp/");
+    ASSERT_TRUE(database.Connect("TestMusicIngest", settings, true));
+  }
+
+  void TearDown() override
+  {
+    database.Close();
+    XFILE::CFile::Delete("special://temp/TestMusicIngest.db");
+  }
+
+  int Count(const std::string &table)
+  {
+    return atoi(database.GetSingleValue("SELECT COUNT(*) FROM " + table).c_str());
+  }
+
+  /* a synthetic album of 10 songs, ~1 artist per 4 albums, 30 genres */
+  static CAlbum MakeAlbum(unsigned int index)
+  {
+    CAlbum album;
+    album.strAlbum = StringUtils::Format("Album %u 'live'", index);
+    album.strPath = StringUtils::Format("/music/Album %u/", index);
+    album.artistCredits.push_back(CArtistCredit(StringUtils::Format("Artist %u", index / 4)));
+    album.genre.push_back(StringUtils::Format("Genre %u", index % 30));
+    for (unsigned int track = 1; track <= 10; track++)
+    {
+      CSong song;
+      song.strTitle = StringUtils::Format("Song %u of %u", track, index);
+      song.strFileName = album.strPath + StringUtils::Format("%02u.flac", track);
+      song.iTrack = track;
+      song.iDuration = 180 + track;
+      song.genre = album.genre;
+      song.artistCredits = album.artistCredits;
+      album.songs.push_back(song);
+    }
+    return album;
+  }
+
+  double Ingest(unsigned int songs, bool bulk)
+  {
+    int64_t start = CurrentHostCounter();
+    if (bulk)
+      database.BeginBulkTransaction(100, 1000000);
+    for (unsigned int index = 0; index < songs / 10; index++)
+    {
+      CAlbum album = MakeAlbum(index);
+      database.AddAlbum(album, -1);
+    }
+    if (bulk)
+      database.CommitBulkTransaction();
+    double seconds = static_cast<double>(CurrentHostCounter() - start) / CurrentHostFrequency();
+    return seconds > 0 ? songs / seconds : 0;
+  }
+
+  void Benchmark(unsigned int songs)
+  {
+    double albums = Ingest(songs, false);
+    ASSERT_EQ(static_cast<int>(songs), Count("song"));
+    const int artists = Count("artist");
+    const int songArtists = Count("song_artist");
+    const int songGenres = Count("song_genre");
+
+    database.Close();
+    XFILE::CFile::Delete("special://temp/TestMusicIngest.db");
+    ASSERT_TRUE(database.Connect("TestMusicIngest", settings, true));
+
+    /* the bulk transaction writes the same rows */
+    double bulk = Ingest(songs, true);
+    EXPECT_EQ(static_cast<int>(songs), Count("song"));
+    EXPECT_EQ(artists, Count("artist"));
+    EXPECT_EQ(songArtists, Count("song_artist"));
+    EXPECT_EQ(songGenres, Count("song_genre"));
+
+    RecordProperty("album_transactions_songs_per_second", StringUtils::Format("%.0f", albums));
+    RecordProperty("bulk_transaction_songs_per_second", StringUtils::Format("%.0f", bulk));
+  }
+};
+
+} // namespace
+
+TEST_F(TestMusicDatabaseIngest, Ingest)
+{
+  Benchmark(2000);
+}
+
+/* the 100k song library, run with --gtest_also_run_disabled_tests */
+TEST_F(TestMusicDatabaseIngest, DISABLED_Ingest100k)
+{
+  Benchmark(100000);
+}
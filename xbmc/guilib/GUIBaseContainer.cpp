@@ -60,7 +60,10 @@ CGUIBaseContainer::~CGUIBaseContainer(void)
 {
   // release the container from items
   for (auto item : m_items)
-    item->FreeMemory();
+  {
+    if (item)
+      item->FreeMemory();
+  }
 
   delete m_listProvider;
 }
@@ -100,7 +103,7 @@ void CGUIBaseContainer::Process(unsigned int currentTime, CDirtyRegionList &dirt
   GetCacheOffsets(cacheBefore, cacheAfter);
 
   // Free memory not used on screen
-  if ((int)m_items.size() > m_itemsPerPage + cacheBefore + cacheAfter)
+  if (IsVirtual() || (int)m_items.size() > m_itemsPerPage + cacheBefore + cacheAfter)
     FreeMemory(CorrectOffset(offset - cacheBefore, 0), CorrectOffset(offset + m_itemsPerPage + 1 + cacheAfter, 0));
 
   CPoint origin = CPoint(m_posX, m_posY) + m_renderOffset;
@@ -122,7 +125,7 @@ void CGUIBaseContainer::Process(unsigned int currentTime, CDirtyRegionList &dirt
     if (itemNo >= (int)m_items.size())
       break;
     bool focused = (current == GetOffset() + GetCursor());
-    if (itemNo >= 0)
+    if (itemNo >= 0 && m_items[itemNo])
     {
       CGUIListItemPtr item = m_items[itemNo];
       // render our item
@@ -229,7 +232,7 @@ void CGUIBaseContainer::Render()
       if (itemNo >= (int)m_items.size())
         break;
       bool focused = (current == GetOffset() + GetCursor());
-      if (itemNo >= 0)
+      if (itemNo >= 0 && m_items[itemNo])
       {
         CGUIListItemPtr item = m_items[itemNo];
         // render our item
@@ -356,7 +359,7 @@ bool CGUIBaseContainer::OnAction(const CAction &action)
       int selected = GetSelectedItem();
       if (selected >= 0 && selected < static_cast<int>(m_items.size()))
       {
-        m_listProvider->OnInfo(m_items[selected]);
+        m_listProvider->OnInfo(GetItem(selected));
         return true;
       }
     }
@@ -457,7 +460,10 @@ bool CGUIBaseContainer::OnMessage(CGUIMessage& message)
     else if (message.GetMessage() == GUI_MSG_REFRESH_LIST)
     { // update our list contents
       for (unsigned int i = 0; i < m_items.size(); ++i)
-        m_items[i]->SetInvalid();
+      {
+        if (m_items[i])
+          m_items[i]->SetInvalid();
+      }
     }
     else if (message.GetMessage() == GUI_MSG_MOVE_OFFSET)
     {
@@ -667,12 +673,12 @@ CGUIListItemPtr CGUIBaseContainer::GetListItem(int offset, unsigned int flag) co
   {
     item %= ((int)m_items.size());
     if (item < 0) item += m_items.size();
-    return m_items[item];
+    return GetItem(item);
   }
   else
   {
     if (item >= 0 && item < (int)m_items.size())
-      return m_items[item];
+      return GetItem(item);
   }
   return CGUIListItemPtr();
 }
@@ -764,9 +770,9 @@ bool CGUIBaseContainer::OnClick(int actionID)
       if (selected >= 0 && selected < static_cast<int>(m_items.size()))
       {
         if (m_clickActions.HasActionsMeetingCondition())
-          m_clickActions.ExecuteActions(0, GetParentID(), m_items[selected]);
+          m_clickActions.ExecuteActions(0, GetParentID(), GetItem(selected));
         else
-          m_listProvider->OnClick(m_items[selected]);
+          m_listProvider->OnClick(GetItem(selected));
       }
       return true;
     }
@@ -792,7 +798,7 @@ bool CGUIBaseContainer::OnContextMenu()
     int selected = GetSelectedItem();
     if (selected >= 0 && selected < static_cast<int>(m_items.size()))
     {
-      m_listProvider->OnContextMenu(m_items[selected]);
+      m_listProvider->OnContextMenu(GetItem(selected));
       return true;
     }
   }
@@ -805,7 +811,9 @@ std::string CGUIBaseContainer::GetDescription() const
   int item = GetSelectedItem();
   if (item >= 0 && item < (int)m_items.size())
   {
-    CGUIListItemPtr pItem = m_items[item];
+    CGUIListItemPtr pItem = GetItem(item);
+    if (!pItem)
+      return strLabel;
     if (pItem->m_bIsFolder)
       strLabel = StringUtils::Format("[%s]", pItem->GetLabel().c_str());
     else
@@ -875,7 +883,10 @@ void CGUIBaseContainer::UpdateLayout(bool updateAllItems)
   if (updateAllItems)
   { // free memory of items
     for (iItems it = m_items.begin(); it != m_items.end(); ++it)
-      (*it)->FreeMemory();
+    {
+      if (*it)
+        (*it)->FreeMemory();
+    }
   }
   // and recalculate the layout
   CalculateLayout();
@@ -937,13 +948,28 @@ void CGUIBaseContainer::UpdateListProvider(bool forceRefresh /* = false */)
       const std::string prevSelectedPath((current && current->IsFileItem()) ? static_cast<CFileItem *>(current)->GetPath() : "");
 
       Reset();
-      m_listProvider->Fetch(m_items);
+      if (m_listProvider->IsVirtual())
+        m_items.resize(m_listProvider->GetItemCount()); // the items are created once they come into view
+      else
+        m_listProvider->Fetch(m_items);
       SetPageControlRange();
       // update the newly selected item
       bool found = false;
 
+      // the items of a virtual list are all recreated and not created yet, ask the provider for the position of the selected path.
+      if (IsVirtual() && !prevSelectedPath.empty())
+      {
+        const int index = m_listProvider->GetIndexOfPath(prevSelectedPath);
+        if (index >= 0)
+        {
+          found = true;
+          if (index != currentItem)
+            SelectItem(index);
+        }
+      }
+
       // first, try to re-identify selected item by comparing item pointers, though it is not guaranteed that item instances got not recreated on update.
-      for (int i = 0; i < (int)m_items.size(); i++)
+      for (int i = 0; !IsVirtual() && i < (int)m_items.size(); i++)
       {
         if (m_items[i].get() == current)
         {
@@ -955,7 +981,7 @@ void CGUIBaseContainer::UpdateListProvider(bool forceRefresh /* = false */)
           }
         }
       }
-      if (!found && !prevSelectedPath.empty())
+      if (!found && !prevSelectedPath.empty() && !IsVirtual())
       {
         // as fallback, try to re-identify selected item by comparing item paths.
         for (int i = 0; i < static_cast<int>(m_items.size()); i++)
@@ -1009,6 +1035,10 @@ void CGUIBaseContainer::UpdateScrollByLetter()
 {
   m_letterOffsets.clear();
 
+  // the items of a virtual list are not all created, it is not scrolled by letter
+  if (IsVirtual())
+    return;
+
   // for scrolling by letter we have an offset table into our vector.
   std::string currentMatch;
   for (unsigned int i = 0; i < m_items.size(); i++)
@@ -1140,6 +1170,7 @@ void CGUIBaseContainer::Reset()
 {
   m_wasReset = true;
   m_items.clear();
+  m_virtualItems.clear();
   m_lastItem.reset();
   ResetAutoScrolling();
 }
@@ -1186,6 +1217,12 @@ void CGUIBaseContainer::SetRenderOffset(const CPoint &offset)
 
 void CGUIBaseContainer::FreeMemory(int keepStart, int keepEnd)
 {
+  if (IsVirtual())
+  {
+    UpdateVirtualItems(keepStart, keepEnd);
+    return;
+  }
+
   if (keepStart < keepEnd)
   { // remove before keepStart and after keepEnd
     for (int i = 0; i < keepStart && i < (int)m_items.size(); ++i)
@@ -1200,6 +1237,74 @@ void CGUIBaseContainer::FreeMemory(int keepStart, int keepEnd)
   }
 }
 
+bool CGUIBaseContainer::IsVirtual() const
+{
+  return m_listProvider && m_listProvider->IsVirtual();
+}
+
+CGUIListItemPtr CGUIBaseContainer::GetItem(int index) const
+{
+  if (!m_items[index] && IsVirtual())
+    return m_listProvider->GetItem(index);
+  return m_items[index];
+}
+
+void CGUIBaseContainer::UpdateVirtualItems(int keepStart, int keepEnd)
+{
+  // extra items of a wrapping list are copies, they are not created by the provider
+  const int count = std::min(m_listProvider->GetItemCount(), static_cast<int>(m_items.size()));
+  if (!count)
+    return;
+
+  if (static_cast<int>(m_items.size()) > count)
+  { // every item is shown
+    keepStart = 0;
+    keepEnd = count - 1;
+  }
+  keepStart = std::min(std::max(keepStart, 0), count - 1);
+  keepEnd = std::min(std::max(keepEnd, 0), count - 1);
+  auto isKept = [keepStart, keepEnd](int i)
+  {
+    return (keepStart <= keepEnd) ? (i >= keepStart && i <= keepEnd) : (i >= keepStart || i <= keepEnd);
+  };
+
+  // free the items that left the range, only the created ones are visited
+  bool changed = false;
+  std::vector<int> created;
+  created.reserve(m_virtualItems.size());
+  for (int i : m_virtualItems)
+  {
+    if (i < count && isKept(i))
+      created.push_back(i);
+    else if (i < count && m_items[i])
+    {
+      m_items[i]->FreeMemory();
+      m_items[i].reset();
+      changed = true;
+    }
+  }
+
+  // and create those that entered it, a wrapping range continues at the start of the list
+  const int end = (keepStart <= keepEnd) ? keepEnd : keepEnd + count;
+  for (int j = keepStart; j <= end; ++j)
+  {
+    const int i = j % count;
+    if (!m_items[i])
+    {
+      m_items[i] = m_listProvider->GetItem(i);
+      if (m_items[i])
+      {
+        created.push_back(i);
+        changed = true;
+      }
+    }
+  }
+  m_virtualItems.swap(created);
+
+  if (changed)
+    m_listProvider->Prefetch(keepStart, keepEnd);
+}
+
 bool CGUIBaseContainer::InsideLayout(const CGUIListItemLayout *layout, const CPoint &point) const
 {
   if (!layout) return false;
@@ -1216,6 +1321,7 @@ void CGUIBaseContainer::DumpTextureUse()
   for (unsigned int i = 0; i < m_items.size(); ++i)
   {
     CGUIListItemPtr item = m_items[i];
+    if (!item) continue;
     if (item->GetFocusedLayout()) item->GetFocusedLayout()->DumpTextureUse();
     if (item->GetLayout()) item->GetLayout()->DumpTextureUse();
   }
@@ -1237,7 +1343,7 @@ bool CGUIBaseContainer::GetCondition(int condition, int data) const
   case CONTAINER_HAS_PREVIOUS:
     return (HasPreviousPage());
   case CONTAINER_HAS_PARENT_ITEM:
-    return (m_items.size() && m_items[0]->IsFileItem() && (std::static_pointer_cast<CFileItem>(m_items[0]))->IsParentFolder());
+    return (m_items.size() && m_items[0] && m_items[0]->IsFileItem() && (std::static_pointer_cast<CFileItem>(m_items[0]))->IsParentFolder());
   case CONTAINER_SUBITEM:
     {
       CGUIListItemLayout *layout = GetFocusedLayout();
@@ -1305,7 +1411,7 @@ std::string CGUIBaseContainer::GetLabel(int info) const
     break;
   case CONTAINER_CURRENT_ITEM:
     {
-      if (m_items.size() && m_items[0]->IsFileItem() && (std::static_pointer_cast<CFileItem>(m_items[0]))->IsParentFolder())
+      if (m_items.size() && m_items[0] && m_items[0]->IsFileItem() && (std::static_pointer_cast<CFileItem>(m_items[0]))->IsParentFolder())
         label = StringUtils::Format("%i", GetSelectedItem());
       else
         label = StringUtils::Format("%i", GetSelectedItem() + 1);
@@ -1315,7 +1421,7 @@ std::string CGUIBaseContainer::GetLabel(int info) const
   case CONTAINER_NUM_ITEMS:
     {
       unsigned int numItems = GetNumItems();
-      if (info == CONTAINER_NUM_ITEMS && numItems && m_items[0]->IsFileItem() && (std::static_pointer_cast<CFileItem>(m_items[0]))->IsParentFolder())
+      if (info == CONTAINER_NUM_ITEMS && numItems && m_items[0] && m_items[0]->IsFileItem() && (std::static_pointer_cast<CFileItem>(m_items[0]))->IsParentFolder())
         label = StringUtils::Format("%u", numItems-1);
       else
         label = StringUtils::Format("%u", numItems);
@@ -1324,9 +1430,10 @@ std::string CGUIBaseContainer::GetLabel(int info) const
   case CONTAINER_NUM_NONFOLDER_ITEMS:
     {
       int numItems = 0;
-      for (auto item : m_items)
+      for (int i = 0; i < static_cast<int>(m_items.size()); ++i)
       {
-        if (!item->m_bIsFolder)
+        CGUIListItemPtr item = GetItem(i);
+        if (item && !item->m_bIsFolder)
           numItems++;
       }
       label = StringUtils::Format("%u", numItems);
@@ -127,6 +127,23 @@ protected:
   int ScrollCorrectionRange() const;
   inline float Size() const;
   void FreeMemory(int keepStart, int keepEnd);
+
+  /*! \brief Whether the items come from a virtual list provider.
+   The items of a virtual list are only created around the visible ones, the other entries of
+   m_items are empty.
+   \sa IListProvider::IsVirtual
+   */
+  bool IsVirtual() const;
+
+  /*! \brief The item at an index, an item of a virtual list that was not created yet is created
+   but not kept.
+   */
+  CGUIListItemPtr GetItem(int index) const;
+
+  /*! \brief Create the items of a virtual list that are kept and free the others.
+   \sa FreeMemory
+   */
+  void UpdateVirtualItems(int keepStart, int keepEnd);
   void GetCurrentLayouts();
   CGUIListItemLayout *GetFocusedLayout() const;
 
@@ -175,6 +192,7 @@ protected:
   void OnJumpLetter(char letter, bool skip = false);
   void OnJumpSMS(int letter);
   std::vector< std::pair<int, std::string> > m_letterOffsets;
+  std::vector<int> m_virtualItems; ///< indices of the created items of a virtual list
 
   /*! \brief Set the cursor position
    Should be used by all base classes rather than directly setting it, as
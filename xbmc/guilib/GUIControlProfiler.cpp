@@ -7,6 +7,9 @@
  */
 
 #include "GUIControlProfiler.h"
+#include "GUIComponent.h"
+#include "ServiceBroker.h"
+#include "TextureManager.h"
 #include "utils/XBMCTinyXML.h"
 #include "utils/TimeUtils.h"
 #include "utils/StringUtils.h"
@@ -237,6 +240,10 @@ bool CGUIControlProfiler::IsRunning(void)
 void CGUIControlProfiler::Start(void)
 {
   m_iFrameCount = 0;
+  m_iDrawCalls = 0;
+  m_iVertices = 0;
+  m_iFontCacheHits = 0;
+  m_iFontCacheMisses = 0;
   m_bIsRunning = true;
   m_pLastItem = NULL;
   m_ItemHead.Reset(this);
@@ -266,6 +273,21 @@ void CGUIControlProfiler::EndRender(CGUIControl *pControl)
   item->EndRender();
 }
 
+void CGUIControlProfiler::AddDrawCall(unsigned int vertices)
+{
+  // batched quads are drawn after their control finished rendering, so draw calls are only counted per frame
+  m_iDrawCalls++;
+  m_iVertices += vertices;
+}
+
+void CGUIControlProfiler::AddFontCacheLookup(bool hit)
+{
+  if (hit)
+    m_iFontCacheHits++;
+  else
+    m_iFontCacheMisses++;
+}
+
 CGUIControlProfilerItem *CGUIControlProfiler::FindOrAddControl(CGUIControl *pControl)
 {
   if (m_pLastItem)
@@ -326,6 +348,26 @@ bool CGUIControlProfiler::SaveResults(void)
   std::string str = StringUtils::Format("%d", m_iFrameCount);
   root->SetAttribute("framecount", str.c_str());
   root->SetAttribute("timeunit", "ms");
+  if (m_iDrawCalls && m_iFrameCount)
+  {
+    str = StringUtils::Format("%u", m_iDrawCalls / m_iFrameCount);
+    root->SetAttribute("drawcalls", str.c_str());
+    str = StringUtils::Format("%u", m_iVertices / m_iFrameCount);
+    root->SetAttribute("vertices", str.c_str());
+  }
+  if ((m_iFontCacheHits || m_iFontCacheMisses) && m_iFrameCount)
+  {
+    str = StringUtils::Format("%u", m_iFontCacheHits / m_iFrameCount);
+    root->SetAttribute("fontcachehits", str.c_str());
+    str = StringUtils::Format("%u", m_iFontCacheMisses / m_iFrameCount);
+    root->SetAttribute("fontcachemisses", str.c_str());
+  }
+
+  const CGUITextureManager& textureManager = CServiceBroker::GetGUI()->GetTextureManager();
+  str = StringUtils::Format("%u", textureManager.GetMemoryUsage() / 1024);
+  root->SetAttribute("texturememory", str.c_str());
+  str = StringUtils::Format("%.0f", textureManager.GetLoadTime());
+  root->SetAttribute("textureloadtime", str.c_str());
   doc.LinkEndChild(root);
 
   m_ItemHead.SaveToXML(root);
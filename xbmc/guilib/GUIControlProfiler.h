@@ -57,6 +57,8 @@ public:
   void EndVisibility(CGUIControl *pControl);
   void BeginRender(CGUIControl *pControl);
   void EndRender(CGUIControl *pControl);
+  void AddDrawCall(unsigned int vertices);
+  void AddFontCacheLookup(bool hit);
   int GetMaxFrameCount(void) const { return m_iMaxFrameCount; };
   void SetMaxFrameCount(int iMaxFrameCount) { m_iMaxFrameCount = iMaxFrameCount; };
   void SetOutputFile(const std::string &strOutputFile) { m_strOutputFile = strOutputFile; };
@@ -79,6 +81,10 @@ private:
   std::string m_strOutputFile;
   int m_iMaxFrameCount = 200;
   int m_iFrameCount = 0;
+  unsigned int m_iDrawCalls = 0;
+  unsigned int m_iVertices = 0;
+  unsigned int m_iFontCacheHits = 0;
+  unsigned int m_iFontCacheMisses = 0;
 };
 
 #define GUIPROFILER_VISIBILITY_BEGIN(x) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().BeginVisibility(x); }
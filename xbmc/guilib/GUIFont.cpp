@@ -77,8 +77,20 @@ std::string& CGUIFont::GetFontName()
   return m_strFontName;
 }
 
+uint64_t CGUIFont::GetTextHash(const vecText &text)
+{
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (character_t ch : text)
+  {
+    hash ^= ch;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
 void CGUIFont::DrawText( float x, float y, const std::vector<UTILS::Color> &colors, UTILS::Color shadowColor,
-                const vecText &text, uint32_t alignment, float maxPixelWidth)
+                const vecText &text, uint32_t alignment, float maxPixelWidth, uint64_t textHash)
 {
   if (!m_font) return;
 
@@ -91,15 +103,17 @@ void CGUIFont::DrawText( float x, float y, const std::vector<UTILS::Color> &colo
   for (unsigned int i = 0; i < colors.size(); i++)
     renderColors.push_back(CServiceBroker::GetWinSystem()->GetGfxContext().MergeAlpha(colors[i] ? colors[i] : m_textColor));
   if (!shadowColor) shadowColor = m_shadowColor;
+  if (!textHash)
+    textHash = GetTextHash(text);
   if (shadowColor)
   {
     shadowColor = CServiceBroker::GetWinSystem()->GetGfxContext().MergeAlpha(shadowColor);
     std::vector<UTILS::Color> shadowColors;
     for (unsigned int i = 0; i < renderColors.size(); i++)
       shadowColors.push_back((renderColors[i] & 0xff000000) != 0 ? shadowColor : 0);
-    m_font->DrawTextInternal(x + 1, y + 1, shadowColors, text, alignment, maxPixelWidth, false);
+    m_font->DrawTextInternal(x + 1, y + 1, shadowColors, text, alignment, maxPixelWidth, false, textHash);
   }
-  m_font->DrawTextInternal( x, y, renderColors, text, alignment, maxPixelWidth, false);
+  m_font->DrawTextInternal( x, y, renderColors, text, alignment, maxPixelWidth, false, textHash);
 
   if (clip)
     CServiceBroker::GetWinSystem()->GetGfxContext().RestoreClipRegion();
@@ -152,7 +166,8 @@ bool CGUIFont::UpdateScrollInfo(const vecText &text, CScrollInfo &scrollInfo)
 }
 
 void CGUIFont::DrawScrollingText(float x, float y, const std::vector<UTILS::Color> &colors, UTILS::Color shadowColor,
-                const vecText &text, uint32_t alignment, float maxWidth, const CScrollInfo &scrollInfo)
+                const vecText &text, uint32_t alignment, float maxWidth, const CScrollInfo &scrollInfo,
+                uint64_t textHash)
 {
   if (!m_font) return;
   if (!shadowColor) shadowColor = m_shadowColor;
@@ -183,6 +198,10 @@ void CGUIFont::DrawScrollingText(float x, float y, const std::vector<UTILS::Colo
   for (unsigned int i = 0; i < colors.size(); i++)
     renderColors.push_back(CServiceBroker::GetWinSystem()->GetGfxContext().MergeAlpha(colors[i] ? colors[i] : m_textColor));
 
+  if (!textHash)
+    textHash = GetTextHash(text);
+  const uint64_t suffixHash = GetTextHash(scrollInfo.suffix);
+
   bool scroll =  !scrollInfo.waitTime && scrollInfo.pixelSpeed;
   if (shadowColor)
   {
@@ -192,14 +211,14 @@ void CGUIFont::DrawScrollingText(float x, float y, const std::vector<UTILS::Colo
       shadowColors.push_back((renderColors[i] & 0xff000000) != 0 ? shadowColor : 0);
     for (float dx = -offset; dx < maxWidth; dx += scrollInfo.m_totalWidth)
     {
-      m_font->DrawTextInternal(x + dx + 1, y + 1, shadowColors, text, alignment, textPixelWidth, scroll);
-      m_font->DrawTextInternal(x + dx + scrollInfo.m_textWidth + 1, y + 1, shadowColors, scrollInfo.suffix, alignment, suffixPixelWidth, scroll);
+      m_font->DrawTextInternal(x + dx + 1, y + 1, shadowColors, text, alignment, textPixelWidth, scroll, textHash);
+      m_font->DrawTextInternal(x + dx + scrollInfo.m_textWidth + 1, y + 1, shadowColors, scrollInfo.suffix, alignment, suffixPixelWidth, scroll, suffixHash);
     }
   }
   for (float dx = -offset; dx < maxWidth; dx += scrollInfo.m_totalWidth)
   {
-    m_font->DrawTextInternal(x + dx, y, renderColors, text, alignment, textPixelWidth, scroll);
-    m_font->DrawTextInternal(x + dx + scrollInfo.m_textWidth, y, renderColors, scrollInfo.suffix, alignment, suffixPixelWidth, scroll);
+    m_font->DrawTextInternal(x + dx, y, renderColors, text, alignment, textPixelWidth, scroll, textHash);
+    m_font->DrawTextInternal(x + dx + scrollInfo.m_textWidth, y, renderColors, scrollInfo.suffix, alignment, suffixPixelWidth, scroll, suffixHash);
   }
 
   CServiceBroker::GetWinSystem()->GetGfxContext().RestoreClipRegion();
@@ -110,19 +110,28 @@ public:
 
   std::string& GetFontName();
 
+  /*! \brief Hash of a text for the vertex caches of the fonts.
+   Callers drawing the same text every frame keep it and pass it to DrawText(), so the text
+   is not hashed again for every lookup.
+   */
+  static uint64_t GetTextHash(const vecText &text);
+
   void DrawText( float x, float y, UTILS::Color color, UTILS::Color shadowColor,
-                 const vecText &text, uint32_t alignment, float maxPixelWidth)
+                 const vecText &text, uint32_t alignment, float maxPixelWidth, uint64_t textHash = 0)
   {
     std::vector<UTILS::Color> colors;
     colors.push_back(color);
-    DrawText(x, y, colors, shadowColor, text, alignment, maxPixelWidth);
+    DrawText(x, y, colors, shadowColor, text, alignment, maxPixelWidth, textHash);
   };
 
+  /*! \param textHash GetTextHash() of the text, 0 to have it computed.
+   */
   void DrawText( float x, float y, const std::vector<UTILS::Color> &colors, UTILS::Color shadowColor,
-                 const vecText &text, uint32_t alignment, float maxPixelWidth);
+                 const vecText &text, uint32_t alignment, float maxPixelWidth, uint64_t textHash = 0);
 
   void DrawScrollingText( float x, float y, const std::vector<UTILS::Color> &colors, UTILS::Color shadowColor,
-                 const vecText &text, uint32_t alignment, float maxPixelWidth, const CScrollInfo &scrollInfo);
+                 const vecText &text, uint32_t alignment, float maxPixelWidth, const CScrollInfo &scrollInfo,
+                 uint64_t textHash = 0);
 
   bool UpdateScrollInfo(const vecText &text, CScrollInfo &scrollInfo);
 
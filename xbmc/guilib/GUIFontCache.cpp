@@ -6,6 +6,9 @@
  *  See LICENSES/README.md for more information.
  */
 
+#include <iterator>
+#include <list>
+#include <map>
 #include <stdint.h>
 #include <vector>
 #include "GUIFontTTF.h"
@@ -16,59 +19,65 @@ class CGUIFontCacheImpl
 {
   struct EntryList
   {
-    using HashMap = std::multimap<size_t, CGUIFontCacheEntry<Position, Value>*>;
+    // least recently used first, hits move their entry to the back without allocating
+    using AgeList = std::list<CGUIFontCacheEntry<Position, Value>*>;
+    using AgeIter = typename AgeList::iterator;
+    using HashMap = std::multimap<uint64_t, AgeIter>;
     using HashIter = typename HashMap::iterator;
-    using AgeMap = std::multimap<size_t, HashIter>;
 
     ~EntryList()
     {
       Flush();
     }
-    HashIter Insert(size_t hash, CGUIFontCacheEntry<Position, Value> *v)
+    void Insert(uint64_t hash, CGUIFontCacheEntry<Position, Value> *v)
     {
-      auto r (hashMap.insert(typename HashMap::value_type(hash, v)));
-      if (r->second)
-        ageMap.insert(typename AgeMap::value_type(r->second->m_lastUsedMillis, r));
-      return r;
+      ageList.push_back(v);
+      hashMap.insert(typename HashMap::value_type(hash, std::prev(ageList.end())));
     }
     void Flush()
     {
-      ageMap.clear();
-      for (auto it = hashMap.begin(); it != hashMap.end(); ++it)
-        delete(it->second);
       hashMap.clear();
+      for (auto it = ageList.begin(); it != ageList.end(); ++it)
+        delete(*it);
+      ageList.clear();
     }
-    typename HashMap::iterator FindKey(CGUIFontCacheKey<Position> key)
+    HashIter FindKey(const CGUIFontCacheKey<Position> &key, uint64_t hash)
     {
-      CGUIFontCacheHash<Position> hashGen;
       CGUIFontCacheKeysMatch<Position> keyMatch;
-      auto range = hashMap.equal_range(hashGen(key));
+      auto range = hashMap.equal_range(hash);
       for (auto ret = range.first; ret != range.second; ++ret)
       {
-        if (keyMatch(ret->second->m_key, key))
+        if (keyMatch((*ret->second)->m_key, key))
         {
           return ret;
         }
       }
       return hashMap.end();
     }
-    void UpdateAge(HashIter it, size_t millis)
+    void UpdateAge(HashIter it, unsigned int millis)
     {
-      auto range = ageMap.equal_range(it->second->m_lastUsedMillis);
-      for (auto ageit = range.first; ageit != range.second; ++ageit)
+      (*it->second)->m_lastUsedMillis = millis;
+      ageList.splice(ageList.end(), ageList, it->second);
+    }
+    // take the least recently used entry out of the cache
+    CGUIFontCacheEntry<Position, Value> *Remove()
+    {
+      CGUIFontCacheEntry<Position, Value> *entry = ageList.front();
+      auto range = hashMap.equal_range(BucketHash(entry->m_key));
+      for (auto it = range.first; it != range.second; ++it)
       {
-        if (ageit->second == it)
+        if (it->second == ageList.begin())
         {
-          ageMap.erase(ageit);
-          ageMap.insert(typename AgeMap::value_type(millis, it));
-          it->second->m_lastUsedMillis = millis;
-          return;
+          hashMap.erase(it);
+          break;
         }
       }
+      ageList.pop_front();
+      return entry;
     }
 
     HashMap hashMap;
-    AgeMap ageMap;
+    AgeList ageList;
   };
 
   EntryList m_list;
@@ -78,7 +87,7 @@ public:
 
   explicit CGUIFontCacheImpl(CGUIFontCache<Position, Value>* parent) : m_parent(parent) {}
   Value &Lookup(Position &pos,
-                const std::vector<UTILS::Color> &colors, const vecText &text,
+                const std::vector<UTILS::Color> &colors, uint64_t textHash,
                 uint32_t alignment, float maxPixelWidth,
                 bool scrolling,
                 unsigned int nowMillis, bool &dirtyCache);
@@ -88,23 +97,13 @@ public:
 template<class Position, class Value>
 CGUIFontCacheEntry<Position, Value>::~CGUIFontCacheEntry()
 {
-  delete &m_key.m_colors;
-  delete &m_key.m_text;
   m_value.clear();
 }
 
 template<class Position, class Value>
 void CGUIFontCacheEntry<Position, Value>::Assign(const CGUIFontCacheKey<Position> &key, unsigned int nowMillis)
 {
-  m_key.m_pos = key.m_pos;
-  m_key.m_colors.assign(key.m_colors.begin(), key.m_colors.end());
-  m_key.m_text.assign(key.m_text.begin(), key.m_text.end());
-  m_key.m_alignment = key.m_alignment;
-  m_key.m_maxPixelWidth = key.m_maxPixelWidth;
-  m_key.m_scrolling = key.m_scrolling;
-  m_matrix = key.m_matrix;
-  m_key.m_scaleX = key.m_scaleX;
-  m_key.m_scaleY = key.m_scaleY;
+  m_key = key;
   m_lastUsedMillis = nowMillis;
   m_value.clear();
 }
@@ -124,7 +123,7 @@ CGUIFontCache<Position, Value>::~CGUIFontCache()
 
 template<class Position, class Value>
 Value &CGUIFontCache<Position, Value>::Lookup(Position &pos,
-                                              const std::vector<UTILS::Color> &colors, const vecText &text,
+                                              const std::vector<UTILS::Color> &colors, uint64_t textHash,
                                               uint32_t alignment, float maxPixelWidth,
                                               bool scrolling,
                                               unsigned int nowMillis, bool &dirtyCache)
@@ -132,55 +131,51 @@ Value &CGUIFontCache<Position, Value>::Lookup(Position &pos,
   if (m_impl == nullptr)
     m_impl = new CGUIFontCacheImpl<Position, Value>(this);
 
-  return m_impl->Lookup(pos, colors, text, alignment, maxPixelWidth, scrolling, nowMillis, dirtyCache);
+  return m_impl->Lookup(pos, colors, textHash, alignment, maxPixelWidth, scrolling, nowMillis, dirtyCache);
 }
 
 template<class Position, class Value>
 Value &CGUIFontCacheImpl<Position, Value>::Lookup(Position &pos,
-                                                  const std::vector<UTILS::Color> &colors, const vecText &text,
+                                                  const std::vector<UTILS::Color> &colors, uint64_t textHash,
                                                   uint32_t alignment, float maxPixelWidth,
                                                   bool scrolling,
                                                   unsigned int nowMillis, bool &dirtyCache)
 {
-  const CGUIFontCacheKey<Position> key(pos,
-                                       const_cast<std::vector<UTILS::Color> &>(colors), const_cast<vecText &>(text),
+  const CGUIFontCacheKey<Position> key(pos, CGUIFontCacheHash::Get(textHash, colors),
                                        alignment, maxPixelWidth,
                                        scrolling, CServiceBroker::GetWinSystem()->GetGfxContext().GetGUIMatrix(),
                                        CServiceBroker::GetWinSystem()->GetGfxContext().GetGUIScaleX(), CServiceBroker::GetWinSystem()->GetGfxContext().GetGUIScaleY());
+  const uint64_t hash = BucketHash(key);
 
-  auto i = m_list.FindKey(key);
+  auto i = m_list.FindKey(key, hash);
   if (i == m_list.hashMap.end())
   {
     // Cache miss
     dirtyCache = true;
     CGUIFontCacheEntry<Position, Value> *entry = nullptr;
-    if (!m_list.ageMap.empty() && (nowMillis - m_list.ageMap.begin()->first) > FONT_CACHE_TIME_LIMIT)
-    {
-      entry = m_list.ageMap.begin()->second->second;
-      m_list.hashMap.erase(m_list.ageMap.begin()->second);
-      m_list.ageMap.erase(m_list.ageMap.begin());
-    }
+    if (!m_list.ageList.empty() && (nowMillis - m_list.ageList.front()->m_lastUsedMillis) > FONT_CACHE_TIME_LIMIT)
+      entry = m_list.Remove();
 
     // add new entry
-    CGUIFontCacheHash<Position> hashgen;
     if (!entry)
       entry = new CGUIFontCacheEntry<Position, Value>(*m_parent, key, nowMillis);
     else
       entry->Assign(key, nowMillis);
-    return m_list.Insert(hashgen(key), entry)->second->m_value;
+    m_list.Insert(hash, entry);
+    return entry->m_value;
   }
   else
   {
     // Cache hit
     // Update the translation arguments so that they hold the offset to apply
     // to the cached values (but only in the dynamic case)
-    pos.UpdateWithOffsets(i->second->m_key.m_pos, scrolling);
+    pos.UpdateWithOffsets((*i->second)->m_key.m_pos, scrolling);
 
     // Update time in entry and move to the back of the list
     m_list.UpdateAge(i, nowMillis);
 
     dirtyCache = false;
-    return i->second->m_value;
+    return (*i->second)->m_value;
   }
 }
 
@@ -199,13 +194,13 @@ void CGUIFontCacheImpl<Position, Value>::Flush()
 template CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::CGUIFontCache(CGUIFontTTFBase &font);
 template CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::~CGUIFontCache();
 template CGUIFontCacheEntry<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::~CGUIFontCacheEntry();
-template CGUIFontCacheStaticValue &CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::Lookup(CGUIFontCacheStaticPosition &, const std::vector<UTILS::Color> &, const vecText &, uint32_t, float, bool, unsigned int, bool &);
+template CGUIFontCacheStaticValue &CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::Lookup(CGUIFontCacheStaticPosition &, const std::vector<UTILS::Color> &, uint64_t, uint32_t, float, bool, unsigned int, bool &);
 template void CGUIFontCache<CGUIFontCacheStaticPosition, CGUIFontCacheStaticValue>::Flush();
 
 template CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::CGUIFontCache(CGUIFontTTFBase &font);
 template CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::~CGUIFontCache();
 template CGUIFontCacheEntry<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::~CGUIFontCacheEntry();
-template CGUIFontCacheDynamicValue &CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::Lookup(CGUIFontCacheDynamicPosition &, const std::vector<UTILS::Color> &, const vecText &, uint32_t, float, bool, unsigned int, bool &);
+template CGUIFontCacheDynamicValue &CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::Lookup(CGUIFontCacheDynamicPosition &, const std::vector<UTILS::Color> &, uint64_t, uint32_t, float, bool, unsigned int, bool &);
 template void CGUIFontCache<CGUIFontCacheDynamicPosition, CGUIFontCacheDynamicValue>::Flush();
 
 void CVertexBuffer::clear()
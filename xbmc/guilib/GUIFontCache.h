@@ -38,22 +38,19 @@ template<class Position>
 struct CGUIFontCacheKey
 {
   Position m_pos;
-  std::vector<UTILS::Color> &m_colors;
-  vecText &m_text;
+  uint64_t m_hash;              ///< hash of the text and its colors
   uint32_t m_alignment;
   float m_maxPixelWidth;
   bool m_scrolling;
-  const TransformMatrix &m_matrix;
+  TransformMatrix m_matrix;
   float m_scaleX;
   float m_scaleY;
 
-  CGUIFontCacheKey(Position pos,
-                   std::vector<UTILS::Color> &colors, vecText &text,
+  CGUIFontCacheKey(Position pos, uint64_t hash,
                    uint32_t alignment, float maxPixelWidth,
                    bool scrolling, const TransformMatrix &matrix,
                    float scaleX, float scaleY) :
-    m_pos(pos),
-    m_colors(colors), m_text(text),
+    m_pos(pos), m_hash(hash),
     m_alignment(alignment), m_maxPixelWidth(maxPixelWidth),
     m_scrolling(scrolling), m_matrix(matrix),
     m_scaleX(scaleX), m_scaleY(scaleY)
@@ -65,22 +62,14 @@ struct CGUIFontCacheEntry
 {
   const CGUIFontCache<Position, Value> &m_cache;
   CGUIFontCacheKey<Position> m_key;
-  TransformMatrix m_matrix;
   unsigned int m_lastUsedMillis;
   Value m_value;
 
   CGUIFontCacheEntry(const CGUIFontCache<Position, Value> &cache, const CGUIFontCacheKey<Position> &key, unsigned int nowMillis) :
     m_cache(cache),
-    m_key(key.m_pos,
-          *new std::vector<UTILS::Color>, *new vecText,
-          key.m_alignment, key.m_maxPixelWidth,
-          key.m_scrolling, m_matrix,
-          key.m_scaleX, key.m_scaleY),
+    m_key(key),
     m_lastUsedMillis(nowMillis)
   {
-    m_key.m_colors.assign(key.m_colors.begin(), key.m_colors.end());
-    m_key.m_text.assign(key.m_text.begin(), key.m_text.end());
-    m_matrix = key.m_matrix;
   }
 
   ~CGUIFontCacheEntry();
@@ -88,18 +77,30 @@ struct CGUIFontCacheEntry
   void Assign(const CGUIFontCacheKey<Position> &key, unsigned int nowMillis);
 };
 
-template<class Position>
 struct CGUIFontCacheHash
 {
-  size_t operator()(const CGUIFontCacheKey<Position> &key) const
+  /*! \brief Mix a value into a hash.
+   */
+  static uint64_t Combine(uint64_t hash, uint64_t value)
+  {
+    return hash ^ (value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
+  }
+
+  static uint64_t Combine(uint64_t hash, float value)
   {
-    /* Not much effort has gone into choosing this hash function */
-    size_t hash = 0, i;
-    for (i = 0; i < 3 && i < key.m_text.size(); ++i)
-      hash += key.m_text[i];
-    if (key.m_colors.size())
-      hash += key.m_colors[0];
-    hash += static_cast<size_t>(MatrixHashContribution(key)); // horrible
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return Combine(hash, static_cast<uint64_t>(bits));
+  }
+
+  /*! \brief The hash of a text drawn with the given colors.
+   \param textHash the hash of the text, see CGUIFont::GetTextHash().
+   */
+  static uint64_t Get(uint64_t textHash, const std::vector<UTILS::Color> &colors)
+  {
+    uint64_t hash = textHash;
+    for (UTILS::Color color : colors)
+      hash = Combine(hash, static_cast<uint64_t>(color));
     return hash;
   }
 };
@@ -109,8 +110,7 @@ struct CGUIFontCacheKeysMatch
 {
   bool operator()(const CGUIFontCacheKey<Position> &a, const CGUIFontCacheKey<Position> &b) const
   {
-    return a.m_text == b.m_text &&
-           a.m_colors == b.m_colors &&
+    return a.m_hash == b.m_hash &&
            a.m_alignment == b.m_alignment &&
            a.m_scrolling == b.m_scrolling &&
            a.m_maxPixelWidth == b.m_maxPixelWidth &&
@@ -136,8 +136,14 @@ public:
 
   ~CGUIFontCache();
 
+  /*! \brief Find the cached vertices of a text, or add an entry for them.
+   \param pos [in/out] the position of the text, for dynamic entries updated to the offset from the cached one.
+   \param colors the colors of the text.
+   \param textHash the hash of the text, see CGUIFont::GetTextHash().
+   \param dirtyCache [out] true if a new entry was added, its value has to be filled in.
+   */
   Value &Lookup(Position &pos,
-                const std::vector<UTILS::Color> &colors, const vecText &text,
+                const std::vector<UTILS::Color> &colors, uint64_t textHash,
                 uint32_t alignment, float maxPixelWidth,
                 bool scrolling,
                 unsigned int nowMillis, bool &dirtyCache);
@@ -152,13 +158,9 @@ struct CGUIFontCacheStaticPosition
   void UpdateWithOffsets(const CGUIFontCacheStaticPosition &cached, bool scrolling) {}
 };
 
-struct CGUIFontCacheStaticValue : public std::shared_ptr<std::vector<SVertex> >
+// entries are reused once they expired, clear() keeps the storage of their vertices
+struct CGUIFontCacheStaticValue : public std::vector<SVertex>
 {
-  void clear()
-  {
-    if (*this)
-      (*this)->clear();
-  }
 };
 
 inline bool Match(const CGUIFontCacheStaticPosition &a, const TransformMatrix &a_m,
@@ -168,10 +170,13 @@ inline bool Match(const CGUIFontCacheStaticPosition &a, const TransformMatrix &a
   return a.m_x == b.m_x && a.m_y == b.m_y && a_m == b_m;
 }
 
-inline float MatrixHashContribution(const CGUIFontCacheKey<CGUIFontCacheStaticPosition> &a)
+inline uint64_t BucketHash(const CGUIFontCacheKey<CGUIFontCacheStaticPosition> &a)
 {
-  /* Ensure horizontally translated versions end up in different buckets */
-  return a.m_matrix.m[0][3];
+  /* Ensure translated versions end up in different buckets */
+  uint64_t hash = CGUIFontCacheHash::Combine(a.m_hash, a.m_pos.m_x);
+  hash = CGUIFontCacheHash::Combine(hash, a.m_pos.m_y);
+  hash = CGUIFontCacheHash::Combine(hash, a.m_matrix.m[0][3]);
+  return CGUIFontCacheHash::Combine(hash, a.m_matrix.m[1][3]);
 }
 
 struct CGUIFontCacheDynamicPosition
@@ -245,8 +250,9 @@ inline bool Match(const CGUIFontCacheDynamicPosition &a, const TransformMatrix &
           // We already know the first 3 columns of both matrices are diagonal, so no need to check the other elements
 }
 
-inline float MatrixHashContribution(const CGUIFontCacheKey<CGUIFontCacheDynamicPosition> &a)
+inline uint64_t BucketHash(const CGUIFontCacheKey<CGUIFontCacheDynamicPosition> &a)
 {
-  return 0;
+  /* Positions only match approximately, so they can't be part of the hash */
+  return a.m_hash;
 }
 
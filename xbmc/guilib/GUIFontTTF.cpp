@@ -9,6 +9,7 @@
 #include "GUIFont.h"
 #include "GUIFontTTF.h"
 #include "GUIFontManager.h"
+#include "GUIControlProfiler.h"
 #include "Texture.h"
 #include "windowing/GraphicContext.h"
 #include "ServiceBroker.h"
@@ -20,7 +21,10 @@
 #include "URL.h"
 #include "filesystem/File.h"
 #include "threads/SystemClock.h"
+#include "utils/TimeUtils.h"
+#include "utils/TraceRecorder.h"
 
+#include <algorithm>
 #include <math.h>
 #include <memory>
 #include <queue>
@@ -199,6 +203,7 @@ void CGUIFontTTFBase::ClearCharacterCache()
   memset(m_charquick, 0, sizeof(m_charquick));
   m_numChars = 0;
   m_maxChars = CHAR_CHUNK;
+  m_rowStamps.clear();
   // set the posX and posY so that our texture will be created on first character write.
   m_posX = m_textureWidth;
   m_posY = -(int)GetTextureLineHeight();
@@ -214,6 +219,7 @@ void CGUIFontTTFBase::Clear()
   m_char = NULL;
   m_maxChars = 0;
   m_numChars = 0;
+  m_rowStamps.clear();
   m_posX = 0;
   m_posY = 0;
   m_nestedBeginCount = 0;
@@ -297,6 +303,7 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
 
   m_maxChars = 0;
   m_numChars = 0;
+  m_rowStamps.clear();
 
   m_strFilename = strFilename;
 
@@ -342,7 +349,7 @@ void CGUIFontTTFBase::End()
   LastEnd();
 }
 
-void CGUIFontTTFBase::DrawTextInternal(float x, float y, const std::vector<UTILS::Color> &colors, const vecText &text, uint32_t alignment, float maxPixelWidth, bool scrolling)
+void CGUIFontTTFBase::DrawTextInternal(float x, float y, const std::vector<UTILS::Color> &colors, const vecText &text, uint32_t alignment, float maxPixelWidth, bool scrolling, uint64_t textHash)
 {
   if (text.empty())
   {
@@ -351,6 +358,9 @@ void CGUIFontTTFBase::DrawTextInternal(float x, float y, const std::vector<UTILS
 
   Begin();
 
+  // the characters of this text must stay in the texture while it is drawn
+  m_drawStamp++;
+
   uint32_t rawAlignment = alignment;
   bool dirtyCache(false);
   bool hardwareClipping = m_renderSystem->ScissorsCanEffectClipping();
@@ -365,23 +375,28 @@ void CGUIFontTTFBase::DrawTextInternal(float x, float y, const std::vector<UTILS
   CVertexBuffer unusedVertexBuffer;
   CVertexBuffer &vertexBuffer = hardwareClipping ?
       m_dynamicCache.Lookup(dynamicPos,
-                            colors, text,
+                            colors, textHash,
                             alignment, maxPixelWidth,
                             scrolling,
                             XbmcThreads::SystemClockMillis(),
                             dirtyCache) :
       unusedVertexBuffer;
-  std::shared_ptr<std::vector<SVertex> > tempVertices = std::make_shared<std::vector<SVertex> >();
-  std::shared_ptr<std::vector<SVertex> > &vertices = hardwareClipping ?
-      tempVertices :
-      static_cast<std::shared_ptr<std::vector<SVertex> >&>(m_staticCache.Lookup(staticPos,
-                           colors, text,
+  CGUIFontCacheStaticValue unusedVertices;
+  const CGUIFontCacheStaticValue &vertices = hardwareClipping ?
+      unusedVertices :
+      m_staticCache.Lookup(staticPos,
+                           colors, textHash,
                            alignment, maxPixelWidth,
                            scrolling,
                            XbmcThreads::SystemClockMillis(),
-                           dirtyCache));
+                           dirtyCache);
+  if (CGUIControlProfiler::IsRunning())
+    CGUIControlProfiler::Instance().AddFontCacheLookup(!dirtyCache);
+
   if (dirtyCache)
   {
+    CTraceScope trace("CGUIFontTTFBase::DrawTextInternal uncached");
+
     // save the origin, which is scaled separately
     m_originX = x;
     m_originY = y;
@@ -462,6 +477,8 @@ void CGUIFontTTFBase::DrawTextInternal(float x, float y, const std::vector<UTILS
     }
     cursorX = 0;
 
+    std::vector<SVertex> &tempVertices = m_newVertices;
+    tempVertices.clear();
     for (vecText::const_iterator pos = text.begin(); pos != text.end(); ++pos)
     {
       // If starting text on a new line, determine justification effects
@@ -492,7 +509,7 @@ void CGUIFontTTFBase::DrawTextInternal(float x, float y, const std::vector<UTILS
 
           for (int i = 0; i < 3; i++)
           {
-            RenderCharacter(startX + cursorX, startY, period, color, !scrolling, *tempVertices);
+            RenderCharacter(startX + cursorX, startY, period, color, !scrolling, tempVertices);
             cursorX += period->advance;
           }
           break;
@@ -501,7 +518,7 @@ void CGUIFontTTFBase::DrawTextInternal(float x, float y, const std::vector<UTILS
       else if (maxPixelWidth > 0 && cursorX > maxPixelWidth)
         break;  // exceeded max allowed width - stop rendering
 
-      RenderCharacter(startX + cursorX, startY, ch, color, !scrolling, *tempVertices);
+      RenderCharacter(startX + cursorX, startY, ch, color, !scrolling, tempVertices);
       if ( alignment & XBFONT_JUSTIFIED )
       {
         if ((*pos & 0xffff) == L' ')
@@ -516,25 +533,26 @@ void CGUIFontTTFBase::DrawTextInternal(float x, float y, const std::vector<UTILS
     if (hardwareClipping)
     {
       CVertexBuffer &vertexBuffer = m_dynamicCache.Lookup(dynamicPos,
-                                                          colors, text,
+                                                          colors, textHash,
                                                           rawAlignment, maxPixelWidth,
                                                           scrolling,
                                                           XbmcThreads::SystemClockMillis(),
                                                           dirtyCache);
-      CVertexBuffer newVertexBuffer = CreateVertexBuffer(*tempVertices);
+      CVertexBuffer newVertexBuffer = CreateVertexBuffer(tempVertices);
       vertexBuffer = newVertexBuffer;
       m_vertexTrans.push_back(CTranslatedVertices(0, 0, 0, &vertexBuffer, CServiceBroker::GetWinSystem()->GetGfxContext().GetClipRegion()));
     }
     else
     {
+      /* Copy into the storage of the entry, a reused entry keeps its capacity */
       m_staticCache.Lookup(staticPos,
-                           colors, text,
+                           colors, textHash,
                            rawAlignment, maxPixelWidth,
                            scrolling,
                            XbmcThreads::SystemClockMillis(),
-                           dirtyCache) = *static_cast<CGUIFontCacheStaticValue *>(&tempVertices);
+                           dirtyCache).assign(tempVertices.begin(), tempVertices.end());
       /* Append the new vertices to the set collected since the first Begin() call */
-      m_vertex.insert(m_vertex.end(), tempVertices->begin(), tempVertices->end());
+      m_vertex.insert(m_vertex.end(), tempVertices.begin(), tempVertices.end());
     }
   }
   else
@@ -543,7 +561,7 @@ void CGUIFontTTFBase::DrawTextInternal(float x, float y, const std::vector<UTILS
       m_vertexTrans.push_back(CTranslatedVertices(dynamicPos.m_x, dynamicPos.m_y, dynamicPos.m_z, &vertexBuffer, CServiceBroker::GetWinSystem()->GetGfxContext().GetClipRegion()));
     else
       /* Append the vertices from the cache to the set collected since the first Begin() call */
-      m_vertex.insert(m_vertex.end(), vertices->begin(), vertices->end());
+      m_vertex.insert(m_vertex.end(), vertices.begin(), vertices.end());
   }
 
   End();
@@ -610,25 +628,52 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
   {
     character_t ch = (style << 8) | letter;
     if (ch < LOOKUPTABLE_SIZE && m_charquick[ch])
+    {
+      if (m_charquick[ch]->row != NO_TEXTURE_ROW)
+        m_rowStamps[m_charquick[ch]->row] = m_drawStamp;
       return m_charquick[ch];
+    }
   }
 
   // letters are stored based on style and letter
   character_t ch = (style << 16) | letter;
 
-  int low = 0;
-  int high = m_numChars - 1;
-  while (low <= high)
+  Character *pos = std::lower_bound(m_char, m_char + m_numChars, ch,
+                                    [](const Character &c, character_t letterAndStyle) { return c.letterAndStyle < letterAndStyle; });
+  if (pos != m_char + m_numChars && pos->letterAndStyle == ch)
   {
-    int mid = (low + high) >> 1;
-    if (ch > m_char[mid].letterAndStyle)
-      low = mid + 1;
-    else if (ch < m_char[mid].letterAndStyle)
-      high = mid - 1;
-    else
-      return &m_char[mid];
+    if (pos->row != NO_TEXTURE_ROW)
+      m_rowStamps[pos->row] = m_drawStamp;
+    return pos;
+  }
+
+  // render the character to our texture
+  // must End() as we can't render text to our texture during a Begin(), End() block
+  unsigned int nestedBeginCount = m_nestedBeginCount;
+  m_nestedBeginCount = 1;
+  if (nestedBeginCount) End();
+  Character character;
+  int64_t start = CurrentHostCounter();
+  if (!CacheCharacter(letter, style, &character))
+  { // unable to cache character - try clearing them all out and starting over
+    CLog::Log(LOGDEBUG, "%s: Unable to cache character.  Clearing character cache of %i characters", __FUNCTION__, m_numChars);
+    ClearCharacterCache();
+    if (!CacheCharacter(letter, style, &character))
+    {
+      CLog::Log(LOGERROR, "%s: Unable to cache character (out of memory?)", __FUNCTION__);
+      if (nestedBeginCount) Begin();
+      m_nestedBeginCount = nestedBeginCount;
+      return NULL;
+    }
   }
-  // if we get to here, then low is where we should insert the new character
+  m_rasterTime += CurrentHostCounter() - start;
+  m_rasterisedChars++;
+  if (nestedBeginCount) Begin();
+  m_nestedBeginCount = nestedBeginCount;
+
+  // find where to insert the new character, caching it may have dropped others
+  int low = std::lower_bound(m_char, m_char + m_numChars, ch,
+                             [](const Character &c, character_t letterAndStyle) { return c.letterAndStyle < letterAndStyle; }) - m_char;
 
   // increase the size of the buffer if we need it
   if (m_numChars >= m_maxChars)
@@ -648,26 +693,8 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
   { // just move the data along as necessary
     memmove(m_char + low + 1, m_char + low, (m_numChars - low) * sizeof(Character));
   }
-  // render the character to our texture
-  // must End() as we can't render text to our texture during a Begin(), End() block
-  unsigned int nestedBeginCount = m_nestedBeginCount;
-  m_nestedBeginCount = 1;
-  if (nestedBeginCount) End();
-  if (!CacheCharacter(letter, style, m_char + low))
-  { // unable to cache character - try clearing them all out and starting over
-    CLog::Log(LOGDEBUG, "%s: Unable to cache character.  Clearing character cache of %i characters", __FUNCTION__, m_numChars);
-    ClearCharacterCache();
-    low = 0;
-    if (!CacheCharacter(letter, style, m_char + low))
-    {
-      CLog::Log(LOGERROR, "%s: Unable to cache character (out of memory?)", __FUNCTION__);
-      if (nestedBeginCount) Begin();
-      m_nestedBeginCount = nestedBeginCount;
-      return NULL;
-    }
-  }
-  if (nestedBeginCount) Begin();
-  m_nestedBeginCount = nestedBeginCount;
+  m_char[low] = character;
+  m_numChars++;
 
   // fixup quick access
   memset(m_charquick, 0, sizeof(m_charquick));
@@ -728,34 +755,15 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
     // check we have enough room for the character.
     // cast-fest is here to avoid warnings due to freeetype version differences (signedness of width).
     if (static_cast<int>(m_posX + bitGlyph->left + bitmap.width) > static_cast<int>(m_textureWidth))
-    { // no space - gotta drop to the next line (which means creating a new texture and copying it across)
+    { // no space - gotta drop to the next line
+      if (!NextTextureRow())
+      {
+        FT_Done_Glyph(glyph);
+        return false;
+      }
       m_posX = 0;
-      m_posY += GetTextureLineHeight();
       if (bitGlyph->left < 0)
         m_posX += -bitGlyph->left;
-
-      if(m_posY + GetTextureLineHeight() >= m_textureHeight)
-      {
-        // create the new larger texture
-        unsigned int newHeight = m_posY + GetTextureLineHeight();
-        // check for max height
-        if (newHeight > m_renderSystem->GetMaxTextureSize())
-        {
-          CLog::Log(LOGDEBUG, "%s: New cache texture is too large (%u > %u pixels long)", __FUNCTION__, newHeight, m_renderSystem->GetMaxTextureSize());
-          FT_Done_Glyph(glyph);
-          return false;
-        }
-
-        CBaseTexture* newTexture = NULL;
-        newTexture = ReallocTexture(newHeight);
-        if(newTexture == NULL)
-        {
-          FT_Done_Glyph(glyph);
-          CLog::Log(LOGDEBUG, "%s: Failed to allocate new texture of height %u", __FUNCTION__, newHeight);
-          return false;
-        }
-        m_texture = newTexture;
-      }
     }
 
     if(m_texture == NULL)
@@ -774,6 +782,7 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
   ch->right = ch->left + bitmap.width;
   ch->bottom = ch->top + bitmap.rows;
   ch->advance = (float)MathUtils::round_int( (float)m_face->glyph->advance.x / 64 );
+  ch->row = isEmptyGlyph ? NO_TEXTURE_ROW : m_posY / GetTextureLineHeight();
 
   // we need only render if we actually have some pixels
   if (!isEmptyGlyph)
@@ -784,10 +793,10 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
     unsigned int x2 = std::min(x1 + bitmap.width, m_textureWidth);
     unsigned int y2 = std::min(y1 + bitmap.rows, m_textureHeight);
     CopyCharToTexture(bitGlyph, x1, y1, x2, y2);
+    m_rowStamps[ch->row] = m_drawStamp;
 
     m_posX += spacing_between_characters_in_texture + (unsigned short)std::max(ch->right - ch->left + ch->offsetX, ch->advance);
   }
-  m_numChars++;
 
   // free the glyph
   FT_Done_Glyph(glyph);
@@ -795,6 +804,75 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
   return true;
 }
 
+bool CGUIFontTTFBase::NextTextureRow()
+{
+  const unsigned int lineHeight = GetTextureLineHeight();
+  const unsigned int posY = m_rowStamps.size() * lineHeight;
+  if (posY + lineHeight > m_textureHeight)
+  {
+    // create the new larger texture
+    unsigned int newHeight = posY + lineHeight;
+    // once at the max height, replace the characters not drawn for the longest time
+    if (newHeight > m_renderSystem->GetMaxTextureSize())
+      return EvictTextureRow();
+
+    CBaseTexture* newTexture = ReallocTexture(newHeight);
+    if (newTexture == NULL)
+    {
+      CLog::Log(LOGDEBUG, "%s: Failed to allocate new texture of height %u", __FUNCTION__, newHeight);
+      return false;
+    }
+    m_texture = newTexture;
+    LogCacheUsage("grown");
+  }
+
+  m_posY = posY;
+  m_rowStamps.push_back(m_drawStamp);
+  return true;
+}
+
+bool CGUIFontTTFBase::EvictTextureRow()
+{
+  std::vector<uint64_t>::const_iterator oldest = std::min_element(m_rowStamps.begin(), m_rowStamps.end());
+  // every row holds characters of the text being drawn
+  if (oldest == m_rowStamps.end() || *oldest == m_drawStamp)
+    return false;
+
+  const unsigned int row = oldest - m_rowStamps.begin();
+  m_numChars = std::remove_if(m_char, m_char + m_numChars, [row](const Character &c) { return c.row == row; }) - m_char;
+  // GetCharacter() rebuilds the quick access table
+  memset(m_charquick, 0, sizeof(m_charquick));
+
+  // cached text may refer to the old characters
+  m_staticCache.Flush();
+  m_dynamicCache.Flush();
+
+  // clear the row, filtering must not pick up the old characters around the new ones
+  const unsigned int lineHeight = GetTextureLineHeight();
+  std::vector<unsigned char> blank(m_textureWidth * lineHeight);
+  FT_BitmapGlyphRec blankGlyph = {};
+  blankGlyph.bitmap.buffer = blank.data();
+  blankGlyph.bitmap.width = m_textureWidth;
+  blankGlyph.bitmap.pitch = m_textureWidth;
+  blankGlyph.bitmap.rows = lineHeight;
+  CopyCharToTexture(&blankGlyph, 0, row * lineHeight, m_textureWidth, std::min((row + 1) * lineHeight, m_textureHeight));
+
+  m_posY = row * lineHeight;
+  m_rowStamps[row] = m_drawStamp;
+  m_evictedRows++;
+  LogCacheUsage("evicted a row");
+  return true;
+}
+
+void CGUIFontTTFBase::LogCacheUsage(const char *reason) const
+{
+  const unsigned int lineHeight = GetTextureLineHeight();
+  CLog::Log(LOGDEBUG, "CGUIFontTTFBase::%s - %s %.1f: %s, %i characters in %u of %u rows (%ux%u), %u rows evicted, %u characters rendered in %.1f ms",
+            __FUNCTION__, m_strFilename.c_str(), m_height, reason, m_numChars, static_cast<unsigned int>(m_rowStamps.size()),
+            m_textureHeight / lineHeight, m_textureWidth, m_textureHeight, m_evictedRows, m_rasterisedChars,
+            1000.0 * m_rasterTime / CurrentHostFrequency());
+}
+
 void CGUIFontTTFBase::RenderCharacter(float posX, float posY, const Character *ch, UTILS::Color color, bool roundX, std::vector<SVertex> &vertices)
 {
   // actual image width isn't same as the character width as that is
@@ -92,7 +92,9 @@ protected:
     float left, top, right, bottom;
     float advance;
     character_t letterAndStyle;
+    unsigned int row;              // the texture row holding the glyph, NO_TEXTURE_ROW if it has no pixels
   };
+  static const unsigned int NO_TEXTURE_ROW = ~0U;
   void AddReference();
   void RemoveReference();
 
@@ -104,7 +106,7 @@ protected:
   float GetFontHeight() const { return m_height; }
 
   void DrawTextInternal(float x, float y, const std::vector<UTILS::Color> &colors, const vecText &text,
-                            uint32_t alignment, float maxPixelWidth, bool scrolling);
+                            uint32_t alignment, float maxPixelWidth, bool scrolling, uint64_t textHash);
 
   float m_height;
   std::string m_strFilename;
@@ -115,6 +117,14 @@ protected:
   void RenderCharacter(float posX, float posY, const Character *ch, UTILS::Color color, bool roundX, std::vector<SVertex> &vertices);
   void ClearCharacterCache();
 
+  /*! \brief Start a new row in the texture for the next characters.
+   Grows the texture while it may, afterwards reuses the row least recently drawn from.
+   \return false if there is no row that can be reused.
+   */
+  bool NextTextureRow();
+  bool EvictTextureRow();
+  void LogCacheUsage(const char *reason) const;
+
   virtual CBaseTexture* ReallocTexture(unsigned int& newHeight) = 0;
   virtual bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) = 0;
   virtual void DeleteHardwareTexture() = 0;
@@ -143,6 +153,12 @@ protected:
   int m_maxChars;                    // size of character array (can be incremented)
   int m_numChars;                    // the current number of cached characters
 
+  std::vector<uint64_t> m_rowStamps;     // the draw each texture row was last used in
+  uint64_t m_drawStamp = 0;              // incremented for every drawn text
+  unsigned int m_evictedRows = 0;
+  unsigned int m_rasterisedChars = 0;
+  int64_t m_rasterTime = 0;              // time spent rendering glyphs in host counter ticks
+
   float m_ellipsesWidth;               // this is used every character (width of '.')
 
   unsigned int m_cellBaseLine;
@@ -170,6 +186,7 @@ protected:
   };
   std::vector<CTranslatedVertices> m_vertexTrans;
   std::vector<SVertex> m_vertex;
+  std::vector<SVertex> m_newVertices; // vertices of the text being added to the caches
 
   float    m_textureScaleX;
   float    m_textureScaleY;
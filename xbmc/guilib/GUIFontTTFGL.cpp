@@ -66,6 +66,10 @@ bool CGUIFontTTFGL::FirstBegin()
 #else
   GLenum pixformat = GL_ALPHA; // deprecated
   GLenum internalFormat = GL_ALPHA;
+
+  // draw the queued GUI quads before the font changes texture and blend state
+  CRenderSystemGLES* renderSystem = dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
+  renderSystem->FlushBatch();
 #endif
 
   if (m_textureStatus == TEXTURE_REALLOCATED)
@@ -61,6 +61,13 @@ public:
    */
   const INFO::CSkinVariableString* CreateSkinVariable(const std::string& name, int context);
 
+  /*!
+   \brief Get the include files that were loaded.
+
+   \return the paths of the files
+   */
+  const std::vector<std::string>& GetFiles() const { return m_files; }
+
 private:
   enum ResolveParamsResult
   {
@@ -0,0 +1,258 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIIncludesCache.h"
+
+#include <cinttypes>
+#include <cstring>
+
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "utils/Crc32.h"
+#include "utils/EndianSwap.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/XBMCTinyXML.h"
+
+namespace
+{
+  const char CACHE_MAGIC[] = "XSKC";
+  const uint32_t CACHE_VERSION = 1;
+
+  enum NodeType : uint8_t
+  {
+    NODE_ELEMENT = 0,
+    NODE_TEXT = 1,
+    NODE_CDATA = 2
+  };
+
+  void WriteUInt32(std::string &data, uint32_t value)
+  {
+    value = Endian_SwapLE32(value);
+    data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void WriteString(std::string &data, const std::string &value)
+  {
+    WriteUInt32(data, static_cast<uint32_t>(value.size()));
+    data.append(value);
+  }
+
+  bool ReadUInt32(const char *&data, const char *end, uint32_t &value)
+  {
+    if (end - data < static_cast<ptrdiff_t>(sizeof(value)))
+      return false;
+    memcpy(&value, data, sizeof(value));
+    value = Endian_SwapLE32(value);
+    data += sizeof(value);
+    return true;
+  }
+
+  bool ReadUInt8(const char *&data, const char *end, uint8_t &value)
+  {
+    if (data >= end)
+      return false;
+    value = static_cast<uint8_t>(*data++);
+    return true;
+  }
+
+  bool ReadString(const char *&data, const char *end, std::string &value)
+  {
+    uint32_t size;
+    if (!ReadUInt32(data, end, size) || static_cast<uint32_t>(end - data) < size)
+      return false;
+    value.assign(data, size);
+    data += size;
+    return true;
+  }
+}
+
+void CGUIIncludesCache::Open(const std::string &directory, const std::string &fingerprint)
+{
+  m_directory.clear();
+  if (!XFILE::CDirectory::Exists(directory) && !XFILE::CDirectory::Create(directory))
+  {
+    CLog::Log(LOGWARNING, "CGUIIncludesCache: unable to create %s", directory.c_str());
+    return;
+  }
+
+  m_directory = directory;
+  m_fingerprint = fingerprint;
+}
+
+void CGUIIncludesCache::Close()
+{
+  m_directory.clear();
+  m_fingerprint.clear();
+}
+
+std::string CGUIIncludesCache::GetEntryPath(const std::string &windowFile) const
+{
+  return URIUtils::AddFileToFolder(m_directory, StringUtils::Format("%08x.bin", Crc32::Compute(windowFile)));
+}
+
+std::string CGUIIncludesCache::GetFileStamp(const std::string &file)
+{
+  struct __stat64 stat;
+  if (XFILE::CFile::Stat(file, &stat) != 0)
+    return "";
+
+  return StringUtils::Format("%s:%" PRId64 ":%" PRId64, file.c_str(), static_cast<int64_t>(stat.st_mtime), static_cast<int64_t>(stat.st_size));
+}
+
+bool CGUIIncludesCache::Get(const std::string &windowFile, std::unique_ptr<TiXmlElement> &root, Conditions &conditions) const
+{
+  if (!IsOpen())
+    return false;
+
+  XFILE::auto_buffer buffer;
+  if (XFILE::CFile().LoadFile(GetEntryPath(windowFile), buffer) <= 0)
+    return false;
+
+  const char *data = buffer.get();
+  const char *end = data + buffer.size();
+
+  uint32_t version;
+  std::string fingerprint;
+  std::string stamp;
+  if (end - data < 4 || memcmp(data, CACHE_MAGIC, 4) != 0)
+    return false;
+  data += 4;
+  if (!ReadUInt32(data, end, version) || version != CACHE_VERSION ||
+      !ReadString(data, end, fingerprint) || fingerprint != m_fingerprint ||
+      !ReadString(data, end, stamp) || stamp.empty() || stamp != GetFileStamp(windowFile))
+    return false;
+
+  uint32_t count;
+  if (!ReadUInt32(data, end, count))
+    return false;
+
+  conditions.clear();
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    std::string expression;
+    uint8_t value;
+    if (!ReadString(data, end, expression) || !ReadUInt8(data, end, value))
+      return false;
+    conditions.emplace_back(expression, value != 0);
+  }
+
+  root = Deserialize(data, end);
+  return root != nullptr && data == end;
+}
+
+void CGUIIncludesCache::Set(const std::string &windowFile, const TiXmlElement &root, const Conditions &conditions)
+{
+  if (!IsOpen())
+    return;
+
+  const std::string stamp = GetFileStamp(windowFile);
+  if (stamp.empty())
+    return;
+
+  std::string data(CACHE_MAGIC, 4);
+  WriteUInt32(data, CACHE_VERSION);
+  WriteString(data, m_fingerprint);
+  WriteString(data, stamp);
+  WriteUInt32(data, static_cast<uint32_t>(conditions.size()));
+  for (const auto& condition : conditions)
+  {
+    WriteString(data, condition.first);
+    data.push_back(condition.second ? 1 : 0);
+  }
+  Serialize(root, data);
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(GetEntryPath(windowFile), true) ||
+      file.Write(data.data(), data.size()) != static_cast<ssize_t>(data.size()))
+    CLog::Log(LOGWARNING, "CGUIIncludesCache: unable to store %s", windowFile.c_str());
+}
+
+void CGUIIncludesCache::Serialize(const TiXmlElement &element, std::string &data)
+{
+  data.push_back(NODE_ELEMENT);
+  WriteString(data, element.ValueStr());
+
+  uint32_t attributes = 0;
+  for (const TiXmlAttribute *attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+    ++attributes;
+  WriteUInt32(data, attributes);
+  for (const TiXmlAttribute *attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+  {
+    WriteString(data, attribute->NameTStr());
+    WriteString(data, attribute->ValueStr());
+  }
+
+  uint32_t children = 0;
+  for (const TiXmlNode *child = element.FirstChild(); child; child = child->NextSibling())
+  {
+    if (child->Type() == TiXmlNode::TINYXML_ELEMENT || child->Type() == TiXmlNode::TINYXML_TEXT)
+      ++children;
+  }
+  WriteUInt32(data, children);
+  for (const TiXmlNode *child = element.FirstChild(); child; child = child->NextSibling())
+  {
+    if (child->Type() == TiXmlNode::TINYXML_ELEMENT)
+      Serialize(*child->ToElement(), data);
+    else if (child->Type() == TiXmlNode::TINYXML_TEXT)
+    {
+      data.push_back(child->ToText()->CDATA() ? NODE_CDATA : NODE_TEXT);
+      WriteString(data, child->ValueStr());
+    }
+  }
+}
+
+std::unique_ptr<TiXmlElement> CGUIIncludesCache::Deserialize(const char *&data, const char *end)
+{
+  uint8_t type;
+  std::string value;
+  if (!ReadUInt8(data, end, type) || type != NODE_ELEMENT || !ReadString(data, end, value))
+    return nullptr;
+
+  std::unique_ptr<TiXmlElement> element(new TiXmlElement(value));
+
+  uint32_t attributes;
+  if (!ReadUInt32(data, end, attributes))
+    return nullptr;
+  for (uint32_t i = 0; i < attributes; ++i)
+  {
+    std::string name;
+    if (!ReadString(data, end, name) || !ReadString(data, end, value))
+      return nullptr;
+    element->SetAttribute(name, value);
+  }
+
+  uint32_t children;
+  if (!ReadUInt32(data, end, children))
+    return nullptr;
+  for (uint32_t i = 0; i < children; ++i)
+  {
+    // peek at the type, elements read it themselves
+    if (data >= end)
+      return nullptr;
+
+    if (static_cast<uint8_t>(*data) == NODE_ELEMENT)
+    {
+      std::unique_ptr<TiXmlElement> child = Deserialize(data, end);
+      if (!child)
+        return nullptr;
+      element->LinkEndChild(child.release());
+    }
+    else
+    {
+      if (!ReadUInt8(data, end, type) || type > NODE_CDATA || !ReadString(data, end, value))
+        return nullptr;
+      TiXmlText *text = new TiXmlText(value);
+      text->SetCDATA(type == NODE_CDATA);
+      element->LinkEndChild(text);
+    }
+  }
+
+  return element;
+}
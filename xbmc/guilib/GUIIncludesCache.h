@@ -0,0 +1,77 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class TiXmlElement;
+
+/*!
+ \ingroup skin
+ \brief Stores windows with their includes, constants, expressions and parameters resolved.
+
+ Each window is kept in a compact binary file, so the next load neither parses the window XML
+ nor resolves its includes. An entry is only used while the includes are unchanged (the
+ fingerprint), the window file is unchanged and the include conditions the window was resolved
+ with still have the same values. The caller checks the conditions.
+ */
+class CGUIIncludesCache
+{
+public:
+  typedef std::vector<std::pair<std::string, bool>> Conditions; ///< expressions of include conditions and their values
+
+  /*! \brief Use the cache.
+   \param directory the folder holding the entries.
+   \param fingerprint identifies the includes, entries created with another one are ignored.
+   */
+  void Open(const std::string &directory, const std::string &fingerprint);
+
+  /*! \brief Stop using the cache, the entries are kept.
+   */
+  void Close();
+
+  bool IsOpen() const { return !m_directory.empty(); }
+
+  /*! \brief Get a resolved window.
+   \param windowFile the path of the window XML.
+   \param root [out] the resolved window.
+   \param conditions [out] the include conditions the window was resolved with.
+   \return true if there was a valid entry.
+   */
+  bool Get(const std::string &windowFile, std::unique_ptr<TiXmlElement> &root, Conditions &conditions) const;
+
+  /*! \brief Store a resolved window, replacing an earlier entry.
+   \param windowFile the path of the window XML.
+   \param root the resolved window.
+   \param conditions the include conditions the window was resolved with.
+   */
+  void Set(const std::string &windowFile, const TiXmlElement &root, const Conditions &conditions);
+
+  /*! \brief Append an element and its children to a buffer.
+   Comments and declarations are dropped.
+   */
+  static void Serialize(const TiXmlElement &element, std::string &data);
+
+  /*! \brief Read an element written by Serialize().
+   \param data [in/out] the buffer, moved past the element.
+   \param end the end of the buffer.
+   \return the element or nullptr if the buffer is invalid.
+   */
+  static std::unique_ptr<TiXmlElement> Deserialize(const char *&data, const char *end);
+
+private:
+  std::string GetEntryPath(const std::string &windowFile) const;
+  static std::string GetFileStamp(const std::string &file);
+
+  std::string m_directory;
+  std::string m_fingerprint;
+};
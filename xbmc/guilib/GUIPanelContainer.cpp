@@ -42,7 +42,7 @@ void CGUIPanelContainer::Process(unsigned int currentTime, CDirtyRegionList &dir
   GetCacheOffsets(cacheBefore, cacheAfter);
 
   // Free memory not used on screen
-  if ((int)m_items.size() > m_itemsPerPage + cacheBefore + cacheAfter)
+  if (IsVirtual() || (int)m_items.size() > m_itemsPerPage + cacheBefore + cacheAfter)
     FreeMemory(CorrectOffset(offset - cacheBefore, 0), CorrectOffset(offset + m_itemsPerPage + 1 + cacheAfter, 0));
 
   CPoint origin = CPoint(m_posX, m_posY) + m_renderOffset;
@@ -57,7 +57,7 @@ void CGUIPanelContainer::Process(unsigned int currentTime, CDirtyRegionList &dir
   {
     if (current >= (int)m_items.size())
       break;
-    if (current >= 0)
+    if (current >= 0 && m_items[current])
     {
       CGUIListItemPtr item = m_items[current];
       bool focused = (current == GetOffset() * m_itemsPerRow + GetCursor()) && m_bHasFocus;
@@ -112,7 +112,7 @@ void CGUIPanelContainer::Render()
     {
       if (current >= (int)m_items.size())
         break;
-      if (current >= 0)
+      if (current >= 0 && m_items[current])
       {
         CGUIListItemPtr item = m_items[current];
         bool focused = (current == GetOffset() * m_itemsPerRow + GetCursor()) && m_bHasFocus;
@@ -17,6 +17,7 @@
 CGUIString::CGUIString(iString start, iString end, bool carriageReturn)
 {
   m_text.assign(start, end);
+  m_hash = CGUIFont::GetTextHash(m_text);
   m_carriageReturn = carriageReturn;
 }
 
@@ -74,9 +75,9 @@ void CGUITextLayout::Render(float x, float y, float angle, UTILS::Color color, U
     if (align & XBFONT_JUSTIFIED && string.m_carriageReturn)
       align &= ~XBFONT_JUSTIFIED;
     if (solid)
-      m_font->DrawText(x, y, m_colors[0], shadowColor, string.m_text, align, maxWidth);
+      m_font->DrawText(x, y, m_colors[0], shadowColor, string.m_text, align, maxWidth, string.m_hash);
     else
-      m_font->DrawText(x, y, m_colors, shadowColor, string.m_text, align, maxWidth);
+      m_font->DrawText(x, y, m_colors, shadowColor, string.m_text, align, maxWidth, string.m_hash);
     y += m_font->GetLineHeight();
   }
   m_font->End();
@@ -126,7 +127,7 @@ void CGUITextLayout::RenderScrolling(float x, float y, float angle, UTILS::Color
   for (std::vector<CGUIString>::iterator i = m_lines.begin(); i != m_lines.end(); ++i)
   {
     const CGUIString &string = *i;
-    m_font->DrawScrollingText(x, y, m_colors, shadowColor, string.m_text, alignment, maxWidth, scrollInfo);
+    m_font->DrawScrollingText(x, y, m_colors, shadowColor, string.m_text, alignment, maxWidth, scrollInfo, string.m_hash);
     y += m_font->GetLineHeight();
   }
   m_font->End();
@@ -176,7 +177,7 @@ void CGUITextLayout::RenderOutline(float x, float y, UTILS::Color color, UTILS::
 
       // don't pass maxWidth through to the renderer for the same reason above: it will cause clipping
       // on the left.
-      m_borderFont->DrawText(bx, by, outlineColors, 0, string.m_text, align, 0);
+      m_borderFont->DrawText(bx, by, outlineColors, 0, string.m_text, align, 0, string.m_hash);
       by += m_borderFont->GetLineHeight();
     }
     m_borderFont->End();
@@ -195,7 +196,7 @@ void CGUITextLayout::RenderOutline(float x, float y, UTILS::Color color, UTILS::
       align &= ~XBFONT_JUSTIFIED;
 
     // don't pass maxWidth through to the renderer for the reason above.
-    m_font->DrawText(x, y, m_colors, 0, string.m_text, align, 0);
+    m_font->DrawText(x, y, m_colors, 0, string.m_text, align, 0, string.m_hash);
     y += m_font->GetLineHeight();
   }
   m_font->End();
@@ -46,6 +46,7 @@ public:
   std::string GetAsString() const;
 
   vecText m_text;
+  uint64_t m_hash;       // CGUIFont::GetTextHash() of m_text
   bool m_carriageReturn; // true if we have a carriage return here
 };
 
@@ -13,6 +13,9 @@
 #include "utils/MathUtils.h"
 #include "utils/StringUtils.h"
 
+#include <algorithm>
+#include <cmath>
+
 CTextureInfo::CTextureInfo()
 {
   orientation = 0;
@@ -66,6 +69,7 @@ CGUITextureBase::CGUITextureBase(float posX, float posY, float width, float heig
 
   m_allocateDynamically = false;
   m_isAllocated = NO;
+  m_largeSize = 0;
   m_invalid = true;
   m_use_cache = true;
 }
@@ -102,6 +106,7 @@ CGUITextureBase::CGUITextureBase(const CGUITextureBase &right) :
   ResetAnimState();
 
   m_isAllocated = NO;
+  m_largeSize = 0;
   m_invalid = true;
 }
 
@@ -236,6 +241,10 @@ void CGUITextureBase::Render(float left, float top, float right, float bottom, f
   int orientation = GetOrientation();
   OrientateTexture(texture, u3, v3, orientation);
 
+  // move into the atlas page holding the image
+  if (m_texture.m_atlasSlot)
+    texture += CPoint(m_texture.m_atlasSlot->u, m_texture.m_atlasSlot->v);
+
   if (m_diffuse.size())
   {
     // flip the texture as necessary.  Diffuse just gets flipped according to m_info.orientation.
@@ -244,6 +253,8 @@ void CGUITextureBase::Render(float left, float top, float right, float bottom, f
     diffuse.y1 *= m_diffuseScaleV / v3; diffuse.y2 *= m_diffuseScaleV / v3;
     diffuse += m_diffuseOffset;
     OrientateTexture(diffuse, m_diffuseU, m_diffuseV, m_info.orientation);
+    if (m_diffuse.m_atlasSlot)
+      diffuse += CPoint(m_diffuse.m_atlasSlot->u, m_diffuse.m_atlasSlot->v);
   }
 
   float x[4], y[4], z[4];
@@ -299,8 +310,10 @@ bool CGUITextureBase::AllocResources()
     }
     if (m_isAllocated != NORMAL)
     { // use our large image background loader
+      if (!IsAllocated())
+        m_largeSize = GetLargeImageSize();
       CTextureArray texture;
-      if (CServiceBroker::GetGUI()->GetLargeTextureManager().GetImage(m_info.filename, texture, !IsAllocated(), m_use_cache))
+      if (CServiceBroker::GetGUI()->GetLargeTextureManager().GetImage(m_info.filename, texture, !IsAllocated(), m_use_cache, m_largeSize))
       {
         m_isAllocated = LARGE;
 
@@ -439,10 +452,25 @@ bool CGUITextureBase::CalculateSize()
   return true;
 }
 
+unsigned int CGUITextureBase::GetLargeImageSize() const
+{
+  // images kept within the control are never shown larger than the control, the others may be
+  // cropped or shown at their own size. Either orientation has to fit.
+  if (m_aspect.ratio != CAspectRatio::AR_KEEP || m_width <= 0 || m_height <= 0)
+    return 0;
+
+  // the control size does not include its animations, skins zoom focused items by up to 120%.
+  // Leave room for that so they do not get blurry.
+  static const float zoomHeadroom = 1.25f;
+
+  const CGraphicContext &context = CServiceBroker::GetWinSystem()->GetGfxContext();
+  return static_cast<unsigned int>(std::ceil(zoomHeadroom * std::max(m_width * context.GetGUIScaleX(), m_height * context.GetGUIScaleY())));
+}
+
 void CGUITextureBase::FreeResources(bool immediately /* = false */)
 {
   if (m_isAllocated == LARGE || m_isAllocated == LARGE_FAILED)
-    CServiceBroker::GetGUI()->GetLargeTextureManager().ReleaseImage(m_info.filename, immediately || (m_isAllocated == LARGE_FAILED));
+    CServiceBroker::GetGUI()->GetLargeTextureManager().ReleaseImage(m_info.filename, immediately || (m_isAllocated == LARGE_FAILED), m_largeSize);
   else if (m_isAllocated == NORMAL && m_texture.size())
     CServiceBroker::GetGUI()->GetTextureManager().ReleaseTexture(m_info.filename, immediately);
 
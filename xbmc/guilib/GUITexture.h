@@ -113,6 +113,7 @@ protected:
   void Render(float left, float top, float bottom, float right, float u1, float v1, float u2, float v2, float u3, float v3);
   static void OrientateTexture(CRect &rect, float width, float height, int orientation);
   void ResetAnimState();
+  unsigned int GetLargeImageSize() const;
 
   // functions that our implementation classes handle
   virtual void Allocate() {}; ///< called after our textures have been allocated
@@ -149,6 +150,7 @@ protected:
   bool m_allocateDynamically;
   enum ALLOCATE_TYPE { NO = 0, NORMAL, LARGE, NORMAL_FAILED, LARGE_FAILED };
   ALLOCATE_TYPE m_isAllocated;
+  unsigned int m_largeSize; ///< size the large image was requested with \sa CGUILargeTextureManager::GetImage
 
   CTextureInfo m_info;
   CAspectRatio m_aspect;
@@ -32,100 +32,58 @@ void CGUITextureGLES::Begin(UTILS::Color color)
   if (m_diffuse.size())
     m_diffuse.m_textures[0]->LoadToGPU();
 
-  texture->BindToUnit(0);
+  m_state.texture0 = static_cast<CGLTexture*>(texture)->GetTextureObject();
+  m_state.texture1 = 0;
 
   // Setup Colors
-  m_col[0] = (GLubyte)GET_R(color);
-  m_col[1] = (GLubyte)GET_G(color);
-  m_col[2] = (GLubyte)GET_B(color);
-  m_col[3] = (GLubyte)GET_A(color);
+  GLubyte* col = m_state.color;
+  col[0] = (GLubyte)GET_R(color);
+  col[1] = (GLubyte)GET_G(color);
+  col[2] = (GLubyte)GET_B(color);
+  col[3] = (GLubyte)GET_A(color);
 
   if (CServiceBroker::GetWinSystem()->UseLimitedColor())
   {
-    m_col[0] = (235 - 16) * m_col[0] / 255 + 16;
-    m_col[1] = (235 - 16) * m_col[1] / 255 + 16;
-    m_col[2] = (235 - 16) * m_col[2] / 255 + 16;
+    col[0] = (235 - 16) * col[0] / 255 + 16;
+    col[1] = (235 - 16) * col[1] / 255 + 16;
+    col[2] = (235 - 16) * col[2] / 255 + 16;
   }
 
-  bool hasAlpha = m_texture.m_textures[m_currentFrame]->HasAlpha() || m_col[3] < 255;
+  bool hasAlpha = texture->HasAlpha() || col[3] < 255;
 
   if (m_diffuse.size())
   {
-    if (m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255 )
+    if (col[0] == 255 && col[1] == 255 && col[2] == 255 && col[3] == 255 )
     {
-      m_renderSystem->EnableGUIShader(SM_MULTI);
+      m_state.method = SM_MULTI;
     }
     else
     {
-      m_renderSystem->EnableGUIShader(SM_MULTI_BLENDCOLOR);
+      m_state.method = SM_MULTI_BLENDCOLOR;
     }
 
     hasAlpha |= m_diffuse.m_textures[0]->HasAlpha();
 
-    m_diffuse.m_textures[0]->BindToUnit(1);
-
+    m_state.texture1 = static_cast<CGLTexture*>(m_diffuse.m_textures[0])->GetTextureObject();
   }
   else
   {
-    if (m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255)
+    if (col[0] == 255 && col[1] == 255 && col[2] == 255 && col[3] == 255)
     {
-      m_renderSystem->EnableGUIShader(SM_TEXTURE_NOBLEND);
+      m_state.method = SM_TEXTURE_NOBLEND;
     }
     else
     {
-      m_renderSystem->EnableGUIShader(SM_TEXTURE);
+      m_state.method = SM_TEXTURE;
     }
   }
 
-  if ( hasAlpha )
-  {
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
-    glEnable( GL_BLEND );
-  }
-  else
-  {
-    glDisable(GL_BLEND);
-  }
-  m_packedVertices.clear();
+  m_state.blend = hasAlpha ? GUIBLEND_SEPARATE_ALPHA : GUIBLEND_NONE;
 }
 
 void CGUITextureGLES::End()
 {
-  if (m_packedVertices.size())
-  {
-    GLint posLoc  = m_renderSystem->GUIShaderGetPos();
-    GLint tex0Loc = m_renderSystem->GUIShaderGetCoord0();
-    GLint tex1Loc = m_renderSystem->GUIShaderGetCoord1();
-    GLint uniColLoc = m_renderSystem->GUIShaderGetUniCol();
-
-    if(uniColLoc >= 0)
-    {
-      glUniform4f(uniColLoc,(m_col[0] / 255.0f), (m_col[1] / 255.0f), (m_col[2] / 255.0f), (m_col[3] / 255.0f));
-    }
-
-    if(m_diffuse.size())
-    {
-      glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, u2));
-      glEnableVertexAttribArray(tex1Loc);
-    }
-    glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, x));
-    glEnableVertexAttribArray(posLoc);
-    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), (char*)&m_packedVertices[0] + offsetof(PackedVertex, u1));
-    glEnableVertexAttribArray(tex0Loc);
-
-    glDrawElements(GL_TRIANGLES, m_packedVertices.size()*6 / 4, GL_UNSIGNED_SHORT, m_idx.data());
-
-    if (m_diffuse.size())
-      glDisableVertexAttribArray(tex1Loc);
-
-    glDisableVertexAttribArray(posLoc);
-    glDisableVertexAttribArray(tex0Loc);
-  }
-
-  if (m_diffuse.size())
-    glActiveTexture(GL_TEXTURE0);
-  glEnable(GL_BLEND);
-  m_renderSystem->DisableGUIShader();
+  // the quads are drawn by the render system once the state changes
 }
 
 void CGUITextureGLES::Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation)
@@ -199,86 +157,47 @@ void CGUITextureGLES::Draw(float *x, float *y, float *z, const CRect &texture, c
     vertices[i].x = x[i];
     vertices[i].y = y[i];
     vertices[i].z = z[i];
-    m_packedVertices.push_back(vertices[i]);
   }
 
-  if ((m_packedVertices.size() / 4) > (m_idx.size() / 6))
-  {
-    size_t i = m_packedVertices.size() - 4;
-    m_idx.push_back(i+0);
-    m_idx.push_back(i+1);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+2);
-    m_idx.push_back(i+3);
-    m_idx.push_back(i+0);
-  }
+  m_renderSystem->AddGUIQuad(m_state, vertices);
 }
 
 void CGUITextureGLES::DrawQuad(const CRect &rect, UTILS::Color color, CBaseTexture *texture, const CRect *texCoords)
 {
   CRenderSystemGLES *renderSystem = dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
+
+  GUIBatchState state;
+  state.blend = GUIBLEND_ALPHA;
   if (texture)
   {
     texture->LoadToGPU();
-    texture->BindToUnit(0);
+    state.method = SM_TEXTURE;
+    state.texture0 = static_cast<CGLTexture*>(texture)->GetTextureObject();
   }
-
-  glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
-  glEnable(GL_BLEND);          // Turn Blending On
-
-  VerifyGLState();
-
-  GLubyte col[4];
-  GLfloat ver[4][3];
-  GLfloat tex[4][2];
-  GLubyte idx[4] = {0, 1, 3, 2};        //determines order of triangle strip
-
-  if (texture)
-    renderSystem->EnableGUIShader(SM_TEXTURE);
   else
-    renderSystem->EnableGUIShader(SM_DEFAULT);
-
-  GLint posLoc   = renderSystem->GUIShaderGetPos();
-  GLint tex0Loc  = renderSystem->GUIShaderGetCoord0();
-  GLint uniColLoc= renderSystem->GUIShaderGetUniCol();
-
-  glVertexAttribPointer(posLoc,  3, GL_FLOAT, 0, 0, ver);
-  if (texture)
-    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, 0, tex);
-
-  glEnableVertexAttribArray(posLoc);
-  if (texture)
-    glEnableVertexAttribArray(tex0Loc);
+    state.method = SM_DEFAULT;
 
   // Setup Colors
-  col[0] = (GLubyte)GET_R(color);
-  col[1] = (GLubyte)GET_G(color);
-  col[2] = (GLubyte)GET_B(color);
-  col[3] = (GLubyte)GET_A(color);
-
-  glUniform4f(uniColLoc, col[0] / 255.0f, col[1] / 255.0f, col[2] / 255.0f, col[3] / 255.0f);
+  state.color[0] = (GLubyte)GET_R(color);
+  state.color[1] = (GLubyte)GET_G(color);
+  state.color[2] = (GLubyte)GET_B(color);
+  state.color[3] = (GLubyte)GET_A(color);
 
-  ver[0][0] = ver[3][0] = rect.x1;
-  ver[0][1] = ver[1][1] = rect.y1;
-  ver[1][0] = ver[2][0] = rect.x2;
-  ver[2][1] = ver[3][1] = rect.y2;
-  ver[0][2] = ver[1][2] = ver[2][2] = ver[3][2]= 0;
+  PackedVertex vertices[4] = {};
+  vertices[0].x = vertices[3].x = rect.x1;
+  vertices[0].y = vertices[1].y = rect.y1;
+  vertices[1].x = vertices[2].x = rect.x2;
+  vertices[2].y = vertices[3].y = rect.y2;
 
   if (texture)
   {
     // Setup texture coordinates
     CRect coords = texCoords ? *texCoords : CRect(0.0f, 0.0f, 1.0f, 1.0f);
-    tex[0][0] = tex[3][0] = coords.x1;
-    tex[0][1] = tex[1][1] = coords.y1;
-    tex[1][0] = tex[2][0] = coords.x2;
-    tex[2][1] = tex[3][1] = coords.y2;
+    vertices[0].u1 = vertices[3].u1 = coords.x1;
+    vertices[0].v1 = vertices[1].v1 = coords.y1;
+    vertices[1].u1 = vertices[2].u1 = coords.x2;
+    vertices[2].v1 = vertices[3].v1 = coords.y2;
   }
-  glDrawElements(GL_TRIANGLE_STRIP, 4, GL_UNSIGNED_BYTE, idx);
 
-  glDisableVertexAttribArray(posLoc);
-  if (texture)
-    glDisableVertexAttribArray(tex0Loc);
-
-  renderSystem->DisableGUIShader();
+  renderSystem->AddGUIQuad(state, vertices);
 }
-
@@ -11,18 +11,8 @@
 #include "GUITexture.h"
 
 #include "system_gl.h"
-#include <vector>
 #include "utils/Color.h"
-
-struct PackedVertex
-{
-  float x, y, z;
-  float u1, v1;
-  float u2, v2;
-};
-typedef std::vector<PackedVertex> PackedVertices;
-
-class CRenderSystemGLES;
+#include "rendering/gles/RenderSystemGLES.h"
 
 class CGUITextureGLES : public CGUITextureBase
 {
@@ -34,10 +24,7 @@ protected:
   void Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation);
   void End();
 
-  GLubyte m_col[4];
-
-  PackedVertices m_packedVertices;
-  std::vector<GLushort> m_idx;
+  GUIBatchState m_state;
   CRenderSystemGLES *m_renderSystem;
 };
 
@@ -30,9 +30,30 @@
 #include "utils/Color.h"
 #include "utils/Variant.h"
 #include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "TextureManager.h"
 
 using namespace KODI::MESSAGING;
 
+namespace
+{
+  // images are given by the text of their elements, those with info labels are only known later
+  void GetTextureNames(const TiXmlElement *element, std::vector<std::string> &textures)
+  {
+    for (const TiXmlElement *child = element->FirstChildElement(); child; child = child->NextSiblingElement())
+    {
+      const TiXmlNode *text = child->FirstChild();
+      if (text && text->Type() == TiXmlNode::TINYXML_TEXT)
+      {
+        const std::string &value = text->ValueStr();
+        if (value.find('$') == std::string::npos && URIUtils::HasExtension(value, ".png|.jpg|.gif"))
+          textures.push_back(value);
+      }
+      GetTextureNames(child, textures);
+    }
+  }
+}
+
 bool CGUIWindow::icompare::operator()(const std::string &s1, const std::string &s2) const
 {
   return StringUtils::CompareNoCase(s1, s2) < 0;
@@ -125,6 +146,15 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
 
 bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLowerPath)
 {
+  // a window resolved before with the same include conditions skips parsing and resolving,
+  // also when its xml is stored, windows with LOAD_EVERY_TIME keep it between loads
+  std::unique_ptr<TiXmlElement> resolvedRoot = g_SkinInfo->GetResolvedWindow(strPath, m_xmlIncludeConditions);
+  if (resolvedRoot)
+  {
+    CLog::Log(LOGDEBUG, "Using resolved window %s from the skin cache", strPath.c_str());
+    return Load(resolvedRoot.get());
+  }
+
   // load window xml if we don't have it stored yet
   if (!m_windowXMLRootElement)
   {
@@ -151,7 +181,12 @@ bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLower
   else
     CLog::Log(LOGDEBUG, "Using already stored xml root node for %s", strPath.c_str());
 
-  return Load(Prepare(m_windowXMLRootElement).get());
+  // the cache has no entry for the window or it was resolved with other include conditions
+  std::unique_ptr<TiXmlElement> preparedRoot = Prepare(m_windowXMLRootElement);
+  if (preparedRoot)
+    g_SkinInfo->SetResolvedWindow(strPath, *preparedRoot, m_xmlIncludeConditions);
+
+  return Load(preparedRoot.get());
 }
 
 std::unique_ptr<TiXmlElement> CGUIWindow::Prepare(TiXmlElement *pRootElement)
@@ -181,6 +216,11 @@ bool CGUIWindow::Load(TiXmlElement *pRootElement)
   // now load in the skin file
   SetDefaults();
 
+  // decode the bundled images in the background while the controls are created
+  std::vector<std::string> textures;
+  GetTextureNames(pRootElement, textures);
+  CServiceBroker::GetGUI()->GetTextureManager().PrefetchTextures(textures);
+
   CGUIControlFactory::GetInfoColor(pRootElement, "backgroundcolor", m_clearBackground, GetID());
   CGUIControlFactory::GetActions(pRootElement, "onload", m_loadActions);
   CGUIControlFactory::GetActions(pRootElement, "onunload", m_unloadActions);
@@ -129,7 +129,8 @@ void CGUIWrappingListContainer::ValidateOffset()
       // add additional copies of items, as we require extras at render time
       for (unsigned int i = 0; i < numItems; i++)
       {
-        m_items.push_back(CGUIListItemPtr(m_items[i]->Clone()));
+        CGUIListItemPtr item = GetItem(i);
+        m_items.push_back(item ? CGUIListItemPtr(item->Clone()) : item);
         m_extraItems++;
       }
     }
@@ -94,6 +94,7 @@ public:
   unsigned int GetOriginalWidth() const { return m_originalWidth; }
   /*! \brief return the original height of the image, before scaling/cropping */
   unsigned int GetOriginalHeight() const { return m_originalHeight; }
+  unsigned int GetFormat() const { return m_format; }
 
   int GetOrientation() const { return m_orientation; }
   void SetOrientation(int orientation) { m_orientation = orientation; }
@@ -0,0 +1,319 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "ServiceBroker.h"
+#include "Texture.h"
+#include "rendering/RenderSystem.h"
+#if HAS_GLES >= 2
+#include "rendering/gles/RenderSystemGLES.h"
+#endif
+#include "utils/log.h"
+
+namespace
+{
+  const unsigned int PAGE_SIZE = 1024;
+  const unsigned int BYTES_PER_PIXEL = 4;
+
+  // the size of an image with its border
+  unsigned int SlotSize(unsigned int size)
+  {
+    return size + 2;
+  }
+}
+
+/************************************************************************/
+/*                                                                      */
+/************************************************************************/
+CTextureAtlasPacker::CTextureAtlasPacker(unsigned int width, unsigned int height)
+  : m_width(width),
+    m_height(height)
+{
+}
+
+bool CTextureAtlasPacker::Insert(unsigned int width, unsigned int height, unsigned int &x, unsigned int &y)
+{
+  if (width > m_width || height > m_height)
+    return false;
+
+  // use the lowest shelf with room left
+  Shelf* best = nullptr;
+  for (auto& shelf : m_shelves)
+  {
+    if (shelf.height >= height && m_width - shelf.used >= width &&
+        (!best || shelf.height < best->height))
+      best = &shelf;
+  }
+
+  // open a new shelf rather than wasting more than half of the best one
+  const bool canOpen = m_height - m_bottom >= height;
+  if (!best || (best->height > height * 2 && canOpen))
+  {
+    if (!canOpen)
+      return false;
+
+    m_shelves.push_back({m_bottom, height, 0});
+    m_bottom += height;
+    best = &m_shelves.back();
+  }
+
+  x = best->used;
+  y = best->y;
+  best->used += width;
+  return true;
+}
+
+/************************************************************************/
+/*                                                                      */
+/************************************************************************/
+CTextureAtlasPixels::CTextureAtlasPixels(unsigned int size)
+  : m_size(size),
+    m_packer(size, size),
+    m_buffer(size * size * BYTES_PER_PIXEL)
+{
+}
+
+unsigned int CTextureAtlasPixels::GetPitch() const
+{
+  return m_size * BYTES_PER_PIXEL;
+}
+
+void CTextureAtlasPixels::SetPosition(CTextureAtlasSlot &slot, unsigned int x, unsigned int y) const
+{
+  slot.x = x;
+  slot.y = y;
+  slot.u = float(x + 1) / m_size;
+  slot.v = float(y + 1) / m_size;
+}
+
+std::shared_ptr<CTextureAtlasSlot> CTextureAtlasPixels::Add(const unsigned char *pixels, unsigned int width, unsigned int height, unsigned int pitch)
+{
+  const unsigned int slotWidth = SlotSize(width);
+  const unsigned int slotHeight = SlotSize(height);
+  unsigned int x = 0;
+  unsigned int y = 0;
+  if (!m_packer.Insert(slotWidth, slotHeight, x, y))
+    return std::shared_ptr<CTextureAtlasSlot>();
+
+  auto slot = std::make_shared<CTextureAtlasSlot>();
+  slot->width = width;
+  slot->height = height;
+  SetPosition(*slot, x, y);
+  m_slots.push_back(slot);
+  m_dirty = true;
+
+  // copy the image, the border repeats its outer rows and columns
+  const unsigned int dstPitch = GetPitch();
+  const unsigned int rowSize = width * BYTES_PER_PIXEL;
+  for (unsigned int row = 0; row < slotHeight; ++row)
+  {
+    const unsigned int srcRow = std::min(row > 0 ? row - 1 : 0, height - 1);
+    const unsigned char* src = pixels + srcRow * pitch;
+    unsigned char* dst = m_buffer.data() + (y + row) * dstPitch + x * BYTES_PER_PIXEL;
+    memcpy(dst, src, BYTES_PER_PIXEL);
+    memcpy(dst + BYTES_PER_PIXEL, src, rowSize);
+    memcpy(dst + BYTES_PER_PIXEL + rowSize, src + rowSize - BYTES_PER_PIXEL, BYTES_PER_PIXEL);
+  }
+
+  return slot;
+}
+
+bool CTextureAtlasPixels::Collect()
+{
+  for (auto slot = m_slots.begin(); slot != m_slots.end();)
+  {
+    // only we hold the slot, nobody shows the image anymore
+    if (slot->use_count() == 1)
+    {
+      m_freedArea += SlotSize((*slot)->width) * SlotSize((*slot)->height);
+      slot = m_slots.erase(slot);
+    }
+    else
+      ++slot;
+  }
+  return m_slots.empty();
+}
+
+bool CTextureAtlasPixels::Compact()
+{
+  // place the tallest images first, the shelves waste less room that way
+  std::vector<std::shared_ptr<CTextureAtlasSlot>> slots = m_slots;
+  std::sort(slots.begin(), slots.end(),
+            [](const std::shared_ptr<CTextureAtlasSlot> &a, const std::shared_ptr<CTextureAtlasSlot> &b)
+            { return a->height > b->height; });
+
+  CTextureAtlasPacker packer(m_size, m_size);
+  std::vector<std::pair<unsigned int, unsigned int>> positions;
+  positions.reserve(slots.size());
+  for (const auto& slot : slots)
+  {
+    unsigned int x, y;
+    if (!packer.Insert(SlotSize(slot->width), SlotSize(slot->height), x, y))
+      return false;
+    positions.emplace_back(x, y);
+  }
+
+  const unsigned int pitch = GetPitch();
+  std::vector<unsigned char> buffer(m_buffer.size());
+  for (size_t i = 0; i < slots.size(); ++i)
+  {
+    CTextureAtlasSlot& slot = *slots[i];
+    const unsigned int rowSize = SlotSize(slot.width) * BYTES_PER_PIXEL;
+    for (unsigned int row = 0; row < SlotSize(slot.height); ++row)
+    {
+      memcpy(buffer.data() + (positions[i].second + row) * pitch + positions[i].first * BYTES_PER_PIXEL,
+             m_buffer.data() + (slot.y + row) * pitch + slot.x * BYTES_PER_PIXEL, rowSize);
+    }
+    SetPosition(slot, positions[i].first, positions[i].second);
+  }
+
+  m_buffer.swap(buffer);
+  m_packer = packer;
+  m_freedArea = 0;
+  m_dirty = true;
+
+  CLog::Log(LOGDEBUG, "CTextureAtlasPixels::%s - compacted page with %u images", __FUNCTION__, static_cast<unsigned int>(slots.size()));
+  return true;
+}
+
+/************************************************************************/
+/*                                                                      */
+/************************************************************************/
+class CTextureAtlasPage : public CTexture
+{
+public:
+  explicit CTextureAtlasPage(unsigned int size)
+    : CTexture(size, size, XB_FMT_A8R8G8B8),
+      m_contents(size)
+  {
+  }
+
+  void LoadToGPU() override
+  {
+    // the texture drops its pixels after the upload, so changes are uploaded from our copy
+    if (m_contents.IsDirty())
+    {
+#if HAS_GLES >= 2
+      // queued quads of this page were placed for the pixels uploaded before, compacting may have
+      // moved their images. The texture object stays the same, so the batch can't tell.
+      CRenderSystemGLES *renderSystem = dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
+      if (renderSystem)
+        renderSystem->FlushBatch();
+#endif
+      Update(m_contents.GetSize(), m_contents.GetSize(), m_contents.GetPitch(), XB_FMT_A8R8G8B8, m_contents.GetPixels(), false);
+      m_contents.MarkUploaded();
+    }
+    CTexture::LoadToGPU();
+  }
+
+  CTextureAtlasPixels m_contents;
+};
+
+/************************************************************************/
+/*                                                                      */
+/************************************************************************/
+CTextureAtlas::CTextureAtlas() = default;
+
+CTextureAtlas::~CTextureAtlas() = default;
+
+CBaseTexture* CTextureAtlas::Add(const CBaseTexture &texture, unsigned int maxImageSize, std::shared_ptr<CTextureAtlasSlot> &slot)
+{
+  const unsigned int width = texture.GetWidth();
+  const unsigned int height = texture.GetHeight();
+  if (!width || !height || width > maxImageSize || height > maxImageSize)
+    return nullptr;
+
+  // pages are linear filtered ARGB without mipmaps
+  if (!texture.GetPixels() || texture.GetFormat() != XB_FMT_A8R8G8B8 || texture.IsMipmapped() ||
+      texture.GetScalingMethod() != TEXTURE_SCALING::LINEAR || texture.GetOrientation() != 0)
+    return nullptr;
+
+  if (!m_pageSize)
+    m_pageSize = std::min(PAGE_SIZE, CServiceBroker::GetRenderSystem()->GetMaxTextureSize());
+
+  const unsigned int slotWidth = SlotSize(width);
+  const unsigned int slotHeight = SlotSize(height);
+  if (slotWidth > m_pageSize || slotHeight > m_pageSize)
+    return nullptr;
+
+  for (const auto& page : m_pages)
+  {
+    slot = page->m_contents.Add(texture.GetPixels(), width, height, texture.GetPitch());
+    if (slot)
+      return page.get();
+  }
+
+  // reuse the room of freed images before adding a page
+  Collect();
+  for (const auto& page : m_pages)
+  {
+    if (page->m_contents.GetFreedArea() >= slotWidth * slotHeight && page->m_contents.Compact())
+    {
+      slot = page->m_contents.Add(texture.GetPixels(), width, height, texture.GetPitch());
+      if (slot)
+        return page.get();
+    }
+  }
+
+  m_pages.emplace_back(new CTextureAtlasPage(m_pageSize));
+  CTextureAtlasPage* page = m_pages.back().get();
+  slot = page->m_contents.Add(texture.GetPixels(), width, height, texture.GetPitch());
+  if (!slot)
+  {
+    m_pages.pop_back();
+    return nullptr;
+  }
+
+  CLog::Log(LOGDEBUG, "CTextureAtlas::%s - added page %u", __FUNCTION__, static_cast<unsigned int>(m_pages.size()));
+  return page;
+}
+
+void CTextureAtlas::Collect()
+{
+  for (auto page = m_pages.begin(); page != m_pages.end();)
+  {
+    if ((*page)->m_contents.Collect())
+      page = m_pages.erase(page);
+    else
+      ++page;
+  }
+}
+
+void CTextureAtlas::Clear()
+{
+  m_pages.clear();
+}
+
+unsigned int CTextureAtlas::GetMemoryUsage() const
+{
+  // the texture and the copy of its pixels
+  unsigned int memUsage = 0;
+  for (const auto& page : m_pages)
+    memUsage += sizeof(CTextureAtlasPage) + 2 * page->m_contents.GetPitch() * page->m_contents.GetSize();
+  return memUsage;
+}
+
+void CTextureAtlas::Dump() const
+{
+  unsigned int images = 0;
+  unsigned int usedArea = 0;
+  for (const auto& page : m_pages)
+  {
+    images += page->m_contents.GetSlots().size();
+    for (const auto& slot : page->m_contents.GetSlots())
+      usedArea += SlotSize(slot->width) * SlotSize(slot->height);
+  }
+
+  const unsigned int pageArea = m_pageSize * m_pageSize;
+  CLog::Log(LOGDEBUG, "{0}: {1} images in {2} pages, {3}% used", __FUNCTION__, images, m_pages.size(),
+            pageArea && !m_pages.empty() ? 100ull * usedArea / (pageArea * m_pages.size()) : 0ull);
+}
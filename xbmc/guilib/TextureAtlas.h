@@ -0,0 +1,166 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+class CBaseTexture;
+class CTextureAtlasPage;
+
+/*!
+ \ingroup textures
+ \brief Places rectangles in rows (shelves) of a fixed size area.
+ */
+class CTextureAtlasPacker
+{
+public:
+  CTextureAtlasPacker(unsigned int width, unsigned int height);
+
+  /*! \brief Find room for a rectangle.
+   \param width the width of the rectangle.
+   \param height the height of the rectangle.
+   \param x [out] the left of the rectangle.
+   \param y [out] the top of the rectangle.
+   \return true if the rectangle was placed, false if there is no room left.
+   */
+  bool Insert(unsigned int width, unsigned int height, unsigned int &x, unsigned int &y);
+
+  unsigned int GetWidth() const { return m_width; }
+  unsigned int GetHeight() const { return m_height; }
+
+private:
+  struct Shelf
+  {
+    unsigned int y;
+    unsigned int height;
+    unsigned int used;
+  };
+
+  unsigned int m_width;
+  unsigned int m_height;
+  unsigned int m_bottom = 0;
+  std::vector<Shelf> m_shelves;
+};
+
+/*!
+ \ingroup textures
+ \brief The place of an image in an atlas page.
+
+ Shared by the atlas and every texture array showing the image. The atlas frees the slot once
+ it holds the only reference, and may move it within its page when compacting.
+ */
+struct CTextureAtlasSlot
+{
+  float u = 0.0f;              ///< left of the image in texture coordinates of the page
+  float v = 0.0f;              ///< top of the image in texture coordinates of the page
+  unsigned int x = 0;          ///< left of the slot including its border in pixels
+  unsigned int y = 0;          ///< top of the slot including its border in pixels
+  unsigned int width = 0;      ///< width of the image
+  unsigned int height = 0;     ///< height of the image
+};
+
+/*!
+ \ingroup textures
+ \brief The pixels and slots of an atlas page, without the texture they are uploaded to.
+
+ Each image gets a one pixel border repeating its edge, so filtering does not blend in
+ neighbours. The pixels are ARGB, four bytes each.
+ */
+class CTextureAtlasPixels
+{
+public:
+  explicit CTextureAtlasPixels(unsigned int size);
+
+  /*! \brief Copy an image into a free place.
+   \param pixels the first row of the image.
+   \param width the width of the image.
+   \param height the height of the image.
+   \param pitch the bytes per row of the image.
+   \return the place of the image, nullptr if there is no room left.
+   */
+  std::shared_ptr<CTextureAtlasSlot> Add(const unsigned char *pixels, unsigned int width, unsigned int height, unsigned int pitch);
+
+  /*! \brief Free the slots nobody uses anymore.
+   \return true if no slot is left.
+   */
+  bool Collect();
+
+  /*! \brief Move the images together to reuse the room of freed slots.
+   Changes the place of the slots, images drawn from their old place must be drawn first.
+   \return true if the images were moved, false if they did not fit anymore.
+   */
+  bool Compact();
+
+  /*! \brief The pixels of freed slots, reusable after compacting.
+   */
+  unsigned int GetFreedArea() const { return m_freedArea; }
+
+  unsigned int GetSize() const { return m_size; }
+  unsigned int GetPitch() const;
+  const unsigned char* GetPixels() const { return m_buffer.data(); }
+  const std::vector<std::shared_ptr<CTextureAtlasSlot>>& GetSlots() const { return m_slots; }
+
+  /*! \brief Whether the pixels changed since the last MarkUploaded().
+   */
+  bool IsDirty() const { return m_dirty; }
+  void MarkUploaded() { m_dirty = false; }
+
+private:
+  void SetPosition(CTextureAtlasSlot &slot, unsigned int x, unsigned int y) const;
+
+  unsigned int m_size;
+  CTextureAtlasPacker m_packer;
+  std::vector<unsigned char> m_buffer;
+  std::vector<std::shared_ptr<CTextureAtlasSlot>> m_slots;
+  unsigned int m_freedArea = 0;
+  bool m_dirty = true;
+};
+
+/*!
+ \ingroup textures
+ \brief Packs small images into shared texture pages.
+
+ Images drawn from the same page can be drawn together without binding another texture. Each
+ image gets a one pixel border repeating its edge, so filtering does not blend in neighbours.
+ The pages keep a copy of their pixels to upload them again after changes.
+ Must be used with the graphics context locked.
+ */
+class CTextureAtlas
+{
+public:
+  CTextureAtlas();
+  ~CTextureAtlas();
+
+  /*! \brief Copy an image into a page.
+   \param texture the image, it must still hold its pixels.
+   \param maxImageSize the largest width and height packed, 0 to disable the atlas.
+   \param slot [out] the place of the image.
+   \return the page or nullptr if the image is not suited for the atlas.
+   */
+  CBaseTexture* Add(const CBaseTexture &texture, unsigned int maxImageSize, std::shared_ptr<CTextureAtlasSlot> &slot);
+
+  /*! \brief Free the slots nobody uses anymore and the pages that became empty.
+   */
+  void Collect();
+
+  /*! \brief Free all pages, the slots must not be used anymore.
+   */
+  void Clear();
+
+  unsigned int GetMemoryUsage() const;
+  void Dump() const;
+
+private:
+  CTextureAtlas(const CTextureAtlas&) = delete;
+  CTextureAtlas& operator=(const CTextureAtlas&) = delete;
+
+  std::vector<std::unique_ptr<CTextureAtlasPage>> m_pages;
+  unsigned int m_pageSize = 0;
+};
@@ -66,6 +66,14 @@ int CTextureBundle::LoadAnim(const std::string& Filename, CBaseTexture*** ppText
   return 0;
 }
 
+void CTextureBundle::Prefetch(const std::vector<std::string>& filenames)
+{
+  if (m_useXBT)
+  {
+    m_tbXBT.Prefetch(filenames);
+  }
+}
+
 void CTextureBundle::Close()
 {
   m_tbXBT.CloseBundle();
@@ -20,6 +20,14 @@
 #include "utils/StringUtils.h"
 #include "XBTF.h"
 #include "XBTFReader.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
+
+#include <algorithm>
+#include <deque>
+#include <utility>
 #include <lzo/lzo1x.h>
 
 #ifdef TARGET_WINDOWS_DESKTOP
@@ -32,6 +40,106 @@
 #endif
 #endif
 
+namespace
+{
+  // decoded textures waiting to be loaded are dropped beyond this size
+  const size_t MAX_PREFETCH_MEMORY = 64 * 1024 * 1024;
+
+  bool DecompressFrame(const CXBTFFrame& frame, const uint8_t* packed, uint8_t* unpacked)
+  {
+    lzo_uint size = static_cast<lzo_uint>(frame.GetUnpackedSize());
+    return lzo1x_decompress_safe(packed, static_cast<lzo_uint>(frame.GetPackedSize()), unpacked, &size, nullptr) == LZO_E_OK &&
+           size == frame.GetUnpackedSize();
+  }
+
+  uint8_t* UnpackFrameData(const CXBTFFrame& frame, const uint8_t* packedBuffer)
+  {
+    // make sure lzo is initialized
+    if (lzo_init() != LZO_E_OK)
+    {
+      CLog::Log(LOGERROR, "CTextureBundleXBT: failed to initialize lzo");
+      return nullptr;
+    }
+
+    uint8_t* unpackedBuffer = new uint8_t[static_cast<size_t>(frame.GetUnpackedSize())];
+    if (!DecompressFrame(frame, packedBuffer, unpackedBuffer))
+    {
+      CLog::Log(LOGERROR, "CTextureBundleXBT: failed to decompress frame with %" PRIu64" unpacked bytes to %" PRIu64" bytes", frame.GetPackedSize(), frame.GetUnpackedSize());
+      delete[] unpackedBuffer;
+      return nullptr;
+    }
+
+    return unpackedBuffer;
+  }
+}
+
+class CTextureBundleXBT::CPrefetchQueue
+{
+public:
+  explicit CPrefetchQueue(std::shared_ptr<CXBTFReader> reader)
+    : m_reader(std::move(reader))
+  {
+  }
+
+  void Process()
+  {
+    CSingleLock lock(m_section);
+    m_idle.Reset();
+    while (!m_pending.empty() && m_memory < MAX_PREFETCH_MEMORY)
+    {
+      const std::string name = m_pending.front().first;
+      const CXBTFFrame frame = m_pending.front().second;
+      m_pending.pop_front();
+
+      m_decoding = name;
+
+      CBaseTexture* texture = nullptr;
+      {
+        CSingleExit exit(m_section);
+        ConvertFrameToTexture(*m_reader, name, frame, &texture);
+      }
+
+      // dropped if it was loaded meanwhile
+      std::unique_ptr<CBaseTexture> decoded(texture);
+      if (decoded && m_decoding == name)
+      {
+        m_memory += decoded->GetPitch() * decoded->GetRows();
+        m_textures[name] = std::move(decoded);
+      }
+      m_decoding.clear();
+    }
+    m_pending.clear();
+    m_running = false;
+    m_idle.Set();
+  }
+
+  /*!
+   \brief Drop the queued and decoded textures and wait for the job.
+   The job decodes from the mapping of the reader, it must be done before the reader is closed.
+   A job that did not start yet finds nothing to decode.
+   */
+  void Cancel()
+  {
+    {
+      CSingleLock lock(m_section);
+      m_pending.clear();
+      m_textures.clear();
+      m_decoding.clear();
+      m_memory = 0;
+    }
+    m_idle.Wait();
+  }
+
+  CCriticalSection m_section;
+  std::shared_ptr<CXBTFReader> m_reader;
+  std::deque<std::pair<std::string, CXBTFFrame>> m_pending;
+  std::map<std::string, std::unique_ptr<CBaseTexture>> m_textures;
+  std::string m_decoding;
+  size_t m_memory = 0;
+  bool m_running = false;
+  CEvent m_idle{true, true}; //! reset while the job is in Process()
+};
+
 CTextureBundleXBT::CTextureBundleXBT()
   : m_TimeStamp{0}
   , m_themeBundle{false}
@@ -51,6 +159,10 @@ CTextureBundleXBT::~CTextureBundleXBT(void)
 
 void CTextureBundleXBT::CloseBundle()
 {
+  if (m_prefetch)
+    m_prefetch->Cancel();
+  m_prefetch.reset();
+
   if (m_XBTFReader != nullptr && m_XBTFReader->IsOpen())
   {
     XFILE::CXbtManager::GetInstance().Release(CURL(m_path));
@@ -60,6 +172,11 @@ void CTextureBundleXBT::CloseBundle()
 
 bool CTextureBundleXBT::OpenBundle()
 {
+  // a changed bundle is closed and mapped again below
+  if (m_prefetch)
+    m_prefetch->Cancel();
+  m_prefetch.reset();
+
   // Find the correct texture file (skin or theme)
 
   auto mediaDir = CServiceBroker::GetWinSystem()->GetGfxContext().GetMediaDir();
@@ -159,7 +276,31 @@ bool CTextureBundleXBT::LoadTexture(const std::string& Filename, CBaseTexture**
     return false;
 
   CXBTFFrame& frame = file.GetFrames().at(0);
-  if (!ConvertFrameToTexture(Filename, frame, ppTexture))
+
+  *ppTexture = nullptr;
+  if (m_prefetch)
+  {
+    CSingleLock lock(m_prefetch->m_section);
+    auto it = m_prefetch->m_textures.find(name);
+    if (it != m_prefetch->m_textures.end())
+    {
+      *ppTexture = it->second.release();
+      m_prefetch->m_memory -= (*ppTexture)->GetPitch() * (*ppTexture)->GetRows();
+      m_prefetch->m_textures.erase(it);
+    }
+    else
+    {
+      // not decoded yet, it's quicker to do that here than to wait for it
+      auto& pending = m_prefetch->m_pending;
+      pending.erase(std::remove_if(pending.begin(), pending.end(),
+                                   [&name](const std::pair<std::string, CXBTFFrame>& entry) { return entry.first == name; }),
+                    pending.end());
+      if (m_prefetch->m_decoding == name)
+        m_prefetch->m_decoding.clear();
+    }
+  }
+
+  if (*ppTexture == nullptr && !ConvertFrameToTexture(*m_XBTFReader, Filename, frame, ppTexture))
   {
     return false;
   }
@@ -190,7 +331,7 @@ int CTextureBundleXBT::LoadAnim(const std::string& Filename, CBaseTexture*** ppT
   {
     CXBTFFrame& frame = file.GetFrames().at(i);
 
-    if (!ConvertFrameToTexture(Filename, frame, &((*ppTextures)[i])))
+    if (!ConvertFrameToTexture(*m_XBTFReader, Filename, frame, &((*ppTextures)[i])))
     {
       return false;
     }
@@ -205,56 +346,79 @@ int CTextureBundleXBT::LoadAnim(const std::string& Filename, CBaseTexture*** ppT
   return nTextures;
 }
 
-bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name, CXBTFFrame& frame, CBaseTexture** ppTexture)
+bool CTextureBundleXBT::ConvertFrameToTexture(const CXBTFReader& reader, const std::string& name, const CXBTFFrame& frame, CBaseTexture** ppTexture)
 {
-  // found texture - allocate the necessary buffers
-  unsigned char *buffer = new unsigned char [(size_t)frame.GetPackedSize()];
-  if (buffer == NULL)
-  {
-    CLog::Log(LOGERROR, "Out of memory loading texture: %s (need %" PRIu64" bytes)", name.c_str(), frame.GetPackedSize());
-    return false;
-  }
-
-  // load the compressed texture
-  if (!m_XBTFReader->Load(frame, buffer))
+  // a mapped bundle is read in place
+  std::unique_ptr<uint8_t[]> loaded;
+  const uint8_t* packed = reader.GetFrameData(frame);
+  if (packed == nullptr)
   {
-    CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
-    delete[] buffer;
-    return false;
+    loaded.reset(new uint8_t[static_cast<size_t>(frame.GetPackedSize())]);
+    if (!reader.Load(frame, loaded.get()))
+    {
+      CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
+      return false;
+    }
+    packed = loaded.get();
   }
 
   // check if it's packed with lzo
+  const uint8_t* pixels = packed;
+  std::unique_ptr<uint8_t[]> unpacked;
   if (frame.IsPacked())
-  { // unpack
-    unsigned char *unpacked = new unsigned char[(size_t)frame.GetUnpackedSize()];
-    if (unpacked == NULL)
-    {
-      CLog::Log(LOGERROR, "Out of memory unpacking texture: %s (need %" PRIu64" bytes)", name.c_str(), frame.GetUnpackedSize());
-      delete[] buffer;
-      return false;
-    }
-    lzo_uint s = (lzo_uint)frame.GetUnpackedSize();
-    if (lzo1x_decompress_safe(buffer, (lzo_uint)frame.GetPackedSize(), unpacked, &s, NULL) != LZO_E_OK ||
-        s != frame.GetUnpackedSize())
+  {
+    unpacked.reset(new uint8_t[static_cast<size_t>(frame.GetUnpackedSize())]);
+    if (!DecompressFrame(frame, packed, unpacked.get()))
     {
       CLog::Log(LOGERROR, "Error loading texture: %s: Decompression error", name.c_str());
-      delete[] buffer;
-      delete[] unpacked;
       return false;
     }
-    delete[] buffer;
-    buffer = unpacked;
+    pixels = unpacked.get();
   }
 
   // create an xbmc texture
   *ppTexture = new CTexture();
-  (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), frame.HasAlpha(), buffer);
-
-  delete[] buffer;
+  (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), frame.HasAlpha(), pixels);
 
   return true;
 }
 
+void CTextureBundleXBT::Prefetch(const std::vector<std::string>& filenames)
+{
+  if (m_XBTFReader == nullptr || !m_XBTFReader->IsMapped())
+    return;
+
+  if (!m_prefetch || m_prefetch->m_reader != m_XBTFReader)
+    m_prefetch = std::make_shared<CPrefetchQueue>(m_XBTFReader);
+
+  CSingleLock lock(m_prefetch->m_section);
+
+  // the textures of the previous window that weren't loaded won't be anymore
+  m_prefetch->m_pending.clear();
+  m_prefetch->m_textures.clear();
+  m_prefetch->m_decoding.clear();
+  m_prefetch->m_memory = 0;
+
+  for (const auto& filename : filenames)
+  {
+    std::string name = Normalize(filename);
+    CXBTFFile file;
+    if (!m_XBTFReader->Get(name, file) || file.GetFrames().size() != 1)
+      continue;
+
+    // start reading while the queue is processed
+    m_XBTFReader->Prefetch(file.GetFrames().front());
+    m_prefetch->m_pending.emplace_back(name, file.GetFrames().front());
+  }
+
+  if (!m_prefetch->m_running && !m_prefetch->m_pending.empty())
+  {
+    m_prefetch->m_running = true;
+    std::shared_ptr<CPrefetchQueue> queue = m_prefetch;
+    CJobManager::GetInstance().Submit([queue]() { queue->Process(); }, CJob::PRIORITY_HIGH);
+  }
+}
+
 void CTextureBundleXBT::SetThemeBundle(bool themeBundle)
 {
   m_themeBundle = themeBundle;
@@ -275,52 +439,27 @@ std::string CTextureBundleXBT::Normalize(const std::string &name)
 
 uint8_t* CTextureBundleXBT::UnpackFrame(const CXBTFReader& reader, const CXBTFFrame& frame)
 {
-  uint8_t* packedBuffer = new uint8_t[static_cast<size_t>(frame.GetPackedSize())];
-  if (packedBuffer == nullptr)
-  {
-    CLog::Log(LOGERROR, "CTextureBundleXBT: out of memory loading frame with %" PRIu64" packed bytes", frame.GetPackedSize());
-    return nullptr;
-  }
-
-  // load the compressed texture
-  if (!reader.Load(frame, packedBuffer))
-  {
-    CLog::Log(LOGERROR, "CTextureBundleXBT: error loading frame");
-    delete[] packedBuffer;
-    return nullptr;
-  }
+  const uint8_t* mapped = reader.GetFrameData(frame);
 
   // if the frame isn't packed there's nothing else to be done
-  if (!frame.IsPacked())
-    return packedBuffer;
-
-  uint8_t* unpackedBuffer = new uint8_t[static_cast<size_t>(frame.GetUnpackedSize())];
-  if (unpackedBuffer == nullptr)
+  if (!frame.IsPacked() || mapped == nullptr)
   {
-    CLog::Log(LOGERROR, "CTextureBundleXBT: out of memory loading frame with %" PRIu64" unpacked bytes", frame.GetPackedSize());
-    delete[] packedBuffer;
-    return nullptr;
-  }
+    uint8_t* packedBuffer = new uint8_t[static_cast<size_t>(frame.GetPackedSize())];
+    if (!reader.Load(frame, packedBuffer))
+    {
+      CLog::Log(LOGERROR, "CTextureBundleXBT: error loading frame");
+      delete[] packedBuffer;
+      return nullptr;
+    }
 
-  // make sure lzo is initialized
-  if (lzo_init() != LZO_E_OK)
-  {
-    CLog::Log(LOGERROR, "CTextureBundleXBT: failed to initialize lzo");
-    delete[] packedBuffer;
-    delete[] unpackedBuffer;
-    return nullptr;
-  }
+    if (!frame.IsPacked())
+      return packedBuffer;
 
-  lzo_uint size = static_cast<lzo_uint>(frame.GetUnpackedSize());
-  if (lzo1x_decompress_safe(packedBuffer, static_cast<lzo_uint>(frame.GetPackedSize()), unpackedBuffer, &size, nullptr) != LZO_E_OK || size != frame.GetUnpackedSize())
-  {
-    CLog::Log(LOGERROR, "CTextureBundleXBT: failed to decompress frame with %" PRIu64" unpacked bytes to %" PRIu64" bytes", frame.GetPackedSize(), frame.GetUnpackedSize());
+    uint8_t* unpackedBuffer = UnpackFrameData(frame, packedBuffer);
     delete[] packedBuffer;
-    delete[] unpackedBuffer;
-    return nullptr;
+    return unpackedBuffer;
   }
 
-  delete[] packedBuffer;
-
-  return unpackedBuffer;
+  // a mapped frame is unpacked in place
+  return UnpackFrameData(frame, mapped);
 }
@@ -37,18 +37,29 @@ public:
                 int &width, int &height, int& nLoops, int** ppDelays);
 
   static uint8_t* UnpackFrame(const CXBTFReader& reader, const CXBTFFrame& frame);
+
+  /*!
+   \brief Decode textures in the background before they are loaded.
+   Replaces the textures of the previous call that were not loaded yet. Only single frame
+   textures of a mapped bundle are decoded, the others are loaded as usual.
+   \param filenames the textures, all of them must be in the bundle.
+   */
+  void Prefetch(const std::vector<std::string>& filenames);
   
   void CloseBundle();
 
 private:
+  class CPrefetchQueue;
+
   bool OpenBundle();
-  bool ConvertFrameToTexture(const std::string& name, CXBTFFrame& frame, CBaseTexture** ppTexture);
+  static bool ConvertFrameToTexture(const CXBTFReader& reader, const std::string& name, const CXBTFFrame& frame, CBaseTexture** ppTexture);
 
   time_t m_TimeStamp;
 
   bool m_themeBundle;
   std::string m_path;
   std::shared_ptr<CXBTFReader> m_XBTFReader;
+  std::shared_ptr<CPrefetchQueue> m_prefetch;
 };
 
 
@@ -26,6 +26,8 @@ public:
   void LoadToGPU() override;
   void BindToUnit(unsigned int unit) override;
 
+  GLuint GetTextureObject() const { return m_texture; }
+
 protected:
   GLuint m_texture = 0;
   bool m_isOglVersion3orNewer = false;
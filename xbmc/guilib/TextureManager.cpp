@@ -8,6 +8,7 @@
 
 #include "TextureManager.h"
 
+#include <algorithm>
 #include <cassert>
 
 #include "addons/Skin.h"
@@ -15,18 +16,19 @@
 #include "filesystem/File.h"
 #include "windowing/GraphicContext.h"
 #include "Texture.h"
+#include "ServiceBroker.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
 #include "URL.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/URIUtils.h"
 
-#ifdef _DEBUG_TEXTURES
-#include "utils/TimeUtils.h"
-#endif
 #if defined(TARGET_DARWIN_IOS)
-#include "ServiceBroker.h"
 #include "windowing/osx/WinSystemIOS.h" // for g_Windowing in CGUITextureManager::FreeUnusedTextures
 #endif
 #include "FFmpegImage.h"
@@ -69,6 +71,7 @@ void CTextureArray::Reset()
   m_texWidth = 0;
   m_texHeight = 0;
   m_texCoordsArePixels = false;
+  m_atlasSlot.reset();
 }
 
 void CTextureArray::Add(CBaseTexture *texture, int delay)
@@ -96,9 +99,13 @@ void CTextureArray::Set(CBaseTexture *texture, int width, int height)
 void CTextureArray::Free()
 {
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
-  for (unsigned int i = 0; i < m_textures.size(); i++)
+  // atlas pages are owned by the atlas
+  if (!m_atlasSlot)
   {
-    delete m_textures[i];
+    for (unsigned int i = 0; i < m_textures.size(); i++)
+    {
+      delete m_textures[i];
+    }
   }
 
   m_textures.clear();
@@ -206,6 +213,15 @@ void CTextureMap::Add(CBaseTexture* texture, int delay)
     m_memUsage += sizeof(CTexture) + (texture->GetTextureWidth() * texture->GetTextureHeight() * 4);
 }
 
+void CTextureMap::Add(CBaseTexture* page, const std::shared_ptr<CTextureAtlasSlot>& slot)
+{
+  m_texture.Add(page, 100);
+  m_texture.m_atlasSlot = slot;
+
+  // the page is accounted for by the atlas
+  m_memUsage += sizeof(CTextureAtlasSlot);
+}
+
 /************************************************************************/
 /*                                                                      */
 /************************************************************************/
@@ -278,6 +294,38 @@ bool CGUITextureManager::HasTexture(const std::string &textureName, std::string
   return !fullPath.empty();
 }
 
+void CGUITextureManager::PrefetchTextures(const std::vector<std::string>& textureNames)
+{
+  CSingleLock lock(m_section);
+
+  std::vector<std::string> bundled[2];
+  for (const auto& textureName : textureNames)
+  {
+    if (textureName.empty() || !CanLoad(textureName))
+      continue;
+
+    // skip what is loaded already
+    if (std::any_of(m_vecTextures.begin(), m_vecTextures.end(),
+                    [&textureName](const CTextureMap* map) { return map->GetName() == textureName; }) ||
+        std::any_of(m_unusedTextures.begin(), m_unusedTextures.end(),
+                    [&textureName](const std::pair<CTextureMap*, unsigned int>& unused) { return unused.first->GetName() == textureName; }))
+      continue;
+
+    std::string bundledName = CTextureBundle::Normalize(textureName);
+    for (int i = 0; i < 2; i++)
+    {
+      if (m_TexBundle[i].HasFile(bundledName))
+      {
+        bundled[i].push_back(bundledName);
+        break;
+      }
+    }
+  }
+
+  for (int i = 0; i < 2; i++)
+    m_TexBundle[i].Prefetch(bundled[i]);
+}
+
 const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName, bool checkBundleOnly /*= false */)
 {
   std::string strPath;
@@ -291,6 +339,8 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
   if (!HasTexture(strTextureName, &strPath, &bundle, &size))
     return emptyTexture;
 
+  CTraceScope trace("CGUITextureManager::Load");
+
   if (size) // we found the texture
   {
     for (int i = 0; i < (int)m_vecTextures.size(); ++i)
@@ -323,10 +373,7 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
   //Lock here, we will do stuff that could break rendering
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
-#ifdef _DEBUG_TEXTURES
-  int64_t start;
-  start = CurrentHostCounter();
-#endif
+  int64_t start = CurrentHostCounter();
 
   if (bundle >= 0 && StringUtils::EndsWithNoCase(strPath, ".gif"))
   {
@@ -442,9 +489,25 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
   if (!pTexture) return emptyTexture;
 
   CTextureMap* pMap = new CTextureMap(strTextureName, width, height, 0);
-  pMap->Add(pTexture, 100);
+
+  // small images share atlas pages so they can be drawn without switching textures
+  std::shared_ptr<CTextureAtlasSlot> slot;
+  CBaseTexture* page = nullptr;
+  if (pTexture->GetWidth() == (unsigned int)width && pTexture->GetHeight() == (unsigned int)height)
+    page = m_atlas.Add(*pTexture, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiAtlasMaxImageSize, slot);
+
+  if (page)
+  {
+    pMap->Add(page, slot);
+    delete pTexture;
+  }
+  else
+    pMap->Add(pTexture, 100);
   m_vecTextures.push_back(pMap);
 
+  m_loadTime += CurrentHostCounter() - start;
+  m_loadCount++;
+
 #ifdef _DEBUG_TEXTURES
   int64_t end, freq;
   end = CurrentHostCounter();
@@ -498,6 +561,8 @@ void CGUITextureManager::FreeUnusedTextures(unsigned int timeDelay)
       ++i;
   }
 
+  m_atlas.Collect();
+
 #if defined(HAS_GL) || defined(HAS_GLES)
   for (unsigned int i = 0; i < m_unusedHwTextures.size(); ++i)
   {
@@ -550,6 +615,10 @@ void CGUITextureManager::Dump() const
     if (!pMap->IsEmpty())
       pMap->Dump();
   }
+
+  CLog::Log(LOGDEBUG, "{0}: loaded {1} textures in {2:.1f} ms, {3} KB in use", __FUNCTION__, m_loadCount,
+            GetLoadTime(), GetMemoryUsage() / 1024);
+  m_atlas.Dump();
 }
 
 void CGUITextureManager::Flush()
@@ -572,11 +641,13 @@ void CGUITextureManager::Flush()
       ++i;
     }
   }
+
+  m_atlas.Collect();
 }
 
 unsigned int CGUITextureManager::GetMemoryUsage() const
 {
-  unsigned int memUsage = 0;
+  unsigned int memUsage = m_atlas.GetMemoryUsage();
   for (int i = 0; i < (int)m_vecTextures.size(); ++i)
   {
     memUsage += m_vecTextures[i]->GetMemoryUsage();
@@ -584,6 +655,11 @@ unsigned int CGUITextureManager::GetMemoryUsage() const
   return memUsage;
 }
 
+float CGUITextureManager::GetLoadTime() const
+{
+  return 1000.f * m_loadTime / CurrentHostFrequency();
+}
+
 void CGUITextureManager::SetTexturePath(const std::string &texturePath)
 {
   CSingleLock lock(m_section);
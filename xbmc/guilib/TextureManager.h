@@ -9,9 +9,11 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <vector>
 #include <utility>
 
+#include "TextureAtlas.h"
 #include "TextureBundle.h"
 #include "threads/CriticalSection.h"
 
@@ -44,6 +46,7 @@ public:
   int m_texWidth;
   int m_texHeight;
   bool m_texCoordsArePixels;
+  std::shared_ptr<CTextureAtlasSlot> m_atlasSlot; ///< set if the texture is a shared atlas page
 };
 
 /*!
@@ -61,6 +64,7 @@ public:
   virtual ~CTextureMap();
 
   void Add(CBaseTexture* texture, int delay);
+  void Add(CBaseTexture* page, const std::shared_ptr<CTextureAtlasSlot>& slot);
   bool Release();
 
   const std::string& GetName() const;
@@ -96,6 +100,7 @@ public:
   bool HasTexture(const std::string &textureName, std::string *path = NULL, int *bundle = NULL, int *size = NULL);
   static bool CanLoad(const std::string &texturePath); ///< Returns true if the texture manager can load this texture
   const CTextureArray& Load(const std::string& strTextureName, bool checkBundleOnly = false);
+  void PrefetchTextures(const std::vector<std::string>& textureNames); ///< Decode bundled textures in the background before they are loaded
   void ReleaseTexture(const std::string& strTextureName, bool immediately = false);
   void Cleanup();
   void Dump() const;
@@ -110,6 +115,7 @@ public:
 
   void FreeUnusedTextures(unsigned int timeDelay = 0); ///< Free textures (called from app thread only)
   void ReleaseHwTexture(unsigned int texture);
+  float GetLoadTime() const; ///< Time spent loading textures in ms
 protected:
   std::vector<CTextureMap*> m_vecTextures;
   std::list<std::pair<CTextureMap*, unsigned int> > m_unusedTextures;
@@ -121,5 +127,9 @@ protected:
 
   std::vector<std::string> m_texturePaths;
   CCriticalSection m_section;
+
+  CTextureAtlas m_atlas;
+  int64_t m_loadTime = 0;
+  unsigned int m_loadCount = 0;
 };
 
@@ -10,6 +10,10 @@
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
+#ifdef TARGET_POSIX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #include "XBTFReader.h"
 #include "guilib/XBTF.h"
@@ -164,9 +168,38 @@ bool CXBTFReader::Open(const std::string& path)
   if (pos != GetHeaderSize())
     return false;
 
+  Map();
+
   return true;
 }
 
+void CXBTFReader::Map()
+{
+#ifdef TARGET_POSIX
+  struct stat fileStat;
+  if (fstat(fileno(m_file), &fileStat) == -1 || fileStat.st_size <= 0)
+    return;
+
+  // frames are read in place, without a copy into a temporary buffer
+  void* mapping = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fileno(m_file), 0);
+  if (mapping == MAP_FAILED)
+    return;
+
+  m_mapping = static_cast<unsigned char*>(mapping);
+  m_mappingSize = static_cast<uint64_t>(fileStat.st_size);
+#endif
+}
+
+void CXBTFReader::Unmap()
+{
+#ifdef TARGET_POSIX
+  if (m_mapping != nullptr)
+    munmap(m_mapping, static_cast<size_t>(m_mappingSize));
+#endif
+  m_mapping = nullptr;
+  m_mappingSize = 0;
+}
+
 bool CXBTFReader::IsOpen() const
 {
   return m_file != nullptr;
@@ -174,6 +207,8 @@ bool CXBTFReader::IsOpen() const
 
 void CXBTFReader::Close()
 {
+  Unmap();
+
   if (m_file != nullptr)
   {
     fclose(m_file);
@@ -196,8 +231,41 @@ time_t CXBTFReader::GetLastModificationTimestamp() const
   return fileStat.st_mtime;
 }
 
+const unsigned char* CXBTFReader::GetFrameData(const CXBTFFrame& frame) const
+{
+  if (m_mapping == nullptr)
+    return nullptr;
+
+  if (frame.GetOffset() > m_mappingSize || frame.GetPackedSize() > m_mappingSize - frame.GetOffset())
+    return nullptr;
+
+  return m_mapping + frame.GetOffset();
+}
+
+void CXBTFReader::Prefetch(const CXBTFFrame& frame) const
+{
+#ifdef TARGET_POSIX
+  const unsigned char* data = GetFrameData(frame);
+  if (data == nullptr)
+    return;
+
+  // madvise() wants page aligned addresses
+  const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(data) & ~(pageSize - 1);
+  const uintptr_t end = reinterpret_cast<uintptr_t>(data) + static_cast<uintptr_t>(frame.GetPackedSize());
+  madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+#endif
+}
+
 bool CXBTFReader::Load(const CXBTFFrame& frame, unsigned char* buffer) const
 {
+  const unsigned char* data = GetFrameData(frame);
+  if (data != nullptr)
+  {
+    memcpy(buffer, data, static_cast<size_t>(frame.GetPackedSize()));
+    return true;
+  }
+
   if (m_file == nullptr)
     return false;
 
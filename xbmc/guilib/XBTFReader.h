@@ -30,9 +30,31 @@ public:
 
   bool Load(const CXBTFFrame& frame, unsigned char* buffer) const;
 
+  /*!
+   \brief Get the packed data of a frame without copying it.
+   \return the data in the mapped bundle or nullptr if the bundle isn't mapped.
+   */
+  const unsigned char* GetFrameData(const CXBTFFrame& frame) const;
+
+  /*!
+   \brief Whether the bundle is mapped into memory.
+   Frames of a mapped bundle may be loaded from several threads at once.
+   */
+  bool IsMapped() const { return m_mapping != nullptr; }
+
+  /*!
+   \brief Ask the system to read the data of a frame in the background.
+   */
+  void Prefetch(const CXBTFFrame& frame) const;
+
 private:
+  void Map();
+  void Unmap();
+
   std::string m_path;
   FILE* m_file = nullptr;
+  unsigned char* m_mapping = nullptr;
+  uint64_t m_mappingSize = 0;
 };
 
 typedef std::shared_ptr<CXBTFReader> CXBTFReaderPtr;
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUIIncludesCache.h"
+#include "utils/XBMCTinyXML.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+  const std::string WINDOW_XML =
+    "<window type=\"dialog\" id=\"1100\">"
+      "<!-- dropped -->"
+      "<controls>"
+        "<control type=\"image\">"
+          "<texture border=\"5\">dialogs/background.png</texture>"
+          "<visible>!String.IsEmpty(Window.Property(busy))</visible>"
+        "</control>"
+        "<control type=\"label\"><label><![CDATA[<b>$LOCALIZE[31000]</b>]]></label></control>"
+      "</controls>"
+    "</window>";
+
+  std::string Print(const TiXmlElement& element)
+  {
+    TiXmlPrinter printer;
+    element.Accept(&printer);
+    return printer.Str();
+  }
+}
+
+TEST(TestGUIIncludesCache, RoundTrip)
+{
+  CXBMCTinyXML doc;
+  doc.Parse(WINDOW_XML);
+  ASSERT_NE(nullptr, doc.RootElement());
+
+  std::string data;
+  CGUIIncludesCache::Serialize(*doc.RootElement(), data);
+
+  const char* begin = data.data();
+  std::unique_ptr<TiXmlElement> root = CGUIIncludesCache::Deserialize(begin, data.data() + data.size());
+  ASSERT_NE(nullptr, root);
+  EXPECT_EQ(data.data() + data.size(), begin);
+
+  // the comment is the only difference
+  doc.RootElement()->RemoveChild(doc.RootElement()->FirstChild());
+  EXPECT_EQ(Print(*doc.RootElement()), Print(*root));
+
+  const TiXmlElement* label = root->FirstChildElement("controls")->LastChild()->FirstChildElement("label");
+  ASSERT_NE(nullptr, label);
+  EXPECT_TRUE(label->FirstChild()->ToText()->CDATA());
+}
+
+TEST(TestGUIIncludesCache, Truncated)
+{
+  CXBMCTinyXML doc;
+  doc.Parse(WINDOW_XML);
+  ASSERT_NE(nullptr, doc.RootElement());
+
+  std::string data;
+  CGUIIncludesCache::Serialize(*doc.RootElement(), data);
+
+  for (size_t size = 0; size < data.size(); ++size)
+  {
+    const char* begin = data.data();
+    EXPECT_EQ(nullptr, CGUIIncludesCache::Deserialize(begin, data.data() + size));
+  }
+}
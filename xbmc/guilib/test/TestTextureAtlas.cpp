@@ -0,0 +1,192 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/TextureAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+
+struct Rect
+{
+  unsigned int x, y, width, height;
+
+  bool Overlaps(const Rect& other) const
+  {
+    return x < other.x + other.width && other.x < x + width &&
+           y < other.y + other.height && other.y < y + height;
+  }
+};
+
+// an ARGB image with a distinct value in every pixel
+std::vector<unsigned char> MakeImage(unsigned int width, unsigned int height, unsigned char seed)
+{
+  std::vector<unsigned char> pixels(width * height * 4);
+  for (size_t i = 0; i < pixels.size(); ++i)
+    pixels[i] = static_cast<unsigned char>(seed + i);
+  return pixels;
+}
+
+// check the image and its border at the place of the slot
+void ExpectImage(const CTextureAtlasPixels &page, const CTextureAtlasSlot &slot, const std::vector<unsigned char> &image)
+{
+  const unsigned int size = page.GetSize();
+  EXPECT_FLOAT_EQ(float(slot.x + 1) / size, slot.u);
+  EXPECT_FLOAT_EQ(float(slot.y + 1) / size, slot.v);
+
+  const unsigned int rowSize = slot.width * 4;
+  for (unsigned int row = 0; row < slot.height + 2; ++row)
+  {
+    const unsigned int srcRow = std::min(row > 0 ? row - 1 : 0, slot.height - 1);
+    const unsigned char* src = image.data() + srcRow * rowSize;
+    const unsigned char* dst = page.GetPixels() + (slot.y + row) * page.GetPitch() + slot.x * 4;
+    EXPECT_EQ(0, memcmp(dst, src, 4));
+    EXPECT_EQ(0, memcmp(dst + 4, src, rowSize));
+    EXPECT_EQ(0, memcmp(dst + 4 + rowSize, src + rowSize - 4, 4));
+  }
+}
+
+}
+
+TEST(TestTextureAtlasPacker, NoOverlap)
+{
+  CTextureAtlasPacker packer(256, 256);
+  std::vector<Rect> placed;
+
+  const unsigned int sizes[][2] = {{34, 34}, {66, 18}, {18, 66}, {130, 34}, {10, 10}, {34, 66}};
+  for (int i = 0; i < 20; ++i)
+  {
+    const unsigned int width = sizes[i % 6][0];
+    const unsigned int height = sizes[i % 6][1];
+    Rect rect = {0, 0, width, height};
+    if (!packer.Insert(width, height, rect.x, rect.y))
+      continue;
+
+    EXPECT_LE(rect.x + width, 256u);
+    EXPECT_LE(rect.y + height, 256u);
+    for (const auto& other : placed)
+      EXPECT_FALSE(rect.Overlaps(other));
+    placed.push_back(rect);
+  }
+  EXPECT_GT(placed.size(), 10u);
+}
+
+TEST(TestTextureAtlasPacker, Full)
+{
+  CTextureAtlasPacker packer(64, 64);
+  unsigned int x, y;
+
+  EXPECT_FALSE(packer.Insert(65, 10, x, y));
+  EXPECT_FALSE(packer.Insert(10, 65, x, y));
+
+  // 16 squares fill the page exactly
+  for (int i = 0; i < 16; ++i)
+    EXPECT_TRUE(packer.Insert(16, 16, x, y));
+  EXPECT_FALSE(packer.Insert(1, 1, x, y));
+}
+
+TEST(TestTextureAtlasPacker, Shelves)
+{
+  CTextureAtlasPacker packer(64, 64);
+  unsigned int x, y;
+
+  EXPECT_TRUE(packer.Insert(32, 32, x, y));
+  EXPECT_EQ(0u, x);
+  EXPECT_EQ(0u, y);
+
+  // would waste most of the first shelf, opens a new one below
+  EXPECT_TRUE(packer.Insert(8, 8, x, y));
+  EXPECT_EQ(0u, x);
+  EXPECT_EQ(32u, y);
+
+  // fits into the first shelf
+  EXPECT_TRUE(packer.Insert(32, 20, x, y));
+  EXPECT_EQ(32u, x);
+  EXPECT_EQ(0u, y);
+}
+
+TEST(TestTextureAtlasPixels, Add)
+{
+  CTextureAtlasPixels page(64);
+  const std::vector<unsigned char> first = MakeImage(14, 14, 1);
+  const std::vector<unsigned char> second = MakeImage(30, 6, 2);
+
+  auto firstSlot = page.Add(first.data(), 14, 14, 14 * 4);
+  auto secondSlot = page.Add(second.data(), 30, 6, 30 * 4);
+  ASSERT_TRUE(firstSlot && secondSlot);
+  EXPECT_TRUE(page.IsDirty());
+  ExpectImage(page, *firstSlot, first);
+  ExpectImage(page, *secondSlot, second);
+
+  // no room for a second row of 62 pixels high images
+  EXPECT_FALSE(page.Add(MakeImage(62, 62, 3).data(), 62, 62, 62 * 4));
+}
+
+TEST(TestTextureAtlasPixels, Collect)
+{
+  CTextureAtlasPixels page(64);
+  const std::vector<unsigned char> image = MakeImage(14, 14, 1);
+
+  auto kept = page.Add(image.data(), 14, 14, 14 * 4);
+  auto freed = page.Add(image.data(), 14, 14, 14 * 4);
+  ASSERT_TRUE(kept && freed);
+
+  freed.reset();
+  EXPECT_FALSE(page.Collect());
+  EXPECT_EQ(1u, page.GetSlots().size());
+  EXPECT_EQ(16u * 16u, page.GetFreedArea());
+
+  kept.reset();
+  EXPECT_TRUE(page.Collect());
+}
+
+TEST(TestTextureAtlasPixels, Compact)
+{
+  CTextureAtlasPixels page(64);
+
+  // fill the page with 16 images, keep every other one
+  std::vector<std::vector<unsigned char>> images;
+  std::vector<std::shared_ptr<CTextureAtlasSlot>> slots;
+  for (unsigned char i = 0; i < 16; ++i)
+  {
+    images.push_back(MakeImage(14, 14, i * 16));
+    slots.push_back(page.Add(images.back().data(), 14, 14, 14 * 4));
+    ASSERT_TRUE(slots.back());
+  }
+  EXPECT_FALSE(page.Add(images[0].data(), 14, 14, 14 * 4));
+
+  for (size_t i = 0; i < slots.size(); i += 2)
+    slots[i].reset();
+  page.Collect();
+  page.MarkUploaded();
+
+  ASSERT_TRUE(page.Compact());
+  EXPECT_TRUE(page.IsDirty());
+  EXPECT_EQ(0u, page.GetFreedArea());
+
+  // the kept images moved to the top half of the page and their slots tell where
+  std::vector<Rect> placed;
+  for (size_t i = 1; i < slots.size(); i += 2)
+  {
+    ExpectImage(page, *slots[i], images[i]);
+    EXPECT_LT(slots[i]->y, 32u);
+    const Rect rect = {slots[i]->x, slots[i]->y, 16, 16};
+    for (const auto& other : placed)
+      EXPECT_FALSE(rect.Overlaps(other));
+    placed.push_back(rect);
+  }
+
+  // the freed room is usable again
+  for (int i = 0; i < 8; ++i)
+    EXPECT_TRUE(page.Add(images[0].data(), 14, 14, 14 * 4));
+}
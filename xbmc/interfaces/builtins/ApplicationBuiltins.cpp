@@ -10,6 +10,7 @@
 
 #include "Application.h"
 #include "ServiceBroker.h"
+#include "filesystem/SpecialProtocol.h"
 #include "filesystem/ZipManager.h"
 #include "messaging/ApplicationMessenger.h"
 #include "interfaces/AnnouncementManager.h"
@@ -21,6 +22,7 @@
 #include "utils/JSONVariantParser.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
+#include "utils/TraceRecorder.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include <stdlib.h>
@@ -129,6 +131,28 @@ static int ToggleDPMS(const std::vector<std::string>& params)
   return 0;
 }
 
+/*! \brief Start or stop recording a trace, stopping writes the trace to a file.
+ *  \param params The parameters.
+ *  \details params[0] = The file to write the trace to (optional).
+ */
+static int ToggleTrace(const std::vector<std::string>& params)
+{
+  CTraceRecorder &recorder = CTraceRecorder::GetInstance();
+  if (!CTraceRecorder::IsRunning())
+  {
+    recorder.Start();
+    CLog::Log(LOGNOTICE, "ToggleTrace - recording started");
+    return 0;
+  }
+
+  recorder.Stop();
+  std::string file = params.empty() ? "special://home/guitrace.json" : params[0];
+  if (!recorder.Export(CSpecialProtocol::TranslatePath(file)))
+    return -1;
+
+  return 0;
+}
+
 /*! \brief Send a WOL packet to a given host.
  *  \param params The parameters.
  *  \details params[0] = The MAC of the host to wake.
@@ -191,6 +215,15 @@ static int WakeOnLAN(const std::vector<std::string>& params)
 ///     Toggle DPMS mode manually
 ///   }
 ///   \table_row2_l{
+///     <b>`ToggleTrace([file])`</b>
+///     ,
+///     Starts recording a timeline of the GUI thread and the workers\, or stops
+///     it and writes the timeline in the Chrome trace event format\, viewable in
+///     chrome://tracing or https://ui.perfetto.dev.
+///     @param[in] file                  File to write the trace to (optional).
+///             @note If not given\, writes special://home/guitrace.json.
+///   }
+///   \table_row2_l{
 ///     <b>`WakeOnLan(mac)`</b>
 ///     ,
 ///     Sends the wake-up packet to the broadcast address for the specified MAC
@@ -209,6 +242,7 @@ CBuiltins::CommandMap CApplicationBuiltins::GetOperations() const
            {"setvolume", {"Set the current volume", 1, SetVolume}},
            {"toggledebug", {"Enables/disables debug mode", 0, ToggleDebug}},
            {"toggledpms", {"Toggle DPMS mode manually", 0, ToggleDPMS}},
+           {"toggletrace", {"Starts/stops recording a trace and writes it", 0, ToggleTrace}},
            {"wakeonlan", {"Sends the wake-up packet to the broadcast address for the specified MAC address", 1, WakeOnLAN}}
          };
 }
@@ -11,13 +11,15 @@
 
 namespace INFO
 {
-  InfoBool::InfoBool(const std::string &expression, int context, unsigned int &refreshCounter)
+  InfoBool::InfoBool(const std::string &expression, int context, const InfoSourceCounters &counters)
     : m_value(false),
       m_context(context),
       m_listItemDependent(false),
       m_expression(expression),
-      m_refreshCounter(0),
-      m_parentRefreshCounter(refreshCounter)
+      m_sources(1 << INFO_SOURCE_FRAME),
+      m_valid(false),
+      m_stamp(0),
+      m_counters(counters)
   {
     StringUtils::ToLower(m_expression);
   }
@@ -15,6 +15,50 @@ class CGUIListItem;
 
 namespace INFO
 {
+/*!
+ \ingroup info
+ \brief Inputs an info bool depends on
+ */
+enum InfoSource
+{
+  INFO_SOURCE_FRAME = 0,  ///< anything without change notifications, may change every frame
+  INFO_SOURCE_SKIN,       ///< skin settings, strings and theme
+  INFO_SOURCE_TIME,       ///< the date and time of day, changes every minute
+  INFO_SOURCE_PLAYER,     ///< whether and what the player plays and its speed
+  INFO_SOURCE_PVR,        ///< the pvr conditions, polled by the pvr gui info thread
+  INFO_SOURCE_SETTINGS,   ///< the settings read by setting conditions
+  INFO_SOURCE_COUNT
+};
+
+/*!
+ \ingroup info
+ \brief Counts the changes of each info source
+ */
+class InfoSourceCounters
+{
+public:
+  void Changed(InfoSource source) { ++m_counters[source]; }
+  unsigned int Get(InfoSource source) const { return m_counters[source]; }
+
+  /*! \brief Get a value that changes whenever one of the given sources changes
+   \param sources bit mask of the sources, (1 << source) for each source
+   */
+  unsigned int GetStamp(unsigned int sources) const
+  {
+    // the counters only grow, so the sum only stays the same if none of them changed
+    unsigned int stamp = 0;
+    for (unsigned int source = 0; source < INFO_SOURCE_COUNT; ++source)
+    {
+      if (sources & (1 << source))
+        stamp += m_counters[source];
+    }
+    return stamp;
+  }
+
+private:
+  unsigned int m_counters[INFO_SOURCE_COUNT] = {};
+};
+
 /*!
  \ingroup info
  \brief Base class, wrapping boolean conditions and expressions
@@ -22,23 +66,30 @@ namespace INFO
 class InfoBool
 {
 public:
-  InfoBool(const std::string &expression, int context, unsigned int &refreshCounter);
+  InfoBool(const std::string &expression, int context, const InfoSourceCounters &counters);
   virtual ~InfoBool() = default;
 
   virtual void Initialize() {};
 
   /*! \brief Get the value of this info bool
-   This is called to update (if dirty) and fetch the value of the info bool
+   This is called to update (if dirty) and fetch the value of the info bool.
+   The value is only updated if one of the sources it depends on changed.
    \param item the item used to evaluate the bool
    */
   inline bool Get(const CGUIListItem *item = NULL)
   {
     if (item && m_listItemDependent)
       Update(item);
-    else if (m_refreshCounter != m_parentRefreshCounter || m_refreshCounter == 0)
+    else
     {
-      Update(NULL);
-      m_refreshCounter = m_parentRefreshCounter;
+      // nothing is cached before the first frame
+      const unsigned int stamp = m_counters.GetStamp(m_sources);
+      if (!m_valid || stamp != m_stamp || m_counters.Get(INFO_SOURCE_FRAME) == 0)
+      {
+        Update(NULL);
+        m_stamp = stamp;
+        m_valid = true;
+      }
     }
     return m_value;
   }
@@ -66,16 +117,23 @@ public:
 
   const std::string &GetExpression() const { return m_expression; }
   bool ListItemDependent() const { return m_listItemDependent; }
+
+  /*! \brief Get the sources this info bool depends on
+   \return bit mask of the sources, (1 << source) for each source
+   */
+  unsigned int GetSources() const { return m_sources; }
 protected:
 
   bool m_value;                ///< current value
   int m_context;               ///< contextual information to go with the condition
   bool m_listItemDependent;    ///< do not cache if a listitem pointer is given
   std::string  m_expression;   ///< original expression
+  unsigned int m_sources;      ///< the sources the value depends on, set by Initialize()
 
 private:
-  unsigned int m_refreshCounter;
-  unsigned int &m_parentRefreshCounter;
+  bool m_valid;
+  unsigned int m_stamp;
+  const InfoSourceCounters &m_counters;
 };
 
 typedef std::shared_ptr<InfoBool> InfoPtr;
@@ -9,6 +9,7 @@
 #include "InfoExpression.h"
 #include <stack>
 #include "utils/log.h"
+#include "utils/TraceRecorder.h"
 #include "GUIInfoManager.h"
 #include "guilib/GUIComponent.h"
 #include "ServiceBroker.h"
@@ -19,7 +20,9 @@ using namespace INFO;
 
 void InfoSingle::Initialize()
 {
-  m_condition = CServiceBroker::GetGUI()->GetInfoManager().TranslateSingleString(m_expression, m_listItemDependent);
+  CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+  m_condition = infoMgr.TranslateSingleString(m_expression, m_listItemDependent);
+  m_sources = infoMgr.GetConditionSources(m_condition);
 }
 
 void InfoSingle::Update(const CGUIListItem *item)
@@ -29,15 +32,19 @@ void InfoSingle::Update(const CGUIListItem *item)
 
 void InfoExpression::Initialize()
 {
+  // the operands add their sources
+  m_sources = 0;
   if (!Parse(m_expression))
   {
     CLog::Log(LOGERROR, "Error parsing boolean expression %s", m_expression.c_str());
     m_expression_tree = std::make_shared<InfoLeaf>(CServiceBroker::GetGUI()->GetInfoManager().Register("false", 0), false);
+    m_sources = 0;
   }
 }
 
 void InfoExpression::Update(const CGUIListItem *item)
 {
+  CTraceScope trace("InfoExpression::Update");
   m_value = m_expression_tree->Evaluate(item);
 }
 
@@ -240,8 +247,9 @@ bool InfoExpression::Parse(const std::string &expression)
           CLog::Log(LOGERROR, "Bad operand '%s'", operand.c_str());
           return false;
         }
-        /* Propagate any listItem dependency from the operand to the expression */
+        /* Propagate any listItem dependency and the sources from the operand to the expression */
         m_listItemDependent |= info->ListItemDependent();
+        m_sources |= info->GetSources();
         nodes.push(std::make_shared<InfoLeaf>(info, invert));
         /* Reuse operand string for next operand */
         operand.clear();
@@ -291,8 +299,9 @@ bool InfoExpression::Parse(const std::string &expression)
       CLog::Log(LOGERROR, "Bad operand '%s'", operand.c_str());
       return false;
     }
-    /* Propagate any listItem dependency from the operand to the expression */
+    /* Propagate any listItem dependency and the sources from the operand to the expression */
     m_listItemDependent |= info->ListItemDependent();
+    m_sources |= info->GetSources();
     nodes.push(std::make_shared<InfoLeaf>(info, invert));
   }
   while (!operator_stack.empty())
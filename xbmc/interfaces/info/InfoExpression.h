@@ -22,8 +22,8 @@ namespace INFO
 class InfoSingle : public InfoBool
 {
 public:
-  InfoSingle(const std::string &expression, int context, unsigned int &refreshCounter)
-    : InfoBool(expression, context, refreshCounter) {};
+  InfoSingle(const std::string &expression, int context, const InfoSourceCounters &counters)
+    : InfoBool(expression, context, counters) {};
   void Initialize() override;
 
   void Update(const CGUIListItem *item) override;
@@ -36,8 +36,8 @@ private:
 class InfoExpression : public InfoBool
 {
 public:
-  InfoExpression(const std::string &expression, int context, unsigned int &refreshCounter)
-    : InfoBool(expression, context, refreshCounter) {};
+  InfoExpression(const std::string &expression, int context, const InfoSourceCounters &counters)
+    : InfoBool(expression, context, counters) {};
   ~InfoExpression() override = default;
 
   void Initialize() override;
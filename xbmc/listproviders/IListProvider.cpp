@@ -11,6 +11,8 @@
 #include "StaticProvider.h"
 #include "DirectoryProvider.h"
 #include "MultiProvider.h"
+#include "PVRChannelsProvider.h"
+#include "utils/StringUtils.h"
 
 IListProvider *IListProvider::Create(const TiXmlNode *node, int parentID)
 {
@@ -32,6 +34,10 @@ IListProvider *IListProvider::CreateSingle(const TiXmlNode *content, int parentI
   if (item)
     return new CStaticListProvider(content->ToElement(), parentID);
 
+  const char *type = content->ToElement()->Attribute("type");
+  if (type && (StringUtils::EqualsNoCase(type, "tvchannels") || StringUtils::EqualsNoCase(type, "radiochannels")))
+    return new CPVRChannelsProvider(content->ToElement(), parentID);
+
   if (!content->NoChildren())
     return new CDirectoryProvider(content->ToElement(), parentID);
 
@@ -10,6 +10,7 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 
 class TiXmlNode;
 class CGUIListItem;
@@ -49,6 +50,41 @@ public:
    */
   virtual void Fetch(std::vector<CGUIListItemPtr> &items)=0;
 
+  /*! \brief Whether the items are created on demand.
+   Containers do not fetch the items of a virtual provider, they ask for the number of items
+   and get the few they show by their index. Memory use does not depend on the list size.
+   \return true if GetItemCount and GetItem are implemented, false otherwise.
+   \sa GetItemCount, GetItem, Prefetch
+   */
+  virtual bool IsVirtual() const { return false; }
+
+  /*! \brief The number of items of a virtual provider.
+   It must only change in Update().
+   \return the number of items.
+   */
+  virtual int GetItemCount() const { return 0; }
+
+  /*! \brief Create an item of a virtual provider.
+   \param index the position of the item, below GetItemCount().
+   \return the item, NULL if it could not be created.
+   */
+  virtual CGUIListItemPtr GetItem(int index) { return CGUIListItemPtr(); }
+
+  /*! \brief Find an item of a virtual provider by its path.
+   Allows a container to keep the selected item after an update without creating all items.
+   \param path the path of the item.
+   \return the index of the item, -1 if there is no such item.
+   */
+  virtual int GetIndexOfPath(const std::string &path) const { return -1; }
+
+  /*! \brief The items a container is about to show, the visible ones and those around them.
+   Allows a virtual provider with a slow source to load them ahead. The range wraps around the
+   end of the list if start is larger than end.
+   \param start the index of the first item.
+   \param end the index of the last item.
+   */
+  virtual void Prefetch(int start, int end) {}
+
   /*! \brief Check whether the list provider is updating content.
    \return true if in the processing of updating, false otherwise.
    */
@@ -0,0 +1,188 @@
+/*
+ *  Copyright (C) 2013-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRChannelsProvider.h"
+
+#include "ContextMenuManager.h"
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "pvr/PVRGUIActions.h"
+#include "pvr/PVRManager.h"
+#include "pvr/channels/PVRChannelGroup.h"
+#include "pvr/channels/PVRChannelGroupsContainer.h"
+#include "pvr/dialogs/GUIDialogPVRGuideInfo.h"
+#include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
+#include "utils/XBMCTinyXML.h"
+
+using namespace PVR;
+
+CPVRChannelsProvider::CPVRChannelsProvider(const TiXmlElement *element, int parentID)
+  : IListProvider(parentID),
+    m_radio(false)
+{
+  const char *type = element->Attribute("type");
+  if (type)
+    m_radio = StringUtils::EqualsNoCase(type, "radiochannels");
+}
+
+CPVRChannelsProvider::~CPVRChannelsProvider()
+{
+  Reset();
+}
+
+bool CPVRChannelsProvider::Update(bool forceRefresh)
+{
+  {
+    CSingleLock lock(m_section);
+    if (!m_invalidated && !forceRefresh)
+      return false;
+    m_invalidated = false;
+  }
+
+  Subscribe();
+
+  // not under our lock, the group notifies us with its own lock held
+  const CPVRChannelGroupsContainerPtr groups = CServiceBroker::GetPVRManager().ChannelGroups();
+  const CPVRChannelGroupPtr group = groups ? groups->GetGroupAll(m_radio) : CPVRChannelGroupPtr();
+  if (group != m_group)
+  {
+    if (m_group)
+      m_group->UnregisterObserver(this);
+    m_group = group;
+    if (m_group)
+      m_group->RegisterObserver(this);
+  }
+
+  // only the channels are kept, their items are created by GetItem()
+  std::vector<CPVRChannelPtr> channels;
+  if (group)
+  {
+    const std::vector<PVRChannelGroupMember> members = group->GetMembers(CPVRChannelGroup::Include::ONLY_VISIBLE);
+    channels.reserve(members.size());
+    for (const auto& member : members)
+      channels.push_back(member.channel);
+  }
+
+  CSingleLock lock(m_section);
+  m_channels.swap(channels);
+  return true;
+}
+
+void CPVRChannelsProvider::Fetch(std::vector<CGUIListItemPtr> &items)
+{
+  // for containers not supporting virtual providers
+  items.clear();
+  const int count = GetItemCount();
+  items.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    CGUIListItemPtr item = GetItem(i);
+    if (item)
+      items.push_back(item);
+  }
+}
+
+void CPVRChannelsProvider::Reset()
+{
+  Unsubscribe();
+
+  CSingleLock lock(m_section);
+  m_channels.clear();
+  m_invalidated = true;
+}
+
+int CPVRChannelsProvider::GetItemCount() const
+{
+  CSingleLock lock(m_section);
+  return static_cast<int>(m_channels.size());
+}
+
+CGUIListItemPtr CPVRChannelsProvider::GetItem(int index)
+{
+  CPVRChannelPtr channel;
+  {
+    CSingleLock lock(m_section);
+    if (index < 0 || index >= static_cast<int>(m_channels.size()))
+      return CGUIListItemPtr();
+    channel = m_channels[index];
+  }
+  return std::make_shared<CFileItem>(channel);
+}
+
+int CPVRChannelsProvider::GetIndexOfPath(const std::string &path) const
+{
+  CSingleLock lock(m_section);
+  for (size_t i = 0; i < m_channels.size(); ++i)
+  {
+    if (m_channels[i]->Path() == path)
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+bool CPVRChannelsProvider::OnClick(const CGUIListItemPtr &item)
+{
+  auto fileItem = std::static_pointer_cast<CFileItem>(item);
+  return CServiceBroker::GetPVRManager().GUIActions()->SwitchToChannel(fileItem, true);
+}
+
+bool CPVRChannelsProvider::OnInfo(const CGUIListItemPtr &item)
+{
+  auto fileItem = std::static_pointer_cast<CFileItem>(item);
+  CGUIDialogPVRGuideInfo::ShowFor(fileItem);
+  return true;
+}
+
+bool CPVRChannelsProvider::OnContextMenu(const CGUIListItemPtr &item)
+{
+  auto fileItem = std::static_pointer_cast<CFileItem>(item);
+  return CONTEXTMENU::ShowFor(fileItem);
+}
+
+void CPVRChannelsProvider::Notify(const Observable &obs, const ObservableMessage msg)
+{
+  switch (msg)
+  {
+    case ObservableMessageChannelGroup:
+    case ObservableMessageChannelGroupReset:
+    case ObservableMessageChannelGroupsLoaded:
+    case ObservableMessageManagerStopped:
+    {
+      CSingleLock lock(m_section);
+      m_invalidated = true;
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+void CPVRChannelsProvider::Subscribe()
+{
+  if (!m_isSubscribed)
+  {
+    m_isSubscribed = true;
+    CServiceBroker::GetPVRManager().RegisterObserver(this);
+  }
+}
+
+void CPVRChannelsProvider::Unsubscribe()
+{
+  if (m_group)
+  {
+    m_group->UnregisterObserver(this);
+    m_group.reset();
+  }
+
+  if (m_isSubscribed)
+  {
+    m_isSubscribed = false;
+    CServiceBroker::GetPVRManager().UnregisterObserver(this);
+  }
+}
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (C) 2013-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "IListProvider.h"
+#include "threads/CriticalSection.h"
+#include "utils/Observer.h"
+
+class TiXmlElement;
+
+namespace PVR
+{
+  class CPVRChannel;
+  class CPVRChannelGroup;
+}
+
+/*!
+ \ingroup listproviders
+ \brief Provides the channels of the TV or radio "all channels" group.
+
+ A virtual provider: it only keeps the channels, the items are created when a container shows
+ them. Used for <content type="tvchannels"/> or <content type="radiochannels"/>.
+ */
+class CPVRChannelsProvider : public IListProvider, public Observer
+{
+public:
+  CPVRChannelsProvider(const TiXmlElement *element, int parentID);
+  ~CPVRChannelsProvider() override;
+
+  bool Update(bool forceRefresh) override;
+  void Fetch(std::vector<CGUIListItemPtr> &items) override;
+  void Reset() override;
+  bool OnClick(const CGUIListItemPtr &item) override;
+  bool OnInfo(const CGUIListItemPtr &item) override;
+  bool OnContextMenu(const CGUIListItemPtr &item) override;
+
+  bool IsVirtual() const override { return true; }
+  int GetItemCount() const override;
+  CGUIListItemPtr GetItem(int index) override;
+  int GetIndexOfPath(const std::string &path) const override;
+
+  void Notify(const Observable &obs, const ObservableMessage msg) override;
+
+private:
+  void Subscribe();
+  void Unsubscribe();
+
+  bool m_radio;
+  bool m_isSubscribed = false;
+  bool m_invalidated = true;
+  std::shared_ptr<PVR::CPVRChannelGroup> m_group;
+  std::vector<std::shared_ptr<PVR::CPVRChannel>> m_channels;
+  mutable CCriticalSection m_section;
+};
@@ -15,6 +15,7 @@
 #include "guilib/GUIMessage.h"
 #include "messaging/IMessageTarget.h"
 #include "threads/SingleLock.h"
+#include "utils/TraceRecorder.h"
 
 namespace KODI
 {
@@ -221,6 +222,8 @@ void CApplicationMessenger::ProcessMessages()
 
 void CApplicationMessenger::ProcessMessage(ThreadMessage *pMsg)
 {
+  CTraceScope trace("CApplicationMessenger::ProcessMessage");
+
   //special case for this that we handle ourselves
   if (pMsg->dwMessage == TMSG_CALLBACK)
   {
@@ -593,37 +593,82 @@ int CMusicDatabase::AddSong(const int idAlbum,
     if (m_pDS->num_rows() == 0)
     {
       m_pDS->close();
-      strSQL=PrepareSQL("INSERT INTO song ("
-                                          "idSong,idAlbum,idPath,strArtistDisp,"
-                                          "strTitle,iTrack,iDuration,iYear,strFileName,"
-                                          "strMusicBrainzTrackID, strArtistSort, "
-                                          "iTimesPlayed,iStartOffset, "
-                                          "iEndOffset,lastplayed,rating,userrating,votes,comment,mood,strReplayGain"
-                        ") values (NULL, %i, %i, '%s', '%s', %i, %i, %i, '%s'",
-                    idAlbum,
-                    idPath,
-                    artistDisp.c_str(),
-                    strTitle.c_str(),
-                    iTrack, iDuration, iYear,
-                    strFileName.c_str());
-
-      if (strMusicBrainzTrackID.empty())
-        strSQL += PrepareSQL(",NULL");
-      else
-        strSQL += PrepareSQL(",'%s'", strMusicBrainzTrackID.c_str());
-      if (artistSort.empty())
-        strSQL += PrepareSQL(",NULL");
+      static const std::string insertSong = "INSERT INTO song ("
+                                            "idSong,idAlbum,idPath,strArtistDisp,"
+                                            "strTitle,iTrack,iDuration,iYear,strFileName,"
+                                            "strMusicBrainzTrackID, strArtistSort, "
+                                            "iTimesPlayed,iStartOffset, "
+                                            "iEndOffset,lastplayed,rating,userrating,votes,comment,mood,strReplayGain"
+                                            ") values (NULL, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+      dbiplus::PreparedStatement* stmt = GetPreparedStatement(insertSong);
+      if (stmt)
+      {
+        strSQL = insertSong;
+        stmt->bind(1, idAlbum);
+        stmt->bind(2, idPath);
+        stmt->bind(3, artistDisp);
+        stmt->bind(4, strTitle);
+        stmt->bind(5, iTrack);
+        stmt->bind(6, iDuration);
+        stmt->bind(7, iYear);
+        stmt->bind(8, strFileName);
+        if (strMusicBrainzTrackID.empty())
+          stmt->bind_null(9);
+        else
+          stmt->bind(9, strMusicBrainzTrackID);
+        if (artistSort.empty())
+          stmt->bind_null(10);
+        else
+          stmt->bind(10, artistSort);
+        stmt->bind(11, iTimesPlayed);
+        stmt->bind(12, iStartOffset);
+        stmt->bind(13, iEndOffset);
+        if (dtLastPlayed.IsValid())
+          stmt->bind(14, dtLastPlayed.GetAsDBDateTime());
+        else
+          stmt->bind_null(14);
+        stmt->bind(15, static_cast<double>(MathUtils::round_int(rating * 10)) / 10);
+        stmt->bind(16, userrating);
+        stmt->bind(17, votes);
+        stmt->bind(18, strComment);
+        stmt->bind(19, strMood);
+        stmt->bind(20, replayGain.Get());
+        stmt->exec();
+      }
       else
-        strSQL += PrepareSQL(",'%s'", artistSort.c_str());
+      {
+        strSQL=PrepareSQL("INSERT INTO song ("
+                                            "idSong,idAlbum,idPath,strArtistDisp,"
+                                            "strTitle,iTrack,iDuration,iYear,strFileName,"
+                                            "strMusicBrainzTrackID, strArtistSort, "
+                                            "iTimesPlayed,iStartOffset, "
+                                            "iEndOffset,lastplayed,rating,userrating,votes,comment,mood,strReplayGain"
+                          ") values (NULL, %i, %i, '%s', '%s', %i, %i, %i, '%s'",
+                      idAlbum,
+                      idPath,
+                      artistDisp.c_str(),
+                      strTitle.c_str(),
+                      iTrack, iDuration, iYear,
+                      strFileName.c_str());
 
-      if (dtLastPlayed.IsValid())
-        strSQL += PrepareSQL(",%i,%i,%i,'%s', %.1f, %i, %i, '%s','%s', '%s')",
-                      iTimesPlayed, iStartOffset, iEndOffset, dtLastPlayed.GetAsDBDateTime().c_str(), rating, userrating, votes,
-                      strComment.c_str(), strMood.c_str(), replayGain.Get().c_str());
-      else
-        strSQL += PrepareSQL(",%i,%i,%i,NULL, %.1f, %i, %i,'%s', '%s', '%s')",
-                      iTimesPlayed, iStartOffset, iEndOffset, rating, userrating, votes, strComment.c_str(), strMood.c_str(), replayGain.Get().c_str());
-      m_pDS->exec(strSQL);
+        if (strMusicBrainzTrackID.empty())
+          strSQL += PrepareSQL(",NULL");
+        else
+          strSQL += PrepareSQL(",'%s'", strMusicBrainzTrackID.c_str());
+        if (artistSort.empty())
+          strSQL += PrepareSQL(",NULL");
+        else
+          strSQL += PrepareSQL(",'%s'", artistSort.c_str());
+
+        if (dtLastPlayed.IsValid())
+          strSQL += PrepareSQL(",%i,%i,%i,'%s', %.1f, %i, %i, '%s','%s', '%s')",
+                        iTimesPlayed, iStartOffset, iEndOffset, dtLastPlayed.GetAsDBDateTime().c_str(), rating, userrating, votes,
+                        strComment.c_str(), strMood.c_str(), replayGain.Get().c_str());
+        else
+          strSQL += PrepareSQL(",%i,%i,%i,NULL, %.1f, %i, %i,'%s', '%s', '%s')",
+                        iTimesPlayed, iStartOffset, iEndOffset, rating, userrating, votes, strComment.c_str(), strMood.c_str(), replayGain.Get().c_str());
+        m_pDS->exec(strSQL);
+      }
       idSong = (int)m_pDS->lastinsertid();
     }
     else
@@ -1209,6 +1254,28 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
     if (NULL == m_pDB.get()) return -1;
     if (NULL == m_pDS.get()) return -1;
 
+    // During bulk transactions the ids of artists already looked up are kept. A lookup with
+    // another name runs the queries below again, as they may update the stored name.
+    std::map<std::string, std::pair<int, std::string>>* cache = nullptr;
+    std::string key;
+    if (InBulkTransaction())
+    {
+      if (strMusicBrainzArtistID.empty())
+      {
+        cache = &m_artistCache;
+        key = strArtist;
+        StringUtils::ToLower(key);
+      }
+      else
+      {
+        cache = &m_artistMBIDCache;
+        key = strMusicBrainzArtistID;
+      }
+      auto it = cache->find(key);
+      if (it != cache->end() && it->second.second == strArtist)
+        return it->second.first;
+    }
+
     // 1) MusicBrainz
     if (!strMusicBrainzArtistID.empty())
     {
@@ -1227,6 +1294,8 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
           m_pDS->exec(strSQL);
           m_pDS->close();
         }
+        if (cache)
+          (*cache)[key] = std::make_pair(idArtist, strArtist);
         return idArtist;
       }
       m_pDS->close();
@@ -1247,6 +1316,8 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
           bScrapedMBID,
           idArtist);
         m_pDS->exec(strSQL);
+        if (cache)
+          (*cache)[key] = std::make_pair(idArtist, strArtist);
         return idArtist;
       }
 
@@ -1264,6 +1335,8 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
       {
         int idArtist = m_pDS->fv("idArtist").get_asInt();
         m_pDS->close();
+        if (cache)
+          (*cache)[key] = std::make_pair(idArtist, strArtist);
         return idArtist;
       }
       m_pDS->close();
@@ -1281,6 +1354,8 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
 
     m_pDS->exec(strSQL);
     int idArtist = (int)m_pDS->lastinsertid();
+    if (cache)
+      (*cache)[key] = std::make_pair(idArtist, strArtist);
     return idArtist;
   }
   catch (...)
@@ -1569,6 +1644,16 @@ int CMusicDatabase::AddRole(const std::string &strRole)
   {
     if (NULL == m_pDB.get()) return -1;
     if (NULL == m_pDS.get()) return -1;
+
+    std::string key = strRole;
+    StringUtils::ToLower(key);
+    if (InBulkTransaction())
+    {
+      auto it = m_roleCache.find(key);
+      if (it != m_roleCache.end())
+        return it->second;
+    }
+
     strSQL = PrepareSQL("SELECT idRole FROM role WHERE strRole LIKE '%s'", strRole.c_str());
     m_pDS->query(strSQL);
     if (m_pDS->num_rows() > 0)
@@ -1582,6 +1667,9 @@ int CMusicDatabase::AddRole(const std::string &strRole)
       idRole = static_cast<int>(m_pDS->lastinsertid());
       m_pDS->close();
     }
+
+    if (InBulkTransaction() && idRole >= 0)
+      m_roleCache[key] = idRole;
   }
   catch (...)
   {
@@ -1598,6 +1686,26 @@ bool CMusicDatabase::AddSongArtist(int idArtist, int idSong, const std::string&
 
 bool CMusicDatabase::AddSongArtist(int idArtist, int idSong, int idRole, const std::string& strArtist, int iOrder)
 {
+  dbiplus::PreparedStatement* stmt = GetPreparedStatement("REPLACE INTO song_artist (idArtist, idSong, idRole, strArtist, iOrder) VALUES(?,?,?,?,?)");
+  if (stmt)
+  {
+    try
+    {
+      stmt->bind(1, idArtist);
+      stmt->bind(2, idSong);
+      stmt->bind(3, idRole);
+      stmt->bind(4, strArtist);
+      stmt->bind(5, iOrder);
+      stmt->exec();
+      return true;
+    }
+    catch (...)
+    {
+      CLog::Log(LOGERROR, "%s(%i, %i) failed", __FUNCTION__, idArtist, idSong);
+      return false;
+    }
+  }
+
   std::string strSQL;
   strSQL = PrepareSQL("replace into song_artist (idArtist, idSong, idRole, strArtist, iOrder) values(%i,%i,%i,'%s',%i)",
     idArtist, idSong, idRole, strArtist.c_str(), iOrder);
@@ -1735,6 +1843,25 @@ bool CMusicDatabase::DeleteSongArtistsBySong(int idSong)
 
 bool CMusicDatabase::AddAlbumArtist(int idArtist, int idAlbum, std::string strArtist, int iOrder)
 {
+  dbiplus::PreparedStatement* stmt = GetPreparedStatement("REPLACE INTO album_artist (idArtist, idAlbum, strArtist, iOrder) VALUES(?,?,?,?)");
+  if (stmt)
+  {
+    try
+    {
+      stmt->bind(1, idArtist);
+      stmt->bind(2, idAlbum);
+      stmt->bind(3, strArtist);
+      stmt->bind(4, iOrder);
+      stmt->exec();
+      return true;
+    }
+    catch (...)
+    {
+      CLog::Log(LOGERROR, "%s(%i, %i) failed", __FUNCTION__, idArtist, idAlbum);
+      return false;
+    }
+  }
+
   std::string strSQL;
   strSQL = PrepareSQL("replace into album_artist (idArtist, idAlbum, strArtist, iOrder) values(%i,%i,'%s',%i)",
     idArtist, idAlbum, strArtist.c_str(), iOrder);
@@ -1760,9 +1887,18 @@ bool CMusicDatabase::AddSongGenres(int idSong, const std::vector<std::string>& g
       return false;
     unsigned int index = 0;
     std::vector<std::string> modgenres = genres;
+    dbiplus::PreparedStatement* stmt = GetPreparedStatement("INSERT INTO song_genre (idGenre, idSong, iOrder) VALUES(?,?,?)");
     for (auto &strGenre : modgenres)
     {
       int idGenre = AddGenre(strGenre); // Genre string trimed and matched case insensitively
+      if (stmt)
+      {
+        stmt->bind(1, idGenre);
+        stmt->bind(2, idSong);
+        stmt->bind(3, static_cast<int>(index++));
+        stmt->exec();
+        continue;
+      }
       strSQL = PrepareSQL("INSERT INTO song_genre (idGenre, idSong, iOrder) VALUES(%i,%i,%i)",
         idGenre, idSong, index++);
       if (!ExecuteQuery(strSQL))
@@ -2959,6 +3095,9 @@ void CMusicDatabase::EmptyCache()
 {
   m_genreCache.erase(m_genreCache.begin(), m_genreCache.end());
   m_pathCache.erase(m_pathCache.begin(), m_pathCache.end());
+  m_artistCache.clear();
+  m_artistMBIDCache.clear();
+  m_roleCache.clear();
 }
 
 bool CMusicDatabase::Search(const std::string& search, CFileItemList &items)
@@ -4573,76 +4712,112 @@ bool CMusicDatabase::GetSongsFullByWhere(const std::string &baseDir, const Filte
     else
       strSQL = "SELECT songview.* FROM songview " + strSQLExtra;
 
-    CLog::Log(LOGDEBUG, "%s query = %s", __FUNCTION__, strSQL.c_str());
-    // run query
-    if (!m_pDS->query(strSQL))
-      return false;
-
-    int iRowsFound = m_pDS->num_rows();
-    if (iRowsFound == 0)
-    {
-      m_pDS->close();
-      return true;
-    }
-
-    // Store the total number of songs as a property
-    items.SetProperty("total", total);
-
-    DatabaseResults results;
-    results.reserve(iRowsFound);
     // Avoid sorting with limits when have join with songartistview
     // Limit when SortByNone already applied in SQL,
     // apply sort later to fileitems list rather than dataset
     sorting = sortDescription;
     if (artistData && sortDescription.sortBy != SortByNone)
       sorting.sortBy = SortByNone;
-    if (!SortUtils::SortFromDataset(sorting, MediaTypeSong, m_pDS, results))
-      return false;
 
     // Get songs from returned rows. If join songartistview then there is a row for every artist
-    items.Reserve(total);
     int songArtistOffset = song_enumCount;
     int songId = -1;
     VECARTISTCREDITS artistCredits;
-    const dbiplus::query_data &data = m_pDS->get_result_set().records;
     int count = 0;
-    for (const auto &i : results)
+    auto addRow = [&](const dbiplus::sql_record* const record)
     {
-      unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
-      const dbiplus::sql_record* const record = data.at(targetRow);
+      if (songId != record->at(song_idSong).get_asInt())
+      { //New song
+        if (songId > 0 && !artistCredits.empty())
+        {
+          //Store artist credits for previous song
+          GetFileItemFromArtistCredits(artistCredits, items[items.Size()-1].get());
+          artistCredits.clear();
+        }
+        songId = record->at(song_idSong).get_asInt();
+        CFileItemPtr item(new CFileItem);
+        GetFileItemFromDataset(record, item.get(), musicUrl);
+        // HACK for sorting by database returned order
+        item->m_iprogramCount = ++count;
+        items.Add(item);
+      }
+      // Get song artist credits and contributors
+      if (artistData)
+      {
+        int idSongArtistRole = record->at(songArtistOffset + artistCredit_idRole).get_asInt();
+        if (idSongArtistRole == ROLE_ARTIST)
+          artistCredits.push_back(GetArtistCreditFromDataset(record, songArtistOffset));
+        else
+          items[items.Size() - 1]->GetMusicInfoTag()->AppendArtistRole(GetArtistRoleFromDataset(record, songArtistOffset));
+      }
+    };
 
-      try
+    CLog::Log(LOGDEBUG, "%s query = %s", __FUNCTION__, strSQL.c_str());
+    if (sorting.sortBy == SortByNone)
+    {
+      // Rows are used in the order returned, read them through a cursor
+      // rather than holding the whole result set in memory
+      if (!m_pDS->query_cursor(strSQL))
+        return false;
+      if (m_pDS->eof())
       {
-        if (songId != record->at(song_idSong).get_asInt())
-        { //New song
-          if (songId > 0 && !artistCredits.empty())
-          {
-            //Store artist credits for previous song
-            GetFileItemFromArtistCredits(artistCredits, items[items.Size()-1].get());
-            artistCredits.clear();
-          }
-          songId = record->at(song_idSong).get_asInt();
-          CFileItemPtr item(new CFileItem);
-          GetFileItemFromDataset(record, item.get(), musicUrl);
-          // HACK for sorting by database returned order
-          item->m_iprogramCount = ++count;
-          items.Add(item);
+        m_pDS->close();
+        return true;
+      }
+
+      // Store the total number of songs as a property
+      items.SetProperty("total", total);
+      items.Reserve(total);
+      for (; !m_pDS->eof(); m_pDS->next())
+      {
+        try
+        {
+          addRow(m_pDS->get_sql_record());
         }
-        // Get song artist credits and contributors
-        if (artistData)
+        catch (...)
         {
-          int idSongArtistRole = record->at(songArtistOffset + artistCredit_idRole).get_asInt();
-          if (idSongArtistRole == ROLE_ARTIST)
-            artistCredits.push_back(GetArtistCreditFromDataset(record, songArtistOffset));
-          else
-            items[items.Size() - 1]->GetMusicInfoTag()->AppendArtistRole(GetArtistRoleFromDataset(record, songArtistOffset));
+          m_pDS->close();
+          CLog::Log(LOGERROR, "%s: out of memory loading query: %s", __FUNCTION__, filter.where.c_str());
+          return (items.Size() > 0);
         }
       }
-      catch (...)
+    }
+    else
+    {
+      // run query
+      if (!m_pDS->query(strSQL))
+        return false;
+
+      int iRowsFound = m_pDS->num_rows();
+      if (iRowsFound == 0)
       {
         m_pDS->close();
-        CLog::Log(LOGERROR, "%s: out of memory loading query: %s", __FUNCTION__, filter.where.c_str());
-        return (items.Size() > 0);
+        return true;
+      }
+
+      // Store the total number of songs as a property
+      items.SetProperty("total", total);
+
+      DatabaseResults results;
+      results.reserve(iRowsFound);
+      if (!SortUtils::SortFromDataset(sorting, MediaTypeSong, m_pDS, results))
+        return false;
+
+      items.Reserve(total);
+      const dbiplus::query_data &data = m_pDS->get_result_set().records;
+      for (const auto &i : results)
+      {
+        unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
+        try
+        {
+          addRow(data.at(targetRow));
+        }
+        catch (...)
+        {
+          m_pDS->close();
+          CLog::Log(LOGERROR, "%s: out of memory loading query: %s", __FUNCTION__, filter.where.c_str());
+          return (items.Size() > 0);
+        }
       }
     }
     if (!artistCredits.empty())
@@ -9218,6 +9393,10 @@ int CMusicDatabase::GetSongIDFromPath(const std::string &filePath)
 
 bool CMusicDatabase::CommitTransaction()
 {
+  // the library bools are refreshed once when the bulk transaction ends
+  if (InBulkTransaction())
+    return CDatabase::CommitTransaction();
+
   if (CDatabase::CommitTransaction())
   { // number of items in the db has likely changed, so reset the infomanager cache
     CGUIComponent* gui = CServiceBroker::GetGUI();
@@ -105,7 +105,7 @@ public:
 
   bool Open() override;
   bool CommitTransaction() override;
-  void EmptyCache();
+  void EmptyCache() override;
   void Clean();
   int  Cleanup(CGUIDialogProgress* progressDialog = nullptr);
   bool LookupCDDBInfo(bool bRequery=false);
@@ -632,6 +632,11 @@ void SetLibraryLastUpdated();
 protected:
   std::map<std::string, int> m_genreCache;
   std::map<std::string, int> m_pathCache;
+  // id maps only used during bulk transactions, keys are lowercase as matched by LIKE
+  // the artist maps keep the name an id was looked up with, another name is looked up again
+  std::map<std::string, std::pair<int, std::string>> m_artistCache;
+  std::map<std::string, std::pair<int, std::string>> m_artistMBIDCache;
+  std::map<std::string, int> m_roleCache;
 
   void CreateTables() override;
   void CreateAnalytics() override;
@@ -62,6 +62,10 @@ using namespace MUSIC_GRABBER;
 using namespace ADDON;
 using KODI::UTILITY::CDigest;
 
+#define MAX_QUEUED_DIRECTORIES 32 /* directories read ahead of the database writes */
+#define BULK_BATCH_ALBUMS 100 /* albums written per database transaction */
+#define BULK_BATCH_DURATION 2000 /* ms a transaction may keep the database locked */
+
 CMusicInfoScanner::CMusicInfoScanner()
 : m_fileCountReader(this, "MusicFileCounter")
 {
@@ -122,6 +126,10 @@ void CMusicInfoScanner::Process()
       m_bCanInterrupt = false;
       m_needsCleanup = false;
 
+      // Tags are read in parallel while the directories are walked, the
+      // database is only written from this thread
+      m_tagReader.reset(new CMusicTagReaderPool(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iMusicLibraryTagReaderThreads));
+
       bool commit = true;
       for (std::set<std::string>::const_iterator it = m_pathsToScan.begin(); it != m_pathsToScan.end(); ++it)
       {
@@ -140,7 +148,10 @@ void CMusicInfoScanner::Process()
 
         // Clear list of albums added by this scan
         m_albumsAdded.clear();
-        bool scancomplete = DoScan(*it);
+        // Write the albums in large transactions, committed before any online lookups
+        m_musicDatabase.BeginBulkTransaction(BULK_BATCH_ALBUMS, BULK_BATCH_DURATION);
+        bool scancomplete = DoScan(*it) && FlushTagReader(true);
+        m_musicDatabase.CommitBulkTransaction();
         if (scancomplete)
         {
           if (m_albumsAdded.size() > 0)
@@ -157,11 +168,15 @@ void CMusicInfoScanner::Process()
         }
         else
         {
+          m_tagReader->Cancel();
           commit = false;
           break;
         }
       }
 
+      CLog::Log(LOGDEBUG, "%s - Read tags at %.1f files/s", __FUNCTION__, m_tagReader->GetFilesPerSecond());
+      m_tagReader.reset();
+
       if (commit)
       {
         CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetLibraryInfoProvider().ResetLibraryBools();
@@ -505,15 +520,32 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
     items.FilterCueItems();
     items.Sort(SortByLabel, SortOrderAscending);
 
-    // and then scan in the new information from tags
-    if (RetrieveMusicInfo(strDirectory, items) > 0)
+    if (m_tagReader)
     {
-      if (m_handle)
-        OnDirectoryScanned(strDirectory);
+      // have the tags read in the background, the albums are added and the
+      // hash is saved once they are all loaded
+      std::unique_ptr<CMusicTagReaderPool::Directory> directory(new CMusicTagReaderPool::Directory);
+      directory->path = strDirectory;
+      directory->hash = hash;
+      directory->items.Append(items);
+      directory->items.SetPath(items.GetPath());
+      m_tagReader->Push(std::move(directory), regexps);
+
+      if (!FlushTagReader(m_tagReader->GetQueuedDirectories() > MAX_QUEUED_DIRECTORIES))
+        return false;
     }
+    else
+    {
+      // and then scan in the new information from tags
+      if (RetrieveMusicInfo(strDirectory, items) > 0)
+      {
+        if (m_handle)
+          OnDirectoryScanned(strDirectory);
+      }
 
-    // save information about this folder
-    m_musicDatabase.SetPathHash(strDirectory, hash);
+      // save information about this folder
+      m_musicDatabase.SetPathHash(strDirectory, hash);
+    }
   }
   else
   { // path is the same - no need to rescan
@@ -550,7 +582,8 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
 }
 
 CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
-                                                   CFileItemList& scannedItems)
+                                                   CFileItemList& scannedItems,
+                                                   bool tagsLoaded /* = false */)
 {
   std::vector<std::string> regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromScanRegExps;
 
@@ -561,21 +594,15 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
 
     CFileItemPtr pItem = items[i];
 
-    if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), regexps))
-      continue;
-
-    if (pItem->m_bIsFolder || pItem->IsPlayList() || pItem->IsPicture() || pItem->IsLyrics())
+    if (!CMusicTagReaderPool::IsTagCandidate(*pItem, regexps))
       continue;
 
     m_currentItem++;
 
+    if (!tagsLoaded)
+      CMusicTagReaderPool::LoadTag(*pItem);
+
     CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
-    if (!tag.Loaded())
-    {
-      std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(*pItem));
-      if (NULL != pLoader.get())
-        pLoader->Load(pItem->GetPath(), tag);
-    }
 
     if (m_handle && m_itemCount>0)
       m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) / static_cast<float>(m_itemCount));
@@ -845,7 +872,7 @@ CMusicInfoScanner::UpdateArtistInfo(CArtist& artist,
   return result;
 }
 
-int CMusicInfoScanner::RetrieveMusicInfo(const std::string& strDirectory, CFileItemList& items)
+int CMusicInfoScanner::RetrieveMusicInfo(const std::string& strDirectory, CFileItemList& items, bool tagsLoaded /* = false */)
 {
   MAPSONGS songsMap;
 
@@ -854,7 +881,7 @@ int CMusicInfoScanner::RetrieveMusicInfo(const std::string& strDirectory, CFileI
     m_needsCleanup = true;
 
   CFileItemList scannedItems;
-  if (ScanTags(items, scannedItems) == INFO_CANCELLED || scannedItems.Size() == 0)
+  if (ScanTags(items, scannedItems, tagsLoaded) == INFO_CANCELLED || scannedItems.Size() == 0)
     return 0;
 
   VECALBUMS albums;
@@ -912,6 +939,45 @@ int CMusicInfoScanner::RetrieveMusicInfo(const std::string& strDirectory, CFileI
   return numAdded;
 }
 
+bool CMusicInfoScanner::FlushTagReader(bool wait)
+{
+  while (!m_bStop)
+  {
+    std::unique_ptr<CMusicTagReaderPool::Directory> directory = m_tagReader->Pop(wait);
+    if (!directory)
+      break;
+
+    if (RetrieveMusicInfo(directory->path, directory->items, true) > 0)
+    {
+      if (m_handle)
+        OnDirectoryScanned(directory->path);
+    }
+    if (m_bStop)
+      break;
+
+    // save information about this folder
+    m_musicDatabase.SetPathHash(directory->path, directory->hash);
+
+    if (m_handle)
+    {
+      if (m_itemCount > 0)
+        m_handle->SetPercentage(static_cast<float>(m_currentItem * 100) / static_cast<float>(m_itemCount));
+      m_handle->SetText(StringUtils::Format(g_localizeStrings.Get(508).c_str(),
+                                            Prettify(directory->path).c_str(),
+                                            m_tagReader->GetFilesPerSecond(),
+                                            m_tagReader->GetQueuedDirectories(),
+                                            m_tagReader->GetQueuedFiles()));
+    }
+  }
+
+  if (m_bStop)
+  {
+    m_tagReader->Cancel();
+    return false;
+  }
+  return true;
+}
+
 void MUSIC_INFO::CMusicInfoScanner::ScrapeInfoAddedAlbums()
 {
   /* Strategy: Having scanned tags, make a list of albums and add them to the library, only then try
@@ -11,6 +11,7 @@
 #include "InfoScanner.h"
 #include "MusicAlbumInfo.h"
 #include "MusicInfoScraper.h"
+#include "MusicTagReaderPool.h"
 #include "music/MusicDatabase.h"
 #include "threads/Thread.h"
 #include "threads/IRunnable.h"
@@ -193,8 +194,9 @@ protected:
    Any files which couldn't be scanned (no/bad tags) are discarded in the process.
    \param items [in] list of FileItems to scan
    \param scannedItems [in] list to populate with the scannedItems
+   \param tagsLoaded [in] tags were already read by the tag reader pool
    */
-  int RetrieveMusicInfo(const std::string& strDirectory, CFileItemList& items);
+  int RetrieveMusicInfo(const std::string& strDirectory, CFileItemList& items, bool tagsLoaded = false);
 
   void RetrieveLocalArt();
   void ScrapeInfoAddedAlbums();
@@ -205,8 +207,16 @@ protected:
    Any files which couldn't be scanned (no/bad tags) are discarded in the process.
    \param items [in] list of FileItems to scan
    \param scannedItems [in] list to populate with the scannedItems
+   \param tagsLoaded [in] tags were already read by the tag reader pool, files without a tag are not retried
    */
-  INFO_RET ScanTags(const CFileItemList& items, CFileItemList& scannedItems);
+  INFO_RET ScanTags(const CFileItemList& items, CFileItemList& scannedItems, bool tagsLoaded = false);
+
+  /*! \brief Write the directories whose tags the tag reader pool has finished reading
+   Adds their albums and songs to the library and stores their path hashes, in scan order.
+   \param wait [in] wait for and write all queued directories, rather than just the completed ones
+   \return false if the scan was cancelled
+   */
+  bool FlushTagReader(bool wait);
   int GetPathHash(const CFileItemList &items, std::string &hash);
   void GetAlbumArtwork(long id, const CAlbum &artist);
 
@@ -238,5 +248,6 @@ protected:
   std::set<std::string> m_seenPaths;
   int m_flags;
   CThread m_fileCountReader;
+  std::unique_ptr<CMusicTagReaderPool> m_tagReader;
 };
 }
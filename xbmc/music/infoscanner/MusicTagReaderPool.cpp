@@ -0,0 +1,160 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "MusicTagReaderPool.h"
+
+#include "Util.h"
+#include "music/tags/MusicInfoTag.h"
+#include "music/tags/MusicInfoTagLoaderFactory.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+
+using namespace MUSIC_INFO;
+
+CMusicTagReaderPool::CMusicTagReaderPool(unsigned int workers)
+  : m_startTime(XbmcThreads::SystemClockMillis())
+{
+  if (workers == 0)
+    workers = 1;
+
+  for (unsigned int i = 0; i < workers; ++i)
+  {
+    m_workers.emplace_back(new CThread(this, "MusicTagReader"));
+    m_workers.back()->Create();
+  }
+}
+
+CMusicTagReaderPool::~CMusicTagReaderPool()
+{
+  {
+    CSingleLock lock(m_critSection);
+    m_stop = true;
+    m_tasks.clear();
+  }
+  m_workAvailable.notifyAll();
+
+  for (auto& worker : m_workers)
+    worker->StopThread(true);
+}
+
+bool CMusicTagReaderPool::IsTagCandidate(const CFileItem& item, const std::vector<std::string>& regexps)
+{
+  if (CUtil::ExcludeFileOrFolder(item.GetPath(), regexps))
+    return false;
+
+  return !(item.m_bIsFolder || item.IsPlayList() || item.IsPicture() || item.IsLyrics());
+}
+
+void CMusicTagReaderPool::LoadTag(CFileItem& item)
+{
+  CMusicInfoTag& tag = *item.GetMusicInfoTag();
+  if (!tag.Loaded())
+  {
+    std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(item));
+    if (NULL != pLoader.get())
+      pLoader->Load(item.GetPath(), tag);
+  }
+}
+
+void CMusicTagReaderPool::Push(std::unique_ptr<Directory> directory, const std::vector<std::string>& regexps)
+{
+  std::unique_ptr<Entry> entry(new Entry);
+  std::vector<Task> tasks;
+  for (int i = 0; i < directory->items.Size(); ++i)
+  {
+    CFileItemPtr item = directory->items[i];
+    if (IsTagCandidate(*item, regexps))
+      tasks.push_back({ entry.get(), item });
+  }
+  entry->remaining = tasks.size();
+  entry->directory = std::move(directory);
+
+  CSingleLock lock(m_critSection);
+  m_entries.push_back(std::move(entry));
+  m_tasks.insert(m_tasks.end(), tasks.begin(), tasks.end());
+  lock.Leave();
+
+  if (tasks.empty())
+    m_workDone.notifyAll();
+  else
+    m_workAvailable.notifyAll();
+}
+
+std::unique_ptr<CMusicTagReaderPool::Directory> CMusicTagReaderPool::Pop(bool wait)
+{
+  CSingleLock lock(m_critSection);
+  while (!m_entries.empty() && m_entries.front()->remaining > 0)
+  {
+    if (!wait)
+      return nullptr;
+    m_workDone.wait(lock);
+  }
+
+  if (m_entries.empty())
+    return nullptr;
+
+  std::unique_ptr<Directory> directory = std::move(m_entries.front()->directory);
+  m_entries.pop_front();
+  return directory;
+}
+
+void CMusicTagReaderPool::Cancel()
+{
+  CSingleLock lock(m_critSection);
+  m_tasks.clear();
+  while (m_busy > 0)
+    m_workDone.wait(lock);
+  m_entries.clear();
+}
+
+unsigned int CMusicTagReaderPool::GetQueuedDirectories() const
+{
+  CSingleLock lock(m_critSection);
+  return m_entries.size();
+}
+
+unsigned int CMusicTagReaderPool::GetQueuedFiles() const
+{
+  CSingleLock lock(m_critSection);
+  return m_tasks.size();
+}
+
+float CMusicTagReaderPool::GetFilesPerSecond() const
+{
+  CSingleLock lock(m_critSection);
+  unsigned int elapsed = XbmcThreads::SystemClockMillis() - m_startTime;
+  if (elapsed == 0)
+    return 0.0f;
+  return static_cast<float>(m_filesRead) * 1000.0f / elapsed;
+}
+
+void CMusicTagReaderPool::Run()
+{
+  CSingleLock lock(m_critSection);
+  while (!m_stop)
+  {
+    if (m_tasks.empty())
+    {
+      m_workAvailable.wait(lock);
+      continue;
+    }
+
+    Task task = m_tasks.front();
+    m_tasks.pop_front();
+    m_busy++;
+
+    lock.Leave();
+    LoadTag(*task.item);
+    lock.Enter();
+
+    m_busy--;
+    m_filesRead++;
+    task.entry->remaining--;
+    m_workDone.notifyAll();
+  }
+}
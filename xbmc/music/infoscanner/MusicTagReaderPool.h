@@ -0,0 +1,102 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "FileItem.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
+#include "threads/IRunnable.h"
+#include "threads/Thread.h"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace MUSIC_INFO
+{
+
+/*! \brief Pool of worker threads reading music tags in parallel.
+ The scanner pushes the directories that need (re)scanning in scan order.
+ The workers load the tags of their files, which is mostly waiting on I/O
+ for network sources. Directories are handed back in the order they were
+ pushed once all of their tags are loaded, so that the database writes
+ stay on the scanner thread and happen in the same order as before.
+ */
+class CMusicTagReaderPool : private IRunnable
+{
+public:
+  struct Directory
+  {
+    std::string path;     //!< path of the directory
+    std::string hash;     //!< path hash to store once the directory is written
+    CFileItemList items;  //!< items of the directory, tags of the files get loaded
+  };
+
+  explicit CMusicTagReaderPool(unsigned int workers);
+  ~CMusicTagReaderPool() override;
+
+  /*! \brief Queue a directory for tag reading
+   \param directory the directory, files to read are those accepted by IsTagCandidate
+   \param regexps exclude expressions for files that should not be read
+   */
+  void Push(std::unique_ptr<Directory> directory, const std::vector<std::string>& regexps);
+
+  /*! \brief Take the oldest directory if all of its tags are read
+   \param wait block until the oldest directory is complete
+   \return the directory, or nullptr if there is none (or none complete and not waiting)
+   */
+  std::unique_ptr<Directory> Pop(bool wait);
+
+  /*! \brief Drop all queued work and wait for the workers to go idle */
+  void Cancel();
+
+  /*! \brief Number of directories pushed but not yet popped */
+  unsigned int GetQueuedDirectories() const;
+
+  /*! \brief Number of files still waiting for a worker */
+  unsigned int GetQueuedFiles() const;
+
+  /*! \brief Average tag read throughput since the pool was created */
+  float GetFilesPerSecond() const;
+
+  /*! \brief Whether the scanner reads the tags of this item */
+  static bool IsTagCandidate(const CFileItem& item, const std::vector<std::string>& regexps);
+
+  /*! \brief Load the tag of an item unless already loaded */
+  static void LoadTag(CFileItem& item);
+
+private:
+  struct Entry
+  {
+    std::unique_ptr<Directory> directory;
+    unsigned int remaining = 0;
+  };
+
+  struct Task
+  {
+    Entry* entry;
+    CFileItemPtr item;
+  };
+
+  void Run() override;
+
+  mutable CCriticalSection m_critSection;
+  XbmcThreads::ConditionVariable m_workAvailable;
+  XbmcThreads::ConditionVariable m_workDone;
+  std::deque<std::unique_ptr<Entry>> m_entries;
+  std::deque<Task> m_tasks;
+  std::vector<std::unique_ptr<CThread>> m_workers;
+  unsigned int m_busy = 0;
+  unsigned int m_filesRead = 0;
+  unsigned int m_startTime;
+  bool m_stop = false;
+};
+
+}
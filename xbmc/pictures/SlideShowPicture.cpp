@@ -933,6 +933,8 @@ void CSlideShowPic::Render(float *x, float *y, CBaseTexture* pTexture, UTILS::Co
 
 #elif defined(HAS_GLES)
   CRenderSystemGLES *renderSystem = dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
+  // draw the queued GUI quads before changing texture and blend state
+  renderSystem->FlushBatch();
   if (pTexture)
   {
     pTexture->LoadToGPU();
@@ -272,12 +272,12 @@ int CPVRDatabase::Get(CPVRChannelGroup &results, bool bCompressDB)
         channel->m_iEpgId                  = bIgnoreEpgDB ? -1 : m_pDS->fv("idEpg").get_asInt();
         channel->UpdateEncryptionName();
 
-        PVRChannelGroupMember newMember(channel,
+        const std::shared_ptr<PVRChannelGroupMember> newMember = std::make_shared<PVRChannelGroupMember>(channel,
                                         CPVRChannelNumber(static_cast<unsigned int>(m_pDS->fv("iChannelNumber").get_asInt()),
                                                           static_cast<unsigned int>(m_pDS->fv("iSubChannelNumber").get_asInt())),
                                         0);
-        results.m_sortedMembers.emplace_back(newMember);
-        results.m_members.insert(std::make_pair(channel->StorageId(), newMember));
+        newMember->bNeedsSave = false;
+        results.AddMember(newMember);
 
         m_pDS->next();
         ++iReturn;
@@ -562,28 +562,21 @@ int CPVRDatabase::Get(CPVRChannelGroup &group, const CPVRChannelGroup &allGroup)
   {
     iReturn = 0;
 
-    // create a map to speedup data lookup
-    std::map<int, CPVRChannelPtr> allChannels;
-    for (const auto& groupMember : allGroup.GetMembers())
-    {
-      allChannels.insert(std::make_pair(groupMember.channel->ChannelID(), groupMember.channel));
-    }
-
     try
     {
       while (!m_pDS->eof())
       {
         int iChannelId = m_pDS->fv("idChannel").get_asInt();
-        const auto& channel = allChannels.find(iChannelId);
+        const CPVRChannelPtr channel = allGroup.GetByChannelID(iChannelId);
 
-        if (channel != allChannels.end())
+        if (channel)
         {
-          PVRChannelGroupMember newMember(channel->second,
+          const std::shared_ptr<PVRChannelGroupMember> newMember = std::make_shared<PVRChannelGroupMember>(channel,
                                           CPVRChannelNumber(static_cast<unsigned int>(m_pDS->fv("iChannelNumber").get_asInt()),
                                                             static_cast<unsigned int>(m_pDS->fv("iSubChannelNumber").get_asInt())),
                                           0);
-          group.m_sortedMembers.emplace_back(newMember);
-          group.m_members.insert(std::make_pair(channel->second->StorageId(), newMember));
+          newMember->bNeedsSave = false;
+          group.AddMember(newMember);
           ++iReturn;
         }
         else
@@ -620,33 +613,38 @@ bool CPVRDatabase::PersistChannels(CPVRChannelGroup &group)
   bool bReturn(true);
 
   CPVRChannelPtr channel;
+  std::vector<CPVRChannelPtr> newChannels;
   for (const auto& groupMember : group.m_members)
   {
-    channel = groupMember.second.channel;
+    channel = groupMember.second->channel;
     if (channel->IsChanged() || channel->IsNew())
     {
       if (Persist(*channel, false))
       {
-        groupMember.second.channel->Persisted();
+        channel->Persisted();
         bReturn = true;
       }
     }
+
+    if (channel->ChannelID() <= 0)
+      newChannels.emplace_back(channel);
   }
 
   bReturn &= CommitInsertQueries();
 
-  if (bReturn)
+  /* only channels that were not stored before need their database id */
+  if (bReturn && !newChannels.empty())
   {
     std::string strQuery;
     std::string strValue;
-    for (const auto& groupMember : group.m_members)
+    for (const auto& newChannel : newChannels)
     {
-      channel = groupMember.second.channel;
-      strQuery = PrepareSQL("iUniqueId = %u AND iClientId = %u", channel->UniqueID(), channel->ClientID());
+      strQuery = PrepareSQL("iUniqueId = %u AND iClientId = %u", newChannel->UniqueID(), newChannel->ClientID());
       strValue = GetSingleValue("channels", "idChannel", strQuery);
       if (!strValue.empty() && StringUtils::IsInteger(strValue))
-        channel->SetChannelID(atoi(strValue.c_str()));
+        newChannel->SetChannelID(atoi(strValue.c_str()));
     }
+    group.InvalidateIndex();
   }
 
   return bReturn;
@@ -661,23 +659,31 @@ bool CPVRDatabase::PersistGroupMembers(const CPVRChannelGroup &group)
 
   if (group.HasChannels())
   {
+    /* only members that are new or got another channel number since they were stored */
+    std::vector<std::shared_ptr<PVRChannelGroupMember>> savedMembers;
     for (const auto& groupMember : group.m_sortedMembers)
     {
-      const std::string strWhereClause = PrepareSQL("idChannel = %u AND idGroup = %u AND iChannelNumber = %u AND iSubChannelNumber = %u",
-          groupMember.channel->ChannelID(), group.GroupID(), groupMember.channelNumber.GetChannelNumber(), groupMember.channelNumber.GetSubChannelNumber());
-
-      const std::string strValue = GetSingleValue("map_channelgroups_channels", "idChannel", strWhereClause);
-      if (strValue.empty())
-      {
-        strQuery = PrepareSQL("REPLACE INTO map_channelgroups_channels ("
-            "idGroup, idChannel, iChannelNumber, iSubChannelNumber) "
-            "VALUES (%i, %i, %i, %i);",
-            group.GroupID(), groupMember.channel->ChannelID(), groupMember.channelNumber.GetChannelNumber(), groupMember.channelNumber.GetSubChannelNumber());
-        QueueInsertQuery(strQuery);
-      }
+      if (!groupMember->bNeedsSave || groupMember->channel->ChannelID() <= 0)
+        continue;
+
+      strQuery = PrepareSQL("REPLACE INTO map_channelgroups_channels ("
+          "idGroup, idChannel, iChannelNumber, iSubChannelNumber) "
+          "VALUES (%i, %i, %i, %i);",
+          group.GroupID(), groupMember->channel->ChannelID(), groupMember->channelNumber.GetChannelNumber(), groupMember->channelNumber.GetSubChannelNumber());
+      QueueInsertQuery(strQuery);
+      savedMembers.emplace_back(groupMember);
     }
 
     bReturn = CommitInsertQueries();
+    if (bReturn)
+    {
+      for (const auto& groupMember : savedMembers)
+        groupMember->bNeedsSave = false;
+    }
+
+    CLog::LogFC(LOGDEBUG, LOGPVR, "Stored %d of %d members of group '%s'",
+                static_cast<int>(savedMembers.size()), static_cast<int>(group.m_sortedMembers.size()), group.GroupName().c_str());
+
     bRemoveChannels = RemoveStaleChannelsFromGroup(group);
   }
 
@@ -86,6 +86,7 @@ void CPVRGUIInfo::ResetProperties(void)
 
   m_updateBackendCacheRequested = false;
   m_bRegistered = false;
+  m_iConditionState = 0;
 }
 
 void CPVRGUIInfo::ClearQualityInfo(PVR_SIGNAL_STATUS &qualityInfo)
@@ -117,13 +118,19 @@ void CPVRGUIInfo::Stop(void)
   {
     gui->GetInfoManager().UnregisterInfoProvider(this);
     m_bRegistered = false;
+
+    // without the provider all pvr conditions are false
+    gui->GetInfoManager().InfoSourceChanged(INFO::INFO_SOURCE_PVR);
   }
 }
 
 void CPVRGUIInfo::Notify(const Observable &obs, const ObservableMessage msg)
 {
   if (msg == ObservableMessageTimers || msg == ObservableMessageTimersReset)
+  {
     UpdateTimersCache();
+    UpdateConditionState();
+  }
 }
 
 void CPVRGUIInfo::Process(void)
@@ -178,6 +185,9 @@ void CPVRGUIInfo::Process(void)
     if (!m_bStop && iLoop % toggleInterval == 0)
       UpdateBackendCache();
 
+    if (!m_bStop)
+      UpdateConditionState();
+
     if (++iLoop == 1000)
       iLoop = 0;
 
@@ -1589,6 +1599,44 @@ void CPVRGUIInfo::UpdateTimersCache(void)
   m_radioTimersInfo.UpdateTimersCache();
 }
 
+void CPVRGUIInfo::UpdateConditionState(void)
+{
+  static const int conditions[] =
+  {
+    PVR_IS_RECORDING, PVR_IS_RECORDING_TV, PVR_IS_RECORDING_RADIO,
+    PVR_HAS_TIMER, PVR_HAS_TV_TIMER, PVR_HAS_RADIO_TIMER,
+    PVR_HAS_TV_CHANNELS, PVR_HAS_RADIO_CHANNELS,
+    PVR_HAS_NONRECORDING_TIMER, PVR_HAS_NONRECORDING_TV_TIMER, PVR_HAS_NONRECORDING_RADIO_TIMER,
+    PVR_IS_PLAYING_TV, PVR_IS_PLAYING_RADIO, PVR_IS_PLAYING_RECORDING, PVR_IS_PLAYING_EPGTAG,
+    PVR_ACTUAL_STREAM_ENCRYPTED, PVR_IS_TIMESHIFTING,
+    PVR_CAN_RECORD_PLAYING_CHANNEL, PVR_IS_RECORDING_PLAYING_CHANNEL
+  };
+
+  {
+    CSingleLock lock(m_critSection);
+
+    unsigned int iState = 0;
+    unsigned int iBit = 1;
+    for (int condition : conditions)
+    {
+      bool bValue = false;
+      if (GetPVRBool(nullptr, CGUIInfo(condition), bValue) && bValue)
+        iState |= iBit;
+      iBit <<= 1;
+    }
+
+    if (iState == m_iConditionState)
+      return;
+
+    m_iConditionState = iState;
+  }
+
+  // the info manager calls us with its lock held, so it must not be called with ours
+  CGUIComponent* gui = CServiceBroker::GetGUI();
+  if (gui)
+    gui->GetInfoManager().InfoSourceChanged(INFO::INFO_SOURCE_PVR);
+}
+
 void CPVRGUIInfo::UpdateTimersToggle(void)
 {
   m_anyTimersInfo.UpdateTimersToggle();
@@ -71,6 +71,12 @@ namespace PVR
 
     void UpdateTimersToggle(void);
 
+    /*!
+     * @brief Tell the info manager about a change of the values of the PVR bool conditions, so that
+     * the info bools depending on them are evaluated again.
+     */
+    void UpdateConditionState(void);
+
     bool GetListItemAndPlayerLabel(const CFileItem *item, const KODI::GUILIB::GUIINFO::CGUIInfo &info, std::string &strValue) const;
     bool GetPVRLabel(const CFileItem *item, const KODI::GUILIB::GUIINFO::CGUIInfo &info, std::string &strValue) const;
     bool GetRadioRDSLabel(const CFileItem *item, const KODI::GUILIB::GUIINFO::CGUIInfo &info, std::string &strValue) const;
@@ -154,5 +160,6 @@ namespace PVR
     mutable std::atomic<bool> m_updateBackendCacheRequested;
 
     bool m_bRegistered;
+    unsigned int m_iConditionState; /*!< bit mask of the values of the PVR bool conditions */
   };
 }
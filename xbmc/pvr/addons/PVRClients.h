@@ -148,6 +148,14 @@ namespace PVR
      */
     int GetCreatedClients(CPVRClientMap &clients) const;
 
+    /*!
+     * @brief Get all created clients and clients not (yet) ready to use.
+     * @param clientsReady Store the created clients in this map.
+     * @param clientsNotReady Store the the ids of the not (yet) ready clients in this list.
+     * @return PVR_ERROR_NO_ERROR in case all clients are ready, PVR_ERROR_SERVER_ERROR otherwise.
+     */
+    PVR_ERROR GetCreatedClients(CPVRClientMap &clientsReady, std::vector<int> &clientsNotReady) const;
+
     /*!
      * @brief Get the ID of the first created client.
      * @return the ID or -1 if no clients are created;
@@ -330,14 +338,6 @@ namespace PVR
      */
     bool IsCreatedClient(const ADDON::AddonPtr &addon);
 
-    /*!
-     * @brief Get all created clients and clients not (yet) ready to use.
-     * @param clientsReady Store the created clients in this map.
-     * @param clientsNotReady Store the the ids of the not (yet) ready clients in this list.
-     * @return PVR_ERROR_NO_ERROR in case all clients are ready, PVR_ERROR_SERVER_ERROR otherwise.
-     */
-    PVR_ERROR GetCreatedClients(CPVRClientMap &clientsReady, std::vector<int> &clientsNotReady) const;
-
     typedef std::function<PVR_ERROR(const CPVRClientPtr&)> PVRClientFunction;
 
     /*!
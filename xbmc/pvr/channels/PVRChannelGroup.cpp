@@ -21,6 +21,7 @@
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
@@ -29,7 +30,6 @@
 #include "pvr/PVRGUIProgressHandler.h"
 #include "pvr/PVRManager.h"
 #include "pvr/addons/PVRClients.h"
-#include "pvr/epg/EpgChannelData.h"
 #include "pvr/epg/EpgContainer.h"
 
 using namespace PVR;
@@ -74,13 +74,15 @@ CPVRChannelGroup::CPVRChannelGroup(const CPVRChannelGroup &group) :
   m_iLastWatched                = group.m_iLastWatched;
   m_bHidden                     = group.m_bHidden;
   m_bPreventSortAndRenumber     = group.m_bPreventSortAndRenumber;
-  m_members                     = group.m_members;
-  m_sortedMembers               = group.m_sortedMembers;
   m_iPosition                   = group.m_iPosition;
   m_failedClientsForChannels    = group.m_failedClientsForChannels;
   m_failedClientsForChannelGroupMembers = group.m_failedClientsForChannelGroupMembers;
   m_allChannelsGroup = group.m_allChannelsGroup;
 
+  // members are shared by the containers of a group, not between groups
+  for (const auto& member : group.m_sortedMembers)
+    AddMember(std::make_shared<PVRChannelGroupMember>(*member));
+
   OnInit();
 }
 
@@ -119,6 +121,8 @@ bool CPVRChannelGroup::Load(std::vector<std::shared_ptr<CPVRChannel>>& channelsT
   /* make sure this container is empty before loading */
   Unload();
 
+  const unsigned int iStart = XbmcThreads::SystemClockMillis();
+
   const std::shared_ptr<CSettings> settings = CServiceBroker::GetSettingsComponent()->GetSettings();
   m_bUsingBackendChannelOrder   = settings->GetBool(CSettings::SETTING_PVRMANAGER_BACKENDCHANNELORDER);
   m_bUsingBackendChannelNumbers = settings->GetBool(CSettings::SETTING_PVRMANAGER_USEBACKENDCHANNELNUMBERS);
@@ -142,6 +146,8 @@ bool CPVRChannelGroup::Load(std::vector<std::shared_ptr<CPVRChannel>>& channelsT
 
   m_bLoaded = true;
 
+  CLog::LogFC(LOGDEBUG, LOGPVR, "Loaded group '%s' with %d channels in %u ms",
+              m_strGroupName.c_str(), static_cast<int>(Size()), XbmcThreads::SystemClockMillis() - iStart);
   return true;
 }
 
@@ -150,6 +156,7 @@ void CPVRChannelGroup::Unload(void)
   CSingleLock lock(m_critSection);
   m_sortedMembers.clear();
   m_members.clear();
+  InvalidateIndex();
   m_failedClientsForChannels.clear();
   m_failedClientsForChannelGroupMembers.clear();
 }
@@ -174,25 +181,21 @@ std::string CPVRChannelGroup::GetPath() const
 
 bool CPVRChannelGroup::SetChannelNumber(const CPVRChannelPtr &channel, const CPVRChannelNumber &channelNumber)
 {
-  bool bReturn(false);
   CSingleLock lock(m_critSection);
 
-  for (PVR_CHANNEL_GROUP_SORTED_MEMBERS::iterator it = m_sortedMembers.begin(); it != m_sortedMembers.end(); ++it)
-  {
-    PVRChannelGroupMember& member(*it);
-    if (*member.channel == *channel)
-    {
-      if (member.channelNumber  != channelNumber)
-      {
-        m_bChanged = true;
-        bReturn = true;
-        member.channelNumber = channelNumber;
-      }
-      break;
-    }
-  }
+  const int iPosition = GetMemberPosition(channel);
+  if (iPosition < 0)
+    return false;
 
-  return bReturn;
+  PVRChannelGroupMember& member = *m_sortedMembers[iPosition];
+  if (member.channelNumber == channelNumber)
+    return false;
+
+  m_bChanged = true;
+  member.channelNumber = channelNumber;
+  member.bNeedsSave = true;
+  InvalidateIndex();
+  return true;
 }
 
 void CPVRChannelGroup::SearchAndSetChannelIcons(bool bUpdateDb /* = false */)
@@ -226,7 +229,7 @@ void CPVRChannelGroup::SearchAndSetChannelIcons(bool bUpdateDb /* = false */)
   CPVRChannelPtr channel;
   for(PVR_CHANNEL_GROUP_MEMBERS::const_iterator it = m_members.begin(); it != m_members.end(); ++it)
   {
-    channel = it->second.channel;
+    channel = it->second->channel;
 
     /* update progress dialog */
     progressHandler->UpdateProgress(channel->ChannelName(), channelIndex++, m_members.size());
@@ -265,24 +268,24 @@ void CPVRChannelGroup::SearchAndSetChannelIcons(bool bUpdateDb /* = false */)
 
 struct sortByClientChannelNumber
 {
-  bool operator()(const PVRChannelGroupMember &channel1, const PVRChannelGroupMember &channel2) const
+  bool operator()(const std::shared_ptr<PVRChannelGroupMember> &channel1, const std::shared_ptr<PVRChannelGroupMember> &channel2) const
   {
-    if (channel1.iClientPriority == channel2.iClientPriority)
+    if (channel1->iClientPriority == channel2->iClientPriority)
     {
-      if (channel1.channel->ClientChannelNumber() == channel2.channel->ClientChannelNumber())
-        return channel1.channel->ChannelName() < channel2.channel->ChannelName();
+      if (channel1->channel->ClientChannelNumber() == channel2->channel->ClientChannelNumber())
+        return channel1->channel->ChannelName() < channel2->channel->ChannelName();
 
-      return channel1.channel->ClientChannelNumber() < channel2.channel->ClientChannelNumber();
+      return channel1->channel->ClientChannelNumber() < channel2->channel->ClientChannelNumber();
     }
-    return channel1.iClientPriority > channel2.iClientPriority;
+    return channel1->iClientPriority > channel2->iClientPriority;
   }
 };
 
 struct sortByChannelNumber
 {
-  bool operator()(const PVRChannelGroupMember &channel1, const PVRChannelGroupMember &channel2) const
+  bool operator()(const std::shared_ptr<PVRChannelGroupMember> &channel1, const std::shared_ptr<PVRChannelGroupMember> &channel2) const
   {
-    return channel1.channelNumber < channel2.channelNumber;
+    return channel1->channelNumber < channel2->channelNumber;
   }
 };
 
@@ -305,14 +308,20 @@ void CPVRChannelGroup::SortByClientChannelNumber(void)
 {
   CSingleLock lock(m_critSection);
   if (!PreventSortAndRenumber())
+  {
     sort(m_sortedMembers.begin(), m_sortedMembers.end(), sortByClientChannelNumber());
+    InvalidateIndex();
+  }
 }
 
 void CPVRChannelGroup::SortByChannelNumber(void)
 {
   CSingleLock lock(m_critSection);
   if (!PreventSortAndRenumber())
+  {
     sort(m_sortedMembers.begin(), m_sortedMembers.end(), sortByChannelNumber());
+    InvalidateIndex();
+  }
 }
 
 bool CPVRChannelGroup::UpdateClientPriorities()
@@ -329,7 +338,7 @@ bool CPVRChannelGroup::UpdateClientPriorities()
     if (m_bUsingBackendChannelOrder)
     {
       CPVRClientPtr client;
-      if (!clients->GetCreatedClient(member.channel->ClientID(), client))
+      if (!clients->GetCreatedClient(member->channel->ClientID(), client))
         continue;
 
       iNewPriority = client->GetPriority();
@@ -339,8 +348,8 @@ bool CPVRChannelGroup::UpdateClientPriorities()
       iNewPriority = 0;
     }
 
-    bChanged |= (member.iClientPriority != iNewPriority);
-    member.iClientPriority = iNewPriority;
+    bChanged |= (member->iClientPriority != iNewPriority);
+    member->iClientPriority = iNewPriority;
   }
 
   return bChanged;
@@ -351,14 +360,14 @@ PVRChannelGroupMember& CPVRChannelGroup::GetByUniqueID(const std::pair<int, int>
 {
   CSingleLock lock(m_critSection);
   const auto it = m_members.find(id);
-  return it != m_members.end() ? it->second : CPVRChannelGroup::EmptyMember;
+  return it != m_members.end() ? *it->second : CPVRChannelGroup::EmptyMember;
 }
 
 const PVRChannelGroupMember& CPVRChannelGroup::GetByUniqueID(const std::pair<int, int>& id) const
 {
   CSingleLock lock(m_critSection);
   const auto it = m_members.find(id);
-  return it != m_members.end() ? it->second : CPVRChannelGroup::EmptyMember;
+  return it != m_members.end() ? *it->second : CPVRChannelGroup::EmptyMember;
 }
 
 CPVRChannelPtr CPVRChannelGroup::GetByUniqueID(int iUniqueChannelId, int iClientID) const
@@ -368,16 +377,25 @@ CPVRChannelPtr CPVRChannelGroup::GetByUniqueID(int iUniqueChannelId, int iClient
 
 CPVRChannelPtr CPVRChannelGroup::GetByChannelID(int iChannelID) const
 {
-  CPVRChannelPtr retval;
+  if (iChannelID <= 0)
+    return CPVRChannelPtr();
+
   CSingleLock lock(m_critSection);
+  UpdateIndex();
 
-  for (PVR_CHANNEL_GROUP_MEMBERS::const_iterator it = m_members.begin(); !retval && it != m_members.end(); ++it)
+  auto it = m_channelIdIndex.find(iChannelID);
+  if (it == m_channelIdIndex.end() && m_iUnindexedChannelIds > 0)
   {
-    if (it->second.channel->ChannelID() == iChannelID)
-      retval = it->second.channel;
+    // channels without database id when the index was built may have got one since
+    InvalidateIndex();
+    UpdateIndex();
+    it = m_channelIdIndex.find(iChannelID);
   }
 
-  return retval;
+  if (it != m_channelIdIndex.end() && m_sortedMembers[it->second]->channel->ChannelID() == iChannelID)
+    return m_sortedMembers[it->second]->channel;
+
+  return CPVRChannelPtr();
 }
 
 CPVRChannelPtr CPVRChannelGroup::GetByChannelEpgID(int iEpgID) const
@@ -387,8 +405,8 @@ CPVRChannelPtr CPVRChannelGroup::GetByChannelEpgID(int iEpgID) const
 
   for (PVR_CHANNEL_GROUP_MEMBERS::const_iterator it = m_members.begin(); !retval && it != m_members.end(); ++it)
   {
-    if (it->second.channel->EpgID() == iEpgID)
-      retval = it->second.channel;
+    if (it->second->channel->EpgID() == iEpgID)
+      retval = it->second->channel;
   }
 
   return retval;
@@ -401,7 +419,7 @@ CFileItemPtr CPVRChannelGroup::GetLastPlayedChannel(int iCurrentChannel /* = -1
   CPVRChannelPtr returnChannel, channel;
   for (PVR_CHANNEL_GROUP_MEMBERS::const_iterator it = m_members.begin(); it != m_members.end(); ++it)
   {
-    channel = it->second.channel;
+    channel = it->second->channel;
     if (channel->ChannelID() != iCurrentChannel &&
         CServiceBroker::GetPVRManager().Clients()->IsCreatedClient(channel->ClientID()) &&
         channel->LastWatched() > 0 &&
@@ -423,16 +441,14 @@ CPVRChannelNumber CPVRChannelGroup::GetChannelNumber(const CPVRChannelPtr &chann
 
 CFileItemPtr CPVRChannelGroup::GetByChannelNumber(const CPVRChannelNumber &channelNumber) const
 {
-  CFileItemPtr retval;
   CSingleLock lock(m_critSection);
+  UpdateIndex();
 
-  for (PVR_CHANNEL_GROUP_SORTED_MEMBERS::const_iterator it = m_sortedMembers.begin(); !retval && it != m_sortedMembers.end(); ++it)
-  {
-    if ((*it).channelNumber == channelNumber)
-      retval = CFileItemPtr(new CFileItem((*it).channel));
-  }
+  const auto it = m_channelNumberIndex.find(IndexKey(channelNumber));
+  if (it != m_channelNumberIndex.end())
+    return std::make_shared<CFileItem>(m_sortedMembers[it->second]->channel);
 
-  return retval;
+  return CFileItemPtr();
 }
 
 CFileItemPtr CPVRChannelGroup::GetNextChannel(const CPVRChannelPtr &channel) const
@@ -442,21 +458,20 @@ CFileItemPtr CPVRChannelGroup::GetNextChannel(const CPVRChannelPtr &channel) con
   if (channel)
   {
     CSingleLock lock(m_critSection);
-    for (PVR_CHANNEL_GROUP_SORTED_MEMBERS::const_iterator it = m_sortedMembers.begin(); !retval && it != m_sortedMembers.end(); ++it)
+    const int iPosition = GetMemberPosition(channel);
+    if (iPosition >= 0)
     {
-      if ((*it).channel == channel)
+      // the next visible channel, the channel itself if it is the only one
+      const size_t iSize = m_sortedMembers.size();
+      for (size_t i = 1; !retval && i <= iSize; ++i)
       {
-        do
-        {
-          if ((++it) == m_sortedMembers.end())
-            it = m_sortedMembers.begin();
-          if ((*it).channel && !(*it).channel->IsHidden())
-            retval = std::make_shared<CFileItem>((*it).channel);
-        } while (!retval && (*it).channel != channel);
-
-        if (!retval)
-          retval = std::make_shared<CFileItem>();
+        const CPVRChannelPtr& nextChannel = m_sortedMembers[(iPosition + i) % iSize]->channel;
+        if (nextChannel && !nextChannel->IsHidden())
+          retval = std::make_shared<CFileItem>(nextChannel);
       }
+
+      if (!retval)
+        retval = std::make_shared<CFileItem>();
     }
   }
 
@@ -470,21 +485,20 @@ CFileItemPtr CPVRChannelGroup::GetPreviousChannel(const CPVRChannelPtr &channel)
   if (channel)
   {
     CSingleLock lock(m_critSection);
-    for (PVR_CHANNEL_GROUP_SORTED_MEMBERS::const_reverse_iterator it = m_sortedMembers.rbegin(); !retval && it != m_sortedMembers.rend(); ++it)
+    const int iPosition = GetMemberPosition(channel);
+    if (iPosition >= 0)
     {
-      if ((*it).channel == channel)
+      // the previous visible channel, the channel itself if it is the only one
+      const size_t iSize = m_sortedMembers.size();
+      for (size_t i = 1; !retval && i <= iSize; ++i)
       {
-        do
-        {
-          if ((++it) == m_sortedMembers.rend())
-            it = m_sortedMembers.rbegin();
-          if ((*it).channel && !(*it).channel->IsHidden())
-            retval = std::make_shared<CFileItem>((*it).channel);
-        } while (!retval && (*it).channel != channel);
-
-        if (!retval)
-          retval = std::make_shared<CFileItem>();
+        const CPVRChannelPtr& previousChannel = m_sortedMembers[(iPosition + iSize - i) % iSize]->channel;
+        if (previousChannel && !previousChannel->IsHidden())
+          retval = std::make_shared<CFileItem>(previousChannel);
       }
+
+      if (!retval)
+        retval = std::make_shared<CFileItem>();
     }
   }
   return retval;
@@ -493,27 +507,26 @@ CFileItemPtr CPVRChannelGroup::GetPreviousChannel(const CPVRChannelPtr &channel)
 std::vector<PVRChannelGroupMember> CPVRChannelGroup::GetMembers(Include eFilter /* = Include::ALL */) const
 {
   CSingleLock lock(m_critSection);
-  if (eFilter == Include::ALL)
-    return m_sortedMembers;
 
   std::vector<PVRChannelGroupMember> members;
+  members.reserve(m_sortedMembers.size());
   for (const auto& member : m_sortedMembers)
   {
     switch (eFilter)
     {
       case Include::ONLY_HIDDEN:
-        if (!member.channel->IsHidden())
+        if (!member->channel->IsHidden())
           continue;
         break;
       case Include::ONLY_VISIBLE:
-        if (member.channel->IsHidden())
+        if (member->channel->IsHidden())
           continue;
        break;
       default:
         break;
     }
 
-    members.emplace_back(member);
+    members.emplace_back(*member);
   }
 
   return members;
@@ -523,7 +536,7 @@ void CPVRChannelGroup::GetChannelNumbers(std::vector<std::string>& channelNumber
 {
   CSingleLock lock(m_critSection);
   for (const auto& member : m_sortedMembers)
-    channelNumbers.emplace_back(member.channelNumber.FormattedChannelNumber());
+    channelNumbers.emplace_back(member->channelNumber.FormattedChannelNumber());
 }
 
 int CPVRChannelGroup::LoadFromDb(bool bCompress /* = false */)
@@ -562,7 +575,7 @@ bool CPVRChannelGroup::AddAndUpdateChannels(const CPVRChannelGroup &channels, bo
     if (!IsGroupMember(existingChannel.channel))
     {
       AddToGroup(existingChannel.channel,
-                 bUseBackendChannelNumbers ? it->second.channel->ClientChannelNumber() : CPVRChannelNumber(),
+                 bUseBackendChannelNumbers ? it->second->channel->ClientChannelNumber() : CPVRChannelNumber(),
                  bUseBackendChannelNumbers);
 
       bReturn = true;
@@ -596,9 +609,11 @@ std::vector<CPVRChannelPtr> CPVRChannelGroup::RemoveDeletedChannels(const CPVRCh
   CSingleLock lock(m_critSection);
 
   /* check for deleted channels */
-  for (PVR_CHANNEL_GROUP_SORTED_MEMBERS::iterator it = m_sortedMembers.begin(); it != m_sortedMembers.end();)
+  PVR_CHANNEL_GROUP_SORTED_MEMBERS keptMembers;
+  keptMembers.reserve(m_sortedMembers.size());
+  for (const auto& member : m_sortedMembers)
   {
-    const CPVRChannelPtr channel = (*it).channel;
+    const CPVRChannelPtr channel = member->channel;
     if (channels.m_members.find(channel->StorageId()) == channels.m_members.end())
     {
       /* channel was not found */
@@ -608,15 +623,20 @@ std::vector<CPVRChannelPtr> CPVRChannelGroup::RemoveDeletedChannels(const CPVRCh
       removedChannels.emplace_back(channel);
 
       m_members.erase(channel->StorageId());
-      it = m_sortedMembers.erase(it);
       m_bChanged = true;
     }
     else
     {
-      ++it;
+      keptMembers.emplace_back(member);
     }
   }
 
+  if (!removedChannels.empty())
+  {
+    m_sortedMembers.swap(keptMembers);
+    InvalidateIndex();
+  }
+
   return removedChannels;
 }
 
@@ -625,6 +645,7 @@ bool CPVRChannelGroup::UpdateGroupEntries(const CPVRChannelGroup& channels, std:
   bool bReturn(false);
   bool bChanged(false);
   bool bRemoved(false);
+  const unsigned int iStart = XbmcThreads::SystemClockMillis();
 
   CSingleLock lock(m_critSection);
   /* sort by client channel number if this is the first time or if SETTING_PVRMANAGER_BACKENDCHANNELORDER is true */
@@ -648,6 +669,9 @@ bool CPVRChannelGroup::UpdateGroupEntries(const CPVRChannelGroup& channels, std:
 
     SetChanged();
 
+    CLog::LogFC(LOGDEBUG, LOGPVR, "Updated group '%s' with %d channels in %u ms",
+                m_strGroupName.c_str(), static_cast<int>(m_members.size()), XbmcThreads::SystemClockMillis() - iStart);
+
     lock.Leave();
     NotifyObservers(HasNewChannels() || bRemoved || bRenumbered ? ObservableMessageChannelGroupReset : ObservableMessageChannelGroup);
   }
@@ -661,31 +685,21 @@ bool CPVRChannelGroup::UpdateGroupEntries(const CPVRChannelGroup& channels, std:
 
 bool CPVRChannelGroup::RemoveFromGroup(const CPVRChannelPtr &channel)
 {
-  bool bReturn(false);
   CSingleLock lock(m_critSection);
 
-  for (PVR_CHANNEL_GROUP_SORTED_MEMBERS::iterator it = m_sortedMembers.begin(); it != m_sortedMembers.end();)
-  {
-    if (*channel == *((*it).channel))
-    {
-      //! @todo notify observers
-      m_members.erase((*it).channel->StorageId());
-      it = m_sortedMembers.erase(it);
-      bReturn = true;
-      m_bChanged = true;
-      break;
-    }
-    else
-    {
-      ++it;
-    }
-  }
+  const int iPosition = GetMemberPosition(channel);
+  if (iPosition < 0)
+    return false;
 
-  // no need to renumber if nothing was removed
-  if (bReturn)
-    Renumber();
+  //! @todo notify observers
+  m_members.erase(channel->StorageId());
+  m_sortedMembers.erase(m_sortedMembers.begin() + iPosition);
+  InvalidateIndex();
+  m_bChanged = true;
 
-  return bReturn;
+  Renumber();
+
+  return true;
 }
 
 bool CPVRChannelGroup::AddToGroup(const CPVRChannelPtr &channel, const CPVRChannelNumber &channelNumber, bool bUseBackendChannelNumbers)
@@ -706,10 +720,10 @@ bool CPVRChannelGroup::AddToGroup(const CPVRChannelPtr &channel, const CPVRChann
           (!bUseBackendChannelNumbers && (iChannelNumber > m_members.size() + 1)))
         iChannelNumber = m_members.size() + 1;
 
-      PVRChannelGroupMember newMember(realChannel);
-      newMember.channelNumber = CPVRChannelNumber(iChannelNumber, channelNumber.GetSubChannelNumber());
-      m_sortedMembers.push_back(newMember);
-      m_members.insert(std::make_pair(realChannel.channel->StorageId(), newMember));
+      const std::shared_ptr<PVRChannelGroupMember> newMember = std::make_shared<PVRChannelGroupMember>(realChannel);
+      newMember->channelNumber = CPVRChannelNumber(iChannelNumber, channelNumber.GetSubChannelNumber());
+      newMember->bNeedsSave = true;
+      AddMember(newMember);
       m_bChanged = true;
 
       SortAndRenumber();
@@ -730,13 +744,51 @@ bool CPVRChannelGroup::IsGroupMember(const CPVRChannelPtr &channel) const
 
 bool CPVRChannelGroup::IsGroupMember(int iChannelId) const
 {
-  bool bReturn(false);
+  return GetByChannelID(iChannelId) != nullptr;
+}
+
+void CPVRChannelGroup::AddMember(const std::shared_ptr<PVRChannelGroupMember>& member)
+{
   CSingleLock lock(m_critSection);
+  m_sortedMembers.emplace_back(member);
+  m_members.insert(std::make_pair(member->channel->StorageId(), member));
+  InvalidateIndex();
+}
 
-  for (PVR_CHANNEL_GROUP_MEMBERS::const_iterator it = m_members.begin(); !bReturn && it != m_members.end(); ++it)
-    bReturn = (iChannelId == it->second.channel->ChannelID());
+void CPVRChannelGroup::UpdateIndex() const
+{
+  if (m_bIndexValid)
+    return;
 
-  return bReturn;
+  m_positionIndex.clear();
+  m_channelNumberIndex.clear();
+  m_channelIdIndex.clear();
+  m_iUnindexedChannelIds = 0;
+
+  for (size_t i = 0; i < m_sortedMembers.size(); ++i)
+  {
+    const PVRChannelGroupMember& member = *m_sortedMembers[i];
+    m_positionIndex.emplace(&member, i);
+    m_channelNumberIndex.emplace(IndexKey(member.channelNumber), i);
+
+    if (member.channel->ChannelID() > 0)
+      m_channelIdIndex.emplace(member.channel->ChannelID(), i);
+    else
+      m_iUnindexedChannelIds++;
+  }
+
+  m_bIndexValid = true;
+}
+
+int CPVRChannelGroup::GetMemberPosition(const CPVRChannelPtr& channel) const
+{
+  const auto it = m_members.find(channel->StorageId());
+  if (it == m_members.end())
+    return -1;
+
+  UpdateIndex();
+  const auto position = m_positionIndex.find(it->second.get());
+  return position != m_positionIndex.end() ? static_cast<int>(position->second) : -1;
 }
 
 bool CPVRChannelGroup::SetGroupName(const std::string &strGroupName, bool bSaveInDb /* = false */)
@@ -805,34 +857,35 @@ bool CPVRChannelGroup::Renumber(void)
   CSingleLock lock(m_critSection);
 
   CPVRChannelNumber currentChannelNumber;
-  for (PVR_CHANNEL_GROUP_SORTED_MEMBERS::iterator it = m_sortedMembers.begin(); it != m_sortedMembers.end(); ++it)
+  for (const auto& member : m_sortedMembers)
   {
-    if ((*it).channel->IsHidden())
+    if (member->channel->IsHidden())
     {
       currentChannelNumber = CPVRChannelNumber(0, 0);
     }
     else if (bUseBackendChannelNumbers)
     {
-      currentChannelNumber = (*it).channel->ClientChannelNumber();
+      currentChannelNumber = member->channel->ClientChannelNumber();
     }
     else
     {
       if (IsInternalGroup())
         currentChannelNumber = CPVRChannelNumber(++iChannelNumber, 0);
       else
-        currentChannelNumber = m_allChannelsGroup->GetChannelNumber((*it).channel);
+        currentChannelNumber = m_allChannelsGroup->GetChannelNumber(member->channel);
     }
 
-    if ((*it).channelNumber != currentChannelNumber)
+    if (member->channelNumber != currentChannelNumber)
     {
       bReturn = true;
       m_bChanged = true;
-      (*it).channelNumber = currentChannelNumber;
+      member->channelNumber = currentChannelNumber;
+      member->bNeedsSave = true;
     }
 
     //! @todo This is a quick fix for v18. Whole channel number handling should be reworked - code is imo unmaintainable.
     if (IsInternalGroup())
-      (*it).channel->SetChannelNumber((*it).channelNumber);
+      member->channel->SetChannelNumber(member->channelNumber);
   }
 
   SortByChannelNumber();
@@ -845,7 +898,7 @@ bool CPVRChannelGroup::HasChangedChannels(void) const
   CSingleLock lock(m_critSection);
 
   for (PVR_CHANNEL_GROUP_MEMBERS::const_iterator it = m_members.begin(); !bReturn && it != m_members.end(); ++it)
-    bReturn = it->second.channel->IsChanged();
+    bReturn = it->second->channel->IsChanged();
 
   return bReturn;
 }
@@ -856,7 +909,7 @@ bool CPVRChannelGroup::HasNewChannels(void) const
   CSingleLock lock(m_critSection);
 
   for (PVR_CHANNEL_GROUP_MEMBERS::const_iterator it = m_members.begin(); !bReturn && it != m_members.end(); ++it)
-    bReturn = it->second.channel->ChannelID() <= 0;
+    bReturn = it->second->channel->ChannelID() <= 0;
 
   return bReturn;
 }
@@ -909,46 +962,6 @@ void CPVRChannelGroup::OnSettingChanged(std::shared_ptr<const CSetting> setting)
   }
 }
 
-std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVRChannelGroup::GetEPGAll(bool bIncludeChannelsWithoutEPG /* = false */) const
-{
-  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
-
-  CPVREpgInfoTagPtr epgTag;
-  CPVRChannelPtr channel;
-  CSingleLock lock(m_critSection);
-
-  for (PVR_CHANNEL_GROUP_SORTED_MEMBERS::const_iterator it = m_sortedMembers.begin(); it != m_sortedMembers.end(); ++it)
-  {
-    channel = (*it).channel;
-    if (!channel->IsHidden())
-    {
-      bool bEmpty = true;
-
-      CPVREpgPtr epg = channel->GetEPG();
-      if (epg)
-      {
-        const std::vector<std::shared_ptr<CPVREpgInfoTag>> epgTags = epg->GetTags();
-        bEmpty = epgTags.empty();
-        if (!bEmpty)
-          tags.insert(tags.end(), epgTags.begin(), epgTags.end());
-      }
-
-      if (bIncludeChannelsWithoutEPG && bEmpty)
-      {
-        // Add dummy EPG tag associated with this channel
-        if (epg)
-          epgTag = std::make_shared<CPVREpgInfoTag>(epg->GetChannelData(), epg->EpgID());
-        else
-          epgTag = std::make_shared<CPVREpgInfoTag>(std::make_shared<CPVREpgChannelData>(*channel), -1);
-
-        tags.emplace_back(epgTag);
-      }
-    }
-  }
-
-  return tags;
-}
-
 CDateTime CPVRChannelGroup::GetEPGDate(EpgDateType epgDateType) const
 {
   CDateTime date;
@@ -958,7 +971,7 @@ CDateTime CPVRChannelGroup::GetEPGDate(EpgDateType epgDateType) const
 
   for (PVR_CHANNEL_GROUP_MEMBERS::const_iterator it = m_members.begin(); it != m_members.end(); ++it)
   {
-    channel = it->second.channel;
+    channel = it->second->channel;
     if (!channel->IsHidden() && (epg = channel->GetEPG()))
     {
       CDateTime epgDate;
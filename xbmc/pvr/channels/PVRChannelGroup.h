@@ -10,6 +10,8 @@
 
 #include <map>
 #include <memory>
+#include <stdint.h>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -40,10 +42,12 @@ namespace PVR
     CPVRChannelPtr channel;
     CPVRChannelNumber channelNumber; // the number this channel has in the group
     int iClientPriority = 0;
+    bool bNeedsSave = true; // the member is not stored in the database with this channel number yet
   };
 
-  typedef std::vector<PVRChannelGroupMember> PVR_CHANNEL_GROUP_SORTED_MEMBERS;
-  typedef std::map<std::pair<int, int>, PVRChannelGroupMember> PVR_CHANNEL_GROUP_MEMBERS;
+  /* both containers share the same member instances */
+  typedef std::vector<std::shared_ptr<PVRChannelGroupMember>> PVR_CHANNEL_GROUP_SORTED_MEMBERS;
+  typedef std::map<std::pair<int, int>, std::shared_ptr<PVRChannelGroupMember>> PVR_CHANNEL_GROUP_MEMBERS;
 
   enum EpgDateType
   {
@@ -368,13 +372,6 @@ namespace PVR
      */
     virtual bool CreateChannelEpgs(bool bForce = false);
 
-    /*!
-     * @brief Get all EPG tags for all channels in this group.
-     * @param bIncludeChannelsWithoutEPG, for channels without EPG data, put an empty EPG tag associated with the channel into results
-     * @return The tags.
-     */
-    std::vector<std::shared_ptr<CPVREpgInfoTag>> GetEPGAll(bool bIncludeChannelsWithoutEPG = false) const;
-
     /*!
      * @brief Get the start time of the first entry.
      * @return The start time.
@@ -493,6 +490,17 @@ namespace PVR
      */
     bool UpdateClientPriorities();
 
+    /*!
+     * @brief Add a member to the sorted members and to the members by unique id.
+     * @param member The new member.
+     */
+    void AddMember(const std::shared_ptr<PVRChannelGroupMember>& member);
+
+    /*!
+     * @brief Mark the lookup index as outdated, after members were added, removed, sorted or renumbered.
+     */
+    void InvalidateIndex() const { m_bIndexValid = false; }
+
     bool             m_bRadio = false;                      /*!< true if this container holds radio channels, false if it holds TV channels */
     int              m_iGroupType = PVR_GROUP_TYPE_DEFAULT;                  /*!< The type of this group */
     int              m_iGroupId = INVALID_GROUP_ID; /*!< The ID of this group in the database */
@@ -514,6 +522,30 @@ namespace PVR
   private:
     CDateTime GetEPGDate(EpgDateType epgDateType) const;
 
+    /*!
+     * @brief Rebuild the lookup index if it is outdated.
+     */
+    void UpdateIndex() const;
+
+    /*!
+     * @brief Get the position of a channel in the sorted members.
+     * @param channel The channel.
+     * @return The position or -1 if the channel is not a member.
+     */
+    int GetMemberPosition(const CPVRChannelPtr& channel) const;
+
+    static uint64_t IndexKey(const CPVRChannelNumber& channelNumber)
+    {
+      return (static_cast<uint64_t>(channelNumber.GetChannelNumber()) << 32) | channelNumber.GetSubChannelNumber();
+    }
+
     std::shared_ptr<CPVRChannelGroup> m_allChannelsGroup;
+
+    /* lookup index into m_sortedMembers, rebuilt on first use after changes */
+    mutable bool m_bIndexValid = false;
+    mutable std::unordered_map<const PVRChannelGroupMember*, size_t> m_positionIndex; /*!< positions by member */
+    mutable std::unordered_map<uint64_t, size_t> m_channelNumberIndex; /*!< positions of the first member with a channel number */
+    mutable std::unordered_map<int, size_t> m_channelIdIndex; /*!< positions by channel database id */
+    mutable size_t m_iUnindexedChannelIds = 0; /*!< members without a channel database id when the index was built */
   };
 }
@@ -79,10 +79,10 @@ void CPVRChannelGroupInternal::UpdateChannelPaths(void)
   m_iHiddenChannels = 0;
   for (PVR_CHANNEL_GROUP_MEMBERS::iterator it = m_members.begin(); it != m_members.end(); ++it)
   {
-    if (it->second.channel->IsHidden())
+    if (it->second->channel->IsHidden())
       ++m_iHiddenChannels;
     else
-      it->second.channel->UpdatePath(GetPath());
+      it->second->channel->UpdatePath(GetPath());
   }
 }
 
@@ -101,10 +101,8 @@ CPVRChannelPtr CPVRChannelGroupInternal::UpdateFromClient(const CPVRChannelPtr &
     if (iChannelNumber == 0)
       iChannelNumber = static_cast<int>(m_sortedMembers.size()) + 1;
 
-    PVRChannelGroupMember newMember(channel, CPVRChannelNumber(iChannelNumber, channelNumber.GetSubChannelNumber()), 0);
     channel->UpdatePath(GetPath());
-    m_sortedMembers.push_back(newMember);
-    m_members.insert(std::make_pair(channel->StorageId(), newMember));
+    AddMember(std::make_shared<PVRChannelGroupMember>(channel, CPVRChannelNumber(iChannelNumber, channelNumber.GetSubChannelNumber()), 0));
     m_bChanged = true;
 
     SortAndRenumber();
@@ -151,6 +149,8 @@ bool CPVRChannelGroupInternal::AddToGroup(const CPVRChannelPtr &channel, const C
   if (groupMember.channelNumber.GetChannelNumber() != iChannelNumber)
   {
     groupMember.channelNumber = CPVRChannelNumber(iChannelNumber, channelNumber.GetSubChannelNumber());
+    groupMember.bNeedsSave = true;
+    InvalidateIndex();
     bSort = true;
   }
 
@@ -241,22 +241,22 @@ bool CPVRChannelGroupInternal::AddAndUpdateChannels(const CPVRChannelGroup &chan
     if (existingChannel.channel)
     {
       /* if it's present, update the current tag */
-      if (existingChannel.channel->UpdateFromClient(it->second.channel))
+      if (existingChannel.channel->UpdateFromClient(it->second->channel))
       {
         bReturn = true;
-        CLog::LogFC(LOGDEBUG, LOGPVR, "Updated {} channel '{}' from PVR client", m_bRadio ? "radio" : "TV", it->second.channel->ChannelName());
+        CLog::LogFC(LOGDEBUG, LOGPVR, "Updated {} channel '{}' from PVR client", m_bRadio ? "radio" : "TV", it->second->channel->ChannelName());
       }
     }
     else
     {
       /* new channel */
-      UpdateFromClient(it->second.channel, bUseBackendChannelNumbers ? it->second.channel->ClientChannelNumber() : CPVRChannelNumber());
-      if (it->second.channel->CreateEPG())
+      UpdateFromClient(it->second->channel, bUseBackendChannelNumbers ? it->second->channel->ClientChannelNumber() : CPVRChannelNumber());
+      if (it->second->channel->CreateEPG())
       {
-         CLog::LogFC(LOGDEBUG, LOGPVR, "Created EPG for {} channel '{}' from PVR client", m_bRadio ? "radio" : "TV", it->second.channel->ChannelName());
+         CLog::LogFC(LOGDEBUG, LOGPVR, "Created EPG for {} channel '{}' from PVR client", m_bRadio ? "radio" : "TV", it->second->channel->ChannelName());
       }
       bReturn = true;
-      CLog::LogFC(LOGDEBUG, LOGPVR, "Added {} channel '{}' from PVR client", m_bRadio ? "radio" : "TV", it->second.channel->ChannelName());
+      CLog::LogFC(LOGDEBUG, LOGPVR, "Added {} channel '{}' from PVR client", m_bRadio ? "radio" : "TV", it->second->channel->ChannelName());
     }
   }
 
@@ -318,7 +318,7 @@ bool CPVRChannelGroupInternal::CreateChannelEpgs(bool bForce /* = false */)
   {
     CSingleLock lock(m_critSection);
     for (PVR_CHANNEL_GROUP_MEMBERS::iterator it = m_members.begin(); it != m_members.end(); ++it)
-      CreateChannelEpg(it->second.channel);
+      CreateChannelEpg(it->second->channel);
   }
 
   if (HasChangedChannels())
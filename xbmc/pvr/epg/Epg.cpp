@@ -8,11 +8,13 @@
 
 #include "Epg.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "addons/PVRClient.h"
 #include "addons/kodi-addon-dev-kit/include/kodi/xbmc_epg_types.h"
 #include "ServiceBroker.h"
+#include "cores/DataCacheCore.h"
 #include "guilib/LocalizeStrings.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
@@ -23,11 +25,13 @@
 #include "pvr/PVRManager.h"
 #include "pvr/epg/EpgChannelData.h"
 #include "pvr/epg/EpgDatabase.h"
+#include "pvr/epg/EpgSearchFilter.h"
 
 using namespace PVR;
 
 CPVREpg::CPVREpg(int iEpgID, const std::string& strName, const std::string& strScraperName)
-: m_bChanged(false),
+: m_tags(CServiceBroker::GetPVRManager().EpgContainer().GetStringPool()),
+  m_bChanged(false),
   m_iEpgID(iEpgID),
   m_strName(strName),
   m_strScraperName(strScraperName),
@@ -36,7 +40,8 @@ CPVREpg::CPVREpg(int iEpgID, const std::string& strName, const std::string& strS
 }
 
 CPVREpg::CPVREpg(int iEpgID, const std::string& strName, const std::string& strScraperName, const std::shared_ptr<CPVREpgChannelData>& channelData)
-: m_bChanged(true),
+: m_tags(CServiceBroker::GetPVRManager().EpgContainer().GetStringPool()),
+  m_bChanged(true),
   m_iEpgID(iEpgID),
   m_strName(strName),
   m_strScraperName(strScraperName),
@@ -64,14 +69,17 @@ bool CPVREpg::HasValidEntries(void) const
 {
   CSingleLock lock(m_critSection);
   return (m_iEpgID > 0 && /* valid EPG ID */
-          !m_tags.empty() && /* contains at least 1 tag */
-          m_tags.rbegin()->second->EndAsUTC() >= CDateTime::GetCurrentDateTime().GetAsUTCDateTime()); /* the last end time hasn't passed yet */
+          !m_tags.Empty() && /* contains at least 1 tag */
+          m_tags.At(m_tags.Size() - 1).endTime >= CPVREpgTagStore::ToTime(CDateTime::GetUTCDateTime())); /* the last end time hasn't passed yet */
 }
 
 void CPVREpg::Clear(void)
 {
   CSingleLock lock(m_critSection);
-  m_tags.clear();
+  m_tags.Clear();
+  m_liveTags.clear();
+  ++m_iRevision;
+  m_nowActiveStart = CPVREpgTagStore::INVALID_TIME;
 }
 
 void CPVREpg::Cleanup(int iPastDays)
@@ -83,52 +91,46 @@ void CPVREpg::Cleanup(int iPastDays)
 void CPVREpg::Cleanup(const CDateTime &time)
 {
   CSingleLock lock(m_critSection);
-  for (auto it = m_tags.begin(); it != m_tags.end();)
+  if (m_tags.EraseEndingBefore(CPVREpgTagStore::ToTime(time)) > 0)
   {
-    if (it->second->EndAsUTC() < time)
-    {
-      if (m_nowActiveStart == it->first)
-        m_nowActiveStart.SetValid(false);
+    ++m_iRevision;
+    if (m_nowActiveStart != CPVREpgTagStore::INVALID_TIME && m_tags.Find(m_nowActiveStart) < 0)
+      m_nowActiveStart = CPVREpgTagStore::INVALID_TIME;
 
-      it = m_tags.erase(it);
-    }
-    else
-    {
-      ++it;
-    }
+    SweepLiveTags();
   }
 }
 
 CPVREpgInfoTagPtr CPVREpg::GetTagNow(bool bUpdateIfNeeded /* = true */) const
 {
   CSingleLock lock(m_critSection);
-  if (m_nowActiveStart.IsValid())
+  const time_t now = GetCurrentPlayingTime();
+
+  if (m_nowActiveStart != CPVREpgTagStore::INVALID_TIME)
   {
-    const auto it = m_tags.find(m_nowActiveStart);
-    if (it != m_tags.end() && it->second->IsActive())
-      return it->second;
+    const int index = m_tags.Find(m_nowActiveStart);
+    if (index >= 0 && m_tags.At(index).startTime <= now && m_tags.At(index).endTime > now)
+      return GetTag(index);
   }
 
   if (bUpdateIfNeeded)
   {
-    CPVREpgInfoTagPtr lastActiveTag;
-
-    /* one of the first items will always match if the list is sorted */
-    for (const auto& tag : m_tags)
+    /* the last event started before now is either active or the last one that was active */
+    const size_t index = m_tags.UpperBound(now);
+    if (index > 0)
     {
-      if (tag.second->IsActive())
+      const CPVREpgTagStore::Record& record = m_tags.At(index - 1);
+      if (record.endTime > now)
       {
-        m_nowActiveStart = tag.first;
-        return tag.second;
+        m_nowActiveStart = record.startTime;
+        return GetTag(index - 1);
       }
-      else if (tag.second->WasActive())
-        lastActiveTag = tag.second;
-    }
 
-    /* there might be a gap between the last and next event. return the last if found and it ended not more than 5 minutes ago */
-    if (lastActiveTag &&
-        lastActiveTag->EndAsUTC() + CDateTimeSpan(0, 0, 5, 0) >= CDateTime::GetUTCDateTime())
-      return lastActiveTag;
+      /* there might be a gap between the last and next event. return the last if found and it ended not more than 5 minutes ago */
+      if (record.endTime < now &&
+          record.endTime + 5 * 60 >= CPVREpgTagStore::ToTime(CDateTime::GetUTCDateTime()))
+        return GetTag(index - 1);
+    }
   }
 
   return CPVREpgInfoTagPtr();
@@ -136,22 +138,20 @@ CPVREpgInfoTagPtr CPVREpg::GetTagNow(bool bUpdateIfNeeded /* = true */) const
 
 CPVREpgInfoTagPtr CPVREpg::GetTagNext() const
 {
+  CSingleLock lock(m_critSection);
   const CPVREpgInfoTagPtr nowTag = GetTagNow();
   if (nowTag)
   {
-    CSingleLock lock(m_critSection);
-    auto it = m_tags.find(nowTag->StartAsUTC());
-    if (it != m_tags.end() && ++it != m_tags.end())
-      return it->second;
+    const int index = m_tags.Find(CPVREpgTagStore::ToTime(nowTag->StartAsUTC()));
+    if (index >= 0 && static_cast<size_t>(index) + 1 < m_tags.Size())
+      return GetTag(index + 1);
   }
-  else if (m_tags.size() > 0)
+  else
   {
     /* return the first event that is in the future */
-    for (const auto& tag : m_tags)
-    {
-      if (tag.second->IsUpcoming())
-        return tag.second;
-    }
+    const size_t index = m_tags.UpperBound(GetCurrentPlayingTime());
+    if (index < m_tags.Size())
+      return GetTag(index);
   }
 
   return CPVREpgInfoTagPtr();
@@ -159,24 +159,22 @@ CPVREpgInfoTagPtr CPVREpg::GetTagNext() const
 
 CPVREpgInfoTagPtr CPVREpg::GetTagPrevious() const
 {
+  CSingleLock lock(m_critSection);
   const CPVREpgInfoTagPtr nowTag = GetTagNow();
   if (nowTag)
   {
-    CSingleLock lock(m_critSection);
-    auto it = m_tags.find(nowTag->StartAsUTC());
-    if (it != m_tags.end() && it != m_tags.begin())
-    {
-      --it;
-      return it->second;
-    }
+    const int index = m_tags.Find(CPVREpgTagStore::ToTime(nowTag->StartAsUTC()));
+    if (index > 0)
+      return GetTag(index - 1);
   }
-  else if (m_tags.size() > 0)
+  else
   {
-    /* return the first event that is in the past */
-    for (auto it = m_tags.rbegin(); it != m_tags.rend(); ++it)
+    /* return the last event that is in the past */
+    const time_t now = GetCurrentPlayingTime();
+    for (size_t index = m_tags.UpperBound(now); index > 0; --index)
     {
-      if (it->second->WasActive())
-        return it->second;
+      if (m_tags.At(index - 1).endTime < now)
+        return GetTag(index - 1);
     }
   }
 
@@ -203,68 +201,138 @@ CPVREpgInfoTagPtr CPVREpg::GetTagByBroadcastId(unsigned int iUniqueBroadcastId)
   if (iUniqueBroadcastId != EPG_TAG_INVALID_UID)
   {
     CSingleLock lock(m_critSection);
-    for (const auto &infoTag : m_tags)
-    {
-      if (infoTag.second->UniqueBroadcastID() == iUniqueBroadcastId)
-        return infoTag.second;
-    }
+    const int index = m_tags.FindByBroadcastId(iUniqueBroadcastId);
+    if (index >= 0)
+      return GetTag(index);
   }
   return CPVREpgInfoTagPtr();
 }
 
 CPVREpgInfoTagPtr CPVREpg::GetTagBetween(const CDateTime &beginTime, const CDateTime &endTime, bool bUpdateFromClient /* = false */)
 {
-  CPVREpgInfoTagPtr tag;
+  const time_t begin = CPVREpgTagStore::ToTime(beginTime);
+  const time_t end = CPVREpgTagStore::ToTime(endTime);
 
   CSingleLock lock(m_critSection);
-  for (const auto& epgTag : m_tags)
+  for (size_t index = m_tags.LowerBound(begin); index < m_tags.Size() && m_tags.At(index).startTime <= end; ++index)
   {
-    if (epgTag.second->StartAsUTC() >= beginTime && epgTag.second->EndAsUTC() <= endTime)
-    {
-      tag = epgTag.second;
-      break;
-    }
+    if (m_tags.At(index).endTime <= end)
+      return GetTag(index);
   }
 
-  if (!tag && bUpdateFromClient)
+  if (bUpdateFromClient)
   {
     // not found locally; try to fetch from client
-    time_t b;
-    beginTime.GetAsTime(b);
-    time_t e;
-    endTime.GetAsTime(e);
-
     const std::shared_ptr<CPVREpg> tmpEpg = std::make_shared<CPVREpg>(m_iEpgID, m_strName, m_strScraperName, m_channelData);
-    if (tmpEpg->UpdateFromScraper(b, e, true))
-      tag = tmpEpg->GetTagBetween(beginTime, endTime, false);
-
-    if (tag)
+    if (tmpEpg->UpdateFromScraper(begin, end, true))
     {
-      m_tags.insert(std::make_pair(tag->StartAsUTC(), tag));
-      UpdateEntry(tag, !CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_EPG_IGNOREDBFORCLIENT));
+      const CPVREpgInfoTagPtr tag = tmpEpg->GetTagBetween(beginTime, endTime, false);
+      if (tag)
+      {
+        UpdateEntry(tag, !CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_EPG_IGNOREDBFORCLIENT));
+
+        const int index = m_tags.Find(CPVREpgTagStore::ToTime(tag->StartAsUTC()));
+        if (index >= 0)
+          return GetTag(index);
+      }
     }
   }
 
-  return tag;
+  return CPVREpgInfoTagPtr();
 }
 
-void CPVREpg::AddEntry(const CPVREpgInfoTag &tag)
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpg::GetTagsBetween(const CDateTime& start, const CDateTime& end) const
 {
-  CPVREpgInfoTagPtr newTag;
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+  const time_t begin = CPVREpgTagStore::ToTime(start);
+  const time_t finish = CPVREpgTagStore::ToTime(end);
 
   CSingleLock lock(m_critSection);
-  const auto it = m_tags.find(tag.StartAsUTC());
-  if (it != m_tags.end())
-    newTag = it->second;
-  else
+  size_t index = m_tags.UpperBound(begin);
+
+  /* the last event started before the window may still be running */
+  if (index > 0 && m_tags.At(index - 1).endTime > begin)
+    --index;
+
+  for (; index < m_tags.Size() && m_tags.At(index).startTime < finish; ++index)
+    tags.emplace_back(GetTag(index));
+
+  return tags;
+}
+
+CPVREpgInfoTagPtr CPVREpg::GetTag(size_t index) const
+{
+  const time_t startTime = m_tags.At(index).startTime;
+  const auto it = m_liveTags.find(startTime);
+  if (it != m_liveTags.end())
   {
-    newTag.reset(new CPVREpgInfoTag());
-    m_tags.insert(std::make_pair(tag.StartAsUTC(), newTag));
+    const CPVREpgInfoTagPtr tag = it->second.lock();
+    if (tag)
+      return tag;
   }
 
-  newTag->Update(tag);
-  newTag->SetChannelData(m_channelData);
-  newTag->SetEpgID(m_iEpgID);
+  const CPVREpgInfoTagPtr tag = CreateTag(index);
+  m_liveTags[startTime] = tag;
+
+  if (m_liveTags.size() >= m_iLiveTagsSweep)
+    SweepLiveTags();
+
+  return tag;
+}
+
+CPVREpgInfoTagPtr CPVREpg::CreateTag(size_t index) const
+{
+  const CPVREpgInfoTagPtr tag = std::make_shared<CPVREpgInfoTag>(m_channelData, m_iEpgID);
+  m_tags.ToTag(index, *tag);
+  return tag;
+}
+
+void CPVREpg::RefreshTag(size_t index)
+{
+  ++m_iRevision;
+
+  const auto it = m_liveTags.find(m_tags.At(index).startTime);
+  if (it != m_liveTags.end())
+  {
+    const CPVREpgInfoTagPtr tag = it->second.lock();
+    if (tag)
+      m_tags.ToTag(index, *tag);
+    else
+      m_liveTags.erase(it);
+  }
+}
+
+void CPVREpg::EraseTag(size_t index)
+{
+  m_liveTags.erase(m_tags.At(index).startTime);
+  m_tags.Erase(index);
+  ++m_iRevision;
+}
+
+void CPVREpg::SweepLiveTags() const
+{
+  for (auto it = m_liveTags.begin(); it != m_liveTags.end();)
+  {
+    if (it->second.expired() || m_tags.Find(it->first) < 0)
+      it = m_liveTags.erase(it);
+    else
+      ++it;
+  }
+
+  m_iLiveTagsSweep = std::max<size_t>(64, m_liveTags.size() * 2);
+}
+
+time_t CPVREpg::GetCurrentPlayingTime() const
+{
+  if (CServiceBroker::GetPVRManager().IsPlayingChannel(m_channelData->ClientId(), m_channelData->UniqueClientChannelId()))
+  {
+    // start time valid?
+    const time_t startTime = CServiceBroker::GetDataCacheCore().GetStartTime();
+    if (startTime > 0)
+      return startTime + CServiceBroker::GetDataCacheCore().GetPlayTime() / 1000;
+  }
+
+  return CPVREpgTagStore::ToTime(CDateTime::GetUTCDateTime());
 }
 
 bool CPVREpg::Load(const std::shared_ptr<CPVREpgDatabase>& database)
@@ -277,17 +345,27 @@ bool CPVREpg::Load(const std::shared_ptr<CPVREpgDatabase>& database)
     return bReturn;
   }
 
-  const std::vector<CPVREpgInfoTagPtr> result = database->Get(*this);
+  CPVREpgTagStore tags(m_tags.GetStringPool());
+  const int iCount = database->Get(*this, tags);
 
   CSingleLock lock(m_critSection);
-  if (result.empty())
+  if (iCount <= 0)
   {
     CLog::LogFC(LOGDEBUG, LOGEPG, "No database entries found for table '%s'.", m_strName.c_str());
   }
   else
   {
-    for (const auto& entry : result)
-      AddEntry(*entry);
+    if (m_tags.Empty())
+    {
+      m_tags.Swap(tags);
+      m_liveTags.clear();
+      ++m_iRevision;
+    }
+    else
+    {
+      for (size_t i = 0; i < tags.Size(); ++i)
+        RefreshTag(m_tags.Put(tags.At(i)));
+    }
 
     if (!m_lastScanTime.IsValid())
       database->GetLastEpgScanTime(m_iEpgID, &m_lastScanTime);
@@ -310,8 +388,8 @@ bool CPVREpg::UpdateEntries(const CPVREpg &epg, bool bStoreInDb /* = true */)
 {
   CSingleLock lock(m_critSection);
   /* copy over tags */
-  for (const auto& tag : epg.m_tags)
-    UpdateEntry(tag.second, bStoreInDb);
+  for (size_t i = 0; i < epg.m_tags.Size(); ++i)
+    UpdateEntry(epg.m_tags.At(i), bStoreInDb);
 
   FixOverlappingEvents(bStoreInDb);
 
@@ -336,35 +414,66 @@ bool CPVREpg::UpdateEntry(const EPG_TAG *data, int iClientId)
   return UpdateEntry(tag, !CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_EPG_IGNOREDBFORCLIENT));
 }
 
-bool CPVREpg::UpdateEntry(const CPVREpgInfoTagPtr &tag, bool bUpdateDatabase)
+bool CPVREpg::UpdateEntries(const EPG_TAG *data, unsigned int iCount, int iClientId)
 {
-  CPVREpgInfoTagPtr infoTag;
+  if (!data)
+    return false;
+
+  const bool bUpdateDatabase = !CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_EPG_IGNOREDBFORCLIENT);
+  const int iTimeCorrection = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRTimeCorrection;
 
   CSingleLock lock(m_critSection);
-  const auto it = m_tags.find(tag->StartAsUTC());
-  bool bNewTag = false;
-  if (it != m_tags.end())
-  {
-    infoTag = it->second;
-  }
-  else
+  if (m_channelData->ClientId() != iClientId)
+    CLog::LogF(LOGERROR, "Client id mismatch (channel: %d, epg: %d)!", m_channelData->ClientId(), iClientId);
+
+  for (unsigned int i = 0; i < iCount; ++i)
   {
-    infoTag.reset(new CPVREpgInfoTag());
-    infoTag->SetUniqueBroadcastID(tag->UniqueBroadcastID());
-    m_tags.insert(std::make_pair(tag->StartAsUTC(), infoTag));
-    bNewTag = true;
+    bool bChanged = true;
+    const size_t index = m_tags.Put(data[i], iTimeCorrection, false, &bChanged);
+    EntryUpdated(index, bChanged, bUpdateDatabase);
   }
 
-  infoTag->Update(*tag, bNewTag);
-  infoTag->SetChannelData(m_channelData);
-  infoTag->SetEpgID(m_iEpgID);
+  return true;
+}
 
-  if (bUpdateDatabase)
-    m_changedTags.insert(std::make_pair(infoTag->UniqueBroadcastID(), infoTag));
+bool CPVREpg::UpdateEntry(const CPVREpgInfoTagPtr &tag, bool bUpdateDatabase)
+{
+  CSingleLock lock(m_critSection);
+  bool bChanged = true;
+  const size_t index = m_tags.Put(*tag, false, &bChanged);
+  EntryUpdated(index, bChanged, bUpdateDatabase);
 
   return true;
 }
 
+void CPVREpg::UpdateEntry(const CPVREpgTagStore::Record& record, bool bUpdateDatabase)
+{
+  bool bChanged = true;
+  const size_t index = m_tags.Put(record, false, &bChanged);
+  EntryUpdated(index, bChanged, bUpdateDatabase);
+}
+
+void CPVREpg::EntryUpdated(size_t index, bool bChanged, bool bUpdateDatabase)
+{
+  if (bChanged)
+    RefreshTag(index);
+
+  // events identical to the stored ones are not written again
+  const CPVREpgTagStore::Record& record = m_tags.At(index);
+  if (bUpdateDatabase && (bChanged || record.iDatabaseID <= 0))
+    m_changedTags.insert(record.startTime);
+}
+
+void CPVREpg::EntryDeleted(size_t index, bool bUpdateDatabase)
+{
+  const int iDatabaseId = m_tags.At(index).iDatabaseID;
+  if (iDatabaseId > 0 && bUpdateDatabase)
+    m_deletedTags.insert(iDatabaseId);
+
+  m_changedTags.erase(m_tags.At(index).startTime);
+  EraseTag(index);
+}
+
 bool CPVREpg::UpdateEntry(const CPVREpgInfoTagPtr &tag, EPG_EVENT_STATE newState, bool bUpdateDatabase)
 {
   bool bRet = true;
@@ -377,14 +486,8 @@ bool CPVREpg::UpdateEntry(const CPVREpgInfoTagPtr &tag, EPG_EVENT_STATE newState
   else if (newState == EPG_EVENT_DELETED)
   {
     CSingleLock lock(m_critSection);
-    auto it = m_tags.begin();
-    for (; it != m_tags.end(); ++it)
-    {
-      if (it->second->UniqueBroadcastID() == tag->UniqueBroadcastID())
-        break;
-    }
-
-    if (it == m_tags.end())
+    const int index = m_tags.FindByBroadcastId(tag->UniqueBroadcastID());
+    if (index < 0)
     {
       bRet = false;
     }
@@ -393,13 +496,8 @@ bool CPVREpg::UpdateEntry(const CPVREpgInfoTagPtr &tag, EPG_EVENT_STATE newState
       // Respect epg linger time.
       int iPastDays = CServiceBroker::GetSettingsComponent()->GetSettings()->GetInt(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY);
       const CDateTime cleanupTime(CDateTime::GetUTCDateTime() - CDateTimeSpan(iPastDays, 0, 0, 0));
-      if (it->second->EndAsUTC() < cleanupTime)
-      {
-        if (bUpdateDatabase)
-          m_deletedTags.insert(std::make_pair(it->second->UniqueBroadcastID(), it->second));
-
-        m_tags.erase(it);
-      }
+      if (m_tags.At(index).endTime < CPVREpgTagStore::ToTime(cleanupTime))
+        EntryDeleted(index, bUpdateDatabase);
       else
       {
         bNotify = false;
@@ -440,7 +538,7 @@ bool CPVREpg::Update(time_t start,
     Cleanup(iPastDays);
 
   /* enforce advanced settings update interval override for channels with no EPG data */
-  if (m_tags.empty() && !bUpdate && ChannelID() > 0)
+  if (m_tags.Empty() && !bUpdate && ChannelID() > 0)
     iUpdateTime = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iEpgUpdateEmptyTagsInterval;
 
   if (!bForceUpdate)
@@ -474,13 +572,42 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpg::GetTags() const
   std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
 
   CSingleLock lock(m_critSection);
-  for (const auto& tag : m_tags)
-    tags.emplace_back(tag.second);
+  tags.reserve(m_tags.Size());
+  for (size_t i = 0; i < m_tags.Size(); ++i)
+    tags.emplace_back(GetTag(i));
 
   return tags;
 }
 
-bool CPVREpg::Persist(const std::shared_ptr<CPVREpgDatabase>& database)
+void CPVREpg::GetTags(const CPVREpgSearchFilter& filter, const std::vector<bool>* stringMatches, std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const
+{
+  CSingleLock lock(m_critSection);
+  for (size_t i = 0; i < m_tags.Size(); ++i)
+  {
+    if (filter.MatchRecord(m_tags.At(i), stringMatches))
+      tags.emplace_back(GetTag(i));
+  }
+}
+
+size_t CPVREpg::Size() const
+{
+  CSingleLock lock(m_critSection);
+  return m_tags.Size();
+}
+
+unsigned int CPVREpg::GetRevision() const
+{
+  CSingleLock lock(m_critSection);
+  return m_iRevision;
+}
+
+size_t CPVREpg::GetMemoryUsage() const
+{
+  CSingleLock lock(m_critSection);
+  return m_tags.GetMemoryUsage();
+}
+
+bool CPVREpg::Persist(const std::shared_ptr<CPVREpgDatabase>& database, CPVREpgPersistStats* stats /* = nullptr */)
 {
   if (!database)
   {
@@ -490,45 +617,131 @@ bool CPVREpg::Persist(const std::shared_ptr<CPVREpgDatabase>& database)
 
   database->Lock();
 
+  const bool bTransaction = !database->InTransaction();
+  if (bTransaction)
+    database->BeginTransaction();
+
+  bool bReturn = true;
   {
     CSingleLock lock(m_critSection);
+
+    // the change sets are kept until the transaction they are written in is committed
+    m_persistingTags.insert(m_changedTags.begin(), m_changedTags.end());
+    m_persistingDeletedTags.insert(m_deletedTags.begin(), m_deletedTags.end());
+    m_changedTags.clear();
+    m_deletedTags.clear();
+    m_bPersistingChanged |= m_bChanged;
+    m_bPersistingLastScanTime |= m_bUpdateLastScanTime;
+    m_bChanged = false;
+    m_bTagsChanged = false;
+    m_bUpdateLastScanTime = false;
+
+    // the queued writes of CDatabase commit on their own, everything is executed directly instead
     bool bEpgIdChanged = false;
-    if (m_iEpgID <= 0 || m_bChanged)
+    if (m_iEpgID <= 0 || m_bPersistingChanged)
     {
-      int iId = database->Persist(*this, m_iEpgID > 0);
-      if (iId > 0 && m_iEpgID != iId)
+      int iId = database->Persist(*this, false);
+      if (iId <= 0)
+        bReturn = false;
+      else if (m_iEpgID != iId)
       {
         m_iEpgID = iId;
         bEpgIdChanged = true;
       }
     }
 
-    for (const auto& tag : m_deletedTags)
-      database->Delete(*tag.second);
+    std::vector<size_t> changed;
+    changed.reserve(m_persistingTags.size());
+    for (const auto& startTime : m_persistingTags)
+    {
+      const int index = m_tags.Find(startTime);
+      if (index >= 0)
+        changed.emplace_back(index);
+    }
+
+    const std::vector<int> deleted(m_persistingDeletedTags.begin(), m_persistingDeletedTags.end());
+    std::vector<int> databaseIds;
+    CPVREpgPersistStats tableStats;
+    if (m_iEpgID > 0)
+      bReturn &= database->PersistChanges(m_iEpgID, m_tags, changed, deleted, databaseIds, tableStats);
+
+    for (size_t i = 0; i < databaseIds.size(); ++i)
+    {
+      if (databaseIds[i] != m_tags.At(changed[i]).iDatabaseID)
+      {
+        // only valid once committed
+        if (m_tags.At(changed[i]).iDatabaseID <= 0)
+          m_persistingNewTags.insert(m_tags.At(changed[i]).startTime);
+        m_tags.SetDatabaseId(changed[i], databaseIds[i]);
+        RefreshTag(changed[i]);
+      }
+    }
+
+    CLog::LogFC(LOGDEBUG, LOGEPG, "Table '%s': %zu events inserted, %zu updated, %zu deleted, %zu bytes written",
+                m_strName.c_str(), tableStats.iInserted, tableStats.iUpdated, tableStats.iDeleted, tableStats.iBytes);
 
-    for (const auto& tag : m_changedTags)
-      tag.second->Persist(database, false);
+    if (stats)
+    {
+      stats->iInserted += tableStats.iInserted;
+      stats->iUpdated += tableStats.iUpdated;
+      stats->iDeleted += tableStats.iDeleted;
+      stats->iBytes += tableStats.iBytes;
+    }
 
-    if (m_bUpdateLastScanTime)
-      database->PersistLastEpgScanTime(m_iEpgID, m_lastScanTime, true);
+    if (m_bPersistingLastScanTime && m_iEpgID > 0)
+      bReturn &= database->PersistLastEpgScanTime(m_iEpgID, m_lastScanTime, false);
 
     if (bEpgIdChanged)
     {
-      for (const auto& tag : m_tags)
-        tag.second->SetEpgID(m_iEpgID);
+      for (const auto& liveTag : m_liveTags)
+      {
+        const CPVREpgInfoTagPtr tag = liveTag.second.lock();
+        if (tag)
+          tag->SetEpgID(m_iEpgID);
+      }
     }
 
-    m_deletedTags.clear();
-    m_changedTags.clear();
-    m_bChanged            = false;
-    m_bTagsChanged        = false;
-    m_bUpdateLastScanTime = false;
+    m_bPersistFailed = !bReturn;
   }
 
-  bool bRet = database->CommitInsertQueries();
+  if (bTransaction)
+    PersistCompleted(database->CommitTransaction());
 
   database->Unlock();
-  return bRet;
+  return bReturn;
+}
+
+void CPVREpg::PersistCompleted(bool bCommitted)
+{
+  CSingleLock lock(m_critSection);
+
+  if (!bCommitted)
+  {
+    // the rows inserted by the rolled back transaction are gone, insert the events again
+    for (const auto& startTime : m_persistingNewTags)
+    {
+      const int index = m_tags.Find(startTime);
+      if (index >= 0)
+        m_tags.SetDatabaseId(index, -1);
+    }
+  }
+
+  if (!bCommitted || m_bPersistFailed)
+  {
+    // keep the changes for the next attempt, writing them again is harmless
+    m_changedTags.insert(m_persistingTags.begin(), m_persistingTags.end());
+    m_deletedTags.insert(m_persistingDeletedTags.begin(), m_persistingDeletedTags.end());
+    m_bChanged |= m_bPersistingChanged;
+    m_bUpdateLastScanTime |= m_bPersistingLastScanTime;
+    m_bTagsChanged = !m_changedTags.empty() || !m_deletedTags.empty();
+  }
+
+  m_persistingTags.clear();
+  m_persistingDeletedTags.clear();
+  m_persistingNewTags.clear();
+  m_bPersistingChanged = false;
+  m_bPersistingLastScanTime = false;
+  m_bPersistFailed = false;
 }
 
 CDateTime CPVREpg::GetFirstDate(void) const
@@ -536,8 +749,8 @@ CDateTime CPVREpg::GetFirstDate(void) const
   CDateTime first;
 
   CSingleLock lock(m_critSection);
-  if (!m_tags.empty())
-    first = m_tags.begin()->second->StartAsUTC();
+  if (!m_tags.Empty())
+    first = CPVREpgTagStore::FromTime(m_tags.At(0).startTime);
 
   return first;
 }
@@ -547,8 +760,8 @@ CDateTime CPVREpg::GetLastDate(void) const
   CDateTime last;
 
   CSingleLock lock(m_critSection);
-  if (!m_tags.empty())
-    last = m_tags.rbegin()->second->StartAsUTC();
+  if (!m_tags.Empty())
+    last = CPVREpgTagStore::FromTime(m_tags.At(m_tags.Size() - 1).startTime);
 
   return last;
 }
@@ -556,39 +769,33 @@ CDateTime CPVREpg::GetLastDate(void) const
 bool CPVREpg::FixOverlappingEvents(bool bUpdateDb /* = false */)
 {
   bool bReturn = true;
-  CPVREpgInfoTagPtr previousTag, currentTag;
 
-  for (auto it = m_tags.begin(); it != m_tags.end(); it != m_tags.end() ? it++ : it)
+  size_t previous = 0;
+  for (size_t current = 1; current < m_tags.Size();)
   {
-    if (!previousTag)
-    {
-      previousTag = it->second;
-      continue;
-    }
-    currentTag = it->second;
+    const CPVREpgTagStore::Record& previousTag = m_tags.At(previous);
+    const CPVREpgTagStore::Record& currentTag = m_tags.At(current);
 
-    if (previousTag->EndAsUTC() >= currentTag->EndAsUTC())
+    if (previousTag.endTime >= currentTag.endTime)
     {
       // delete the current tag. it's completely overlapped
-      if (bUpdateDb)
-        m_deletedTags.insert(std::make_pair(currentTag->UniqueBroadcastID(), currentTag));
-
-      if (m_nowActiveStart == it->first)
-        m_nowActiveStart.SetValid(false);
+      if (m_nowActiveStart == currentTag.startTime)
+        m_nowActiveStart = CPVREpgTagStore::INVALID_TIME;
 
-      m_tags.erase(it++);
+      EntryDeleted(current, bUpdateDb);
     }
-    else if (previousTag->EndAsUTC() > currentTag->StartAsUTC())
+    else if (previousTag.endTime > currentTag.startTime)
     {
-      previousTag->SetEndFromUTC(currentTag->StartAsUTC());
+      m_tags.SetEnd(previous, currentTag.startTime);
+      RefreshTag(previous);
       if (bUpdateDb)
-        m_changedTags.insert(std::make_pair(previousTag->UniqueBroadcastID(), previousTag));
+        m_changedTags.insert(m_tags.At(previous).startTime);
 
-      previousTag = it->second;
+      previous = current++;
     }
     else
     {
-      previousTag = it->second;
+      previous = current++;
     }
   }
 
@@ -716,8 +923,12 @@ void CPVREpg::SetChannelData(const std::shared_ptr<CPVREpgChannelData>& data)
   CSingleLock lock(m_critSection);
   m_channelData = data;
 
-  for (const auto& tag : m_tags)
-    tag.second->SetChannelData(data);
+  for (const auto& liveTag : m_liveTags)
+  {
+    const CPVREpgInfoTagPtr tag = liveTag.second.lock();
+    if (tag)
+      tag->SetChannelData(data);
+  }
 }
 
 int CPVREpg::ChannelID(void) const
@@ -9,6 +9,8 @@
 #pragma once
 
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -17,11 +19,14 @@
 
 #include "pvr/PVRTypes.h"
 #include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgTagStore.h"
 
 /** EPG container for CPVREpgInfoTag instances */
 namespace PVR
 {
   class CPVREpgChannelData;
+  class CPVREpgSearchFilter;
+  struct CPVREpgPersistStats;
 
   class CPVREpg : public Observable
   {
@@ -148,6 +153,14 @@ namespace PVR
      */
     CPVREpgInfoTagPtr GetTagBetween(const CDateTime &beginTime, const CDateTime &endTime, bool bUpdateFromClient = false);
 
+    /*!
+     * @brief Get the events overlapping the given time window.
+     * @param start The start of the window in UTC.
+     * @param end The end of the window in UTC.
+     * @return The tags, sorted by start time.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> GetTagsBetween(const CDateTime& start, const CDateTime& end) const;
+
     /*!
      * @brief Get the event matching the given unique broadcast id
      * @param iUniqueBroadcastId The uid to look up
@@ -163,6 +176,15 @@ namespace PVR
      */
     bool UpdateEntry(const EPG_TAG *data, int iClientId);
 
+    /*!
+     * @brief Update several entries in this EPG at once.
+     * @param data The tags to update.
+     * @param iCount The number of tags.
+     * @param iClientId The id of the pvr client these events belong to.
+     * @return True if they were updated successfully, false otherwise.
+     */
+    bool UpdateEntries(const EPG_TAG *data, unsigned int iCount, int iClientId);
+
     /*!
      * @brief Update an entry in this EPG.
      * @param tag The tag to update.
@@ -199,11 +221,45 @@ namespace PVR
     std::vector<std::shared_ptr<CPVREpgInfoTag>> GetTags() const;
 
     /*!
-     * @brief Persist this table in the given database
+     * @brief Get the EPG tags that may match a search filter. Tags are only created for events passing CPVREpgSearchFilter::MatchRecord().
+     * @param filter The filter.
+     * @param stringMatches The results of CPVREpgSearchFilter::MatchSearchTerm() for the string pool of this table or nullptr.
+     * @param tags Receives the tags, CPVREpgSearchFilter::FilterEntry() still has to be applied to them.
+     */
+    void GetTags(const CPVREpgSearchFilter& filter, const std::vector<bool>* stringMatches, std::vector<std::shared_ptr<CPVREpgInfoTag>>& tags) const;
+
+    /*!
+     * @brief Get the number of EPG tags.
+     * @return The number of tags.
+     */
+    size_t Size() const;
+
+    /*!
+     * @brief Get the memory used for the EPG tags of this table, without their strings.
+     * @return The size in bytes.
+     */
+    size_t GetMemoryUsage() const;
+
+    /*!
+     * @brief Get the revision of the EPG tags. It changes whenever tags are added, changed or removed.
+     * @return The revision.
+     */
+    unsigned int GetRevision() const;
+
+    /*!
+     * @brief Persist the changes of this table in the given database. When the caller opened the
+     *        transaction, the changes are kept until it reports the commit with PersistCompleted().
      * @param database The database.
+     * @param stats If given, the rows and bytes written are added to it.
      * @return True if the table was persisted, false otherwise.
      */
-    bool Persist(const std::shared_ptr<CPVREpgDatabase>& database);
+    bool Persist(const std::shared_ptr<CPVREpgDatabase>& database, CPVREpgPersistStats* stats = nullptr);
+
+    /*!
+     * @brief Report the outcome of the transaction the last Persist() call wrote in.
+     * @param bCommitted True if it was committed. If not, or if writing failed, the changes are persisted again.
+     */
+    void PersistCompleted(bool bCommitted);
 
     /*!
      * @brief Get the start time of the first entry in this table.
@@ -266,10 +322,63 @@ namespace PVR
     bool FixOverlappingEvents(bool bUpdateDb = false);
 
     /*!
-     * @brief Add an infotag to this container.
-     * @param tag The tag to add.
+     * @brief Get the tag for an event, creating it if no tag for the event is in use.
+     * @param index The index of the event.
+     * @return The tag.
+     */
+    CPVREpgInfoTagPtr GetTag(size_t index) const;
+
+    /*!
+     * @brief Create a new tag for an event, not shared with other users of this table.
+     * @param index The index of the event.
+     * @return The tag.
+     */
+    CPVREpgInfoTagPtr CreateTag(size_t index) const;
+
+    /*!
+     * @brief Update the tag in use for an event, if any, after the event changed.
+     * @param index The index of the event.
+     */
+    void RefreshTag(size_t index);
+
+    /*!
+     * @brief Remove an event.
+     * @param index The index of the event.
+     */
+    void EraseTag(size_t index);
+
+    /*!
+     * @brief Forget tags that are no longer in use or whose event was removed.
+     */
+    void SweepLiveTags() const;
+
+    /*!
+     * @brief Get current time, taking timeshifting into account.
+     * @return The playing time in UTC.
+     */
+    time_t GetCurrentPlayingTime() const;
+
+    /*!
+     * @brief Update an entry in this EPG.
+     * @param record The event to update, from a table sharing the string pool of this table.
+     * @param bUpdateDatabase If set to true, this event will be persisted in the database.
+     */
+    void UpdateEntry(const CPVREpgTagStore::Record& record, bool bUpdateDatabase);
+
+    /*!
+     * @brief Refresh handed out tags of an updated event and mark it for persisting if it differs from the stored one.
+     * @param index The index of the event.
+     * @param bChanged False if the event did not change.
+     * @param bUpdateDatabase If set to true, the event will be persisted in the database.
+     */
+    void EntryUpdated(size_t index, bool bChanged, bool bUpdateDatabase);
+
+    /*!
+     * @brief Remove an event and mark it for deletion from the database.
+     * @param index The index of the event.
+     * @param bUpdateDatabase If set to true, the event will be deleted from the database.
      */
-    void AddEntry(const CPVREpgInfoTag &tag);
+    void EntryDeleted(size_t index, bool bUpdateDatabase);
 
     /*!
      * @brief Load all EPG entries from clients into a temporary table and update this table with the contents of that temporary table.
@@ -294,9 +403,18 @@ namespace PVR
      */
     void Cleanup(int iPastDays);
 
-    std::map<CDateTime, CPVREpgInfoTagPtr> m_tags;
-    std::map<int, CPVREpgInfoTagPtr>       m_changedTags;
-    std::map<int, CPVREpgInfoTagPtr>       m_deletedTags;
+    CPVREpgTagStore                     m_tags;            /*!< the events of this table */
+    mutable std::map<time_t, std::weak_ptr<CPVREpgInfoTag>> m_liveTags; /*!< tags handed out, by start time */
+    mutable size_t                      m_iLiveTagsSweep = 64; /*!< number of live tags that triggers the next sweep */
+    unsigned int                        m_iRevision = 0;   /*!< incremented whenever tags are added, changed or removed */
+    std::set<time_t>                    m_changedTags;     /*!< start times of the new or changed events to persist */
+    std::set<int>                       m_deletedTags;     /*!< database ids of the events to delete */
+    std::set<time_t>                    m_persistingTags;        /*!< m_changedTags written, but not committed yet */
+    std::set<int>                       m_persistingDeletedTags; /*!< m_deletedTags written, but not committed yet */
+    std::set<time_t>                    m_persistingNewTags;     /*!< start times of events inserted by the uncommitted write */
+    bool                                m_bPersistingChanged = false;
+    bool                                m_bPersistingLastScanTime = false;
+    bool                                m_bPersistFailed = false;
     bool                                m_bChanged = false;        /*!< true if anything changed that needs to be persisted, false otherwise */
     bool                                m_bTagsChanged = false;    /*!< true when any tags are changed and not persisted, false otherwise */
     bool                                m_bLoaded = false;         /*!< true when the initial entries have been loaded */
@@ -304,7 +422,7 @@ namespace PVR
     int                                 m_iEpgID = 0;          /*!< the database ID of this table */
     std::string                         m_strName;         /*!< the name of this table */
     std::string                         m_strScraperName;  /*!< the name of the scraper to use */
-    mutable CDateTime                   m_nowActiveStart;  /*!< the start time of the tag that is currently active */
+    mutable time_t                      m_nowActiveStart = CPVREpgTagStore::INVALID_TIME; /*!< the start time of the tag that is currently active */
     CDateTime                           m_lastScanTime;    /*!< the last time the EPG has been updated */
     mutable CCriticalSection            m_critSection;     /*!< critical section for changes in this table */
     bool                                m_bUpdateLastScanTime = false;
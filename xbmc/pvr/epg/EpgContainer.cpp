@@ -8,14 +8,22 @@
 
 #include "EpgContainer.h"
 
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <map>
+#include <vector>
+
 #include "ServiceBroker.h"
 #include "guilib/LocalizeStrings.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
+#include "threads/IRunnable.h"
 #include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
+#include "utils/TimeUtils.h"
 #include "utils/log.h"
 
 #include "pvr/PVRManager.h"
@@ -23,6 +31,7 @@
 #include "pvr/epg/Epg.h"
 #include "pvr/epg/EpgChannelData.h"
 #include "pvr/epg/EpgSearchFilter.h"
+#include "pvr/epg/EpgTagStore.h"
 
 namespace PVR
 {
@@ -53,6 +62,101 @@ void CEpgUpdateRequest::Deliver()
   epg->ForceUpdate();
 }
 
+class CEpgUpdateJobs : private IRunnable
+{
+public:
+  typedef std::function<bool(const std::shared_ptr<CPVREpg>& epg)> Updater;
+
+  explicit CEpgUpdateJobs(unsigned int iThreadsPerClient) : m_iThreadsPerClient(std::max(1u, iThreadsPerClient)) {}
+
+  void Add(int iClientId, const std::shared_ptr<CPVREpg>& epg);
+
+  /*!
+   * @brief Update all tables, using the calling thread and up to iMaxThreads - 1 additional threads.
+   * @param iMaxThreads The maximum number of tables updated at the same time.
+   * @param updater Updates one table, returns false to cancel all remaining updates.
+   * @return True if all tables were processed, false if cancelled.
+   */
+  bool Run(unsigned int iMaxThreads, const Updater& updater);
+
+private:
+  struct Client
+  {
+    std::deque<std::shared_ptr<CPVREpg>> epgs;
+    unsigned int iRunning = 0;
+  };
+
+  void Run() override;
+
+  const unsigned int m_iThreadsPerClient;
+  std::map<int, Client> m_clients;
+  Updater m_updater;
+  bool m_bCancelled = false;
+  CCriticalSection m_critSection;
+};
+
+void CEpgUpdateJobs::Add(int iClientId, const std::shared_ptr<CPVREpg>& epg)
+{
+  m_clients[iClientId].epgs.emplace_back(epg);
+}
+
+bool CEpgUpdateJobs::Run(unsigned int iMaxThreads, const Updater& updater)
+{
+  m_updater = updater;
+
+  unsigned int iThreads = 0;
+  for (const auto& client : m_clients)
+    iThreads += std::min<size_t>(m_iThreadsPerClient, client.second.epgs.size());
+  iThreads = std::min(iThreads, iMaxThreads);
+
+  std::vector<std::unique_ptr<CThread>> workers;
+  for (unsigned int i = 1; i < iThreads; ++i)
+  {
+    workers.emplace_back(new CThread(this, "EPGUpdateWorker"));
+    workers.back()->Create();
+  }
+
+  Run();
+
+  for (auto& worker : workers)
+    worker->StopThread(true);
+
+  return !m_bCancelled;
+}
+
+void CEpgUpdateJobs::Run()
+{
+  CSingleLock lock(m_critSection);
+  while (!m_bCancelled)
+  {
+    // tables of a client at its limit are left to the threads already serving that client
+    Client* client = nullptr;
+    for (auto& entry : m_clients)
+    {
+      if (!entry.second.epgs.empty() && entry.second.iRunning < m_iThreadsPerClient)
+      {
+        client = &entry.second;
+        break;
+      }
+    }
+
+    if (!client)
+      break;
+
+    const std::shared_ptr<CPVREpg> epg = client->epgs.front();
+    client->epgs.pop_front();
+    client->iRunning++;
+
+    lock.Leave();
+    const bool bContinue = m_updater(epg);
+    lock.Enter();
+
+    client->iRunning--;
+    if (!bContinue)
+      m_bCancelled = true;
+  }
+}
+
 class CEpgTagStateChange
 {
 public:
@@ -91,6 +195,7 @@ void CEpgTagStateChange::Deliver()
 CPVREpgContainer::CPVREpgContainer(void) :
   CThread("EPGUpdater"),
   m_database(new CPVREpgDatabase),
+  m_strings(new CPVREpgStringPool),
   m_settings({
     CSettings::SETTING_EPG_IGNOREDBFORCLIENT,
     CSettings::SETTING_EPG_EPGUPDATE,
@@ -290,6 +395,16 @@ void CPVREpgContainer::LoadFromDB(void)
 
   progressHandler->DestroyProgress();
 
+  size_t iTags = 0;
+  size_t iMemory = 0;
+  for (const auto& epgEntry : m_epgIdToEpgMap)
+  {
+    iTags += epgEntry.second->Size();
+    iMemory += epgEntry.second->GetMemoryUsage();
+  }
+  CLog::LogFC(LOGDEBUG, LOGEPG, "Loaded %zu events, %zu bytes of events and %zu bytes for %zu distinct strings",
+              iTags, iMemory, m_strings->GetMemoryUsage(), m_strings->GetCount());
+
   m_bLoaded = bLoaded;
 }
 
@@ -304,12 +419,34 @@ bool CPVREpgContainer::PersistAll(void)
     m_critSection.unlock();
 
     const std::shared_ptr<CPVREpgDatabase> database = GetEpgDatabase();
+    CPVREpgPersistStats stats;
+    bReturn = true;
 
+    // all tables are written in one transaction
+    database->Lock();
+    database->BeginTransaction();
+
+    std::vector<std::shared_ptr<CPVREpg>> persisted;
     for (const auto& epg : epgs)
     {
       if (epg.second && epg.second->NeedsSave())
-        bReturn &= epg.second->Persist(database);
+      {
+        bReturn &= epg.second->Persist(database, &stats);
+        persisted.emplace_back(epg.second);
+      }
     }
+
+    // the tables drop their change sets only once they are committed
+    const bool bCommitted = database->CommitTransaction();
+    database->Unlock();
+
+    for (const auto& epg : persisted)
+      epg->PersistCompleted(bCommitted);
+    bReturn &= bCommitted;
+
+    if (stats.iInserted > 0 || stats.iUpdated > 0 || stats.iDeleted > 0)
+      CLog::LogF(LOGDEBUG, "EPG changes persisted: %zu events inserted, %zu updated, %zu deleted, %zu bytes written",
+                 stats.iInserted, stats.iUpdated, stats.iDeleted, stats.iBytes);
   }
 
   return bReturn;
@@ -499,6 +636,40 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgContainer::GetAllTags() cons
   return allTags;
 }
 
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgContainer::GetTags(const CPVREpgSearchFilter& filter) const
+{
+  const int64_t start = CurrentHostCounter();
+
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+  std::vector<bool> stringMatches;
+
+  for (int iAttempt = 0; ; ++iAttempt)
+  {
+    // ids of released strings are reused after a compaction, then the matches have to be evaluated again
+    const unsigned int iGeneration = m_strings->GetGeneration();
+    const bool bUseStringMatches = iAttempt < 2 && filter.MatchSearchTerm(*m_strings, stringMatches);
+
+    tags.clear();
+    {
+      CSingleLock lock(m_critSection);
+      for (const auto& epgEntry : m_epgIdToEpgMap)
+        epgEntry.second->GetTags(filter, bUseStringMatches ? &stringMatches : nullptr, tags);
+    }
+
+    if (!bUseStringMatches || m_strings->GetGeneration() == iGeneration)
+      break;
+  }
+
+  const size_t iCandidates = tags.size();
+  tags.erase(std::remove_if(tags.begin(), tags.end(),
+                            [&filter](const std::shared_ptr<CPVREpgInfoTag>& tag) { return !filter.FilterEntry(tag); }),
+             tags.end());
+
+  CLog::LogFC(LOGDEBUG, LOGEPG, "%zu matches of %zu candidates in %lld ms", tags.size(), iCandidates,
+              static_cast<long long>((CurrentHostCounter() - start) * 1000 / CurrentHostFrequency()));
+  return tags;
+}
+
 void CPVREpgContainer::InsertFromDB(const CPVREpgPtr &newEpg)
 {
   // table might already have been created when pvr channels were loaded
@@ -668,43 +839,59 @@ bool CPVREpgContainer::UpdateEPG(bool bOnlyPending /* = false */)
   if (bShowProgress && !bOnlyPending)
     progressHandler = new CPVRGUIProgressHandler(g_localizeStrings.Get(19004)); // Importing guide from clients
 
-  /* load or update all EPG tables */
-  unsigned int iCounter = 0;
-  const std::shared_ptr<CPVREpgDatabase> database = IgnoreDB() ? nullptr : GetEpgDatabase();
-  for (const auto& epgEntry : m_epgIdToEpgMap)
+  /* load or update all EPG tables. clients are queried in parallel, each by a limited number of threads */
+  CEpgUpdateJobs jobs(advancedSettings->m_iEpgUpdateThreadsPerClient);
+  size_t iTables = 0;
   {
-    if (InterruptUpdate())
+    CSingleLock lock(m_critSection);
+    for (const auto& epgEntry : m_epgIdToEpgMap)
     {
-      bInterrupted = true;
-      break;
+      if (epgEntry.second)
+      {
+        jobs.Add(epgEntry.second->GetChannelData()->ClientId(), epgEntry.second);
+        iTables++;
+      }
     }
+  }
 
-    const CPVREpgPtr epg = epgEntry.second;
-    if (!epg)
-      continue;
+  unsigned int iCounter = 0;
+  CCriticalSection resultsLock;
+  const std::shared_ptr<CPVREpgDatabase> database = IgnoreDB() ? nullptr : GetEpgDatabase();
+  const int iUpdateTime = m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60;
+  const int iPastDays = m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY);
+
+  bInterrupted = !jobs.Run(advancedSettings->m_iEpgUpdateThreads, [&](const CPVREpgPtr& epg)
+  {
+    if (InterruptUpdate())
+      return false;
 
     if (bShowProgress && !bOnlyPending)
-      progressHandler->UpdateProgress(epg->Name(), ++iCounter, m_epgIdToEpgMap.size());
+    {
+      CSingleLock lock(resultsLock);
+      progressHandler->UpdateProgress(epg->Name(), ++iCounter, iTables);
+    }
 
     if ((!bOnlyPending || epg->UpdatePending()) &&
-        epg->Update(start,
-                    end,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY),
-                    database,
-                    bOnlyPending))
+        epg->Update(start, end, iUpdateTime, iPastDays, database, bOnlyPending))
     {
+      CSingleLock lock(resultsLock);
       iUpdatedTables++;
     }
     else if (!epg->IsValid())
     {
+      CSingleLock lock(resultsLock);
       invalidTables.push_back(epg);
     }
-  }
+    return true;
+  });
 
   if (bShowProgress && !bOnlyPending)
     progressHandler->DestroyProgress();
 
+  /* store the imported tables from this thread only, instead of letting every table wait for the database */
+  if (iUpdatedTables > 0 && !bInterrupted)
+    PersistAll();
+
   for (const auto& epg : invalidTables)
     DeleteEpg(epg, true);
 
@@ -28,6 +28,8 @@ class CFileItem;
 namespace PVR
 {
   class CPVREpgChannelData;
+  class CPVREpgSearchFilter;
+  class CPVREpgStringPool;
   class CEpgUpdateRequest;
   class CEpgTagStateChange;
 
@@ -52,6 +54,12 @@ namespace PVR
      */
     CPVREpgDatabasePtr GetEpgDatabase() const;
 
+    /*!
+     * @brief Get the pool holding the strings of all EPG events.
+     * @return The pool.
+     */
+    const std::shared_ptr<CPVREpgStringPool>& GetStringPool() const { return m_strings; }
+
     /*!
      * @brief Start the EPG update thread.
      * @param bAsync Should the EPG container starts asynchronously
@@ -139,6 +147,15 @@ namespace PVR
      */
     std::vector<std::shared_ptr<CPVREpgInfoTag>> GetAllTags() const;
 
+    /*!
+     * @brief Get the EPG tags matching a search filter.
+     * The search term is evaluated once per distinct string of the string pool and the stored events
+     * are checked before tags are created, so only the events that may match are turned into tags.
+     * @param filter The filter.
+     * @return The tags.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> GetTags(const CPVREpgSearchFilter& filter) const;
+
     /*!
      * @brief Check whether data should be persisted to the EPG database.
      * @return True if data should not be persisted to the EPG database, false otherwise.
@@ -249,6 +266,7 @@ namespace PVR
     void InsertFromDB(const CPVREpgPtr &newEpg);
 
     CPVREpgDatabasePtr m_database; /*!< the EPG database */
+    std::shared_ptr<CPVREpgStringPool> m_strings; /*!< the strings of all EPG events */
 
     bool m_bIsUpdating = false;                /*!< true while an update is running */
     bool m_bIsInitialising = true;             /*!< true while the epg manager hasn't loaded all tables */
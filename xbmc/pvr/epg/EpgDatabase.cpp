@@ -21,10 +21,85 @@
 
 #include "pvr/epg/Epg.h"
 #include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgTagStore.h"
 
 using namespace dbiplus;
 using namespace PVR;
 
+namespace
+{
+  // the columns of an event, without idBroadcast
+  const char* const EPGTAG_COLUMNS =
+      "idEpg, iStartTime, iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, "
+      "sIconPath, iGenreType, iGenreSubType, sGenre, iFirstAired, iParentalRating, iStarRating, bNotify, iSeriesId, "
+      "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, iBroadcastUid";
+  const int EPGTAG_COLUMN_COUNT = 27;
+
+  const char* const EPGTAG_INSERT =
+      "REPLACE INTO epgtags (idEpg, iStartTime, iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, "
+      "sWriter, iYear, sIMDBNumber, sIconPath, iGenreType, iGenreSubType, sGenre, iFirstAired, iParentalRating, iStarRating, "
+      "bNotify, iSeriesId, iEpisodeId, iEpisodePart, sEpisodeName, iFlags, sSeriesLink, iBroadcastUid) "
+      "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+
+  const char* const EPGTAG_UPDATE =
+      "UPDATE epgtags SET idEpg = ?, iStartTime = ?, iEndTime = ?, sTitle = ?, sPlotOutline = ?, sPlot = ?, "
+      "sOriginalTitle = ?, sCast = ?, sDirector = ?, sWriter = ?, iYear = ?, sIMDBNumber = ?, sIconPath = ?, "
+      "iGenreType = ?, iGenreSubType = ?, sGenre = ?, iFirstAired = ?, iParentalRating = ?, iStarRating = ?, "
+      "bNotify = ?, iSeriesId = ?, iEpisodeId = ?, iEpisodePart = ?, sEpisodeName = ?, iFlags = ?, sSeriesLink = ?, "
+      "iBroadcastUid = ? WHERE idBroadcast = ?";
+
+  int64_t ToDBTime(time_t time)
+  {
+    return time == CPVREpgTagStore::INVALID_TIME ? 0 : static_cast<int64_t>(time);
+  }
+
+  /*!
+   * @brief Get the size of the column data of an event.
+   */
+  size_t GetEventSize(const std::string* strings)
+  {
+    size_t iBytes = (EPGTAG_COLUMN_COUNT - CPVREpgTagStore::STRING_FIELD_COUNT) * sizeof(int64_t);
+    for (int field = 0; field < CPVREpgTagStore::STRING_FIELD_COUNT; ++field)
+      iBytes += strings[field].size();
+    return iBytes;
+  }
+
+  /*!
+   * @brief Bind the columns of an event in the order of EPGTAG_COLUMNS.
+   */
+  void BindEvent(PreparedStatement& stmt, int iEpgId, const CPVREpgTagStore::Record& record, const std::string* strings)
+  {
+    int i = 0;
+    stmt.bind(++i, iEpgId);
+    stmt.bind(++i, ToDBTime(record.startTime));
+    stmt.bind(++i, ToDBTime(record.endTime));
+    stmt.bind(++i, strings[CPVREpgTagStore::TITLE]);
+    stmt.bind(++i, strings[CPVREpgTagStore::PLOT_OUTLINE]);
+    stmt.bind(++i, strings[CPVREpgTagStore::PLOT]);
+    stmt.bind(++i, strings[CPVREpgTagStore::ORIGINAL_TITLE]);
+    stmt.bind(++i, strings[CPVREpgTagStore::CAST]);
+    stmt.bind(++i, strings[CPVREpgTagStore::DIRECTORS]);
+    stmt.bind(++i, strings[CPVREpgTagStore::WRITERS]);
+    stmt.bind(++i, record.iYear);
+    stmt.bind(++i, strings[CPVREpgTagStore::IMDB_NUMBER]);
+    stmt.bind(++i, strings[CPVREpgTagStore::ICON_PATH]);
+    stmt.bind(++i, record.iGenreType);
+    stmt.bind(++i, record.iGenreSubType);
+    stmt.bind(++i, strings[CPVREpgTagStore::GENRE]);
+    stmt.bind(++i, ToDBTime(record.firstAired));
+    stmt.bind(++i, record.iParentalRating);
+    stmt.bind(++i, record.iStarRating);
+    stmt.bind(++i, record.bNotify ? 1 : 0);
+    stmt.bind(++i, record.iSeriesNumber);
+    stmt.bind(++i, record.iEpisodeNumber);
+    stmt.bind(++i, record.iEpisodePart);
+    stmt.bind(++i, strings[CPVREpgTagStore::EPISODE_NAME]);
+    stmt.bind(++i, static_cast<int>(record.iFlags));
+    stmt.bind(++i, strings[CPVREpgTagStore::SERIES_LINK]);
+    stmt.bind(++i, static_cast<int>(record.iUniqueBroadcastID));
+  }
+}
+
 bool CPVREpgDatabase::Open()
 {
   CSingleLock lock(m_critSection);
@@ -47,6 +122,29 @@ void CPVREpgDatabase::Unlock()
   m_critSection.unlock();
 }
 
+bool CPVREpgDatabase::CommitTransaction()
+{
+  if (!m_pDB)
+    return false;
+
+  try
+  {
+    // a busy database keeps the transaction open
+    if (!m_pDB->try_commit_transaction())
+    {
+      CLog::LogF(LOGERROR, "Could not commit EPG changes, rolling back");
+      m_pDB->rollback_transaction();
+      return false;
+    }
+  }
+  catch (...)
+  {
+    CLog::LogF(LOGERROR, "Could not commit EPG changes");
+    return false;
+  }
+  return true;
+}
+
 void CPVREpgDatabase::CreateTables(void)
 {
   CLog::Log(LOGINFO, "Creating EPG database tables");
@@ -229,73 +327,69 @@ std::vector<std::shared_ptr<CPVREpg>> CPVREpgDatabase::GetAll()
   return result;
 }
 
-std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::Get(const CPVREpg &epg)
+int CPVREpgDatabase::Get(const CPVREpg &epg, CPVREpgTagStore &store)
 {
-  std::vector<std::shared_ptr<CPVREpgInfoTag>> result;
+  int iReturn = 0;
 
   CSingleLock lock(m_critSection);
-  std::string strQuery = PrepareSQL("SELECT * FROM epgtags WHERE idEpg = %u;", epg.EpgID());
-  if (ResultQuery(strQuery))
+  if (!m_pDB || !m_pDS)
+    return iReturn;
+
+  // rows are read one at a time through a single tag and go straight into the compact store
+  std::string strQuery = PrepareSQL("SELECT * FROM epgtags WHERE idEpg = %u ORDER BY iStartTime;", epg.EpgID());
+  try
   {
-    try
-    {
-      while (!m_pDS->eof())
-      {
-        std::shared_ptr<CPVREpgInfoTag> newTag(new CPVREpgInfoTag());
-
-        time_t iStartTime, iEndTime, iFirstAired;
-        iStartTime = (time_t) m_pDS->fv("iStartTime").get_asInt();
-        CDateTime startTime(iStartTime);
-        newTag->m_startTime = startTime;
-
-        iEndTime = (time_t) m_pDS->fv("iEndTime").get_asInt();
-        CDateTime endTime(iEndTime);
-        newTag->m_endTime = endTime;
-
-        iFirstAired = (time_t) m_pDS->fv("iFirstAired").get_asInt();
-        CDateTime firstAired(iFirstAired);
-        newTag->m_firstAired = firstAired;
-
-        int iBroadcastUID = m_pDS->fv("iBroadcastUid").get_asInt();
-        // Compat: null value for broadcast uid changed from numerical -1 to 0 with PVR Addon API v4.0.0
-        newTag->m_iUniqueBroadcastID = iBroadcastUID == -1 ? EPG_TAG_INVALID_UID : iBroadcastUID;
-
-        newTag->m_iDatabaseID        = m_pDS->fv("idBroadcast").get_asInt();
-        newTag->m_strTitle           = m_pDS->fv("sTitle").get_asString().c_str();
-        newTag->m_strPlotOutline     = m_pDS->fv("sPlotOutline").get_asString().c_str();
-        newTag->m_strPlot            = m_pDS->fv("sPlot").get_asString().c_str();
-        newTag->m_strOriginalTitle   = m_pDS->fv("sOriginalTitle").get_asString().c_str();
-        newTag->m_cast               = newTag->Tokenize(m_pDS->fv("sCast").get_asString());
-        newTag->m_directors          = newTag->Tokenize(m_pDS->fv("sDirector").get_asString());
-        newTag->m_writers            = newTag->Tokenize(m_pDS->fv("sWriter").get_asString());
-        newTag->m_iYear              = m_pDS->fv("iYear").get_asInt();
-        newTag->m_strIMDBNumber      = m_pDS->fv("sIMDBNumber").get_asString().c_str();
-        newTag->m_iGenreType         = m_pDS->fv("iGenreType").get_asInt();
-        newTag->m_iGenreSubType      = m_pDS->fv("iGenreSubType").get_asInt();
-        newTag->m_genre              = newTag->Tokenize(m_pDS->fv("sGenre").get_asString());
-        newTag->m_iParentalRating    = m_pDS->fv("iParentalRating").get_asInt();
-        newTag->m_iStarRating        = m_pDS->fv("iStarRating").get_asInt();
-        newTag->m_bNotify            = m_pDS->fv("bNotify").get_asBool();
-        newTag->m_iEpisodeNumber     = m_pDS->fv("iEpisodeId").get_asInt();
-        newTag->m_iEpisodePart       = m_pDS->fv("iEpisodePart").get_asInt();
-        newTag->m_strEpisodeName     = m_pDS->fv("sEpisodeName").get_asString().c_str();
-        newTag->m_iSeriesNumber      = m_pDS->fv("iSeriesId").get_asInt();
-        newTag->m_strIconPath        = m_pDS->fv("sIconPath").get_asString().c_str();
-        newTag->m_iFlags             = m_pDS->fv("iFlags").get_asInt();
-        newTag->m_strSeriesLink      = m_pDS->fv("sSeriesLink").get_asString().c_str();
-
-        result.emplace_back(newTag);
+    if (!m_pDS->query_cursor(strQuery))
+      return iReturn;
 
-        m_pDS->next();
-      }
-      m_pDS->close();
-    }
-    catch (...)
+    CPVREpgInfoTag tag;
+    while (!m_pDS->eof())
     {
-      CLog::LogF(LOGERROR, "Could not load EPG data from the database");
+      tag.m_startTime = CDateTime(static_cast<time_t>(m_pDS->fv("iStartTime").get_asInt()));
+      tag.m_endTime = CDateTime(static_cast<time_t>(m_pDS->fv("iEndTime").get_asInt()));
+      tag.m_firstAired = CDateTime(static_cast<time_t>(m_pDS->fv("iFirstAired").get_asInt()));
+
+      int iBroadcastUID = m_pDS->fv("iBroadcastUid").get_asInt();
+      // Compat: null value for broadcast uid changed from numerical -1 to 0 with PVR Addon API v4.0.0
+      tag.m_iUniqueBroadcastID = iBroadcastUID == -1 ? EPG_TAG_INVALID_UID : iBroadcastUID;
+
+      tag.m_iDatabaseID        = m_pDS->fv("idBroadcast").get_asInt();
+      tag.m_strTitle           = m_pDS->fv("sTitle").get_asString();
+      tag.m_strPlotOutline     = m_pDS->fv("sPlotOutline").get_asString();
+      tag.m_strPlot            = m_pDS->fv("sPlot").get_asString();
+      tag.m_strOriginalTitle   = m_pDS->fv("sOriginalTitle").get_asString();
+      tag.m_cast               = tag.Tokenize(m_pDS->fv("sCast").get_asString());
+      tag.m_directors          = tag.Tokenize(m_pDS->fv("sDirector").get_asString());
+      tag.m_writers            = tag.Tokenize(m_pDS->fv("sWriter").get_asString());
+      tag.m_iYear              = m_pDS->fv("iYear").get_asInt();
+      tag.m_strIMDBNumber      = m_pDS->fv("sIMDBNumber").get_asString();
+      tag.m_iGenreType         = m_pDS->fv("iGenreType").get_asInt();
+      tag.m_iGenreSubType      = m_pDS->fv("iGenreSubType").get_asInt();
+      tag.m_genre              = tag.Tokenize(m_pDS->fv("sGenre").get_asString());
+      tag.m_iParentalRating    = m_pDS->fv("iParentalRating").get_asInt();
+      tag.m_iStarRating        = m_pDS->fv("iStarRating").get_asInt();
+      tag.m_bNotify            = m_pDS->fv("bNotify").get_asBool();
+      tag.m_iEpisodeNumber     = m_pDS->fv("iEpisodeId").get_asInt();
+      tag.m_iEpisodePart       = m_pDS->fv("iEpisodePart").get_asInt();
+      tag.m_strEpisodeName     = m_pDS->fv("sEpisodeName").get_asString();
+      tag.m_iSeriesNumber      = m_pDS->fv("iSeriesId").get_asInt();
+      tag.m_strIconPath        = m_pDS->fv("sIconPath").get_asString();
+      tag.m_iFlags             = m_pDS->fv("iFlags").get_asInt();
+      tag.m_strSeriesLink      = m_pDS->fv("sSeriesLink").get_asString();
+
+      store.Put(tag);
+      iReturn++;
+
+      m_pDS->next();
     }
+    m_pDS->close();
   }
-  return result;
+  catch (...)
+  {
+    CLog::LogF(LOGERROR, "Could not load EPG data from the database");
+  }
+
+  return iReturn;
 }
 
 bool CPVREpgDatabase::GetLastEpgScanTime(int iEpgId, CDateTime *lastScan)
@@ -425,6 +519,113 @@ int CPVREpgDatabase::Persist(const CPVREpgInfoTag &tag, bool bSingleUpdate /* =
   return iReturn;
 }
 
+bool CPVREpgDatabase::PersistChanges(int iEpgId, const CPVREpgTagStore &tags, const std::vector<size_t> &changed,
+                                     const std::vector<int> &deletedIds, std::vector<int> &databaseIds,
+                                     CPVREpgPersistStats &stats)
+{
+  databaseIds.clear();
+
+  if (iEpgId <= 0)
+  {
+    CLog::LogF(LOGERROR, "Table %d is not valid", iEpgId);
+    return false;
+  }
+
+  CSingleLock lock(m_critSection);
+  if (!m_pDB || !m_pDS)
+    return false;
+
+  PreparedStatement* deleteStmt = GetPreparedStatement("DELETE FROM epgtags WHERE idBroadcast = ?");
+  PreparedStatement* insertStmt = GetPreparedStatement(EPGTAG_INSERT);
+  PreparedStatement* updateStmt = GetPreparedStatement(EPGTAG_UPDATE);
+  const bool bPrepared = deleteStmt && insertStmt && updateStmt;
+
+  bool bReturn = true;
+  try
+  {
+    // deletes go first, a new event may take the start time of a deleted one
+    for (int iDatabaseId : deletedIds)
+    {
+      if (bPrepared)
+      {
+        deleteStmt->bind(1, iDatabaseId);
+        deleteStmt->exec();
+      }
+      else if (!ExecuteQuery(PrepareSQL("DELETE FROM epgtags WHERE idBroadcast = %i", iDatabaseId)))
+      {
+        bReturn = false;
+        continue;
+      }
+
+      stats.iDeleted++;
+      stats.iBytes += sizeof(int64_t);
+    }
+
+    std::string strings[CPVREpgTagStore::STRING_FIELD_COUNT];
+    databaseIds.reserve(changed.size());
+    for (size_t index : changed)
+    {
+      const CPVREpgTagStore::Record& record = tags.At(index);
+      for (int field = 0; field < CPVREpgTagStore::STRING_FIELD_COUNT; ++field)
+        strings[field] = tags.GetString(index, static_cast<CPVREpgTagStore::StringField>(field));
+
+      int iDatabaseId = record.iDatabaseID;
+      if (bPrepared)
+      {
+        PreparedStatement* stmt = iDatabaseId > 0 ? updateStmt : insertStmt;
+        BindEvent(*stmt, iEpgId, record, strings);
+        if (iDatabaseId > 0)
+          stmt->bind(EPGTAG_COLUMN_COUNT + 1, iDatabaseId);
+        stmt->exec();
+      }
+      else
+      {
+        const std::string strQuery = PrepareSQL("REPLACE INTO epgtags (%s, idBroadcast) "
+            "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', %u, %i, %i, %i, %i, %i, %i, '%s', %i, '%s', %i, %s);",
+            EPGTAG_COLUMNS, iEpgId, static_cast<unsigned int>(ToDBTime(record.startTime)), static_cast<unsigned int>(ToDBTime(record.endTime)),
+            strings[CPVREpgTagStore::TITLE].c_str(), strings[CPVREpgTagStore::PLOT_OUTLINE].c_str(), strings[CPVREpgTagStore::PLOT].c_str(),
+            strings[CPVREpgTagStore::ORIGINAL_TITLE].c_str(), strings[CPVREpgTagStore::CAST].c_str(), strings[CPVREpgTagStore::DIRECTORS].c_str(),
+            strings[CPVREpgTagStore::WRITERS].c_str(), record.iYear, strings[CPVREpgTagStore::IMDB_NUMBER].c_str(),
+            strings[CPVREpgTagStore::ICON_PATH].c_str(), record.iGenreType, record.iGenreSubType, strings[CPVREpgTagStore::GENRE].c_str(),
+            static_cast<unsigned int>(ToDBTime(record.firstAired)), record.iParentalRating, record.iStarRating, record.bNotify,
+            record.iSeriesNumber, record.iEpisodeNumber, record.iEpisodePart, strings[CPVREpgTagStore::EPISODE_NAME].c_str(),
+            record.iFlags, strings[CPVREpgTagStore::SERIES_LINK].c_str(), record.iUniqueBroadcastID,
+            iDatabaseId > 0 ? StringUtils::Format("%i", iDatabaseId).c_str() : "NULL");
+        if (!ExecuteQuery(strQuery))
+        {
+          bReturn = false;
+          databaseIds.push_back(iDatabaseId);
+          continue;
+        }
+      }
+
+      stats.iBytes += GetEventSize(strings);
+
+      if (iDatabaseId > 0)
+      {
+        stats.iUpdated++;
+      }
+      else
+      {
+        iDatabaseId = static_cast<int>(m_pDS->lastinsertid());
+        stats.iInserted++;
+      }
+      databaseIds.push_back(iDatabaseId);
+    }
+  }
+  catch (...)
+  {
+    CLog::LogF(LOGERROR, "Could not write the changes of table %d", iEpgId);
+    bReturn = false;
+  }
+
+  // keep the ids of events that were not written
+  for (size_t i = databaseIds.size(); i < changed.size(); ++i)
+    databaseIds.push_back(tags.At(changed[i]).iDatabaseID);
+
+  return bReturn;
+}
+
 int CPVREpgDatabase::GetLastEPGId(void)
 {
   CSingleLock lock(m_critSection);
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "dbwrappers/Database.h"
 #include "threads/CriticalSection.h"
 
@@ -17,6 +19,18 @@ namespace PVR
 {
   class CPVREpg;
   class CPVREpgInfoTag;
+  class CPVREpgTagStore;
+
+  /*!
+   * @brief Rows and bytes written by CPVREpgDatabase::PersistChanges.
+   */
+  struct CPVREpgPersistStats
+  {
+    size_t iInserted = 0; /*!< number of events inserted */
+    size_t iUpdated = 0;  /*!< number of events updated */
+    size_t iDeleted = 0;  /*!< number of events deleted */
+    size_t iBytes = 0;    /*!< size of the column data written */
+  };
 
   /** The EPG database */
 
@@ -54,6 +68,13 @@ namespace PVR
      */
     void Unlock();
 
+    /*!
+     * @brief Commit the current transaction, roll it back if the commit fails.
+     * The tables keep their changes until they are committed, so they need to know the result.
+     * @return True if the transaction was committed, false if it was rolled back.
+     */
+    bool CommitTransaction() override;
+
     /*!
      * @brief Get the minimal database version that is required to operate correctly.
      * @return The minimal database version.
@@ -105,9 +126,10 @@ namespace PVR
     /*!
      * @brief Get all EPG entries for a table.
      * @param epg The EPG table to get the entries for.
-     * @return The entries.
+     * @param store Receives the entries.
+     * @return The number of entries read.
      */
-    std::vector<std::shared_ptr<CPVREpgInfoTag>> Get(const CPVREpg &epg);
+    int Get(const CPVREpg &epg, CPVREpgTagStore &store);
 
     /*!
      * @brief Get the last stored EPG scan time.
@@ -142,6 +164,21 @@ namespace PVR
      */
     int Persist(const CPVREpgInfoTag &tag, bool bSingleUpdate = true);
 
+    /*!
+     * @brief Write the differences between an EPG table and its stored events.
+     * Events with a database id are updated, other events are inserted. Run this inside a transaction.
+     * @param iEpgId The id of the table.
+     * @param tags The events of the table.
+     * @param changed The indices of the new or changed events in tags.
+     * @param deletedIds The database ids of the events to delete.
+     * @param databaseIds Receives the database ids of the changed events, in the order of changed.
+     * @param stats Receives the number of rows and bytes written.
+     * @return True if all changes were written, false otherwise.
+     */
+    bool PersistChanges(int iEpgId, const CPVREpgTagStore &tags, const std::vector<size_t> &changed,
+                        const std::vector<int> &deletedIds, std::vector<int> &databaseIds,
+                        CPVREpgPersistStats &stats);
+
     /*!
      * @return Last EPG id in the database
      */
@@ -52,6 +52,9 @@ void CPVREpgSearchFilter::Reset()
     m_endDateTime.SetFromUTCDateTime(m_startDateTime + CDateTimeSpan(10, 0, 0, 0)); // default to start + 10 days
   }
 
+  m_startTime = CPVREpgTagStore::ToTime(m_startDateTime);
+  m_endTime = CPVREpgTagStore::ToTime(m_endDateTime);
+
   m_bIncludeUnknownGenres    = false;
   m_bRemoveDuplicates        = false;
 
@@ -96,6 +99,18 @@ bool CPVREpgSearchFilter::MatchStartAndEndTimes(const CPVREpgInfoTagPtr &tag) co
   return (tag->StartAsLocalTime() >= m_startDateTime && tag->EndAsLocalTime() <= m_endDateTime);
 }
 
+void CPVREpgSearchFilter::SetStartDateTime(const CDateTime &startDateTime)
+{
+  m_startDateTime = startDateTime;
+  m_startTime = CPVREpgTagStore::ToTime(startDateTime);
+}
+
+void CPVREpgSearchFilter::SetEndDateTime(const CDateTime &endDateTime)
+{
+  m_endDateTime = endDateTime;
+  m_endTime = CPVREpgTagStore::ToTime(endDateTime);
+}
+
 void CPVREpgSearchFilter::SetSearchPhrase(const std::string &strSearchPhrase)
 {
   // match the exact phrase
@@ -121,6 +136,55 @@ bool CPVREpgSearchFilter::MatchSearchTerm(const CPVREpgInfoTagPtr &tag) const
   return bReturn;
 }
 
+bool CPVREpgSearchFilter::MatchSearchTerm(const CPVREpgStringPool& strings, std::vector<bool>& matches) const
+{
+  if (m_strSearchTerm.empty())
+    return false;
+
+  CTextSearch search(m_strSearchTerm, m_bIsCaseSensitive, SEARCH_DEFAULT_OR);
+  strings.Match([&search](const std::string& str) { return search.Search(str); }, matches);
+  return true;
+}
+
+bool CPVREpgSearchFilter::MatchRecord(const CPVREpgTagStore::Record& record, const std::vector<bool>* stringMatches) const
+{
+  if (m_iUniqueBroadcastId != EPG_TAG_INVALID_UID && record.iUniqueBroadcastID != m_iUniqueBroadcastId)
+    return false;
+
+  if (m_iGenreType != EPG_SEARCH_UNSET && record.iGenreType != m_iGenreType)
+  {
+    const bool bIsUnknownGenre = record.iGenreType > EPG_EVENT_CONTENTMASK_USERDEFINED ||
+                                 record.iGenreType < EPG_EVENT_CONTENTMASK_MOVIEDRAMA;
+    if (!m_bIncludeUnknownGenres || !bIsUnknownGenre)
+      return false;
+  }
+
+  if (stringMatches)
+  {
+    // strings added after the search term was evaluated are not covered, they may match
+    const auto matches = [stringMatches](CPVREpgStringPool::Id id) {
+      return id >= stringMatches->size() || (*stringMatches)[id];
+    };
+    if (!matches(record.strings[CPVREpgTagStore::TITLE]) &&
+        !matches(record.strings[CPVREpgTagStore::PLOT_OUTLINE]) &&
+        !(m_bSearchInDescription && matches(record.strings[CPVREpgTagStore::PLOT])))
+      return false;
+  }
+
+  if (record.startTime == CPVREpgTagStore::INVALID_TIME || record.endTime == CPVREpgTagStore::INVALID_TIME)
+    return true;
+
+  const int iDuration = record.endTime - record.startTime > 0 ? static_cast<int>(record.endTime - record.startTime) : 3600;
+  if ((m_iMinimumDuration != EPG_SEARCH_UNSET && iDuration <= m_iMinimumDuration * 60) ||
+      (m_iMaximumDuration != EPG_SEARCH_UNSET && iDuration >= m_iMaximumDuration * 60))
+    return false;
+
+  // the filter times are local times, allow for any time zone offset here. the exact check is done on the tag.
+  static const time_t TIME_ZONE_SLACK = 24 * 60 * 60;
+  return (m_startTime == CPVREpgTagStore::INVALID_TIME || record.startTime + TIME_ZONE_SLACK >= m_startTime) &&
+         (m_endTime == CPVREpgTagStore::INVALID_TIME || record.endTime - TIME_ZONE_SLACK <= m_endTime);
+}
+
 bool CPVREpgSearchFilter::MatchBroadcastId(const CPVREpgInfoTagPtr &tag) const
 {
   if (m_iUniqueBroadcastId != EPG_TAG_INVALID_UID)
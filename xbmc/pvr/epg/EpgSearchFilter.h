@@ -16,6 +16,7 @@
 
 #include "pvr/PVRTypes.h"
 #include "pvr/channels/PVRChannelNumber.h"
+#include "pvr/epg/EpgTagStore.h"
 
 namespace PVR
 {
@@ -46,6 +47,23 @@ namespace PVR
      */
     bool FilterEntry(const CPVREpgInfoTagPtr &tag) const;
 
+    /*!
+     * @brief Evaluate the search term once for every string of the given pool.
+     * @param strings The pool.
+     * @param matches Receives the results indexed by string id.
+     * @return False if there is no search term to evaluate, true otherwise.
+     */
+    bool MatchSearchTerm(const CPVREpgStringPool& strings, std::vector<bool>& matches) const;
+
+    /*!
+     * @brief Check if a stored event may match this filter, without creating a tag for it.
+     * Only checks the data of the event itself, FilterEntry() has to be applied to the tags of the events that may match.
+     * @param record The event.
+     * @param stringMatches The results of MatchSearchTerm() for the pool of the event or nullptr if there is no search term.
+     * @return False if the event does not match, true if it may match.
+     */
+    bool MatchRecord(const CPVREpgTagStore::Record& record, const std::vector<bool>* stringMatches) const;
+
     /*!
      * @brief remove duplicates from a list of epg tags.
      * @param results The list of epg tags.
@@ -81,10 +99,10 @@ namespace PVR
     void SetMaximumDuration(int iMaximumDuration) { m_iMaximumDuration = iMaximumDuration; }
 
     const CDateTime &GetStartDateTime() const { return m_startDateTime; }
-    void SetStartDateTime(const CDateTime &startDateTime) { m_startDateTime = startDateTime; }
+    void SetStartDateTime(const CDateTime &startDateTime);
 
     const CDateTime &GetEndDateTime() const  { return m_endDateTime; }
-    void SetEndDateTime(const CDateTime &endDateTime) { m_endDateTime = endDateTime; }
+    void SetEndDateTime(const CDateTime &endDateTime);
 
     bool ShouldIncludeUnknownGenres() const { return m_bIncludeUnknownGenres; }
     void SetIncludeUnknownGenres(bool bIncludeUnknownGenres) { m_bIncludeUnknownGenres = bIncludeUnknownGenres; }
@@ -132,6 +150,8 @@ namespace PVR
     int           m_iMaximumDuration;         /*!< The maximum duration for an entry */
     CDateTime     m_startDateTime;            /*!< The minimum start time for an entry */
     CDateTime     m_endDateTime;              /*!< The maximum end time for an entry */
+    time_t        m_startTime;                /*!< m_startDateTime for stored events */
+    time_t        m_endTime;                  /*!< m_endDateTime for stored events */
     bool          m_bIncludeUnknownGenres;    /*!< Include unknown genres or not */
     bool          m_bRemoveDuplicates;        /*!< True to remove duplicate events, false if not */
     const bool    m_bIsRadio;                 /*!< True to filter radio channels only, false to tv only */
@@ -0,0 +1,591 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "EpgTagStore.h"
+
+#include <algorithm>
+#include <limits>
+#include <string.h>
+
+#include "ServiceBroker.h"
+#include "addons/kodi-addon-dev-kit/include/kodi/xbmc_epg_types.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
+
+#include "pvr/epg/Epg.h"
+#include "pvr/epg/EpgInfoTag.h"
+
+using namespace PVR;
+
+namespace
+{
+  // compact the arena once this many bytes are unused and they are at least half of it
+  const size_t COMPACT_MIN_UNUSED_BYTES = 1024 * 1024;
+
+  struct StartTimeLess
+  {
+    bool operator()(const CPVREpgTagStore::Record& record, time_t time) const { return record.startTime < time; }
+    bool operator()(time_t time, const CPVREpgTagStore::Record& record) const { return time < record.startTime; }
+  };
+}
+
+const CPVREpgStringPool::Id CPVREpgStringPool::EMPTY;
+
+CPVREpgStringPool::CPVREpgStringPool()
+{
+  m_entries.push_back({0, 0, 0, 0}); // EMPTY
+  m_table.resize(1024, EMPTY);
+}
+
+uint32_t CPVREpgStringPool::Hash(const char* str, size_t length)
+{
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; ++i)
+  {
+    hash ^= static_cast<unsigned char>(str[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+CPVREpgStringPool::Id CPVREpgStringPool::Find(const char* str, size_t length, uint32_t hash) const
+{
+  const size_t mask = m_table.size() - 1;
+  for (size_t slot = hash & mask; m_table[slot] != EMPTY; slot = (slot + 1) & mask)
+  {
+    const Entry& entry = m_entries[m_table[slot]];
+    if (entry.hash == hash && entry.length == length &&
+        memcmp(m_arena.data() + entry.offset, str, length) == 0)
+      return m_table[slot];
+  }
+  return EMPTY;
+}
+
+void CPVREpgStringPool::InsertIntoTable(Id id)
+{
+  const size_t mask = m_table.size() - 1;
+  size_t slot = m_entries[id].hash & mask;
+  while (m_table[slot] != EMPTY)
+    slot = (slot + 1) & mask;
+
+  m_table[slot] = id;
+  m_iTableCount++;
+}
+
+void CPVREpgStringPool::Rehash(size_t size)
+{
+  m_table.assign(size, EMPTY);
+  m_iTableCount = 0;
+  for (Id id = 1; id < m_entries.size(); ++id)
+  {
+    if (m_entries[id].refs > 0)
+      InsertIntoTable(id);
+  }
+}
+
+CPVREpgStringPool::Id CPVREpgStringPool::AddLocked(const char* str, size_t length)
+{
+  if (length == 0)
+    return EMPTY;
+
+  const uint32_t hash = Hash(str, length);
+  Id id = Find(str, length, hash);
+  if (id != EMPTY)
+  {
+    Entry& entry = m_entries[id];
+    if (entry.refs++ == 0)
+    {
+      // unused string in use again
+      m_iUnusedBytes -= entry.length;
+      m_iCount++;
+    }
+    return id;
+  }
+
+  // keep the table at most half full, unused strings count as they are still in it
+  if ((m_iTableCount + 1) * 2 > m_table.size())
+    Rehash(m_table.size() * 2);
+
+  const Entry entry = {static_cast<uint32_t>(m_arena.size()), static_cast<uint32_t>(length), hash, 1};
+  m_arena.insert(m_arena.end(), str, str + length);
+
+  if (!m_freeIds.empty())
+  {
+    id = m_freeIds.back();
+    m_freeIds.pop_back();
+    m_entries[id] = entry;
+    // the id now stands for another string, matches evaluated before are stale
+    m_iGeneration++;
+  }
+  else
+  {
+    id = static_cast<Id>(m_entries.size());
+    m_entries.push_back(entry);
+  }
+
+  InsertIntoTable(id);
+  m_iCount++;
+  return id;
+}
+
+CPVREpgStringPool::Id CPVREpgStringPool::Add(const std::string& str)
+{
+  CSingleLock lock(m_critSection);
+  return AddLocked(str.c_str(), str.size());
+}
+
+void CPVREpgStringPool::Add(const std::string* strings, size_t count, Id* ids)
+{
+  CSingleLock lock(m_critSection);
+  for (size_t i = 0; i < count; ++i)
+    ids[i] = AddLocked(strings[i].c_str(), strings[i].size());
+}
+
+void CPVREpgStringPool::Add(const char* const* strings, size_t count, Id* ids)
+{
+  CSingleLock lock(m_critSection);
+  for (size_t i = 0; i < count; ++i)
+    ids[i] = strings[i] ? AddLocked(strings[i], strlen(strings[i])) : EMPTY;
+}
+
+void CPVREpgStringPool::AddRef(const Id* ids, size_t count)
+{
+  CSingleLock lock(m_critSection);
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (ids[i] != EMPTY)
+      m_entries[ids[i]].refs++;
+  }
+}
+
+void CPVREpgStringPool::Release(const Id* ids, size_t count)
+{
+  CSingleLock lock(m_critSection);
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (ids[i] == EMPTY)
+      continue;
+
+    Entry& entry = m_entries[ids[i]];
+    if (--entry.refs == 0)
+    {
+      m_iUnusedBytes += entry.length;
+      m_iCount--;
+    }
+  }
+
+  if (m_iUnusedBytes >= COMPACT_MIN_UNUSED_BYTES && m_iUnusedBytes * 2 >= m_arena.size())
+    Compact();
+}
+
+void CPVREpgStringPool::Compact()
+{
+  // move the strings still in use to a new arena. their ids do not change.
+  std::vector<char> arena;
+  arena.reserve(m_arena.size() - m_iUnusedBytes);
+
+  for (Id id = 1; id < m_entries.size(); ++id)
+  {
+    Entry& entry = m_entries[id];
+    if (entry.refs > 0)
+    {
+      const uint32_t offset = static_cast<uint32_t>(arena.size());
+      arena.insert(arena.end(), m_arena.begin() + entry.offset, m_arena.begin() + entry.offset + entry.length);
+      entry.offset = offset;
+    }
+    else if (entry.length > 0)
+    {
+      entry.length = 0;
+      m_freeIds.push_back(id);
+    }
+  }
+
+  m_arena.swap(arena);
+  m_iUnusedBytes = 0;
+  m_iGeneration++;
+
+  size_t tableSize = 1024;
+  while (tableSize < m_iCount * 2)
+    tableSize *= 2;
+  Rehash(tableSize);
+}
+
+std::string CPVREpgStringPool::Get(Id id) const
+{
+  if (id == EMPTY)
+    return std::string();
+
+  CSingleLock lock(m_critSection);
+  const Entry& entry = m_entries[id];
+  return std::string(m_arena.data() + entry.offset, entry.length);
+}
+
+void CPVREpgStringPool::Get(const Id* ids, size_t count, std::string* strings) const
+{
+  CSingleLock lock(m_critSection);
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (ids[i] == EMPTY)
+    {
+      strings[i].clear();
+    }
+    else
+    {
+      const Entry& entry = m_entries[ids[i]];
+      strings[i].assign(m_arena.data() + entry.offset, entry.length);
+    }
+  }
+}
+
+void CPVREpgStringPool::Match(const std::function<bool(const std::string&)>& predicate, std::vector<bool>& matches) const
+{
+  CSingleLock lock(m_critSection);
+  matches.assign(m_entries.size(), false);
+  matches[EMPTY] = predicate(std::string());
+
+  // unused strings keep their id until the next compaction, they may be referenced again
+  std::string str;
+  for (Id id = 1; id < m_entries.size(); ++id)
+  {
+    const Entry& entry = m_entries[id];
+    if (entry.length > 0)
+    {
+      str.assign(m_arena.data() + entry.offset, entry.length);
+      matches[id] = predicate(str);
+    }
+  }
+}
+
+unsigned int CPVREpgStringPool::GetGeneration() const
+{
+  CSingleLock lock(m_critSection);
+  return m_iGeneration;
+}
+
+size_t CPVREpgStringPool::GetCount() const
+{
+  CSingleLock lock(m_critSection);
+  return m_iCount;
+}
+
+size_t CPVREpgStringPool::GetMemoryUsage() const
+{
+  CSingleLock lock(m_critSection);
+  return m_arena.capacity() +
+         m_entries.capacity() * sizeof(Entry) +
+         m_freeIds.capacity() * sizeof(Id) +
+         m_table.capacity() * sizeof(Id);
+}
+
+const time_t CPVREpgTagStore::INVALID_TIME = std::numeric_limits<time_t>::min();
+
+CPVREpgTagStore::CPVREpgTagStore(const std::shared_ptr<CPVREpgStringPool>& strings)
+: m_strings(strings)
+{
+}
+
+CPVREpgTagStore::~CPVREpgTagStore()
+{
+  Clear();
+}
+
+time_t CPVREpgTagStore::ToTime(const CDateTime& dateTime)
+{
+  if (!dateTime.IsValid())
+    return INVALID_TIME;
+
+  time_t time;
+  dateTime.GetAsTime(time);
+  return time;
+}
+
+CDateTime CPVREpgTagStore::FromTime(time_t time)
+{
+  if (time == INVALID_TIME)
+  {
+    CDateTime invalid;
+    invalid.SetValid(false);
+    return invalid;
+  }
+  return CDateTime(time);
+}
+
+int CPVREpgTagStore::Find(time_t startTime) const
+{
+  const size_t index = LowerBound(startTime);
+  if (index < m_records.size() && m_records[index].startTime == startTime)
+    return static_cast<int>(index);
+  return -1;
+}
+
+size_t CPVREpgTagStore::LowerBound(time_t time) const
+{
+  return std::lower_bound(m_records.begin(), m_records.end(), time, StartTimeLess()) - m_records.begin();
+}
+
+size_t CPVREpgTagStore::UpperBound(time_t time) const
+{
+  return std::upper_bound(m_records.begin(), m_records.end(), time, StartTimeLess()) - m_records.begin();
+}
+
+int CPVREpgTagStore::FindByBroadcastId(unsigned int iUniqueBroadcastId) const
+{
+  for (size_t i = 0; i < m_records.size(); ++i)
+  {
+    if (m_records[i].iUniqueBroadcastID == iUniqueBroadcastId)
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+size_t CPVREpgTagStore::Put(const CPVREpgInfoTag& tag, bool bUpdateDatabaseId /* = true */, bool* pbChanged /* = nullptr */)
+{
+  Record record;
+  std::string strings[STRING_FIELD_COUNT];
+  {
+    CSingleLock lock(tag.m_critSection);
+    record.startTime = ToTime(tag.m_startTime);
+    record.endTime = ToTime(tag.m_endTime);
+    record.firstAired = ToTime(tag.m_firstAired);
+    record.iUniqueBroadcastID = tag.m_iUniqueBroadcastID;
+    record.iDatabaseID = tag.m_iDatabaseID;
+    record.iFlags = tag.m_iFlags;
+    record.iGenreType = tag.m_iGenreType;
+    record.iGenreSubType = tag.m_iGenreSubType;
+    record.iParentalRating = tag.m_iParentalRating;
+    record.iStarRating = tag.m_iStarRating;
+    record.iYear = tag.m_iYear;
+    record.iSeriesNumber = tag.m_iSeriesNumber;
+    record.iEpisodeNumber = tag.m_iEpisodeNumber;
+    record.iEpisodePart = tag.m_iEpisodePart;
+    record.bNotify = tag.m_bNotify;
+
+    strings[TITLE] = tag.m_strTitle;
+    strings[PLOT_OUTLINE] = tag.m_strPlotOutline;
+    strings[PLOT] = tag.m_strPlot;
+    strings[ORIGINAL_TITLE] = tag.m_strOriginalTitle;
+    strings[CAST] = CPVREpgInfoTag::DeTokenize(tag.m_cast);
+    strings[DIRECTORS] = CPVREpgInfoTag::DeTokenize(tag.m_directors);
+    strings[WRITERS] = CPVREpgInfoTag::DeTokenize(tag.m_writers);
+    strings[IMDB_NUMBER] = tag.m_strIMDBNumber;
+    // genres given by type are looked up when the tag is created
+    if (tag.m_iGenreType == EPG_GENRE_USE_STRING)
+      strings[GENRE] = CPVREpgInfoTag::DeTokenize(tag.m_genre);
+    strings[EPISODE_NAME] = tag.m_strEpisodeName;
+    strings[ICON_PATH] = tag.m_strIconPath;
+    strings[SERIES_LINK] = tag.m_strSeriesLink;
+  }
+
+  m_strings->Add(strings, STRING_FIELD_COUNT, record.strings);
+  return Put(record, bUpdateDatabaseId, false, pbChanged);
+}
+
+size_t CPVREpgTagStore::Put(const EPG_TAG& data, int iTimeCorrection, bool bUpdateDatabaseId /* = true */, bool* pbChanged /* = nullptr */)
+{
+  Record record;
+  record.startTime = data.startTime + iTimeCorrection;
+  record.endTime = data.endTime + iTimeCorrection;
+  record.firstAired = data.firstAired + iTimeCorrection;
+  record.iUniqueBroadcastID = data.iUniqueBroadcastId;
+  record.iDatabaseID = -1;
+  record.iFlags = data.iFlags;
+  record.iGenreType = data.iGenreType;
+  record.iGenreSubType = data.iGenreSubType;
+  record.iParentalRating = data.iParentalRating;
+  record.iStarRating = data.iStarRating;
+  record.iYear = data.iYear;
+  record.iSeriesNumber = data.iSeriesNumber;
+  record.iEpisodeNumber = data.iEpisodeNumber;
+  record.iEpisodePart = data.iEpisodePartNumber;
+  record.bNotify = data.bNotify;
+
+  // the add-on already joins cast, directors, writers and genres with EPG_STRING_TOKEN_SEPARATOR
+  const char* strings[STRING_FIELD_COUNT] = {};
+  strings[TITLE] = data.strTitle;
+  strings[PLOT_OUTLINE] = data.strPlotOutline;
+  strings[PLOT] = data.strPlot;
+  strings[ORIGINAL_TITLE] = data.strOriginalTitle;
+  strings[CAST] = data.strCast;
+  strings[DIRECTORS] = data.strDirector;
+  strings[WRITERS] = data.strWriter;
+  strings[IMDB_NUMBER] = data.strIMDBNumber;
+  if (data.iGenreType == EPG_GENRE_USE_STRING)
+    strings[GENRE] = data.strGenreDescription;
+  strings[EPISODE_NAME] = data.strEpisodeName;
+  strings[ICON_PATH] = data.strIconPath;
+  strings[SERIES_LINK] = data.strSeriesLink;
+
+  m_strings->Add(strings, STRING_FIELD_COUNT, record.strings);
+  return Put(record, bUpdateDatabaseId, false, pbChanged);
+}
+
+size_t CPVREpgTagStore::Put(const Record& record, bool bUpdateDatabaseId /* = true */, bool* pbChanged /* = nullptr */)
+{
+  Record copy = record;
+  return Put(copy, bUpdateDatabaseId, true, pbChanged);
+}
+
+bool CPVREpgTagStore::IsSameEvent(const Record& left, const Record& right)
+{
+  // strings are deduplicated, equal ids mean equal strings
+  return left.startTime == right.startTime &&
+         left.endTime == right.endTime &&
+         left.firstAired == right.firstAired &&
+         left.iUniqueBroadcastID == right.iUniqueBroadcastID &&
+         left.iFlags == right.iFlags &&
+         left.iGenreType == right.iGenreType &&
+         left.iGenreSubType == right.iGenreSubType &&
+         left.iParentalRating == right.iParentalRating &&
+         left.iStarRating == right.iStarRating &&
+         left.iYear == right.iYear &&
+         left.iSeriesNumber == right.iSeriesNumber &&
+         left.iEpisodeNumber == right.iEpisodeNumber &&
+         left.iEpisodePart == right.iEpisodePart &&
+         left.bNotify == right.bNotify &&
+         std::equal(left.strings, left.strings + STRING_FIELD_COUNT, right.strings);
+}
+
+size_t CPVREpgTagStore::Put(Record& record, bool bUpdateDatabaseId, bool bAddRef, bool* pbChanged)
+{
+  if (bAddRef)
+    m_strings->AddRef(record.strings, STRING_FIELD_COUNT);
+
+  // events mostly arrive in order
+  size_t index = m_records.size();
+  if (!m_records.empty() && m_records.back().startTime >= record.startTime)
+    index = LowerBound(record.startTime);
+
+  if (index < m_records.size() && m_records[index].startTime == record.startTime)
+  {
+    Record& existing = m_records[index];
+    if (!bUpdateDatabaseId)
+      record.iDatabaseID = existing.iDatabaseID;
+
+    if (pbChanged)
+      *pbChanged = !IsSameEvent(existing, record);
+
+    m_strings->Release(existing.strings, STRING_FIELD_COUNT);
+    existing = record;
+  }
+  else
+  {
+    if (pbChanged)
+      *pbChanged = true;
+
+    m_records.insert(m_records.begin() + index, record);
+  }
+
+  return index;
+}
+
+void CPVREpgTagStore::SetEnd(size_t index, time_t endTime)
+{
+  m_records[index].endTime = endTime;
+}
+
+void CPVREpgTagStore::SetDatabaseId(size_t index, int iDatabaseId)
+{
+  m_records[index].iDatabaseID = iDatabaseId;
+}
+
+void CPVREpgTagStore::Erase(size_t index)
+{
+  m_strings->Release(m_records[index].strings, STRING_FIELD_COUNT);
+  m_records.erase(m_records.begin() + index);
+}
+
+size_t CPVREpgTagStore::EraseEndingBefore(time_t time)
+{
+  const auto it = std::remove_if(m_records.begin(), m_records.end(),
+                                 [this, time](const Record& record)
+                                 {
+                                   if (record.endTime >= time)
+                                     return false;
+
+                                   m_strings->Release(record.strings, STRING_FIELD_COUNT);
+                                   return true;
+                                 });
+  const size_t count = m_records.end() - it;
+  m_records.erase(it, m_records.end());
+  return count;
+}
+
+void CPVREpgTagStore::Clear()
+{
+  for (const auto& record : m_records)
+    m_strings->Release(record.strings, STRING_FIELD_COUNT);
+
+  m_records.clear();
+  m_records.shrink_to_fit();
+}
+
+void CPVREpgTagStore::Reserve(size_t count)
+{
+  m_records.reserve(count);
+}
+
+void CPVREpgTagStore::Swap(CPVREpgTagStore& other)
+{
+  m_records.swap(other.m_records);
+}
+
+std::string CPVREpgTagStore::GetString(size_t index, StringField field) const
+{
+  return m_strings->Get(m_records[index].strings[field]);
+}
+
+void CPVREpgTagStore::ToTag(size_t index, CPVREpgInfoTag& tag) const
+{
+  const Record& record = m_records[index];
+  std::string strings[STRING_FIELD_COUNT];
+  m_strings->Get(record.strings, STRING_FIELD_COUNT, strings);
+
+  CSingleLock lock(tag.m_critSection);
+  tag.m_startTime = FromTime(record.startTime);
+  tag.m_endTime = FromTime(record.endTime);
+  tag.m_firstAired = FromTime(record.firstAired);
+  tag.m_iUniqueBroadcastID = record.iUniqueBroadcastID;
+  tag.m_iDatabaseID = record.iDatabaseID;
+  tag.m_iFlags = record.iFlags;
+  tag.m_iGenreType = record.iGenreType;
+  tag.m_iGenreSubType = record.iGenreSubType;
+  tag.m_iParentalRating = record.iParentalRating;
+  tag.m_iStarRating = record.iStarRating;
+  tag.m_iYear = record.iYear;
+  tag.m_iSeriesNumber = record.iSeriesNumber;
+  tag.m_iEpisodeNumber = record.iEpisodeNumber;
+  tag.m_iEpisodePart = record.iEpisodePart;
+  tag.m_bNotify = record.bNotify;
+
+  tag.m_strTitle.swap(strings[TITLE]);
+  tag.m_strPlotOutline.swap(strings[PLOT_OUTLINE]);
+  tag.m_strPlot.swap(strings[PLOT]);
+  tag.m_strOriginalTitle.swap(strings[ORIGINAL_TITLE]);
+  tag.m_cast = CPVREpgInfoTag::Tokenize(strings[CAST]);
+  tag.m_directors = CPVREpgInfoTag::Tokenize(strings[DIRECTORS]);
+  tag.m_writers = CPVREpgInfoTag::Tokenize(strings[WRITERS]);
+  tag.m_strIMDBNumber.swap(strings[IMDB_NUMBER]);
+  if (record.iGenreType == EPG_GENRE_USE_STRING && !strings[GENRE].empty())
+    tag.m_genre = CPVREpgInfoTag::Tokenize(strings[GENRE]);
+  else
+    tag.m_genre = StringUtils::Split(CPVREpg::ConvertGenreIdToString(record.iGenreType, record.iGenreSubType),
+                                     CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
+  tag.m_strEpisodeName.swap(strings[EPISODE_NAME]);
+  tag.m_strIconPath.swap(strings[ICON_PATH]);
+  tag.m_strSeriesLink.swap(strings[SERIES_LINK]);
+
+  tag.UpdatePath();
+}
+
+size_t CPVREpgTagStore::GetMemoryUsage() const
+{
+  return m_records.capacity() * sizeof(Record);
+}
@@ -0,0 +1,347 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <time.h>
+#include <vector>
+
+#include "XBDateTime.h"
+#include "threads/CriticalSection.h"
+
+struct EPG_TAG;
+
+namespace PVR
+{
+  class CPVREpgInfoTag;
+
+  /*!
+   * @brief Deduplicated storage for the strings of all EPG events.
+   *
+   * Every distinct string is stored once in an arena and referenced by a 32 bit id.
+   * Ids are reference counted and stay valid as long as they are referenced. Unreferenced
+   * strings are kept until enough of the arena is unused, then the arena is compacted.
+   * All methods are thread safe.
+   */
+  class CPVREpgStringPool
+  {
+  public:
+    typedef uint32_t Id;
+    static const Id EMPTY = 0; /*!< the id of the empty string, which is never stored */
+
+    CPVREpgStringPool();
+
+    /*!
+     * @brief Add a reference to a string, storing it if it is not in the pool yet.
+     * @param str The string.
+     * @return The id of the string.
+     */
+    Id Add(const std::string& str);
+
+    /*!
+     * @brief Add references to several strings at once.
+     * @param strings The strings.
+     * @param count The number of strings.
+     * @param ids Receives the ids of the strings.
+     */
+    void Add(const std::string* strings, size_t count, Id* ids);
+
+    /*!
+     * @brief Add references to several C strings at once. NULL is stored as the empty string.
+     * @param strings The strings.
+     * @param count The number of strings.
+     * @param ids Receives the ids of the strings.
+     */
+    void Add(const char* const* strings, size_t count, Id* ids);
+
+    /*!
+     * @brief Add references to already stored strings.
+     * @param ids The ids.
+     * @param count The number of ids.
+     */
+    void AddRef(const Id* ids, size_t count);
+
+    /*!
+     * @brief Drop references to strings.
+     * @param ids The ids.
+     * @param count The number of ids.
+     */
+    void Release(const Id* ids, size_t count);
+
+    /*!
+     * @brief Get a string.
+     * @param id The id of the string.
+     * @return The string.
+     */
+    std::string Get(Id id) const;
+
+    /*!
+     * @brief Get several strings at once.
+     * @param ids The ids.
+     * @param count The number of ids.
+     * @param strings Receives the strings.
+     */
+    void Get(const Id* ids, size_t count, std::string* strings) const;
+
+    /*!
+     * @brief Evaluate a predicate once for every distinct string instead of once per event.
+     * @param predicate The predicate.
+     * @param matches Receives the results indexed by id. Ids added later are not covered, ids reused later change the generation.
+     */
+    void Match(const std::function<bool(const std::string&)>& predicate, std::vector<bool>& matches) const;
+
+    /*!
+     * @brief Get the generation of the ids. It changes whenever an id may stand for another string than before,
+     * i.e. when a compaction freed ids and when a freed id is reused for a new string.
+     * @return The generation.
+     */
+    unsigned int GetGeneration() const;
+
+    /*!
+     * @brief Get the number of distinct strings referenced.
+     * @return The number of strings.
+     */
+    size_t GetCount() const;
+
+    /*!
+     * @brief Get the memory allocated by the pool.
+     * @return The size in bytes.
+     */
+    size_t GetMemoryUsage() const;
+
+  private:
+    CPVREpgStringPool(const CPVREpgStringPool&) = delete;
+    CPVREpgStringPool& operator=(const CPVREpgStringPool&) = delete;
+
+    struct Entry
+    {
+      uint32_t offset; /*!< offset of the string in the arena */
+      uint32_t length; /*!< length of the string */
+      uint32_t hash;   /*!< hash of the string */
+      uint32_t refs;   /*!< number of references, 0 if unused */
+    };
+
+    static uint32_t Hash(const char* str, size_t length);
+    Id Find(const char* str, size_t length, uint32_t hash) const;
+    Id AddLocked(const char* str, size_t length);
+    void InsertIntoTable(Id id);
+    void Rehash(size_t size);
+    void Compact();
+
+    mutable CCriticalSection m_critSection;
+    std::vector<char> m_arena;      /*!< the characters of all stored strings */
+    std::vector<Entry> m_entries;   /*!< the stored strings, indexed by id */
+    std::vector<Id> m_freeIds;      /*!< ids that can be reused */
+    std::vector<Id> m_table;        /*!< open addressing hash table of ids, EMPTY for free slots */
+    size_t m_iTableCount = 0;       /*!< number of ids in the hash table */
+    size_t m_iUnusedBytes = 0;      /*!< bytes of the arena used by unreferenced strings */
+    size_t m_iCount = 0;            /*!< number of referenced strings */
+    unsigned int m_iGeneration = 0; /*!< incremented on every compaction and every reuse of a freed id */
+  };
+
+  /*!
+   * @brief Compact storage for the events of one EPG table.
+   *
+   * Events are kept as fixed size records sorted by start time, their strings are
+   * stored in a shared CPVREpgStringPool. CPVREpgInfoTag instances are only created
+   * on request with ToTag(). The store is not thread safe, it is protected by its owner.
+   */
+  class CPVREpgTagStore
+  {
+  public:
+    enum StringField
+    {
+      TITLE = 0,
+      PLOT_OUTLINE,
+      PLOT,
+      ORIGINAL_TITLE,
+      CAST,
+      DIRECTORS,
+      WRITERS,
+      IMDB_NUMBER,
+      GENRE,
+      EPISODE_NAME,
+      ICON_PATH,
+      SERIES_LINK,
+      STRING_FIELD_COUNT
+    };
+
+    static const time_t INVALID_TIME; /*!< stored for invalid date/times */
+
+    struct Record
+    {
+      time_t startTime;
+      time_t endTime;
+      time_t firstAired;
+      unsigned int iUniqueBroadcastID;
+      int iDatabaseID;
+      unsigned int iFlags;
+      int iGenreType;
+      int iGenreSubType;
+      int iParentalRating;
+      int iStarRating;
+      int iYear;
+      int iSeriesNumber;
+      int iEpisodeNumber;
+      int iEpisodePart;
+      bool bNotify;
+      CPVREpgStringPool::Id strings[STRING_FIELD_COUNT]; /*!< cast, directors, writers and genre are stored detokenized */
+    };
+
+    explicit CPVREpgTagStore(const std::shared_ptr<CPVREpgStringPool>& strings);
+    ~CPVREpgTagStore();
+
+    /*!
+     * @brief Get the string pool of this store.
+     * @return The pool.
+     */
+    const std::shared_ptr<CPVREpgStringPool>& GetStringPool() const { return m_strings; }
+
+    bool Empty() const { return m_records.empty(); }
+    size_t Size() const { return m_records.size(); }
+    const Record& At(size_t index) const { return m_records[index]; }
+
+    /*!
+     * @brief Find the event starting at the given time.
+     * @param startTime The start time in UTC.
+     * @return The index of the event or -1 if not found.
+     */
+    int Find(time_t startTime) const;
+
+    /*!
+     * @brief Get the index of the first event starting at or after the given time.
+     * @param time The time in UTC.
+     * @return The index, Size() if there is no such event.
+     */
+    size_t LowerBound(time_t time) const;
+
+    /*!
+     * @brief Get the index of the first event starting after the given time.
+     * @param time The time in UTC.
+     * @return The index, Size() if there is no such event.
+     */
+    size_t UpperBound(time_t time) const;
+
+    /*!
+     * @brief Find the first event with the given unique broadcast id.
+     * @param iUniqueBroadcastId The id.
+     * @return The index of the event or -1 if not found.
+     */
+    int FindByBroadcastId(unsigned int iUniqueBroadcastId) const;
+
+    /*!
+     * @brief Add or replace the event with the start time of the given tag.
+     * @param tag The tag.
+     * @param bUpdateDatabaseId False to keep the database id of a replaced event.
+     * @param pbChanged If given, set to false if an identical event was already stored.
+     * @return The index of the event.
+     */
+    size_t Put(const CPVREpgInfoTag& tag, bool bUpdateDatabaseId = true, bool* pbChanged = nullptr);
+
+    /*!
+     * @brief Add or replace the event with the start time of the given record.
+     * @param record The record, from a store using the same string pool.
+     * @param bUpdateDatabaseId False to keep the database id of a replaced event.
+     * @param pbChanged If given, set to false if an identical event was already stored.
+     * @return The index of the event.
+     */
+    size_t Put(const Record& record, bool bUpdateDatabaseId = true, bool* pbChanged = nullptr);
+
+    /*!
+     * @brief Add or replace the event with the start time of the given add-on EPG data, without creating a tag.
+     * @param data The data.
+     * @param iTimeCorrection Seconds to add to the times of the data.
+     * @param bUpdateDatabaseId False to keep the database id of a replaced event.
+     * @param pbChanged If given, set to false if an identical event was already stored.
+     * @return The index of the event.
+     */
+    size_t Put(const EPG_TAG& data, int iTimeCorrection, bool bUpdateDatabaseId = true, bool* pbChanged = nullptr);
+
+    /*!
+     * @brief Change the end time of an event.
+     * @param index The index of the event.
+     * @param endTime The new end time in UTC.
+     */
+    void SetEnd(size_t index, time_t endTime);
+
+    /*!
+     * @brief Change the database id of an event.
+     * @param index The index of the event.
+     * @param iDatabaseId The new database id.
+     */
+    void SetDatabaseId(size_t index, int iDatabaseId);
+
+    /*!
+     * @brief Remove an event.
+     * @param index The index of the event.
+     */
+    void Erase(size_t index);
+
+    /*!
+     * @brief Remove all events that ended before the given time.
+     * @param time The time in UTC.
+     * @return The number of events removed.
+     */
+    size_t EraseEndingBefore(time_t time);
+
+    /*!
+     * @brief Remove all events.
+     */
+    void Clear();
+
+    /*!
+     * @brief Reserve space for the given number of events.
+     * @param count The number of events.
+     */
+    void Reserve(size_t count);
+
+    /*!
+     * @brief Exchange the events of two stores using the same string pool.
+     * @param other The other store.
+     */
+    void Swap(CPVREpgTagStore& other);
+
+    /*!
+     * @brief Get a string of an event.
+     * @param index The index of the event.
+     * @param field The string to get.
+     * @return The string.
+     */
+    std::string GetString(size_t index, StringField field) const;
+
+    /*!
+     * @brief Fill a tag with the data of an event. Channel data and EPG id of the tag are kept.
+     * @param index The index of the event.
+     * @param tag The tag.
+     */
+    void ToTag(size_t index, CPVREpgInfoTag& tag) const;
+
+    /*!
+     * @brief Get the memory allocated for the records of this store, without the strings.
+     * @return The size in bytes.
+     */
+    size_t GetMemoryUsage() const;
+
+    static time_t ToTime(const CDateTime& dateTime);
+    static CDateTime FromTime(time_t time);
+
+  private:
+    CPVREpgTagStore(const CPVREpgTagStore&) = delete;
+    CPVREpgTagStore& operator=(const CPVREpgTagStore&) = delete;
+
+    size_t Put(Record& record, bool bUpdateDatabaseId, bool bAddRef, bool* pbChanged);
+    static bool IsSameEvent(const Record& left, const Record& right);
+
+    std::shared_ptr<CPVREpgStringPool> m_strings;
+    std::vector<Record> m_records; /*!< the events, sorted by start time */
+  };
+}
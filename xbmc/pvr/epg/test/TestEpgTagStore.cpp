@@ -0,0 +1,421 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "addons/kodi-addon-dev-kit/include/kodi/xbmc_epg_types.h"
+#include "pvr/epg/EpgInfoTag.h"
+#include "pvr/epg/EpgTagStore.h"
+#include "utils/StringUtils.h"
+#include "utils/TextSearch.h"
+#include "utils/TimeUtils.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(TARGET_POSIX)
+#include <sys/resource.h>
+#endif
+
+#include "gtest/gtest.h"
+
+using namespace PVR;
+
+namespace
+{
+
+const time_t GUIDE_START = 1546300800; // 2019-01-01 00:00:00 UTC
+
+class TestEpgTagStore : public testing::Test
+{
+protected:
+  std::shared_ptr<CPVREpgInfoTag> CreateTag(unsigned int iUid, time_t start, time_t end,
+                                            const std::string& strTitle, const std::string& strPlot)
+  {
+    EPG_TAG data = {};
+    data.iUniqueBroadcastId = iUid;
+    data.iUniqueChannelId = 1;
+    data.strTitle = strTitle.c_str();
+    data.strPlot = strPlot.c_str();
+    data.strCast = "Actor One" EPG_STRING_TOKEN_SEPARATOR "Actor Two";
+    data.strGenreDescription = "Drama";
+    data.iGenreType = EPG_GENRE_USE_STRING;
+    data.startTime = start;
+    data.endTime = end;
+    data.iSeriesNumber = 2;
+    data.iEpisodeNumber = iUid % 13;
+    return std::make_shared<CPVREpgInfoTag>(data, 1, nullptr, 1);
+  }
+
+  static long PeakRSS()
+  {
+#if defined(TARGET_POSIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+      return usage.ru_maxrss;
+#endif
+    return 0;
+  }
+
+  /* a guide of back to back half hour events, titles repeat like they do in real guides */
+  std::shared_ptr<CPVREpgInfoTag> CreateGuideTag(unsigned int i)
+  {
+    const std::string strTitle = StringUtils::Format("Show %u", i % 500);
+    const std::string strPlot = StringUtils::Format("Episode %u of show %u, a plot long enough to be realistic.", i % 2000, i % 500);
+    return CreateTag(i + 1, GUIDE_START + i * 1800, GUIDE_START + (i + 1) * 1800, strTitle, strPlot);
+  }
+
+  void CompareGuides(unsigned int events)
+  {
+    long rss = PeakRSS();
+    int64_t start = CurrentHostCounter();
+    std::shared_ptr<CPVREpgStringPool> strings(new CPVREpgStringPool);
+    std::unique_ptr<CPVREpgTagStore> store(new CPVREpgTagStore(strings));
+    for (unsigned int i = 0; i < events; ++i)
+      store->Put(*CreateGuideTag(i));
+    double storeSeconds = static_cast<double>(CurrentHostCounter() - start) / CurrentHostFrequency();
+    long storeRSS = PeakRSS() - rss;
+    EXPECT_EQ(events, store->Size());
+    const size_t storeBytes = store->GetMemoryUsage() + strings->GetMemoryUsage();
+    store.reset();
+
+    rss = PeakRSS();
+    start = CurrentHostCounter();
+    std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>> tags;
+    for (unsigned int i = 0; i < events; ++i)
+    {
+      const std::shared_ptr<CPVREpgInfoTag> tag = CreateGuideTag(i);
+      tags.insert(std::make_pair(tag->StartAsUTC(), tag));
+    }
+    double mapSeconds = static_cast<double>(CurrentHostCounter() - start) / CurrentHostFrequency();
+    long mapRSS = PeakRSS() - rss;
+    EXPECT_EQ(events, tags.size());
+
+    RecordProperty("map_ms", StringUtils::Format("%.1f", mapSeconds * 1000));
+    RecordProperty("store_ms", StringUtils::Format("%.1f", storeSeconds * 1000));
+    RecordProperty("map_peak_rss_kb", StringUtils::Format("%ld", mapRSS));
+    RecordProperty("store_peak_rss_kb", StringUtils::Format("%ld", storeRSS));
+    RecordProperty("store_bytes", StringUtils::Format("%zu", storeBytes));
+  }
+
+  void CompareSearches(unsigned int events)
+  {
+    CPVREpgTagStore store(std::make_shared<CPVREpgStringPool>());
+    for (unsigned int i = 0; i < events; ++i)
+      store.Put(*CreateGuideTag(i));
+
+    const CTextSearch search("\"show 42\"", false, SEARCH_DEFAULT_OR);
+    std::shared_ptr<CPVREpgInfoTag> tag = CreateTag(0, 0, 0, "", "");
+
+    // a tag for every event, searched like CPVREpgSearchFilter::FilterEntry does
+    int64_t start = CurrentHostCounter();
+    size_t linearMatches = 0;
+    for (size_t i = 0; i < store.Size(); ++i)
+    {
+      store.ToTag(i, *tag);
+      if (search.Search(tag->Title()) || search.Search(tag->PlotOutline()))
+        linearMatches++;
+    }
+    const double linearSeconds = static_cast<double>(CurrentHostCounter() - start) / CurrentHostFrequency();
+
+    // every distinct string searched once, tags only for the candidates
+    start = CurrentHostCounter();
+    std::vector<bool> matches;
+    store.GetStringPool()->Match([&search](const std::string& str) { return search.Search(str); }, matches);
+    size_t indexedMatches = 0;
+    for (size_t i = 0; i < store.Size(); ++i)
+    {
+      const CPVREpgTagStore::Record& record = store.At(i);
+      if (matches[record.strings[CPVREpgTagStore::TITLE]] || matches[record.strings[CPVREpgTagStore::PLOT_OUTLINE]])
+      {
+        store.ToTag(i, *tag);
+        indexedMatches++;
+      }
+    }
+    const double indexedSeconds = static_cast<double>(CurrentHostCounter() - start) / CurrentHostFrequency();
+
+    EXPECT_LT(0u, linearMatches);
+    EXPECT_EQ(linearMatches, indexedMatches);
+
+    RecordProperty("linear_ms", StringUtils::Format("%.1f", linearSeconds * 1000));
+    RecordProperty("indexed_ms", StringUtils::Format("%.1f", indexedSeconds * 1000));
+  }
+
+  /* add-on side of a guide transfer, the strings of all entries point into one table */
+  static void CreateTransfer(unsigned int events, std::vector<std::string>& strings, std::vector<EPG_TAG>& entries)
+  {
+    strings.clear();
+    for (unsigned int i = 0; i < 500; ++i)
+      strings.push_back(StringUtils::Format("Show %u", i));
+    for (unsigned int i = 0; i < 2000; ++i)
+      strings.push_back(StringUtils::Format("Episode %u, a plot long enough to be realistic.", i));
+
+    entries.assign(events, EPG_TAG());
+    for (unsigned int i = 0; i < events; ++i)
+    {
+      EPG_TAG& data = entries[i];
+      data.iUniqueBroadcastId = i + 1;
+      data.iUniqueChannelId = 1;
+      data.strTitle = strings[i % 500].c_str();
+      data.strPlot = strings[500 + i % 2000].c_str();
+      data.strCast = "Actor One" EPG_STRING_TOKEN_SEPARATOR "Actor Two";
+      data.strGenreDescription = "Drama";
+      data.iGenreType = EPG_GENRE_USE_STRING;
+      data.startTime = GUIDE_START + i * 1800;
+      data.endTime = GUIDE_START + (i + 1) * 1800;
+      data.iSeriesNumber = 2;
+      data.iEpisodeNumber = i % 13;
+    }
+  }
+
+  void CompareTransfers(unsigned int events)
+  {
+    std::vector<std::string> strings;
+    std::vector<EPG_TAG> entries;
+    CreateTransfer(events, strings, entries);
+
+    // one callback per entry, each creating a tag
+    CPVREpgTagStore single(std::make_shared<CPVREpgStringPool>());
+    int64_t start = CurrentHostCounter();
+    for (const auto& data : entries)
+      single.Put(CPVREpgInfoTag(data, 1, nullptr, 1), false);
+    const double singleSeconds = static_cast<double>(CurrentHostCounter() - start) / CurrentHostFrequency();
+
+    // one callback for all entries
+    CPVREpgTagStore batch(std::make_shared<CPVREpgStringPool>());
+    start = CurrentHostCounter();
+    for (const auto& data : entries)
+      batch.Put(data, 0, false);
+    const double batchSeconds = static_cast<double>(CurrentHostCounter() - start) / CurrentHostFrequency();
+
+    ASSERT_EQ(events, single.Size());
+    ASSERT_EQ(events, batch.Size());
+    EXPECT_EQ(single.GetStringPool()->GetCount(), batch.GetStringPool()->GetCount());
+    for (unsigned int i = 0; i < events; i += events / 10 + 1)
+    {
+      for (int field = 0; field < CPVREpgTagStore::STRING_FIELD_COUNT; ++field)
+        EXPECT_EQ(single.GetString(i, static_cast<CPVREpgTagStore::StringField>(field)),
+                  batch.GetString(i, static_cast<CPVREpgTagStore::StringField>(field)));
+      EXPECT_EQ(single.At(i).endTime, batch.At(i).endTime);
+      EXPECT_EQ(single.At(i).iEpisodeNumber, batch.At(i).iEpisodeNumber);
+    }
+
+    RecordProperty("single_ms", StringUtils::Format("%.1f", singleSeconds * 1000));
+    RecordProperty("batch_ms", StringUtils::Format("%.1f", batchSeconds * 1000));
+    RecordProperty("single_entries_per_s", StringUtils::Format("%.0f", events / std::max(singleSeconds, 1e-9)));
+    RecordProperty("batch_entries_per_s", StringUtils::Format("%.0f", events / std::max(batchSeconds, 1e-9)));
+  }
+};
+
+}
+
+TEST(TestEpgStringPool, Deduplicates)
+{
+  CPVREpgStringPool strings;
+  EXPECT_EQ(CPVREpgStringPool::EMPTY, strings.Add(""));
+
+  const CPVREpgStringPool::Id news = strings.Add("News");
+  EXPECT_EQ(news, strings.Add("News"));
+  EXPECT_NE(news, strings.Add("Weather"));
+  EXPECT_EQ(2u, strings.GetCount());
+  EXPECT_EQ("News", strings.Get(news));
+  EXPECT_EQ("", strings.Get(CPVREpgStringPool::EMPTY));
+}
+
+TEST(TestEpgStringPool, ReleasesAndCompacts)
+{
+  CPVREpgStringPool strings;
+  const CPVREpgStringPool::Id kept = strings.Add("kept");
+
+  // enough unused data to trigger compaction
+  std::vector<CPVREpgStringPool::Id> ids;
+  for (int i = 0; i < 20000; ++i)
+    ids.push_back(strings.Add(StringUtils::Format("%05d %s", i, std::string(100, 'x').c_str())));
+  EXPECT_EQ(20001u, strings.GetCount());
+
+  const size_t usage = strings.GetMemoryUsage();
+  strings.Release(ids.data(), ids.size());
+  EXPECT_EQ(1u, strings.GetCount());
+  EXPECT_LT(strings.GetMemoryUsage(), usage);
+  EXPECT_EQ("kept", strings.Get(kept));
+
+  // freed ids are reused, the string is found again. matches of the old strings are stale then.
+  const unsigned int iGeneration = strings.GetGeneration();
+  const CPVREpgStringPool::Id id = strings.Add("again");
+  EXPECT_NE(iGeneration, strings.GetGeneration());
+  EXPECT_EQ(id, strings.Add("again"));
+  EXPECT_EQ("again", strings.Get(id));
+  EXPECT_EQ(kept, strings.Add("kept"));
+}
+
+TEST_F(TestEpgTagStore, PutAndFind)
+{
+  CPVREpgTagStore store(std::make_shared<CPVREpgStringPool>());
+  store.Put(*CreateTag(2, GUIDE_START + 3600, GUIDE_START + 7200, "Second", "plot"));
+  store.Put(*CreateTag(1, GUIDE_START, GUIDE_START + 3600, "First", "plot"));
+  store.Put(*CreateTag(3, GUIDE_START + 7200, GUIDE_START + 9000, "Third", "plot"));
+  ASSERT_EQ(3u, store.Size());
+
+  EXPECT_EQ(0, store.Find(GUIDE_START));
+  EXPECT_EQ(2, store.Find(GUIDE_START + 7200));
+  EXPECT_EQ(-1, store.Find(GUIDE_START + 60));
+  EXPECT_EQ(1u, store.LowerBound(GUIDE_START + 60));
+  EXPECT_EQ(1u, store.UpperBound(GUIDE_START));
+  EXPECT_EQ(1, store.FindByBroadcastId(2));
+  EXPECT_EQ("Second", store.GetString(1, CPVREpgTagStore::TITLE));
+
+  // same start time replaces the event
+  store.Put(*CreateTag(4, GUIDE_START + 3600, GUIDE_START + 7200, "Replaced", "plot"));
+  EXPECT_EQ(3u, store.Size());
+  EXPECT_EQ("Replaced", store.GetString(1, CPVREpgTagStore::TITLE));
+  EXPECT_EQ(-1, store.FindByBroadcastId(2));
+  EXPECT_EQ(6u, store.GetStringPool()->GetCount()); // three titles, shared plot, cast and genre
+}
+
+TEST(TestEpgStringPool, Match)
+{
+  CPVREpgStringPool strings;
+  const CPVREpgStringPool::Id news = strings.Add("Evening News");
+  const CPVREpgStringPool::Id weather = strings.Add("Weather");
+  const CPVREpgStringPool::Id released = strings.Add("Late News");
+  strings.Release(&released, 1);
+
+  int calls = 0;
+  std::vector<bool> matches;
+  strings.Match([&calls](const std::string& str) {
+    calls++;
+    return str.find("News") != std::string::npos;
+  }, matches);
+
+  // once per stored string and once for the empty string
+  EXPECT_EQ(4, calls);
+  ASSERT_EQ(4u, matches.size());
+  EXPECT_FALSE(matches[CPVREpgStringPool::EMPTY]);
+  EXPECT_TRUE(matches[news]);
+  EXPECT_FALSE(matches[weather]);
+
+  // a released string keeps its id until the pool is compacted, it can be referenced again
+  EXPECT_TRUE(matches[released]);
+  EXPECT_EQ(released, strings.Add("Late News"));
+}
+
+TEST_F(TestEpgTagStore, RoundTrip)
+{
+  CPVREpgTagStore store(std::make_shared<CPVREpgStringPool>());
+  const std::shared_ptr<CPVREpgInfoTag> tag = CreateTag(7, GUIDE_START, GUIDE_START + 1800, "Title", "Plot");
+  store.Put(*tag);
+
+  std::shared_ptr<CPVREpgInfoTag> copy = CreateTag(0, 0, 0, "", "");
+  store.ToTag(0, *copy);
+  EXPECT_EQ(tag->UniqueBroadcastID(), copy->UniqueBroadcastID());
+  EXPECT_EQ(tag->StartAsUTC(), copy->StartAsUTC());
+  EXPECT_EQ(tag->EndAsUTC(), copy->EndAsUTC());
+  EXPECT_EQ(tag->Title(), copy->Title());
+  EXPECT_EQ(tag->Plot(), copy->Plot());
+  EXPECT_EQ(tag->Cast(), copy->Cast());
+  EXPECT_EQ(tag->Genre(), copy->Genre());
+  EXPECT_EQ(tag->SeriesNumber(), copy->SeriesNumber());
+  EXPECT_EQ(tag->EpisodeNumber(), copy->EpisodeNumber());
+  EXPECT_EQ(tag->Path(), copy->Path());
+}
+
+TEST_F(TestEpgTagStore, DetectsChanges)
+{
+  CPVREpgTagStore store(std::make_shared<CPVREpgStringPool>());
+  bool bChanged = false;
+  store.Put(*CreateTag(1, GUIDE_START, GUIDE_START + 1800, "Title", "Plot"), true, &bChanged);
+  EXPECT_TRUE(bChanged);
+  store.SetDatabaseId(0, 42);
+
+  // a refresh delivering the same event keeps the database id and reports no change
+  store.Put(*CreateTag(1, GUIDE_START, GUIDE_START + 1800, "Title", "Plot"), false, &bChanged);
+  EXPECT_FALSE(bChanged);
+  EXPECT_EQ(42, store.At(0).iDatabaseID);
+
+  store.Put(*CreateTag(1, GUIDE_START, GUIDE_START + 1800, "Title", "Other plot"), false, &bChanged);
+  EXPECT_TRUE(bChanged);
+  store.Put(*CreateTag(1, GUIDE_START, GUIDE_START + 1200, "Title", "Other plot"), false, &bChanged);
+  EXPECT_TRUE(bChanged);
+  EXPECT_EQ(42, store.At(0).iDatabaseID);
+}
+
+TEST_F(TestEpgTagStore, EraseEndingBefore)
+{
+  CPVREpgTagStore store(std::make_shared<CPVREpgStringPool>());
+  for (unsigned int i = 0; i < 10; ++i)
+    store.Put(*CreateGuideTag(i));
+
+  // the event ending exactly at the given time is kept
+  EXPECT_EQ(3u, store.EraseEndingBefore(GUIDE_START + 4 * 1800));
+  ASSERT_EQ(7u, store.Size());
+  EXPECT_EQ(GUIDE_START + 3 * 1800, store.At(0).startTime);
+
+  store.Clear();
+  EXPECT_TRUE(store.Empty());
+  EXPECT_EQ(0u, store.GetStringPool()->GetCount());
+}
+
+TEST_F(TestEpgTagStore, Guide)
+{
+  CompareGuides(20000);
+}
+
+TEST_F(TestEpgTagStore, DISABLED_Guide1M)
+{
+  CompareGuides(1000000);
+}
+
+TEST_F(TestEpgTagStore, Search)
+{
+  CompareSearches(20000);
+}
+
+TEST_F(TestEpgTagStore, DISABLED_Search1M)
+{
+  CompareSearches(1000000);
+}
+
+TEST_F(TestEpgTagStore, PutAddonData)
+{
+  EPG_TAG data = {};
+  data.iUniqueBroadcastId = 5;
+  data.strTitle = "Title";
+  data.strPlot = nullptr;
+  data.iGenreType = EPG_EVENT_CONTENTMASK_NEWSCURRENTAFFAIRS;
+  data.strGenreDescription = "ignored";
+  data.startTime = GUIDE_START;
+  data.endTime = GUIDE_START + 1800;
+
+  CPVREpgTagStore store(std::make_shared<CPVREpgStringPool>());
+  ASSERT_EQ(0u, store.Put(data, 60));
+  EXPECT_EQ(GUIDE_START + 60, store.At(0).startTime);
+  EXPECT_EQ(GUIDE_START + 1860, store.At(0).endTime);
+  EXPECT_EQ(-1, store.At(0).iDatabaseID);
+  EXPECT_EQ("Title", store.GetString(0, CPVREpgTagStore::TITLE));
+  EXPECT_EQ("", store.GetString(0, CPVREpgTagStore::PLOT));
+  EXPECT_EQ("", store.GetString(0, CPVREpgTagStore::GENRE));
+
+  // same result as going through a tag
+  const CPVREpgInfoTag tag(data, 1, nullptr, 1);
+  std::shared_ptr<CPVREpgInfoTag> copy = CreateTag(0, 0, 0, "", "");
+  store.ToTag(0, *copy);
+  EXPECT_EQ(tag.Title(), copy->Title());
+  EXPECT_EQ(tag.Genre(), copy->Genre());
+  EXPECT_EQ(tag.GenreType(), copy->GenreType());
+}
+
+TEST_F(TestEpgTagStore, Transfer)
+{
+  CompareTransfers(20000);
+}
+
+TEST_F(TestEpgTagStore, DISABLED_Transfer1M)
+{
+  CompareTransfers(1000000);
+}
@@ -156,7 +156,10 @@ bool CPVRRecording::operator ==(const CPVRRecording& right) const
        m_bRadio             == right.m_bRadio &&
        m_genre              == right.m_genre &&
        m_iGenreType         == right.m_iGenreType &&
-       m_iGenreSubType      == right.m_iGenreSubType);
+       m_iGenreSubType      == right.m_iGenreSubType &&
+       GetLocalPlayCount()  == right.GetLocalPlayCount() &&
+       GetLocalResumePoint().timeInSeconds      == right.GetLocalResumePoint().timeInSeconds &&
+       GetLocalResumePoint().totalTimeInSeconds == right.GetLocalResumePoint().totalTimeInSeconds);
 }
 
 bool CPVRRecording::operator !=(const CPVRRecording& right) const
@@ -352,6 +355,8 @@ void CPVRRecording::Update(const CPVRRecording &tag)
   m_strPlotOutline    = tag.m_strPlotOutline;
   m_strChannelName    = tag.m_strChannelName;
   m_genre             = tag.m_genre;
+  m_iGenreType        = tag.m_iGenreType;
+  m_iGenreSubType     = tag.m_iGenreSubType;
   m_strIconPath       = tag.m_strIconPath;
   m_strThumbnailPath  = tag.m_strThumbnailPath;
   m_strFanartPath     = tag.m_strFanartPath;
@@ -8,6 +8,7 @@
 
 #include "PVRRecordings.h"
 
+#include <set>
 #include <utility>
 
 #include "FileItem.h"
@@ -32,12 +33,99 @@ CPVRRecordings::~CPVRRecordings()
     m_database->Close();
 }
 
-void CPVRRecordings::UpdateFromClients(void)
+bool CPVRRecordings::UpdateFromClients(void)
 {
   CSingleLock lock(m_critSection);
-  Unload();
-  CServiceBroker::GetPVRManager().Clients()->GetRecordings(this, false);
-  CServiceBroker::GetPVRManager().Clients()->GetRecordings(this, true);
+
+  CPVRClientMap clients;
+  std::vector<int> clientsNotReady;
+  CServiceBroker::GetPVRManager().Clients()->GetCreatedClients(clients, clientsNotReady);
+
+  m_bChanged = false;
+  m_updatedRecordings.clear();
+
+  // clients not ready to use, whose recordings are up to date or could not be fetched keep their recordings
+  std::set<int> keptClients(clientsNotReady.begin(), clientsNotReady.end());
+  for (const auto &clientEntry : clients)
+  {
+    const CPVRClientPtr &client = clientEntry.second;
+
+    std::string strToken;
+    const bool bHasToken = client->GetRecordingsChangeToken(strToken) == PVR_ERROR_NO_ERROR;
+    if (bHasToken)
+    {
+      const auto it = m_changeTokens.find(clientEntry.first);
+      if (it != m_changeTokens.end() && it->second == strToken)
+      {
+        keptClients.insert(clientEntry.first);
+        continue;
+      }
+    }
+
+    PVR_ERROR error = client->GetRecordings(this, false);
+    if (error == PVR_ERROR_NO_ERROR || error == PVR_ERROR_NOT_IMPLEMENTED)
+      error = client->GetRecordings(this, true);
+
+    if (error != PVR_ERROR_NO_ERROR && error != PVR_ERROR_NOT_IMPLEMENTED)
+    {
+      keptClients.insert(clientEntry.first);
+      m_changeTokens.erase(clientEntry.first);
+    }
+    else if (bHasToken)
+      m_changeTokens[clientEntry.first] = strToken;
+    else
+      m_changeTokens.erase(clientEntry.first);
+  }
+
+  // remove the recordings that are gone, recordings of disabled clients are gone as well
+  for (auto it = m_recordings.begin(); it != m_recordings.end();)
+  {
+    if (m_updatedRecordings.find(it->first) == m_updatedRecordings.end() &&
+        keptClients.find(it->first.m_iClientId) == keptClients.end())
+    {
+      it = m_recordings.erase(it);
+      m_bChanged = true;
+    }
+    else
+      ++it;
+  }
+
+  for (auto it = m_changeTokens.begin(); it != m_changeTokens.end();)
+  {
+    if (clients.find(it->first) == clients.end())
+      it = m_changeTokens.erase(it);
+    else
+      ++it;
+  }
+
+  m_updatedRecordings.clear();
+  UpdateCounters();
+  return m_bChanged;
+}
+
+void CPVRRecordings::UpdateCounters(void)
+{
+  m_bDeletedTVRecordings = false;
+  m_bDeletedRadioRecordings = false;
+  m_iTVRecordings = 0;
+  m_iRadioRecordings = 0;
+
+  for (const auto &recordingEntry : m_recordings)
+  {
+    const CPVRRecordingPtr &recording = recordingEntry.second;
+    if (recording->IsRadio())
+    {
+      ++m_iRadioRecordings;
+      if (recording->IsDeleted())
+        m_bDeletedRadioRecordings = true;
+    }
+    else
+    {
+      ++m_iTVRecordings;
+      if (recording->IsDeleted())
+        m_bDeletedTVRecordings = true;
+    }
+  }
 }
 
 int CPVRRecordings::Load(void)
@@ -55,6 +143,7 @@ void CPVRRecordings::Unload()
   m_iTVRecordings = 0;
   m_iRadioRecordings = 0;
   m_recordings.clear();
+  m_changeTokens.clear();
 }
 
 void CPVRRecordings::Update(void)
@@ -66,12 +155,18 @@ void CPVRRecordings::Update(void)
   lock.Leave();
 
   CLog::LogFC(LOGDEBUG, LOGPVR, "Updating recordings");
-  UpdateFromClients();
+  const bool bChanged = UpdateFromClients();
 
   lock.Enter();
   m_bIsUpdating = false;
   lock.Leave();
 
+  if (!bChanged)
+  {
+    CLog::LogFC(LOGDEBUG, LOGPVR, "Recordings did not change");
+    return;
+  }
+
   CServiceBroker::GetPVRManager().SetChanged();
   CServiceBroker::GetPVRManager().NotifyObservers(ObservableMessageRecordings);
   CServiceBroker::GetPVRManager().PublishEvent(PVREvent::RecordingsInvalidated);
@@ -245,10 +340,21 @@ void CPVRRecordings::UpdateFromClient(const CPVRRecordingPtr &tag)
       m_bDeletedTVRecordings = true;
   }
 
+  const CPVRRecordingUid uid(tag->m_iClientId, tag->m_strRecordingId);
+  m_updatedRecordings.insert(uid);
+
   CPVRRecordingPtr newTag = GetById(tag->m_iClientId, tag->m_strRecordingId);
   if (newTag)
   {
-    newTag->Update(*tag);
+    // the transferred tag has no id and no locally stored play count and resume point yet,
+    // they must not count as a change
+    tag->m_iRecordingId = newTag->m_iRecordingId;
+    tag->UpdateMetadata(GetVideoDatabase());
+    if (*newTag != *tag)
+    {
+      newTag->Update(*tag);
+      m_bChanged = true;
+    }
   }
   else
   {
@@ -256,11 +362,12 @@ void CPVRRecordings::UpdateFromClient(const CPVRRecordingPtr &tag)
     newTag->Update(*tag);
     newTag->UpdateMetadata(GetVideoDatabase());
     newTag->m_iRecordingId = ++m_iLastId;
-    m_recordings.insert(std::make_pair(CPVRRecordingUid(newTag->m_iClientId, newTag->m_strRecordingId), newTag));
+    m_recordings.insert(std::make_pair(uid, newTag));
     if (newTag->IsRadio())
       ++m_iRadioRecordings;
     else
       ++m_iTVRecordings;
+    m_bChanged = true;
   }
 }
 
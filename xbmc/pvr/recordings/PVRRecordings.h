@@ -10,6 +10,8 @@
 
 #include <map>
 #include <memory>
+#include <set>
+#include <string>
 
 #include "FileItem.h"
 #include "video/VideoDatabase.h"
@@ -41,6 +43,7 @@ namespace PVR
 
     /**
      * @brief refresh the recordings list from the clients.
+     * Recordings that did not change are kept, observers are only notified if something changed.
      */
     void Update(void);
 
@@ -93,8 +96,20 @@ namespace PVR
     bool m_bDeletedRadioRecordings = false;
     unsigned int m_iTVRecordings = 0;
     unsigned int m_iRadioRecordings = 0;
+    std::map<int, std::string> m_changeTokens; /*!< the last recordings change token of each client */
+    std::set<CPVRRecordingUid> m_updatedRecordings; /*!< the recordings transferred during the running update */
+    bool m_bChanged = false; /*!< recordings were added, changed or removed during the running update */
 
-    void UpdateFromClients(void);
+    /*!
+     * @brief Fetch the recordings of all clients whose change token changed and remove the recordings that are gone.
+     * @return True if recordings were added, changed or removed, false otherwise.
+     */
+    bool UpdateFromClients(void);
+
+    /*!
+     * @brief Recount the recordings and deleted recordings.
+     */
+    void UpdateCounters(void);
 
     /*!
      * @brief Get/Open the video database.
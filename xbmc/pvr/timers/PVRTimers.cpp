@@ -8,6 +8,8 @@
 
 #include "PVRTimers.h"
 
+#include <set>
+#include <string>
 #include <utility>
 
 #include "FileItem.h"
@@ -105,6 +107,7 @@ void CPVRTimers::Unload()
   // remove all tags
   CSingleLock lock(m_critSection);
   m_tags.clear();
+  m_changeTokens.clear();
 }
 
 bool CPVRTimers::Update(void)
@@ -119,7 +122,54 @@ bool CPVRTimers::Update(void)
   CLog::LogFC(LOGDEBUG, LOGPVR, "Updating timers");
   CPVRTimersContainer newTimerList;
   std::vector<int> failedClients;
-  CServiceBroker::GetPVRManager().Clients()->GetTimers(&newTimerList, failedClients);
+
+  // timers of clients not ready to use are kept
+  CPVRClientMap clients;
+  CServiceBroker::GetPVRManager().Clients()->GetCreatedClients(clients, failedClients);
+
+  for (const auto &clientEntry : clients)
+  {
+    const CPVRClientPtr &client = clientEntry.second;
+
+    // timers of clients whose change token did not change are kept like the ones of failed clients
+    std::string strToken;
+    const bool bHasToken = client->GetTimersChangeToken(strToken) == PVR_ERROR_NO_ERROR;
+    if (bHasToken)
+    {
+      CSingleLock lock(m_critSection);
+      const auto it = m_changeTokens.find(clientEntry.first);
+      if (it != m_changeTokens.end() && it->second == strToken)
+      {
+        failedClients.emplace_back(clientEntry.first);
+        continue;
+      }
+    }
+
+    const PVR_ERROR error = client->GetTimers(&newTimerList);
+
+    CSingleLock lock(m_critSection);
+    if (error != PVR_ERROR_NO_ERROR && error != PVR_ERROR_NOT_IMPLEMENTED)
+    {
+      failedClients.emplace_back(clientEntry.first);
+      m_changeTokens.erase(clientEntry.first);
+    }
+    else if (bHasToken)
+      m_changeTokens[clientEntry.first] = strToken;
+    else
+      m_changeTokens.erase(clientEntry.first);
+  }
+
+  {
+    CSingleLock lock(m_critSection);
+    for (auto it = m_changeTokens.begin(); it != m_changeTokens.end();)
+    {
+      if (clients.find(it->first) == clients.end())
+        it = m_changeTokens.erase(it);
+      else
+        ++it;
+    }
+  }
+
   return UpdateEntries(newTimerList, failedClients);
 }
 
@@ -143,15 +193,30 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer &timers, const std::vec
 
   CSingleLock lock(m_critSection);
 
+  /* index both containers by client id and client index, GetByClient() is a linear search */
+  std::map<ClientTimerKey, CPVRTimerInfoTagPtr> existingTimers;
+  for (const auto &tagsEntry : m_tags)
+  {
+    for (const auto &timer : tagsEntry.second)
+      existingTimers.insert(std::make_pair(ClientTimerKey(timer->m_iClientId, timer->m_iClientIndex), timer));
+  }
+
+  std::set<ClientTimerKey> updatedTimers;
+  const std::set<int> ignoredClients(failedClients.begin(), failedClients.end());
+
   /* go through the timer list and check for updated or new timers */
   for (MapTags::const_iterator it = timers.GetTags().begin(); it != timers.GetTags().end(); ++it)
   {
     for (VecTimerInfoTag::const_iterator timerIt = it->second.begin(); timerIt != it->second.end(); ++timerIt)
     {
+      const ClientTimerKey key((*timerIt)->m_iClientId, (*timerIt)->m_iClientIndex);
+      updatedTimers.insert(key);
+
       /* check if this timer is present in this container */
-      CPVRTimerInfoTagPtr existingTimer = GetByClient((*timerIt)->m_iClientId, (*timerIt)->m_iClientIndex);
-      if (existingTimer)
+      const auto existingIt = existingTimers.find(key);
+      if (existingIt != existingTimers.end())
       {
+        const CPVRTimerInfoTagPtr &existingTimer = existingIt->second;
         /* if it's present, update the current tag */
         bool bStateChanged(existingTimer->m_state != (*timerIt)->m_state);
         if (existingTimer->UpdateEntry(*timerIt))
@@ -177,6 +242,7 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer &timers, const std::vec
         newTimer->UpdateEntry(*timerIt);
         newTimer->m_iTimerId = ++m_iLastId;
         InsertTimer(newTimer);
+        existingTimers.insert(std::make_pair(key, newTimer));
 
         bChanged = true;
         bAddedOrDeleted = true;
@@ -200,20 +266,11 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer &timers, const std::vec
     for (std::vector<CPVRTimerInfoTagPtr>::iterator it2 = it->second.begin(); it2 != it->second.end();)
     {
       CPVRTimerInfoTagPtr timer(*it2);
-      if (!timers.GetByClient(timer->m_iClientId, timer->m_iClientIndex))
+      const ClientTimerKey key(timer->m_iClientId, timer->m_iClientIndex);
+      if (updatedTimers.find(key) == updatedTimers.end())
       {
         /* timer was not found */
-        bool bIgnoreTimer(false);
-        for (const auto &failedClient : failedClients)
-        {
-          if (failedClient == timer->m_iClientId)
-          {
-            bIgnoreTimer = true;
-            break;
-          }
-        }
-
-        if (bIgnoreTimer)
+        if (ignoredClients.find(timer->m_iClientId) != ignoredClients.end())
         {
           ++it2;
           continue;
@@ -225,6 +282,7 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer &timers, const std::vec
         timerNotifications.push_back(std::make_pair(timer->m_iClientId, timer->GetDeletedNotificationText()));
 
         it2 = it->second.erase(it2);
+        existingTimers.erase(key);
 
         bChanged = true;
         bAddedOrDeleted = true;
@@ -267,9 +325,9 @@ bool CPVRTimers::UpdateEntries(const CPVRTimersContainer &timers, const std::vec
     {
       if (timersEntry->GetTimerRuleId() != PVR_TIMER_NO_PARENT)
       {
-        const CPVRTimerInfoTagPtr parentTimer(GetByClient(timersEntry->m_iClientId, timersEntry->GetTimerRuleId()));
-        if (parentTimer)
-          parentTimer->UpdateChildState(timersEntry);
+        const auto parentIt = existingTimers.find(ClientTimerKey(timersEntry->m_iClientId, timersEntry->GetTimerRuleId()));
+        if (parentIt != existingTimers.end())
+          parentIt->second->UpdateChildState(timersEntry);
       }
     }
   }
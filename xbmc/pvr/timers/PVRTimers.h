@@ -10,6 +10,8 @@
 
 #include <map>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "XBDateTime.h"
@@ -260,6 +262,14 @@ namespace PVR
     CPVRTimerInfoTagPtr GetById(unsigned int iTimerId) const;
 
   private:
+    typedef std::pair<int, unsigned int> ClientTimerKey; /*!< client id and client index of a timer */
+
+    /*!
+     * @brief Merge the timers fetched from the clients into this container.
+     * @param timers The fetched timers.
+     * @param failedClients The clients whose timers were not fetched, their timers are kept.
+     * @return True if timers were added, changed or removed, false otherwise.
+     */
     bool UpdateEntries(const CPVRTimersContainer &timers, const std::vector<int> &failedClients);
 
     enum TimerKind
@@ -278,5 +288,6 @@ namespace PVR
 
     bool m_bIsUpdating = false;
     CPVRSettings m_settings;
+    std::map<int, std::string> m_changeTokens; /*!< the last timers change token of each client */
   };
 }
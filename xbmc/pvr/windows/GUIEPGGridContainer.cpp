@@ -730,7 +730,8 @@ void CGUIEPGGridContainer::UpdateItems()
   m_lastItem    = nullptr;
   m_lastChannel = nullptr;
 
-  // always use asynchronously precalculated grid data.
+  // always use asynchronously precalculated grid data. rows of unchanged channels need not be created again.
+  m_updatedGridModel->CopyUnchangedRows(*m_gridModel);
   m_gridModel = std::move(m_updatedGridModel);
 
   if (prevSelectedEpgTag)
@@ -2023,7 +2024,10 @@ void CGUIEPGGridContainer::HandleChannels(bool bRender, unsigned int currentTime
   {
     // Free memory not used on screen
     if (m_gridModel->ChannelItemsSize() > m_channelsPerPage + cacheBeforeChannel + cacheAfterChannel)
+    {
       m_gridModel->FreeChannelMemory(chanOffset - cacheBeforeChannel, chanOffset + m_channelsPerPage + 1 + cacheAfterChannel);
+      m_gridModel->FreeGridMemory(chanOffset - cacheBeforeChannel, chanOffset + m_channelsPerPage + 1 + cacheAfterChannel, m_channelOffset + m_channelCursor);
+    }
   }
 
   CPoint originChannel = CPoint(m_channelPosX, m_channelPosY) + m_renderOffset;
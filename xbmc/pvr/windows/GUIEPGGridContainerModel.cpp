@@ -8,7 +8,10 @@
 
 #include "GUIEPGGridContainerModel.h"
 
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <utility>
 
 #include "FileItem.h"
 #include "ServiceBroker.h"
@@ -144,11 +147,11 @@ void CGUIEPGGridContainerModel::Initialize(const std::unique_ptr<CFileItemList>
     m_rulerItems.emplace_back(rulerItem);
   }
 
-  FreeItemsMemory();
+  // no FreeMemory() on the programme items here. this runs on the refresh thread and the items of
+  // unchanged channels are shared with the model on screen. the other items are new.
 
   ////////////////////////////////////////////////////////////////////////
   // Create epg grid
-  const CDateTimeSpan blockDuration(0, 0, MINSPERBLOCK, 0);
   const CDateTimeSpan gridDuration(m_gridEnd - m_gridStart);
   m_blocks = (gridDuration.GetDays() * 24 * 60 + gridDuration.GetHours() * 60 + gridDuration.GetMinutes()) / MINSPERBLOCK;
   if (m_blocks >= MAXBLOCKS)
@@ -156,106 +159,161 @@ void CGUIEPGGridContainerModel::Initialize(const std::unique_ptr<CFileItemList>
   else if (m_blocks < iBlocksPerPage)
     m_blocks = iBlocksPerPage;
 
-  m_gridIndex.reserve(m_channelItems.size());
-  const std::vector<GridItem> blocks(m_blocks);
+  m_fBlockSize = fBlockSize;
 
-  for (size_t channel = 0; channel < m_channelItems.size(); ++channel)
-  {
-    m_gridIndex.emplace_back(blocks);
+  // the blocks of a channel are created on first access
+  m_gridIndex.resize(m_channelItems.size());
+}
 
-    CDateTime gridCursor(m_gridStart); //reset cursor for new channel
-    unsigned long progIdx = m_epgItemsPtr[channel].start;
-    unsigned long lastIdx = m_epgItemsPtr[channel].stop;
-    int iEpgId            = m_programmeItems[progIdx]->GetEPGInfoTag()->EpgID();
-    int itemSize          = 1; // size of the programme in blocks
-    int savedBlock        = 0;
-    CFileItemPtr item;
-    CPVREpgInfoTagPtr tag;
+std::vector<GridItem> &CGUIEPGGridContainerModel::GetGridRow(int iChannel) const
+{
+  if (m_gridIndex[iChannel].empty())
+    CreateGridRow(iChannel);
 
-    for (int block = 0; block < m_blocks; ++block)
-    {
-      while (progIdx <= lastIdx)
-      {
-        item = m_programmeItems[progIdx];
-        tag = item->GetEPGInfoTag();
+  return m_gridIndex[iChannel];
+}
 
-        // Note: Start block of an event is start-time-based calculated block + 1,
-        //       unless start times matches exactly the begin of a block.
+void CGUIEPGGridContainerModel::CreateGridRow(int iChannel) const
+{
+  const size_t channel = iChannel;
+  std::vector<GridItem> &row = m_gridIndex[channel];
+  row.resize(m_blocks);
+  m_createdRows.insert(iChannel);
 
-        if (tag->EpgID() != iEpgId || gridCursor < tag->StartAsUTC() || m_gridEnd <= tag->StartAsUTC())
-          break;
+  const CDateTimeSpan blockDuration(0, 0, MINSPERBLOCK, 0);
+  CDateTime gridCursor(m_gridStart); //reset cursor for new channel
+  unsigned long progIdx = m_epgItemsPtr[channel].start;
+  unsigned long lastIdx = m_epgItemsPtr[channel].stop;
+  int iEpgId            = m_programmeItems[progIdx]->GetEPGInfoTag()->EpgID();
+  int itemSize          = 1; // size of the programme in blocks
+  int savedBlock        = 0;
+  CFileItemPtr item;
+  CPVREpgInfoTagPtr tag;
+
+  for (int block = 0; block < m_blocks; ++block)
+  {
+    while (progIdx <= lastIdx)
+    {
+      item = m_programmeItems[progIdx];
+      tag = item->GetEPGInfoTag();
 
-        if (gridCursor < tag->EndAsUTC())
-        {
-          m_gridIndex[channel][block].item = item;
-          m_gridIndex[channel][block].progIndex = progIdx;
-          break;
-        }
+      // Note: Start block of an event is start-time-based calculated block + 1,
+      //       unless start times matches exactly the begin of a block.
 
-        progIdx++;
+      if (tag->EpgID() != iEpgId || gridCursor < tag->StartAsUTC() || m_gridEnd <= tag->StartAsUTC())
+        break;
+
+      if (gridCursor < tag->EndAsUTC())
+      {
+        row[block].item = item;
+        row[block].progIndex = progIdx;
+        break;
       }
 
-      gridCursor += blockDuration;
+      progIdx++;
+    }
 
-      if (block == 0)
-        continue;
+    gridCursor += blockDuration;
+
+    if (block == 0)
+      continue;
 
-      const CFileItemPtr prevItem(m_gridIndex[channel][block - 1].item);
-      const CFileItemPtr currItem(m_gridIndex[channel][block].item);
+    const CFileItemPtr prevItem(row[block - 1].item);
+    const CFileItemPtr currItem(row[block].item);
 
-      if (block == m_blocks - 1 || prevItem != currItem)
+    if (block == m_blocks - 1 || prevItem != currItem)
+    {
+      // special handling for last block.
+      int blockDelta = -1;
+      int sizeDelta = 0;
+      if (block == m_blocks - 1 && prevItem == currItem)
       {
-        // special handling for last block.
-        int blockDelta = -1;
-        int sizeDelta = 0;
-        if (block == m_blocks - 1 && prevItem == currItem)
+        itemSize++;
+        blockDelta = 0;
+        sizeDelta = 1;
+      }
+
+      if (prevItem)
+      {
+        row[savedBlock].item->SetProperty("GenreType", prevItem->GetEPGInfoTag()->GenreType());
+      }
+      else
+      {
+        const std::shared_ptr<CFileItem> gapItem = CreateGapItem(channel);
+        for (int i = block + blockDelta; i >= block - itemSize + sizeDelta; --i)
         {
-          itemSize++;
-          blockDelta = 0;
-          sizeDelta = 1;
+          row[i].item = gapItem;
         }
+      }
+
+      float fItemWidth = itemSize * m_fBlockSize;
+      row[savedBlock].originWidth = fItemWidth;
+      row[savedBlock].width = fItemWidth;
+
+      itemSize = 1;
+      savedBlock = block;
 
-        if (prevItem)
+      // special handling for last block.
+      if (block == m_blocks - 1 && prevItem != currItem)
+      {
+        if (currItem)
         {
-          m_gridIndex[channel][savedBlock].item->SetProperty("GenreType", prevItem->GetEPGInfoTag()->GenreType());
+          row[savedBlock].item->SetProperty("GenreType", currItem->GetEPGInfoTag()->GenreType());
         }
         else
         {
-          const std::shared_ptr<CFileItem> gapItem = CreateGapItem(channel);
-          for (int i = block + blockDelta; i >= block - itemSize + sizeDelta; --i)
-          {
-            m_gridIndex[channel][i].item = gapItem;
-          }
+          row[block].item = CreateGapItem(channel);
         }
 
-        float fItemWidth = itemSize * fBlockSize;
-        m_gridIndex[channel][savedBlock].originWidth = fItemWidth;
-        m_gridIndex[channel][savedBlock].width = fItemWidth;
+        row[savedBlock].originWidth = m_fBlockSize; // size always 1 block here
+        row[savedBlock].width = m_fBlockSize;
+      }
+    }
+    else
+    {
+      itemSize++;
+    }
+  }
+}
 
-        itemSize = 1;
-        savedBlock = block;
+void CGUIEPGGridContainerModel::CopyUnchangedRows(const CGUIEPGGridContainerModel &previous)
+{
+  if (previous.m_gridStart != m_gridStart || previous.m_blocks != m_blocks || previous.m_fBlockSize != m_fBlockSize)
+    return;
 
-        // special handling for last block.
-        if (block == m_blocks - 1 && prevItem != currItem)
-        {
-          if (currItem)
-          {
-            m_gridIndex[channel][savedBlock].item->SetProperty("GenreType", currItem->GetEPGInfoTag()->GenreType());
-          }
-          else
-          {
-            m_gridIndex[channel][block].item = CreateGapItem(channel);
-          }
+  std::map<std::pair<int, int>, int> channels;
+  for (size_t i = 0; i < m_channelItems.size(); ++i)
+  {
+    const std::shared_ptr<CPVRChannel> channel = m_channelItems[i]->GetPVRChannelInfoTag();
+    channels.insert(std::make_pair(std::make_pair(channel->ClientID(), channel->UniqueID()), static_cast<int>(i)));
+  }
 
-          m_gridIndex[channel][savedBlock].originWidth = fBlockSize; // size always 1 block here
-          m_gridIndex[channel][savedBlock].width = fBlockSize;
-        }
-      }
-      else
-      {
-        itemSize++;
-      }
+  for (int iPrevious : previous.m_createdRows)
+  {
+    const std::shared_ptr<CPVRChannel> channel = previous.m_channelItems[iPrevious]->GetPVRChannelInfoTag();
+    const auto it = channels.find(std::make_pair(channel->ClientID(), channel->UniqueID()));
+    if (it == channels.end() || !m_gridIndex[it->second].empty())
+      continue;
+
+    // the row can only be taken over if it shows the same programme items
+    const ItemsPtr &items = m_epgItemsPtr[it->second];
+    const ItemsPtr &previousItems = previous.m_epgItemsPtr[iPrevious];
+    if (items.stop - items.start != previousItems.stop - previousItems.start ||
+        !std::equal(m_programmeItems.begin() + items.start, m_programmeItems.begin() + items.stop + 1,
+                    previous.m_programmeItems.begin() + previousItems.start))
+      continue;
+
+    std::vector<GridItem> &row = m_gridIndex[it->second];
+    row = previous.m_gridIndex[iPrevious];
+
+    // programme indices refer to the programme items of the model
+    const long offset = items.start - previousItems.start;
+    for (auto &gridItem : row)
+    {
+      if (gridItem.progIndex != -1)
+        gridItem.progIndex += offset;
     }
+    m_createdRows.insert(it->second);
   }
 }
 
@@ -403,14 +461,18 @@ void CGUIEPGGridContainerModel::FreeRulerMemory(int keepStart, int keepEnd)
   }
 }
 
-void CGUIEPGGridContainerModel::FreeItemsMemory()
+void CGUIEPGGridContainerModel::FreeGridMemory(int keepStart, int keepEnd, int keepChannel)
 {
-  for (const auto &programme : m_programmeItems)
-    programme->FreeMemory();
-  for (const auto &channel : m_channelItems)
-    channel->FreeMemory();
-  for (const auto &ruler : m_rulerItems)
-    ruler->FreeMemory();
+  for (auto it = m_createdRows.begin(); it != m_createdRows.end();)
+  {
+    if ((*it < keepStart || *it > keepEnd) && *it != keepChannel)
+    {
+      std::vector<GridItem>().swap(m_gridIndex[*it]);
+      it = m_createdRows.erase(it);
+    }
+    else
+      ++it;
+  }
 }
 
 unsigned int CGUIEPGGridContainerModel::GetPageNowOffset() const
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "XBDateTime.h"
@@ -30,6 +31,13 @@ namespace PVR
     int progIndex = -1;
   };
 
+  /*!
+   * @brief The data of the EPG grid control.
+   *
+   * Initialize() only groups the programmes by channel. The blocks of a channel row are
+   * created on first access and can be freed again for rows far away from the view port,
+   * so the cost of a model does not grow with the number of channels.
+   */
   class CGUIEPGGridContainerModel
   {
   public:
@@ -42,6 +50,12 @@ namespace PVR
     void Initialize(const std::unique_ptr<CFileItemList> &items, const CDateTime &gridStart, const CDateTime &gridEnd, int iRulerUnit, int iBlocksPerPage, float fBlockSize);
     void SetInvalid();
 
+    /*!
+     * @brief Take over the already created rows of a previous model for channels whose programmes did not change.
+     * @param previous The previous model.
+     */
+    void CopyUnchangedRows(const CGUIEPGGridContainerModel &previous);
+
     static const int INVALID_INDEX = -1;
     void FindChannelAndBlockIndex(int channelUid, unsigned int broadcastUid, int eventOffset, int &newChannelIndex, int &newBlockIndex) const;
 
@@ -49,6 +63,14 @@ namespace PVR
     void FreeProgrammeMemory(int channel, int keepStart, int keepEnd);
     void FreeRulerMemory(int keepStart, int keepEnd);
 
+    /*!
+     * @brief Free the created rows outside the given range. They are created again on access.
+     * @param keepStart The first channel to keep.
+     * @param keepEnd The last channel to keep.
+     * @param keepChannel Another channel to keep, the one of the selected item.
+     */
+    void FreeGridMemory(int keepStart, int keepEnd, int keepChannel);
+
     CFileItemPtr GetProgrammeItem(int iIndex) const { return m_programmeItems[iIndex]; }
     bool HasProgrammeItems() const { return !m_programmeItems.empty(); }
     int ProgrammeItemsSize() const { return static_cast<int>(m_programmeItems.size()); }
@@ -62,12 +84,12 @@ namespace PVR
 
     int GetBlockCount() const { return m_blocks; }
     bool HasGridItems() const { return !m_gridIndex.empty(); }
-    GridItem *GetGridItemPtr(int iChannel, int iBlock) { return &m_gridIndex[iChannel][iBlock]; }
-    CFileItemPtr GetGridItem(int iChannel, int iBlock) const { return m_gridIndex[iChannel][iBlock].item; }
-    float GetGridItemWidth(int iChannel, int iBlock) const { return m_gridIndex[iChannel][iBlock].width; }
-    float GetGridItemOriginWidth(int iChannel, int iBlock) const { return m_gridIndex[iChannel][iBlock].originWidth; }
-    int GetGridItemIndex(int iChannel, int iBlock) const { return m_gridIndex[iChannel][iBlock].progIndex; }
-    void SetGridItemWidth(int iChannel, int iBlock, float fWidth) { m_gridIndex[iChannel][iBlock].width = fWidth; }
+    GridItem *GetGridItemPtr(int iChannel, int iBlock) { return &GetGridRow(iChannel)[iBlock]; }
+    CFileItemPtr GetGridItem(int iChannel, int iBlock) const { return GetGridRow(iChannel)[iBlock].item; }
+    float GetGridItemWidth(int iChannel, int iBlock) const { return GetGridRow(iChannel)[iBlock].width; }
+    float GetGridItemOriginWidth(int iChannel, int iBlock) const { return GetGridRow(iChannel)[iBlock].originWidth; }
+    int GetGridItemIndex(int iChannel, int iBlock) const { return GetGridRow(iChannel)[iBlock].progIndex; }
+    void SetGridItemWidth(int iChannel, int iBlock, float fWidth) { GetGridRow(iChannel)[iBlock].width = fWidth; }
 
     bool IsZeroGridDuration() const { return (m_gridEnd - m_gridStart) == CDateTimeSpan(0, 0, 0, 0); }
     const CDateTime &GetGridStart() const { return m_gridStart; }
@@ -83,9 +105,16 @@ namespace PVR
     int GetLastEventBlock(const CPVREpgInfoTagPtr &event) const;
 
   private:
-    void FreeItemsMemory();
     std::shared_ptr<CFileItem> CreateGapItem(int iChannel) const;
 
+    /*!
+     * @brief Get the blocks of a channel, create them if needed.
+     * @param iChannel The channel index.
+     * @return The blocks.
+     */
+    std::vector<GridItem> &GetGridRow(int iChannel) const;
+    void CreateGridRow(int iChannel) const;
+
     struct ItemsPtr
     {
       long start;
@@ -99,8 +128,10 @@ namespace PVR
     std::vector<CFileItemPtr> m_channelItems;
     std::vector<CFileItemPtr> m_rulerItems;
     std::vector<ItemsPtr> m_epgItemsPtr;
-    std::vector<std::vector<GridItem> > m_gridIndex;
+    mutable std::vector<std::vector<GridItem> > m_gridIndex; //! rows are empty until created by GetGridRow()
+    mutable std::set<int> m_createdRows;
 
     int m_blocks = 0;
+    float m_fBlockSize = 0.0f;
   };
 }
@@ -21,11 +21,13 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "utils/log.h"
 #include "view/GUIViewState.h"
 
 #include "pvr/PVRGUIActions.h"
 #include "pvr/PVRManager.h"
 #include "pvr/channels/PVRChannelGroupsContainer.h"
+#include "pvr/epg/Epg.h"
 #include "pvr/epg/EpgChannelData.h"
 #include "pvr/epg/EpgContainer.h"
 #include "pvr/recordings/PVRRecordings.h"
@@ -80,6 +82,7 @@ void CGUIWindowPVRGuideBase::ClearData()
     CSingleLock lock(m_critSection);
     m_cachedChannelGroup.reset();
     m_newTimeline.reset();
+    m_timelineRows.clear();
   }
 
   CGUIWindowPVRBase::ClearData();
@@ -618,6 +621,15 @@ bool CGUIWindowPVRGuideBase::RefreshTimelineItems()
 
       std::unique_ptr<CFileItemList> timeline(new CFileItemList);
 
+      const CDateTime currentDate(CDateTime::GetCurrentDateTime().GetAsUTCDateTime());
+      CPVREpgContainer& epgContainer = CServiceBroker::GetPVRManager().EpgContainer();
+
+      // the grid never shows more than the past and future days to display
+      int iPastDays = epgContainer.GetPastDaysToDisplay();
+      const CDateTime maxPastDate(currentDate - CDateTimeSpan(iPastDays, 0, 0, 0));
+      int iFutureDays = epgContainer.GetFutureDaysToDisplay();
+      const CDateTime maxFutureDate(currentDate + CDateTimeSpan(iFutureDays, 0, 0, 0));
+
       if (m_bFirstOpen)
       {
         m_bFirstOpen = false;
@@ -633,23 +645,25 @@ bool CGUIWindowPVRGuideBase::RefreshTimelineItems()
           timeline->Add(std::make_shared<CFileItem>(gapTag));
         }
 
+        if (m_guiState.get())
+          timeline->Sort(m_guiState->GetSortMethod());
+
         // next, fetch actual data.
         m_bRefreshTimelineItems = true;
         m_refreshTimelineItemsThread->DoRefresh(false);
       }
       else
       {
+        // full hours, so that unchanged channels can be reused between refreshes
+        const CDateTime fetchStart(maxPastDate.GetYear(), maxPastDate.GetMonth(), maxPastDate.GetDay(), maxPastDate.GetHour(), 0, 0);
+        const CDateTime fetchEnd(maxFutureDate.GetYear(), maxFutureDate.GetMonth(), maxFutureDate.GetDay(), maxFutureDate.GetHour(), 0, 0);
+
         // can be very expensive. never call with lock acquired.
-        const std::vector<std::shared_ptr<CPVREpgInfoTag>> tags = group->GetEPGAll(true);
-        for (const auto& tag : tags)
-        {
-          timeline->Add(std::make_shared<CFileItem>(tag));
-        }
+        GetTimelineRows(group->GetMembers(CPVRChannelGroup::Include::ONLY_VISIBLE), fetchStart, fetchEnd, *timeline);
       }
 
       CDateTime startDate(group->GetFirstEPGDate());
       CDateTime endDate(group->GetLastEPGDate());
-      const CDateTime currentDate(CDateTime::GetCurrentDateTime().GetAsUTCDateTime());
 
       if (!startDate.IsValid())
         startDate = currentDate;
@@ -657,23 +671,14 @@ bool CGUIWindowPVRGuideBase::RefreshTimelineItems()
       if (!endDate.IsValid() || endDate < startDate)
         endDate = startDate;
 
-      CPVREpgContainer& epgContainer = CServiceBroker::GetPVRManager().EpgContainer();
-
       // limit start to past days to display
-      int iPastDays = epgContainer.GetPastDaysToDisplay();
-      const CDateTime maxPastDate(currentDate - CDateTimeSpan(iPastDays, 0, 0, 0));
       if (startDate < maxPastDate)
         startDate = maxPastDate;
 
       // limit end to future days to display
-      int iFutureDays = epgContainer.GetFutureDaysToDisplay();
-      const CDateTime maxFutureDate(currentDate + CDateTimeSpan(iFutureDays, 0, 0, 0));
       if (endDate > maxFutureDate)
         endDate = maxFutureDate;
 
-      if (m_guiState.get())
-        timeline->Sort(m_guiState->GetSortMethod());
-
       // can be very expensive. never call with lock acquired.
       epgGridContainer->SetTimelineItems(timeline, startDate, endDate);
 
@@ -689,6 +694,90 @@ bool CGUIWindowPVRGuideBase::RefreshTimelineItems()
   return false;
 }
 
+void CGUIWindowPVRGuideBase::GetTimelineRows(const std::vector<PVRChannelGroupMember>& members, const CDateTime& start, const CDateTime& end, CFileItemList& timeline)
+{
+  TimelineRows rows;
+  {
+    CSingleLock lock(m_critSection);
+    rows.swap(m_timelineRows);
+  }
+
+  TimelineRows newRows;
+  CFileItemList channels;
+  int iFetched = 0;
+
+  for (const auto& member : members)
+  {
+    const std::shared_ptr<CPVRChannel> channel = member.channel;
+    const std::pair<int, int> key(channel->ClientID(), channel->UniqueID());
+
+    const std::shared_ptr<CPVREpg> epg = channel->GetEPG();
+    const int iEpgId = epg ? epg->EpgID() : -1;
+    // get the revision first, a change while fetching is picked up by the next refresh
+    const unsigned int iRevision = epg ? epg->GetRevision() : 0;
+
+    TimelineRow row;
+    const auto it = rows.find(key);
+    if (it != rows.end() &&
+        it->second.iEpgId == iEpgId && it->second.iRevision == iRevision &&
+        it->second.start == start && it->second.end == end)
+    {
+      row = std::move(it->second);
+    }
+    else
+    {
+      row.iEpgId = iEpgId;
+      row.iRevision = iRevision;
+      row.start = start;
+      row.end = end;
+
+      if (epg)
+      {
+        const std::vector<std::shared_ptr<CPVREpgInfoTag>> tags = epg->GetTagsBetween(start, end);
+        row.items.reserve(tags.size());
+        for (const auto& tag : tags)
+          row.items.emplace_back(std::make_shared<CFileItem>(tag));
+      }
+
+      if (row.items.empty())
+      {
+        // fake a tag for channels without epg
+        if (epg)
+          row.items.emplace_back(std::make_shared<CFileItem>(std::make_shared<CPVREpgInfoTag>(epg->GetChannelData(), epg->EpgID())));
+        else
+          row.items.emplace_back(std::make_shared<CFileItem>(std::make_shared<CPVREpgInfoTag>(std::make_shared<CPVREpgChannelData>(*channel), -1)));
+      }
+
+      ++iFetched;
+    }
+
+    // one new item per channel to sort the rows. sorting sets the sort label of the sorted items,
+    // but the programme items of unchanged channels are shared with the grid on screen.
+    const CFileItemPtr channelItem = std::make_shared<CFileItem>(row.items.front()->GetEPGInfoTag());
+    channelItem->SetProperty("clientid", key.first);
+    channelItem->SetProperty("channeluid", key.second);
+    channels.Add(channelItem);
+
+    newRows.insert(std::make_pair(key, std::move(row)));
+  }
+
+  if (m_guiState.get())
+    channels.Sort(m_guiState->GetSortMethod());
+
+  for (const auto& channelItem : channels)
+  {
+    const std::pair<int, int> key(static_cast<int>(channelItem->GetProperty("clientid").asInteger()),
+                                  static_cast<int>(channelItem->GetProperty("channeluid").asInteger()));
+    for (const auto& item : newRows[key].items)
+      timeline.Add(item);
+  }
+
+  CLog::LogFC(LOGDEBUG, LOGEPG, "Fetched the programmes of %d of %d channels", iFetched, static_cast<int>(members.size()));
+
+  CSingleLock lock(m_critSection);
+  m_timelineRows.swap(newRows);
+}
+
 bool CGUIWindowPVRGuideBase::OnContextButtonBegin()
 {
   GetGridControl()->GoToBegin();
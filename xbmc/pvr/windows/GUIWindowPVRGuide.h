@@ -9,12 +9,17 @@
 #pragma once
 
 #include <atomic>
+#include <map>
 #include <memory>
+#include <utility>
+#include <vector>
 
+#include "XBDateTime.h"
 #include "threads/Event.h"
 #include "threads/Thread.h"
 
 #include "pvr/PVRChannelNumberInputHandler.h"
+#include "pvr/channels/PVRChannelGroup.h"
 #include "pvr/windows/GUIWindowPVRBase.h"
 
 namespace PVR
@@ -70,12 +75,36 @@ namespace PVR
 
     void RefreshView(CGUIMessage& message, bool bInitGridControl);
 
+    /*!
+     * @brief The programme items of a channel, reused while the channel's EPG does not change.
+     */
+    struct TimelineRow
+    {
+      int iEpgId = -1;
+      unsigned int iRevision = 0;
+      CDateTime start;
+      CDateTime end;
+      std::vector<CFileItemPtr> items;
+    };
+    typedef std::map<std::pair<int, int>, TimelineRow> TimelineRows; //! by client id and channel uid
+
+    /*!
+     * @brief Add the programme items of the given channels to the timeline, fetch the items of changed channels only.
+     * Runs on the refresh thread, the reused items are shared with the grid on screen and are not modified.
+     * @param members The channels.
+     * @param start The start of the time window to fetch.
+     * @param end The end of the time window to fetch.
+     * @param timeline The timeline.
+     */
+    void GetTimelineRows(const std::vector<PVRChannelGroupMember>& members, const CDateTime& start, const CDateTime& end, CFileItemList& timeline);
+
     std::unique_ptr<CPVRRefreshTimelineItemsThread> m_refreshTimelineItemsThread;
     std::atomic_bool m_bRefreshTimelineItems;
     std::atomic_bool m_bSyncRefreshTimelineItems;
 
     CPVRChannelGroupPtr m_cachedChannelGroup;
     std::unique_ptr<CFileItemList> m_newTimeline;
+    TimelineRows m_timelineRows;
 
     bool m_bChannelSelectionRestored;
     std::atomic_bool m_bFirstOpen;
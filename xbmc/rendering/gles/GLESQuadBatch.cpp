@@ -0,0 +1,121 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GLESQuadBatch.h"
+
+#include <cstddef>
+
+namespace
+{
+  // indices are GLushort, a single draw must not address more than 65536 vertices
+  const unsigned int MAX_QUADS = 4096;
+  const unsigned int MAX_VERTICES = MAX_QUADS * 4;
+  const unsigned int BUFFER_VERTICES = MAX_VERTICES * 2;
+}
+
+void CGLESQuadBatch::Add(const PackedVertex* vertices)
+{
+  m_vertices.insert(m_vertices.end(), vertices, vertices + 4);
+}
+
+bool CGLESQuadBatch::IsFull() const
+{
+  return m_vertices.size() >= MAX_VERTICES;
+}
+
+void CGLESQuadBatch::CreateBuffers()
+{
+  std::vector<GLushort> indices;
+  indices.reserve(MAX_QUADS * 6);
+  for (unsigned int i = 0; i < MAX_VERTICES; i += 4)
+  {
+    indices.push_back(i + 0);
+    indices.push_back(i + 1);
+    indices.push_back(i + 2);
+    indices.push_back(i + 2);
+    indices.push_back(i + 3);
+    indices.push_back(i + 0);
+  }
+
+  glGenBuffers(1, &m_indexBuffer);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
+
+  glGenBuffers(1, &m_vertexBuffer);
+  glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+  // allocated on the first Draw()
+  m_bufferOffset = BUFFER_VERTICES;
+}
+
+unsigned int CGLESQuadBatch::Draw(GLint posLoc, GLint tex0Loc, GLint tex1Loc)
+{
+  const unsigned int count = m_vertices.size();
+  if (!count)
+    return 0;
+
+  if (!m_vertexBuffer)
+  {
+    CreateBuffers();
+  }
+  else
+  {
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffer);
+  }
+
+  if (m_bufferOffset + count > BUFFER_VERTICES)
+  {
+    // orphan the storage, the driver keeps the old one alive until the pending draws finished
+    glBufferData(GL_ARRAY_BUFFER, BUFFER_VERTICES * sizeof(PackedVertex), nullptr, GL_STREAM_DRAW);
+    m_bufferOffset = 0;
+  }
+
+  glBufferSubData(GL_ARRAY_BUFFER, m_bufferOffset * sizeof(PackedVertex), count * sizeof(PackedVertex), m_vertices.data());
+
+  const char* base = reinterpret_cast<const char*>(m_bufferOffset * sizeof(PackedVertex));
+  glVertexAttribPointer(posLoc, 3, GL_FLOAT, GL_FALSE, sizeof(PackedVertex), base + offsetof(PackedVertex, x));
+  glEnableVertexAttribArray(posLoc);
+  if (tex0Loc >= 0)
+  {
+    glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, GL_FALSE, sizeof(PackedVertex), base + offsetof(PackedVertex, u1));
+    glEnableVertexAttribArray(tex0Loc);
+  }
+  if (tex1Loc >= 0)
+  {
+    glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, GL_FALSE, sizeof(PackedVertex), base + offsetof(PackedVertex, u2));
+    glEnableVertexAttribArray(tex1Loc);
+  }
+
+  glDrawElements(GL_TRIANGLES, count / 4 * 6, GL_UNSIGNED_SHORT, nullptr);
+
+  glDisableVertexAttribArray(posLoc);
+  if (tex0Loc >= 0)
+    glDisableVertexAttribArray(tex0Loc);
+  if (tex1Loc >= 0)
+    glDisableVertexAttribArray(tex1Loc);
+
+  // everything else draws from client memory
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+  m_bufferOffset += count;
+  m_vertices.clear();
+  return count;
+}
+
+void CGLESQuadBatch::Release()
+{
+  if (m_vertexBuffer)
+    glDeleteBuffers(1, &m_vertexBuffer);
+  if (m_indexBuffer)
+    glDeleteBuffers(1, &m_indexBuffer);
+  m_vertexBuffer = 0;
+  m_indexBuffer = 0;
+  m_bufferOffset = 0;
+  m_vertices.clear();
+}
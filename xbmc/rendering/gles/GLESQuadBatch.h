@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "system_gl.h"
+
+#include <vector>
+
+struct PackedVertex
+{
+  float x, y, z;
+  float u1, v1;
+  float u2, v2;
+};
+
+/*!
+ * @brief Collects GUI quads and draws them with a single call from a streamed vertex buffer.
+ *
+ * The caller decides which quads may be merged, the batch only stores their vertices. Each
+ * Draw() appends the vertices to the next free range of the buffer, the buffer is orphaned
+ * when it is full so the driver does not need to wait for pending draws.
+ */
+class CGLESQuadBatch
+{
+public:
+  CGLESQuadBatch() = default;
+  ~CGLESQuadBatch() = default;
+
+  /*!
+   * @brief Add a quad.
+   * @param vertices The four corners, clockwise from top left.
+   */
+  void Add(const PackedVertex* vertices);
+
+  bool IsEmpty() const { return m_vertices.empty(); }
+  bool IsFull() const;
+
+  /*!
+   * @brief Draw and remove the queued quads with the enabled shader.
+   * @param posLoc The position attribute.
+   * @param tex0Loc The first texture coordinate attribute or -1 if unused.
+   * @param tex1Loc The second texture coordinate attribute or -1 if unused.
+   * @return The number of vertices drawn.
+   */
+  unsigned int Draw(GLint posLoc, GLint tex0Loc, GLint tex1Loc);
+
+  /*!
+   * @brief Free the GL buffers, they are created again on the next Draw().
+   */
+  void Release();
+
+private:
+  CGLESQuadBatch(const CGLESQuadBatch&) = delete;
+  CGLESQuadBatch& operator=(const CGLESQuadBatch&) = delete;
+
+  void CreateBuffers();
+
+  std::vector<PackedVertex> m_vertices;
+  GLuint m_vertexBuffer = 0;
+  GLuint m_indexBuffer = 0;
+  unsigned int m_bufferOffset = 0; /*!< the first free vertex of the vertex buffer */
+};
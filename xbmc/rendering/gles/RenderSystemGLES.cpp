@@ -7,6 +7,7 @@
  */
 
 #include "guilib/DirtyRegion.h"
+#include "guilib/GUIControlProfiler.h"
 #include "windowing/GraphicContext.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
@@ -111,6 +112,8 @@ bool CRenderSystemGLES::InitRenderSystem()
 
 bool CRenderSystemGLES::ResetRenderSystem(int width, int height)
 {
+  FlushBatch();
+
   m_width = width;
   m_height = height;
 
@@ -153,6 +156,7 @@ bool CRenderSystemGLES::DestroyRenderSystem()
   glFinish();
   PresentRenderImpl(true);
 
+  m_batch.Release();
   ReleaseShaders();
   m_bRenderCreated = false;
 
@@ -182,6 +186,8 @@ bool CRenderSystemGLES::EndRender()
   if (!m_bRenderCreated)
     return false;
 
+  FlushBatch();
+
   return true;
 }
 
@@ -190,6 +196,8 @@ bool CRenderSystemGLES::ClearBuffers(UTILS::Color color)
   if (!m_bRenderCreated)
     return false;
 
+  FlushBatch();
+
   float r = GET_R(color) / 255.0f;
   float g = GET_G(color) / 255.0f;
   float b = GET_B(color) / 255.0f;
@@ -228,6 +236,7 @@ void CRenderSystemGLES::PresentRender(bool rendered, bool videoLayer)
   if (!m_bRenderCreated)
     return;
 
+  FlushBatch();
   PresentRenderImpl(rendered);
 
   // if video is rendered to a separate layer, we should not block this thread
@@ -258,6 +267,8 @@ void CRenderSystemGLES::CaptureStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  FlushBatch();
+
   glMatrixProject.Push();
   glMatrixModview.Push();
   glMatrixTexture.Push();
@@ -273,6 +284,8 @@ void CRenderSystemGLES::ApplyStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  FlushBatch();
+
   glMatrixProject.PopLoad();
   glMatrixModview.PopLoad();
   glMatrixTexture.PopLoad();
@@ -287,6 +300,8 @@ void CRenderSystemGLES::SetCameraPosition(const CPoint &camera, int screenWidth,
   if (!m_bRenderCreated)
     return;
 
+  FlushBatch();
+
   CPoint offset = camera - CPoint(screenWidth*0.5f, screenHeight*0.5f);
 
   float w = (float)m_viewPort[2]*0.5f;
@@ -335,6 +350,8 @@ void CRenderSystemGLES::SetViewPort(const CRect& viewPort)
   if (!m_bRenderCreated)
     return;
 
+  FlushBatch();
+
   glScissor((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   m_viewPort[0] = viewPort.x1;
@@ -369,6 +386,9 @@ void CRenderSystemGLES::SetScissors(const CRect &rect)
 {
   if (!m_bRenderCreated)
     return;
+
+  FlushBatch();
+
   GLint x1 = MathUtils::round_int(rect.x1);
   GLint y1 = MathUtils::round_int(rect.y1);
   GLint x2 = MathUtils::round_int(rect.x2);
@@ -543,6 +563,20 @@ void CRenderSystemGLES::ReleaseShaders()
 }
 
 void CRenderSystemGLES::EnableGUIShader(ESHADERMETHOD method)
+{
+  // fonts, pictures and overlays set textures, blending and matrices before they enable their shader.
+  // queued quads at this point have been drawn with that state instead of their own.
+  if (!m_batch.IsEmpty() && !m_bBatchInterleaveLogged)
+  {
+    CLog::Log(LOGWARNING, "CRenderSystemGLES::%s - GUI quads still queued for shader %d, FlushBatch() must be called before changing GL state", __FUNCTION__, method);
+    m_bBatchInterleaveLogged = true;
+  }
+
+  FlushBatch();
+  ApplyGUIShader(method);
+}
+
+void CRenderSystemGLES::ApplyGUIShader(ESHADERMETHOD method)
 {
   m_method = method;
   if (m_pShader[m_method])
@@ -564,6 +598,76 @@ void CRenderSystemGLES::DisableGUIShader()
   m_method = SM_DEFAULT;
 }
 
+bool GUIBatchState::operator==(const GUIBatchState& right) const
+{
+  return method == right.method &&
+         blend == right.blend &&
+         texture0 == right.texture0 &&
+         texture1 == right.texture1 &&
+         color[0] == right.color[0] &&
+         color[1] == right.color[1] &&
+         color[2] == right.color[2] &&
+         color[3] == right.color[3];
+}
+
+void CRenderSystemGLES::AddGUIQuad(const GUIBatchState& state, const PackedVertex* vertices)
+{
+  if (!m_batch.IsEmpty() && (state != m_batchState || m_batch.IsFull()))
+    FlushBatch();
+
+  m_batchState = state;
+  m_batch.Add(vertices);
+}
+
+void CRenderSystemGLES::FlushBatch()
+{
+  if (m_batch.IsEmpty())
+    return;
+
+  if (m_batchState.texture1)
+  {
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, m_batchState.texture1);
+  }
+  glActiveTexture(GL_TEXTURE0);
+  if (m_batchState.texture0)
+    glBindTexture(GL_TEXTURE_2D, m_batchState.texture0);
+
+  ApplyGUIShader(m_batchState.method);
+
+  switch (m_batchState.blend)
+  {
+    case GUIBLEND_NONE:
+      glDisable(GL_BLEND);
+      break;
+    case GUIBLEND_ALPHA:
+      glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+      glEnable(GL_BLEND);
+      break;
+    case GUIBLEND_SEPARATE_ALPHA:
+      glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+      glEnable(GL_BLEND);
+      break;
+  }
+
+  GLint uniColLoc = GUIShaderGetUniCol();
+  if (uniColLoc >= 0)
+  {
+    const GLubyte* col = m_batchState.color;
+    glUniform4f(uniColLoc, col[0] / 255.0f, col[1] / 255.0f, col[2] / 255.0f, col[3] / 255.0f);
+  }
+
+  const unsigned int vertices = m_batch.Draw(GUIShaderGetPos(),
+                                             m_batchState.texture0 ? GUIShaderGetCoord0() : -1,
+                                             m_batchState.texture1 ? GUIShaderGetCoord1() : -1);
+
+  glEnable(GL_BLEND);
+  DisableGUIShader();
+
+  if (CGUIControlProfiler::IsRunning())
+    CGUIControlProfiler::Instance().AddDrawCall(vertices);
+}
+
 GLint CRenderSystemGLES::GUIShaderGetPos()
 {
   if (m_pShader[m_method])
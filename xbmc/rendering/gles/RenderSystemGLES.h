@@ -11,6 +11,7 @@
 #include "system_gl.h"
 #include "rendering/RenderSystem.h"
 #include "utils/Color.h"
+#include "GLESQuadBatch.h"
 #include "GLESShader.h"
 
 #include <array>
@@ -32,6 +33,28 @@ enum ESHADERMETHOD
   SM_MAX
 };
 
+enum EGUIBLENDMODE
+{
+  GUIBLEND_NONE,
+  GUIBLEND_ALPHA,
+  GUIBLEND_SEPARATE_ALPHA, //!< keeps the destination alpha
+};
+
+/*!
+ * @brief The state a GUI quad is drawn with, consecutive quads of equal state are drawn together.
+ */
+struct GUIBatchState
+{
+  ESHADERMETHOD method = SM_DEFAULT;
+  EGUIBLENDMODE blend = GUIBLEND_NONE;
+  GLuint texture0 = 0;
+  GLuint texture1 = 0;
+  GLubyte color[4] = {255, 255, 255, 255};
+
+  bool operator==(const GUIBatchState& right) const;
+  bool operator!=(const GUIBatchState& right) const { return !(*this == right); }
+};
+
 class CRenderSystemGLES : public CRenderSystemBase
 {
 public:
@@ -75,6 +98,20 @@ public:
   void EnableGUIShader(ESHADERMETHOD method);
   void DisableGUIShader();
 
+  /*!
+   * @brief Queue a quad, it is drawn together with the following quads of equal state.
+   * @param state The shader, blend mode, textures and color of the quad.
+   * @param vertices The four corners, clockwise from top left.
+   */
+  void AddGUIQuad(const GUIBatchState& state, const PackedVertex* vertices);
+
+  /*!
+   * @brief Draw the queued quads, must be called before any GL state change.
+   * Code that draws with its own GL calls, e.g. fonts, calls it before it binds textures, sets blending or
+   * pushes matrices. EnableGUIShader() flushes too, but only after that state was already changed.
+   */
+  void FlushBatch();
+
   GLint GUIShaderGetPos();
   GLint GUIShaderGetCol();
   GLint GUIShaderGetCoord0();
@@ -91,6 +128,7 @@ protected:
   virtual void SetVSyncImpl(bool enable) = 0;
   virtual void PresentRenderImpl(bool rendered) = 0;
   void CalculateMaxTexturesize();
+  void ApplyGUIShader(ESHADERMETHOD method);
 
   bool m_bVsyncInit{false};
   int m_width;
@@ -102,5 +140,9 @@ protected:
   ESHADERMETHOD m_method = SM_DEFAULT;
 
   GLint      m_viewPort[4];
+
+  CGLESQuadBatch m_batch;
+  GUIBatchState m_batchState;
+  bool m_bBatchInterleaveLogged = false;
 };
 
@@ -305,6 +305,7 @@ void CAdvancedSettings::Initialize()
   m_musicArtistSeparators = { ";", " feat. ", " ft. " };
   m_videoItemSeparator = " / ";
   m_iMusicLibraryDateAdded = 1; // prefer mtime over ctime and current time
+  m_iMusicLibraryTagReaderThreads = 4;
 
   m_bVideoLibraryAllItemsOnBottom = false;
   m_iVideoLibraryRecentlyAddedItems = 25;
@@ -344,6 +345,9 @@ void CAdvancedSettings::Initialize()
                                                       updateemptytagsinterval = 3600 => trigger an EPG update for every
                                                       channel without EPG data every 2 hours and trigger an EPG update
                                                       for every channel with EPG data every 1 hour. */
+  m_iEpgUpdateThreads = 8; /* Maximum number of EPG tables updated at the same time */
+  m_iEpgUpdateThreadsPerClient = 1; /* Maximum number of EPG tables updated at the same time from one client. Raise
+                                       only for add-ons that can serve several requests in parallel. */
   m_bEpgDisplayUpdatePopup = true; /* Display a progress popup while updating EPG data from clients */
   m_bEpgDisplayIncrementalUpdatePopup = false; /* Display a progress popup while doing incremental EPG updates, but
                                                   only if 'displayupdatepopup' is also enabled. */
@@ -403,6 +407,8 @@ void CAdvancedSettings::Initialize()
   m_iPVRNumericChannelSwitchTimeout = 2000;
   m_iPVRTimeshiftThreshold = 10;
   m_bPVRTimeshiftSimpleOSD = true;
+  m_iPVRLocalTimeshiftSize = 0;
+  m_iPVRLocalTimeshiftDuration = 60;
 
   m_cacheMemSize = 1024 * 1024 * 20;
   m_cacheBufferMode = CACHE_BUFFER_MODE_INTERNET; // Default (buffer all internet streams/filesystems)
@@ -421,6 +427,7 @@ void CAdvancedSettings::Initialize()
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
   m_guiSmartRedraw = false;
+  m_guiAtlasMaxImageSize = 128;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
 
@@ -790,6 +797,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetString(pElement, "albumformat", m_strMusicLibraryAlbumFormat);
     XMLUtils::GetString(pElement, "itemseparator", m_musicItemSeparator);
     XMLUtils::GetInt(pElement, "dateadded", m_iMusicLibraryDateAdded);
+    XMLUtils::GetInt(pElement, "tagreaderthreads", m_iMusicLibraryTagReaderThreads, 1, 16);
     //Music artist name separators
     TiXmlElement* separators = pElement->FirstChildElement("artistseparators");
     if (separators)
@@ -946,6 +954,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "activetagcheckinterval", m_iEpgActiveTagCheckInterval);
     XMLUtils::GetInt(pElement, "retryinterruptedupdateinterval", m_iEpgRetryInterruptedUpdateInterval);
     XMLUtils::GetInt(pElement, "updateemptytagsinterval", m_iEpgUpdateEmptyTagsInterval);
+    XMLUtils::GetInt(pElement, "updatethreads", m_iEpgUpdateThreads, 1, 64);
+    XMLUtils::GetInt(pElement, "updatethreadsperclient", m_iEpgUpdateThreadsPerClient, 1, 64);
     XMLUtils::GetBoolean(pElement, "displayupdatepopup", m_bEpgDisplayUpdatePopup);
     XMLUtils::GetBoolean(pElement, "displayincrementalupdatepopup", m_bEpgDisplayIncrementalUpdatePopup);
   }
@@ -1142,6 +1152,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pPVR, "numericchannelswitchtimeout", m_iPVRNumericChannelSwitchTimeout, 50, 60000);
     XMLUtils::GetInt(pPVR, "timeshiftthreshold", m_iPVRTimeshiftThreshold, 0, 60);
     XMLUtils::GetBoolean(pPVR, "timeshiftsimpleosd", m_bPVRTimeshiftSimpleOSD);
+    XMLUtils::GetInt(pPVR, "localtimeshiftsize", m_iPVRLocalTimeshiftSize, 0, 65536);
+    XMLUtils::GetInt(pPVR, "localtimeshiftduration", m_iPVRLocalTimeshiftDuration, 0, 1440);
   }
 
   TiXmlElement* pDatabase = pRootElement->FirstChildElement("videodatabase");
@@ -1242,6 +1254,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
     XMLUtils::GetBoolean(pElement, "smartredraw", m_guiSmartRedraw);
+    XMLUtils::GetUInt(pElement, "atlasmaximagesize", m_guiAtlasMaxImageSize, 0, 512);
   }
 
   std::string seekSteps;
@@ -249,6 +249,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     int m_iMusicLibraryRecentlyAddedItems;
     int m_iMusicLibraryDateAdded;
+    int m_iMusicLibraryTagReaderThreads;
     bool m_bMusicLibraryAllItemsOnBottom;
     bool m_bMusicLibraryCleanOnUpdate;
     bool m_bMusicLibraryArtistSortOnUpdate;
@@ -283,6 +284,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iEpgActiveTagCheckInterval; // seconds
     int m_iEpgRetryInterruptedUpdateInterval; // seconds
     int m_iEpgUpdateEmptyTagsInterval; // seconds
+    int m_iEpgUpdateThreads;
+    int m_iEpgUpdateThreadsPerClient;
     bool m_bEpgDisplayUpdatePopup;
     bool m_bEpgDisplayIncrementalUpdatePopup;
 
@@ -334,6 +337,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iPVRNumericChannelSwitchTimeout; /*!< @brief time in msecs after that a channel switch occurs after entering a channel number, if confirmchannelswitch is disabled */
     int m_iPVRTimeshiftThreshold; /*!< @brief time diff between current playing time and timeshift buffer end, in seconds, before a playing stream is displayed as timeshifting. */
     bool m_bPVRTimeshiftSimpleOSD; /*!< @brief use simple timeshift OSD (with progress only for the playing event instead of progress for the whole ts buffer). */
+    int m_iPVRLocalTimeshiftSize; /*!< @brief size in MB of the local timeshift buffer for backends without timeshift support, 0 to disable. defaults to 0. */
+    int m_iPVRLocalTimeshiftDuration; /*!< @brief maximum duration in minutes of the local timeshift buffer, 0 for no limit. defaults to 60. */
     DatabaseSettings m_databaseMusic; // advanced music database setup
     DatabaseSettings m_databaseVideo; // advanced video database setup
     DatabaseSettings m_databaseTV;    // advanced tv database setup
@@ -343,6 +348,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
     bool m_guiSmartRedraw;
+    unsigned int m_guiAtlasMaxImageSize; /*!< @brief largest width and height of skin images packed into shared texture pages, 0 to disable. defaults to 128. */
     unsigned int m_addonPackageFolderSize;
 
     unsigned int m_cacheMemSize;
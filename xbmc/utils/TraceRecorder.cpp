@@ -0,0 +1,163 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TraceRecorder.h"
+
+#include "filesystem/File.h"
+#include "threads/SingleLock.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/log.h"
+#include "utils/TimeUtils.h"
+#include "utils/Variant.h"
+
+const unsigned int CTraceRecorder::EVENTS_PER_THREAD;
+std::atomic<bool> CTraceRecorder::m_running(false);
+
+CTraceRecorder &CTraceRecorder::GetInstance()
+{
+  static CTraceRecorder recorder;
+  return recorder;
+}
+
+void CTraceRecorder::Start()
+{
+  m_startTime = CurrentHostCounter();
+  m_running = true;
+}
+
+void CTraceRecorder::Stop()
+{
+  m_running = false;
+}
+
+CTraceRecorder::ThreadBufferOwner::~ThreadBufferOwner()
+{
+  if (buffer)
+    CTraceRecorder::GetInstance().ReleaseThreadBuffer(buffer);
+}
+
+CTraceRecorder::ThreadBuffer &CTraceRecorder::GetThreadBuffer()
+{
+  thread_local ThreadBufferOwner owner;
+  if (!owner.buffer)
+  {
+    CSingleLock lock(m_section);
+    if (!m_freeBuffers.empty())
+    {
+      // the events of the exited thread are dropped, Export() holds the lock while reading them
+      owner.buffer = m_freeBuffers.front();
+      m_freeBuffers.erase(m_freeBuffers.begin());
+      owner.buffer->written.store(0, std::memory_order_relaxed);
+    }
+    else
+    {
+      m_buffers.emplace_back(new ThreadBuffer);
+      owner.buffer = m_buffers.back().get();
+    }
+    // a new id, the timeline must not show the events of two threads in one row
+    owner.buffer->thread = ++m_lastThread;
+  }
+  return *owner.buffer;
+}
+
+void CTraceRecorder::ReleaseThreadBuffer(ThreadBuffer *buffer)
+{
+  CSingleLock lock(m_section);
+  m_freeBuffers.push_back(buffer);
+}
+
+void CTraceRecorder::AddEvent(const char *name, int64_t start, int64_t end)
+{
+  ThreadBuffer &buffer = GetThreadBuffer();
+
+  // only this thread writes. the odd sequence tells Export() the slot is being overwritten, the
+  // release stores publish the event.
+  const uint64_t index = buffer.written.load(std::memory_order_relaxed);
+  Event &event = buffer.events[index % EVENTS_PER_THREAD];
+  event.sequence.store(2 * index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  event.name.store(name, std::memory_order_relaxed);
+  event.start.store(start, std::memory_order_relaxed);
+  event.end.store(end, std::memory_order_relaxed);
+  event.sequence.store(2 * index + 2, std::memory_order_release);
+  buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void CTraceRecorder::Export(std::string &json) const
+{
+  const int64_t startTime = m_startTime;
+  const double usPerTick = 1000000.0 / CurrentHostFrequency();
+
+  CVariant events(CVariant::VariantTypeArray);
+  CSingleLock lock(m_section);
+  for (const auto& buffer : m_buffers)
+  {
+    const uint64_t written = buffer->written.load(std::memory_order_acquire);
+    const uint64_t first = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+    for (uint64_t i = first; i < written; ++i)
+    {
+      const Event &event = buffer->events[i % EVENTS_PER_THREAD];
+      const uint64_t sequence = event.sequence.load(std::memory_order_acquire);
+      const char *name = event.name.load(std::memory_order_relaxed);
+      const int64_t start = event.start.load(std::memory_order_relaxed);
+      const int64_t end = event.end.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+
+      // left out if the thread overwrote the event meanwhile
+      if (sequence != 2 * i + 2 || event.sequence.load(std::memory_order_relaxed) != sequence)
+        continue;
+      if (start < startTime)
+        continue;
+
+      CVariant entry;
+      entry["name"] = name;
+      entry["cat"] = "kodi";
+      entry["ph"] = "X";
+      entry["ts"] = (start - startTime) * usPerTick;
+      entry["dur"] = (end - start) * usPerTick;
+      entry["pid"] = 1;
+      entry["tid"] = buffer->thread;
+      events.push_back(entry);
+    }
+  }
+  lock.Leave();
+
+  CVariant trace;
+  trace["traceEvents"] = events;
+  trace["displayTimeUnit"] = "ms";
+  CJSONVariantWriter::Write(trace, json, true);
+}
+
+bool CTraceRecorder::Export(const std::string &file) const
+{
+  std::string json;
+  Export(json);
+
+  XFILE::CFile output;
+  if (!output.OpenForWrite(file, true) ||
+      output.Write(json.c_str(), json.size()) != static_cast<ssize_t>(json.size()))
+  {
+    CLog::Log(LOGERROR, "CTraceRecorder::%s - unable to write %s", __FUNCTION__, file.c_str());
+    return false;
+  }
+
+  CLog::Log(LOGNOTICE, "CTraceRecorder::%s - trace written to %s", __FUNCTION__, file.c_str());
+  return true;
+}
+
+CTraceScope::CTraceScope(const char *name)
+  : m_name(name),
+    m_start(CTraceRecorder::IsRunning() ? CurrentHostCounter() : 0)
+{
+}
+
+CTraceScope::~CTraceScope()
+{
+  if (m_start && CTraceRecorder::IsRunning())
+    CTraceRecorder::GetInstance().AddEvent(m_name, m_start, CurrentHostCounter());
+}
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "threads/CriticalSection.h"
+
+/*!
+ \brief Records timed events of all threads for a timeline of single frames.
+
+ Each thread writes its events into its own ring buffer without locking, so only the latest
+ events of a thread are kept. Nothing is recorded while the recorder is stopped, a marker then
+ only costs a check of a flag. The events are exported in the trace event format of Chrome
+ (chrome://tracing, https://ui.perfetto.dev).
+
+ \sa CTraceScope
+ */
+class CTraceRecorder
+{
+public:
+  static const unsigned int EVENTS_PER_THREAD = 32768;
+
+  static CTraceRecorder &GetInstance();
+
+  static bool IsRunning() { return m_running.load(std::memory_order_relaxed); }
+
+  /*! \brief Start recording, earlier events are not exported anymore.
+   */
+  void Start();
+  void Stop();
+
+  /*! \brief Record an event of the calling thread.
+   \param name the name of the event, must be a string literal as only the pointer is kept.
+   \param start the start of the event, a value of CurrentHostCounter().
+   \param end the end of the event, a value of CurrentHostCounter().
+   */
+  void AddEvent(const char *name, int64_t start, int64_t end);
+
+  /*! \brief Write the recorded events as trace event JSON.
+   Can be called while recording, events overwritten meanwhile are left out.
+   */
+  void Export(std::string &json) const;
+  bool Export(const std::string &file) const;
+
+private:
+  CTraceRecorder() = default;
+  CTraceRecorder(const CTraceRecorder&) = delete;
+  CTraceRecorder& operator=(const CTraceRecorder&) = delete;
+
+  /*! \brief A slot of a ring buffer, a seqlock so Export() never takes a half written event.
+   The sequence is odd while the event is written and 2 * (index + 1) once it is complete, index
+   being the number of events the thread wrote before.
+   */
+  struct Event
+  {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<int64_t> start{0};
+    std::atomic<int64_t> end{0};
+  };
+
+  /*! \brief The events of a thread, written by that thread only.
+   Returned when the thread exits and handed to the next new thread, so threads that come and go
+   (e.g. job workers) do not add buffers. The events stay exported until then.
+   */
+  struct ThreadBuffer
+  {
+    unsigned int thread = 0;
+    std::atomic<uint64_t> written{0};
+    Event events[EVENTS_PER_THREAD];
+  };
+
+  /*! \brief Returns the buffer of a thread when the thread exits.
+   */
+  struct ThreadBufferOwner
+  {
+    ~ThreadBufferOwner();
+    ThreadBuffer *buffer = nullptr;
+  };
+
+  ThreadBuffer &GetThreadBuffer();
+  void ReleaseThreadBuffer(ThreadBuffer *buffer);
+
+  static std::atomic<bool> m_running;
+  std::atomic<int64_t> m_startTime{0};
+  mutable CCriticalSection m_section; ///< guards the lists of buffers, not the events
+  std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+  std::vector<ThreadBuffer*> m_freeBuffers; ///< buffers of exited threads, longest free first
+  unsigned int m_lastThread = 0;
+};
+
+/*!
+ \brief Records an event for the lifetime of the scope, while the CTraceRecorder is running.
+
+ \code
+ CTraceScope trace("CGUIWindowManager::Render");
+ \endcode
+ */
+class CTraceScope
+{
+public:
+  explicit CTraceScope(const char *name);
+  ~CTraceScope();
+
+private:
+  CTraceScope(const CTraceScope&) = delete;
+  CTraceScope& operator=(const CTraceScope&) = delete;
+
+  const char *m_name;
+  int64_t m_start;
+};
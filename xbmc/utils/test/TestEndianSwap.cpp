@@ -8,6 +8,8 @@
 
 #include "utils/EndianSwap.h"
 
+#include <string.h>
+
 #include "gtest/gtest.h"
 
 TEST(TestEndianSwap, Endian_Swap16)
@@ -131,3 +133,27 @@ TEST(TestEndianSwap, Endian_SwapBE64)
   EXPECT_EQ(ref, var);
 }
 #endif
+
+TEST(TestEndianSwap, Endian_Swap16_buf)
+{
+  /* odd lengths and offsets exercise both the vector body and the scalar tail */
+  uint16_t src[67], dst[67];
+  for (unsigned int i = 0; i < 67; i++)
+    src[i] = static_cast<uint16_t>(i * 0x0101 + 0x1200);
+
+  for (int w = 0; w <= 65; w++)
+  {
+    memset(dst, 0, sizeof(dst));
+    Endian_Swap16_buf(dst + 1, src + 1, w);
+    for (int i = 0; i < w; i++)
+      EXPECT_EQ(Endian_Swap16(src[i + 1]), dst[i + 1]);
+    EXPECT_EQ(0, dst[0]);
+    EXPECT_EQ(0, dst[w + 1]);
+  }
+
+  /* in place */
+  memcpy(dst, src, sizeof(src));
+  Endian_Swap16_buf(dst, dst, 67);
+  for (unsigned int i = 0; i < 67; i++)
+    EXPECT_EQ(Endian_Swap16(src[i]), dst[i]);
+}
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/JSONVariantParser.h"
+#include "utils/TraceRecorder.h"
+#include "utils/Variant.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+  unsigned int CountEvents(const std::string &name)
+  {
+    std::string json;
+    CTraceRecorder::GetInstance().Export(json);
+
+    CVariant trace;
+    EXPECT_TRUE(CJSONVariantParser::Parse(json, trace));
+    EXPECT_TRUE(trace["traceEvents"].isArray());
+
+    unsigned int count = 0;
+    for (auto it = trace["traceEvents"].begin_array(); it != trace["traceEvents"].end_array(); ++it)
+    {
+      if ((*it)["name"].asString() == name)
+      {
+        EXPECT_EQ("X", (*it)["ph"].asString());
+        EXPECT_GE((*it)["dur"].asDouble(), 0.0);
+        count++;
+      }
+    }
+    return count;
+  }
+}
+
+TEST(TestTraceRecorder, Stopped)
+{
+  CTraceRecorder::GetInstance().Stop();
+  {
+    CTraceScope trace("TestTraceRecorder.Stopped");
+  }
+  EXPECT_EQ(0U, CountEvents("TestTraceRecorder.Stopped"));
+}
+
+TEST(TestTraceRecorder, Scopes)
+{
+  CTraceRecorder::GetInstance().Start();
+  for (int i = 0; i < 3; ++i)
+  {
+    CTraceScope trace("TestTraceRecorder.Scopes");
+  }
+  CTraceRecorder::GetInstance().Stop();
+  EXPECT_EQ(3U, CountEvents("TestTraceRecorder.Scopes"));
+
+  // a new recording leaves out the events before it
+  CTraceRecorder::GetInstance().Start();
+  CTraceRecorder::GetInstance().Stop();
+  EXPECT_EQ(0U, CountEvents("TestTraceRecorder.Scopes"));
+}
+
+TEST(TestTraceRecorder, Wrap)
+{
+  CTraceRecorder::GetInstance().Start();
+  for (unsigned int i = 0; i < CTraceRecorder::EVENTS_PER_THREAD + 10; ++i)
+  {
+    CTraceScope trace("TestTraceRecorder.Wrap");
+  }
+  CTraceRecorder::GetInstance().Stop();
+  EXPECT_EQ(CTraceRecorder::EVENTS_PER_THREAD, CountEvents("TestTraceRecorder.Wrap"));
+}
+
+TEST(TestTraceRecorder, ThreadExit)
+{
+  CTraceRecorder::GetInstance().Start();
+  std::thread first([]() { CTraceScope trace("TestTraceRecorder.ThreadExit.First"); });
+  first.join();
+  EXPECT_EQ(1U, CountEvents("TestTraceRecorder.ThreadExit.First"));
+
+  // the next thread takes over the buffer of the exited one instead of adding a buffer
+  std::thread second([]() { CTraceScope trace("TestTraceRecorder.ThreadExit.Second"); });
+  second.join();
+  CTraceRecorder::GetInstance().Stop();
+  EXPECT_EQ(0U, CountEvents("TestTraceRecorder.ThreadExit.First"));
+  EXPECT_EQ(1U, CountEvents("TestTraceRecorder.ThreadExit.Second"));
+}
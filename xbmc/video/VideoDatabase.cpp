@@ -1674,6 +1674,26 @@ int CVideoDatabase::AddActor(const std::string& name, const std::string& thumbUR
 
 void CVideoDatabase::AddLinkToActor(int mediaId, const char *mediaType, int actorId, const std::string &role, int order)
 {
+  // the link is unique on (actor_id, media_type, media_id), let sqlite skip existing ones
+  dbiplus::PreparedStatement* stmt = m_sqlite ? GetPreparedStatement("INSERT OR IGNORE INTO actor_link (actor_id, media_id, media_type, role, cast_order) VALUES(?,?,?,?,?)") : nullptr;
+  if (stmt)
+  {
+    try
+    {
+      stmt->bind(1, actorId);
+      stmt->bind(2, mediaId);
+      stmt->bind(3, std::string(mediaType));
+      stmt->bind(4, role);
+      stmt->bind(5, order);
+      stmt->exec();
+    }
+    catch (...)
+    {
+      CLog::Log(LOGERROR, "%s (%i, %i) failed", __FUNCTION__, actorId, mediaId);
+    }
+    return;
+  }
+
   std::string sql=PrepareSQL("SELECT 1 FROM actor_link WHERE actor_id=%i AND media_id=%i AND media_type='%s'", actorId, mediaId, mediaType);
 
   if (GetSingleValue(sql).empty())
@@ -1686,6 +1706,25 @@ void CVideoDatabase::AddLinkToActor(int mediaId, const char *mediaType, int acto
 void CVideoDatabase::AddToLinkTable(int mediaId, const std::string& mediaType, const std::string& table, int valueId, const char *foreignKey)
 {
   const char *key = foreignKey ? foreignKey : table.c_str();
+
+  // the link tables are unique on (value id, media_type, media_id), let sqlite skip existing ones
+  dbiplus::PreparedStatement* stmt = m_sqlite ? GetPreparedStatement(PrepareSQL("INSERT OR IGNORE INTO %s_link (%s_id,media_id,media_type) VALUES(?,?,?)", table.c_str(), key)) : nullptr;
+  if (stmt)
+  {
+    try
+    {
+      stmt->bind(1, valueId);
+      stmt->bind(2, mediaId);
+      stmt->bind(3, mediaType);
+      stmt->exec();
+    }
+    catch (...)
+    {
+      CLog::Log(LOGERROR, "%s (%s, %i, %i) failed", __FUNCTION__, table.c_str(), valueId, mediaId);
+    }
+    return;
+  }
+
   std::string sql = PrepareSQL("SELECT 1 FROM %s_link WHERE %s_id=%i AND media_id=%i AND media_type='%s'", table.c_str(), key, valueId, mediaId, mediaType.c_str());
 
   if (GetSingleValue(sql).empty())
@@ -7101,6 +7140,25 @@ bool CVideoDatabase::GetMoviesNav(const std::string& strBaseDir, CFileItemList&
   return GetMoviesByWhere(videoUrl.ToString(), filter, items, sortDescription, getDetails);
 }
 
+void CVideoDatabase::AddMovieItem(const CVideoInfoTag &movie, const CVideoDbUrl &videoUrl, CFileItemList &items)
+{
+  if (m_profileManager.GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE ||
+      g_passwordManager.bMasterUser                                   ||
+      g_passwordManager.IsDatabasePathUnlocked(movie.m_strPath, *CMediaSourceSettings::GetInstance().GetSources("video")))
+  {
+    CFileItemPtr pItem(new CFileItem(movie));
+
+    CVideoDbUrl itemUrl = videoUrl;
+    std::string path = StringUtils::Format("%i", movie.m_iDbId);
+    itemUrl.AppendPath(path);
+    pItem->SetPath(itemUrl.ToString());
+    pItem->SetDynPath(movie.m_strFileNameAndPath);
+
+    pItem->SetOverlayImage(CGUIListItem::ICON_OVERLAY_UNWATCHED,movie.GetPlayCount() > 0);
+    items.Add(pItem);
+  }
+}
+
 bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filter &filter, CFileItemList& items, const SortDescription &sortDescription /* = SortDescription() */, int getDetails /* = VideoDbDetailsNone */)
 {
   try
@@ -7136,6 +7194,25 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
 
     strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
 
+    // without sorting the rows are used in database order, so they can be
+    // read through a cursor instead of holding the whole result set
+    if (sortDescription.sortBy == SortByNone)
+    {
+      unsigned int time = XbmcThreads::SystemClockMillis();
+      int iRowsFound = 0;
+      m_pDS->query_cursor(strSQL);
+      for (; !m_pDS->eof(); m_pDS->next(), iRowsFound++)
+        AddMovieItem(GetDetailsForMovie(m_pDS->get_sql_record(), getDetails), videoUrl, items);
+      m_pDS->close();
+      CLog::Log(LOGDEBUG, LOGDATABASE, "%s took %d ms for %d items cursor query: %s", __FUNCTION__, XbmcThreads::SystemClockMillis() - time, iRowsFound, strSQL.c_str());
+
+      // store the total value of items as a property
+      if (total < iRowsFound)
+        total = iRowsFound;
+      items.SetProperty("total", total);
+      return true;
+    }
+
     int iRowsFound = RunQuery(strSQL);
     if (iRowsFound <= 0)
       return iRowsFound == 0;
@@ -7159,22 +7236,7 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
       unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
       const dbiplus::sql_record* const record = data.at(targetRow);
 
-      CVideoInfoTag movie = GetDetailsForMovie(record, getDetails);
-      if (m_profileManager.GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE ||
-          g_passwordManager.bMasterUser                                   ||
-          g_passwordManager.IsDatabasePathUnlocked(movie.m_strPath, *CMediaSourceSettings::GetInstance().GetSources("video")))
-      {
-        CFileItemPtr pItem(new CFileItem(movie));
-
-        CVideoDbUrl itemUrl = videoUrl;
-        std::string path = StringUtils::Format("%i", movie.m_iDbId);
-        itemUrl.AppendPath(path);
-        pItem->SetPath(itemUrl.ToString());
-        pItem->SetDynPath(movie.m_strFileNameAndPath);
-
-        pItem->SetOverlayImage(CGUIListItem::ICON_OVERLAY_UNWATCHED,movie.GetPlayCount() > 0);
-        items.Add(pItem);
-      }
+      AddMovieItem(GetDetailsForMovie(record, getDetails), videoUrl, items);
     }
 
     // cleanup